@@ -1,7 +1,12 @@
 #version 440
 
-uniform mat4 model_view;
-uniform mat4 model_view_projection;
+layout(std140) uniform Camera
+{
+    mat4 view;
+    mat4 view_projection;
+};
+
+uniform mat4 model;
 
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec3 normal;
@@ -11,8 +16,10 @@ out vec3 vertex_normal;
 
 void main()
 {
-    gl_Position = model_view_projection * vec4(position, 1.0);
+    vec4 world_position = model * vec4(position, 1.0);
+    gl_Position = view_projection * world_position;
 
-    vertex_position = (model_view * vec4(position, 1.0)).xyz;
+    mat4 model_view = view * model;
+    vertex_position = (view * world_position).xyz;
     vertex_normal = normalize((model_view * vec4(normal, 0.0)).xyz);
 }
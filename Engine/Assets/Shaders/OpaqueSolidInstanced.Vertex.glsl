@@ -0,0 +1,26 @@
+#version 440
+
+layout(std140) uniform Camera
+{
+    mat4 view;
+    mat4 view_projection;
+};
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+
+// The model matrix of the instance occupies locations 12 through 15
+layout(location = 12) in mat4 model;
+
+out vec3 vertex_position;
+out vec3 vertex_normal;
+
+void main()
+{
+    vec4 world_position = model * vec4(position, 1.0);
+    gl_Position = view_projection * world_position;
+
+    mat4 model_view = view * model;
+    vertex_position = (view * world_position).xyz;
+    vertex_normal = normalize((model_view * vec4(normal, 0.0)).xyz);
+}
@@ -11,6 +11,7 @@ set(SOURCE_MATERIALS
     "Materials/Default.material.yaml"
     "Materials/Opaque.material.yaml"
     "Materials/OpaqueSolid.material.yaml"
+    "Materials/OpaqueSolidInstanced.material.yaml"
     )
 
 source_group("Assets\\Materials" FILES ${SOURCE_MATERIALS})
@@ -43,6 +44,8 @@ set(SOURCE_SHADERS
     "Shaders/OpaqueSolid.Fragment.glsl"
     "Shaders/OpaqueSolid.shader.yaml"
     "Shaders/OpaqueSolid.Vertex.glsl"
+    "Shaders/OpaqueSolidInstanced.shader.yaml"
+    "Shaders/OpaqueSolidInstanced.Vertex.glsl"
     "Shaders/SkyBox.Fragment.glsl"
     "Shaders/SkyBox.shader.yaml"
     "Shaders/SkyBox.Vertex.glsl"
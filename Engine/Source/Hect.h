@@ -42,26 +42,39 @@ namespace hect {}
 #include "Hect/Core/Format.h"
 #include "Hect/Core/Logging.h"
 #include "Hect/Core/Optional.h"
+#include "Hect/Core/RadixSort.h"
 #include "Hect/Core/Sequence.h"
+#include "Hect/Core/StridedView.h"
 #include "Hect/Core/Uncopyable.h"
 #include "Hect/Graphics/BlendFactor.h"
 #include "Hect/Graphics/Font.h"
 #include "Hect/Graphics/FrameBuffer.h"
 #include "Hect/Graphics/Image.h"
+#include "Hect/Graphics/ImageCompressor.h"
+#include "Hect/Graphics/LightProbeConvolver.h"
 #include "Hect/Graphics/Material.h"
 #include "Hect/Graphics/Mesh.h"
+#include "Hect/Graphics/MeshOptimizer.h"
 #include "Hect/Graphics/MeshReader.h"
 #include "Hect/Graphics/MeshWriter.h"
+#include "Hect/Graphics/MipmapFilter.h"
+#include "Hect/Graphics/MipmapGenerator.h"
 #include "Hect/Graphics/PhysicallyBasedSceneRenderer.h"
+#include "Hect/Graphics/PixelConversion.h"
+#include "Hect/Graphics/RenderCommandBuffer.h"
 #include "Hect/Graphics/Renderer.h"
 #include "Hect/Graphics/RenderTarget.h"
 #include "Hect/Graphics/Shader.h"
+#include "Hect/Graphics/SphericalHarmonics.h"
 #include "Hect/Graphics/Texture2.h"
 #include "Hect/Graphics/Uniform.h"
 #include "Hect/Graphics/UniformBinding.h"
+#include "Hect/Graphics/UniformBlock.h"
+#include "Hect/Graphics/UniformBlockLayout.h"
 #include "Hect/Graphics/UniformValue.h"
 #include "Hect/Graphics/VectorRenderer.h"
 #include "Hect/Graphics/VertexAttribute.h"
+#include "Hect/Graphics/VertexAttributeTraits.h"
 #include "Hect/Graphics/VertexLayout.h"
 #include "Hect/Input/InputAxis.h"
 #include "Hect/Input/InputAxisBinding.h"
@@ -79,6 +92,7 @@ namespace hect {}
 #include "Hect/IO/AssetDecoder.h"
 #include "Hect/IO/AssetEntry.h"
 #include "Hect/IO/AssetHandle.h"
+#include "Hect/IO/AssetManifest.h"
 #include "Hect/IO/BinaryDecoder.h"
 #include "Hect/IO/BinaryEncoder.h"
 #include "Hect/IO/ByteVector.h"
@@ -97,15 +111,19 @@ namespace hect {}
 #include "Hect/IO/ReadStream.h"
 #include "Hect/IO/WriteStream.h"
 #include "Hect/Math/AxisAlignedBox.h"
+#include "Hect/Math/AxisAlignedBoxBatch.h"
 #include "Hect/Math/Box.h"
 #include "Hect/Math/Constants.h"
 #include "Hect/Math/Frustum.h"
 #include "Hect/Math/Functions.h"
 #include "Hect/Math/Matrix4.h"
 #include "Hect/Math/Plane.h"
+#include "Hect/Math/Quantization.h"
 #include "Hect/Math/Quaternion.h"
 #include "Hect/Math/Rectangle.h"
+#include "Hect/Math/Simd.h"
 #include "Hect/Math/Sphere.h"
+#include "Hect/Math/SphereBatch.h"
 #include "Hect/Math/Vector2.h"
 #include "Hect/Math/Vector3.h"
 #include "Hect/Math/Vector4.h"
@@ -123,9 +141,11 @@ namespace hect {}
 #include "Hect/Scene/ComponentPool.h"
 #include "Hect/Scene/ComponentRegistry.h"
 #include "Hect/Scene/Entity.h"
+#include "Hect/Scene/EntityCommandBuffer.h"
 #include "Hect/Scene/EntityEvent.h"
 #include "Hect/Scene/EntityPool.h"
 #include "Hect/Scene/IdPool.h"
+#include "Hect/Scene/Prefab.h"
 #include "Hect/Scene/Scene.h"
 #include "Hect/Scene/SceneRegistry.h"
 #include "Hect/Scene/System.h"
@@ -103,6 +103,11 @@ void TaskPool::wait()
     }
 }
 
+size_t TaskPool::thread_count() const
+{
+    return _threads.size();
+}
+
 void TaskPool::initialize_threads(size_t thread_count)
 {
     for (unsigned i = 0; i < thread_count; ++i)
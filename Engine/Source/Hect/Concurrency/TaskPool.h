@@ -85,6 +85,10 @@ public:
     /// Waits until all enqueued tasks complete.
     void wait();
 
+    ///
+    /// Returns the number of worker threads.
+    size_t thread_count() const;
+
 private:
     void initialize_threads(size_t thread_count);
     void thread_loop();
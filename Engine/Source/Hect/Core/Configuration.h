@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2015 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// Detect build platform and mode
+#ifdef _MSC_VER
+#define HECT_WINDOWS_BUILD
+#ifdef _DEBUG
+#define HECT_DEBUG_BUILD
+#endif
+#endif
+
+#define HECT_HEADLESS
+
+// Set platform/renderer implementation
+#ifndef HECT_HEADLESS
+#define HECT_PLATFORM_SDL
+#define HECT_RENDERER_OPENGL
+#endif
+
+#define HECT_SIMD
+
+// Detect the SIMD instruction sets available to the math kernels
+#ifdef HECT_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HECT_SIMD_SSE2
+#endif
+#if defined(__AVX__) && defined(HECT_SIMD_SSE2)
+#define HECT_SIMD_AVX
+#endif
+#endif
+
+// Enable logger levels for debug/release builds
+#ifdef HECT_DEBUG_BUILD
+#define HECT_ENABLE_LOG_INFO
+#define HECT_ENABLE_LOG_DEBUG
+#define HECT_ENABLE_LOG_WARNING
+#define HECT_ENABLE_LOG_ERROR
+#define HECT_ENABLE_LOG_TRACE
+#else
+#define HECT_ENABLE_LOG_INFO
+#define HECT_ENABLE_LOG_WARNING
+#define HECT_ENABLE_LOG_ERROR
+#endif
@@ -30,11 +30,16 @@
 namespace hect
 {
 
+class TaskPool;
+
 template <typename Type>
 class EventListener;
 
 ///
 /// Notifies registered EventListener%s of specific events.
+///
+/// Events can either be dispatched immediately or enqueued to be delivered
+/// in a batch at a later sync point using dispatch_queued_events().
 template <typename Type>
 class EventDispatcher
 {
@@ -68,8 +73,45 @@ public:
     /// \param event The event.
     void dispatch_event(const Type& event);
 
+    ///
+    /// Enqueues an event to be dispatched on the next call to
+    /// dispatch_queued_events().
+    ///
+    /// \param event The event.
+    void enqueue_event(const Type& event);
+
+    ///
+    /// Returns whether there are any events waiting to be dispatched.
+    bool has_queued_events() const;
+
+    ///
+    /// Dispatches all enqueued events to all registered EventListener%s as
+    /// a single batch.
+    ///
+    /// \note Events enqueued while the batch is being dispatched are held
+    /// until the next call.  If a listener throws then the rest of the batch
+    /// is discarded rather than delivered again on the next call.
+    void dispatch_queued_events();
+
+    ///
+    /// Dispatches all enqueued events as a single batch with each registered
+    /// EventListener receiving the batch in a separate task.
+    ///
+    /// \warning The listeners must be safe to invoke concurrently with each
+    /// other.
+    ///
+    /// \param task_pool The task pool to enqueue the tasks to.
+    ///
+    /// \throws TaskError If a listener throws; the remaining listeners still
+    /// receive the batch before the error is re-thrown.
+    void dispatch_queued_events(TaskPool& task_pool);
+
 private:
     std::vector<EventListener<Type>*> _listeners;
+
+    // The buffers are swapped on dispatch so that their capacity is retained
+    std::vector<Type> _queued_events;
+    std::vector<Type> _dispatching_events;
 };
 
 }
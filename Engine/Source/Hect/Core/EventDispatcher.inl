@@ -22,7 +22,9 @@
 // IN THE SOFTWARE.
 ///////////////////////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <exception>
 
+#include "Hect/Concurrency/TaskPool.h"
 #include "Hect/Core/EventListener.h"
 
 namespace hect
@@ -80,4 +82,89 @@ void EventDispatcher<Type>::dispatch_event(const Type& event)
     }
 }
 
+template <typename Type>
+void EventDispatcher<Type>::enqueue_event(const Type& event)
+{
+    _queued_events.push_back(event);
+}
+
+template <typename Type>
+bool EventDispatcher<Type>::has_queued_events() const
+{
+    return !_queued_events.empty();
+}
+
+template <typename Type>
+void EventDispatcher<Type>::dispatch_queued_events()
+{
+    _dispatching_events.swap(_queued_events);
+
+    try
+    {
+        for (EventListener<Type>* listener : _listeners)
+        {
+            listener->receive_events(_dispatching_events);
+        }
+    }
+    catch (...)
+    {
+        // Never deliver the events of the batch again
+        _dispatching_events.clear();
+        throw;
+    }
+
+    _dispatching_events.clear();
+}
+
+template <typename Type>
+void EventDispatcher<Type>::dispatch_queued_events(TaskPool& task_pool)
+{
+    _dispatching_events.swap(_queued_events);
+
+    std::exception_ptr exception;
+    if (!_dispatching_events.empty())
+    {
+        std::vector<Task::Handle> tasks;
+        try
+        {
+            tasks.reserve(_listeners.size());
+            for (EventListener<Type>* listener : _listeners)
+            {
+                tasks.push_back(task_pool.enqueue([this, listener]
+                {
+                    listener->receive_events(_dispatching_events);
+                }));
+            }
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        // Every task reads the batch so all of them must finish before it is
+        // cleared, even if one of them failed; the first error is re-thrown
+        for (Task::Handle& task : tasks)
+        {
+            try
+            {
+                task->wait();
+            }
+            catch (...)
+            {
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        }
+    }
+
+    _dispatching_events.clear();
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
 }
@@ -52,6 +52,15 @@ public:
     /// \param event The event.
     virtual void receive_event(const Type& event) = 0;
 
+    ///
+    /// Notifies the listener of a batch of events.
+    ///
+    /// \note The default implementation invokes receive_event() for each
+    /// event in order.
+    ///
+    /// \param events The events.
+    virtual void receive_events(const std::vector<Type>& events);
+
 private:
     void add_dispatcher(EventDispatcher<Type>& dispatcher);
     void remove_dispatcher(EventDispatcher<Type>& dispatcher);
@@ -41,6 +41,15 @@ EventListener<Type>::~EventListener()
     }
 }
 
+template <typename Type>
+void EventListener<Type>::receive_events(const std::vector<Type>& events)
+{
+    for (const Type& event : events)
+    {
+        receive_event(event);
+    }
+}
+
 template <typename Type>
 void EventListener<Type>::add_dispatcher(EventDispatcher<Type>& dispatcher)
 {
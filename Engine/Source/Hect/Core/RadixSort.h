@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace hect
+{
+
+///
+/// Sorts values in ascending order of a 64-bit unsigned key using a stable
+/// least-significant-digit radix sort.
+///
+/// The key of each value is read once per pass; passes over bytes which are
+/// the same for every key are skipped.
+///
+/// \param values The values to sort.
+/// \param scratch A buffer used while sorting; its contents are unspecified
+/// afterwards but its capacity can be re-used between sorts.
+/// \param key The key of a value; must be callable as a function accepting a
+/// constant reference to a value and returning a \c uint64_t.
+template <typename Type, typename KeyType>
+void radix_sort(std::vector<Type>& values, std::vector<Type>& scratch, KeyType&& key);
+
+}
+
+#include "RadixSort.inl"
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <array>
+#include <utility>
+
+namespace hect
+{
+
+template <typename Type, typename KeyType>
+void radix_sort(std::vector<Type>& values, std::vector<Type>& scratch, KeyType&& key)
+{
+    const size_t count = values.size();
+    if (count < 2)
+    {
+        return;
+    }
+
+    const unsigned byte_count = 8;
+    const unsigned bucket_count = 256;
+
+    // Build the histograms of all bytes in a single pass
+    std::array<std::array<size_t, bucket_count>, byte_count> histograms = { };
+    for (const Type& value : values)
+    {
+        uint64_t value_key = key(value);
+        for (unsigned byte = 0; byte < byte_count; ++byte)
+        {
+            ++histograms[byte][(value_key >> (byte * 8)) & 0xff];
+        }
+    }
+
+    scratch.resize(count);
+
+    std::vector<Type>* source = &values;
+    std::vector<Type>* dest = &scratch;
+
+    for (unsigned byte = 0; byte < byte_count; ++byte)
+    {
+        std::array<size_t, bucket_count>& histogram = histograms[byte];
+
+        // Skip the pass if every key falls in the same bucket
+        const uint64_t first_bucket = (key((*source)[0]) >> (byte * 8)) & 0xff;
+        if (histogram[first_bucket] == count)
+        {
+            continue;
+        }
+
+        // Convert the histogram into the offset of each bucket
+        size_t offset = 0;
+        for (size_t& bucket : histogram)
+        {
+            const size_t bucket_size = bucket;
+            bucket = offset;
+            offset += bucket_size;
+        }
+
+        for (Type& value : *source)
+        {
+            const uint64_t bucket = (key(value) >> (byte * 8)) & 0xff;
+            (*dest)[histogram[bucket]++] = std::move(value);
+        }
+
+        std::swap(source, dest);
+    }
+
+    // Move the result back if it ended up in the scratch buffer
+    if (source != &values)
+    {
+        values.swap(scratch);
+    }
+}
+
+}
@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hect
+{
+
+///
+/// A read-only view of values of a type laid out in memory at a fixed
+/// stride, such as a single attribute of interleaved vertex data.
+///
+/// \note Values are copied out of the underlying memory when accessed so
+/// the memory does not need to be aligned for the type.  The view does not
+/// own the memory and is invalidated when the memory is.
+template <typename Type>
+class StridedView
+{
+public:
+
+    ///
+    /// An iterator over the values of a StridedView.
+    class Iterator
+    {
+    public:
+
+        ///
+        /// Constructs an iterator.
+        ///
+        /// \param data The address of the value the iterator refers to.
+        /// \param stride The number of bytes between consecutive values.
+        Iterator(const uint8_t* data, size_t stride);
+
+        ///
+        /// Returns the value the iterator refers to.
+        Type operator*() const;
+
+        ///
+        /// Moves to the next value.
+        ///
+        /// \returns A reference to the iterator.
+        Iterator& operator++();
+
+        ///
+        /// Returns whether the iterator is equivalent to another.
+        ///
+        /// \param other The other iterator.
+        bool operator==(const Iterator& other) const;
+
+        ///
+        /// Returns whether the iterator is different from another.
+        ///
+        /// \param other The other iterator.
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        const uint8_t* _data;
+        size_t _stride;
+    };
+
+    ///
+    /// Constructs an empty view.
+    StridedView();
+
+    ///
+    /// Constructs a view.
+    ///
+    /// \param data The address of the first value.
+    /// \param stride The number of bytes between consecutive values.
+    /// \param count The number of values.
+    StridedView(const uint8_t* data, size_t stride, size_t count);
+
+    ///
+    /// Returns an iterator to the beginning of the view.
+    Iterator begin() const;
+
+    ///
+    /// Returns an iterator to the end of the view.
+    Iterator end() const;
+
+    ///
+    /// Returns the number of values in the view.
+    size_t size() const;
+
+    ///
+    /// Returns whether the view has no values.
+    bool empty() const;
+
+    ///
+    /// Returns the number of bytes between consecutive values.
+    size_t stride() const;
+
+    ///
+    /// Returns whether the values are tightly packed.
+    bool is_contiguous() const;
+
+    ///
+    /// Returns the address of the first value.
+    const uint8_t* data() const;
+
+    ///
+    /// Returns the value at the given index.
+    ///
+    /// \param index The index of the value.
+    Type operator[](size_t index) const;
+
+    ///
+    /// Copies all values of the view into an array.
+    ///
+    /// \param values The array to copy the values into; must be large
+    /// enough to hold all values of the view.
+    void copy_to(Type* values) const;
+
+    ///
+    /// Converts all values of the view to another type and stores them in
+    /// an array.
+    ///
+    /// \param values The array to store the converted values in; must be
+    /// large enough to hold all values of the view.
+    template <typename OutputType>
+    void convert_to(OutputType* values) const;
+
+private:
+    const uint8_t* _data { nullptr };
+    size_t _stride { sizeof(Type) };
+    size_t _count { 0 };
+};
+
+}
+
+#include "StridedView.inl"
@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <cstring>
+
+namespace hect
+{
+
+template <typename Type>
+StridedView<Type>::Iterator::Iterator(const uint8_t* data, size_t stride) :
+    _data(data),
+    _stride(stride)
+{
+}
+
+template <typename Type>
+Type StridedView<Type>::Iterator::operator*() const
+{
+    Type value;
+    std::memcpy(&value, _data, sizeof(Type));
+    return value;
+}
+
+template <typename Type>
+typename StridedView<Type>::Iterator& StridedView<Type>::Iterator::operator++()
+{
+    _data += _stride;
+    return *this;
+}
+
+template <typename Type>
+bool StridedView<Type>::Iterator::operator==(const Iterator& other) const
+{
+    return _data == other._data;
+}
+
+template <typename Type>
+bool StridedView<Type>::Iterator::operator!=(const Iterator& other) const
+{
+    return _data != other._data;
+}
+
+template <typename Type>
+StridedView<Type>::StridedView()
+{
+}
+
+template <typename Type>
+StridedView<Type>::StridedView(const uint8_t* data, size_t stride, size_t count) :
+    _data(data),
+    _stride(stride),
+    _count(count)
+{
+}
+
+template <typename Type>
+typename StridedView<Type>::Iterator StridedView<Type>::begin() const
+{
+    return Iterator(_data, _stride);
+}
+
+template <typename Type>
+typename StridedView<Type>::Iterator StridedView<Type>::end() const
+{
+    return Iterator(_data + _stride * _count, _stride);
+}
+
+template <typename Type>
+size_t StridedView<Type>::size() const
+{
+    return _count;
+}
+
+template <typename Type>
+bool StridedView<Type>::empty() const
+{
+    return _count == 0;
+}
+
+template <typename Type>
+size_t StridedView<Type>::stride() const
+{
+    return _stride;
+}
+
+template <typename Type>
+bool StridedView<Type>::is_contiguous() const
+{
+    return _stride == sizeof(Type);
+}
+
+template <typename Type>
+const uint8_t* StridedView<Type>::data() const
+{
+    return _data;
+}
+
+template <typename Type>
+Type StridedView<Type>::operator[](size_t index) const
+{
+    Type value;
+    std::memcpy(&value, _data + _stride * index, sizeof(Type));
+    return value;
+}
+
+template <typename Type>
+void StridedView<Type>::copy_to(Type* values) const
+{
+    if (_count == 0)
+    {
+        return;
+    }
+
+    if (is_contiguous())
+    {
+        std::memcpy(values, _data, sizeof(Type) * _count);
+    }
+    else
+    {
+        const uint8_t* data = _data;
+        for (size_t i = 0; i < _count; ++i, data += _stride)
+        {
+            std::memcpy(values + i, data, sizeof(Type));
+        }
+    }
+}
+
+template <typename Type>
+template <typename OutputType>
+void StridedView<Type>::convert_to(OutputType* values) const
+{
+    const uint8_t* data = _data;
+    for (size_t i = 0; i < _count; ++i, data += _stride)
+    {
+        Type value;
+        std::memcpy(&value, data, sizeof(Type));
+        values[i] = static_cast<OutputType>(value);
+    }
+}
+
+}
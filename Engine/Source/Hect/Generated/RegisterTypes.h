@@ -0,0 +1,890 @@
+// Generated by Build Tool (see Engine/Tools/Build for details)
+#pragma once
+
+#include <Hect/Scene/ComponentRegistry.h>
+#include <Hect/Scene/SceneRegistry.h>
+#include <Hect/Scene/SystemRegistry.h>
+#include <Hect/Reflection/Type.h>
+
+#include "../Core/LogLevel.h"
+#include "../Graphics/BlendFactor.h"
+#include "../Graphics/BlendFunction.h"
+#include "../Graphics/ColorSpace.h"
+#include "../Graphics/CubeSide.h"
+#include "../Graphics/CullMode.h"
+#include "../Graphics/FrameBufferAttachmentType.h"
+#include "../Graphics/FrameBufferSlot.h"
+#include "../Graphics/IndexType.h"
+#include "../Graphics/MipmapFilter.h"
+#include "../Graphics/PixelType.h"
+#include "../Graphics/PrimitiveType.h"
+#include "../Graphics/RenderStage.h"
+#include "../Graphics/ShaderModuleType.h"
+#include "../Graphics/TextureFilter.h"
+#include "../Graphics/UniformBinding.h"
+#include "../Graphics/UniformType.h"
+#include "../Graphics/VertexAttributeSemantic.h"
+#include "../Graphics/VertexAttributeType.h"
+#include "../IO/DataValueType.h"
+#include "../Input/InputAxisBindingType.h"
+#include "../Input/JoystickAxis.h"
+#include "../Input/JoystickEventType.h"
+#include "../Input/Key.h"
+#include "../Input/KeyboardEventType.h"
+#include "../Input/MouseButton.h"
+#include "../Input/MouseEventType.h"
+#include "../Input/MouseMode.h"
+#include "../Interface/HorizontalAlign.h"
+#include "../Interface/StyleColor.h"
+#include "../Interface/VerticalAlign.h"
+#include "../Math/Frustum.h"
+#include "../Network/Host.h"
+#include "../Network/Peer.h"
+#include "../Reflection/Type.h"
+#include "../Scene/ComponentEventType.h"
+#include "../Scene/Components/BoundingBoxComponent.h"
+#include "../Scene/Components/CameraComponent.h"
+#include "../Scene/Components/DirectionalLightComponent.h"
+#include "../Scene/Components/GeometryComponent.h"
+#include "../Scene/Components/LightProbeComponent.h"
+#include "../Scene/Components/RigidBodyComponent.h"
+#include "../Scene/Components/SkyBoxComponent.h"
+#include "../Scene/Components/TransformComponent.h"
+#include "../Scene/EntityEventType.h"
+#include "../Scene/Scenes/DefaultScene.h"
+#include "../Scene/Systems/BoundingBoxSystem.h"
+#include "../Scene/Systems/CameraSystem.h"
+#include "../Scene/Systems/DebugSystem.h"
+#include "../Scene/Systems/InputSystem.h"
+#include "../Scene/Systems/InterfaceSystem.h"
+#include "../Scene/Systems/PhysicsSystem.h"
+#include "../Scene/Systems/ScriptSystem.h"
+#include "../Scene/Systems/TransformSystem.h"
+
+namespace hect
+{
+
+void register_types()
+{
+    // Enums
+    
+    // ShaderModuleType
+    {
+        hect::Type& type = hect::Type::create<ShaderModuleType>(hect::Kind::Enum, "ShaderModuleType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(ShaderModuleType::Vertex), "Vertex");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(ShaderModuleType::Fragment), "Fragment");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(ShaderModuleType::Geometry), "Geometry");
+    }
+    
+    // FrameBufferSlot
+    {
+        hect::Type& type = hect::Type::create<FrameBufferSlot>(hect::Kind::Enum, "FrameBufferSlot");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color0), "Color0");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color1), "Color1");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color2), "Color2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color3), "Color3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color4), "Color4");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color5), "Color5");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color6), "Color6");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color7), "Color7");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color8), "Color8");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color9), "Color9");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color10), "Color10");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color11), "Color11");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color12), "Color12");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color13), "Color13");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color14), "Color14");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Color15), "Color15");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferSlot::Depth), "Depth");
+    }
+    
+    // RenderStage
+    {
+        hect::Type& type = hect::Type::create<RenderStage>(hect::Kind::Enum, "RenderStage");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(RenderStage::None), "None");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(RenderStage::PrePhysicalGeometry), "PrePhysicalGeometry");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(RenderStage::PhysicalGeometry), "PhysicalGeometry");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(RenderStage::PostPhysicalGeometry), "PostPhysicalGeometry");
+    }
+    
+    // UniformBinding
+    {
+        hect::Type& type = hect::Type::create<UniformBinding>(hect::Kind::Enum, "UniformBinding");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::None), "None");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::RenderTargetSize), "RenderTargetSize");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::CameraPosition), "CameraPosition");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::CameraFront), "CameraFront");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::CameraUp), "CameraUp");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::CameraExposure), "CameraExposure");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::CameraOneOverGamma), "CameraOneOverGamma");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::PrimaryLightDirection), "PrimaryLightDirection");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::PrimaryLightColor), "PrimaryLightColor");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::ViewMatrix), "ViewMatrix");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::ProjectionMatrix), "ProjectionMatrix");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::ViewProjectionMatrix), "ViewProjectionMatrix");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::ModelMatrix), "ModelMatrix");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::ModelViewMatrix), "ModelViewMatrix");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::ModelViewProjectionMatrix), "ModelViewProjectionMatrix");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::LightProbeTexture), "LightProbeTexture");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::SkyBoxTexture), "SkyBoxTexture");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::DiffuseBuffer), "DiffuseBuffer");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::MaterialBuffer), "MaterialBuffer");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::PositionBuffer), "PositionBuffer");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::NormalBuffer), "NormalBuffer");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformBinding::BackBuffer), "BackBuffer");
+    }
+    
+    // MipmapFilter
+    {
+        hect::Type& type = hect::Type::create<MipmapFilter>(hect::Kind::Enum, "MipmapFilter");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MipmapFilter::Box), "Box");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MipmapFilter::Kaiser), "Kaiser");
+    }
+    
+    // UniformType
+    {
+        hect::Type& type = hect::Type::create<UniformType>(hect::Kind::Enum, "UniformType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::Int), "Int");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::Float), "Float");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::Vector2), "Vector2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::Vector3), "Vector3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::Vector4), "Vector4");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::Matrix4), "Matrix4");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::Color), "Color");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::Texture2), "Texture2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::Texture3), "Texture3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(UniformType::TextureCube), "TextureCube");
+    }
+    
+    // BlendFunction
+    {
+        hect::Type& type = hect::Type::create<BlendFunction>(hect::Kind::Enum, "BlendFunction");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFunction::Add), "Add");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFunction::Subtract), "Subtract");
+    }
+    
+    // PrimitiveType
+    {
+        hect::Type& type = hect::Type::create<PrimitiveType>(hect::Kind::Enum, "PrimitiveType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PrimitiveType::Triangles), "Triangles");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PrimitiveType::TriangleStrip), "TriangleStrip");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PrimitiveType::Lines), "Lines");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PrimitiveType::LineStrip), "LineStrip");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PrimitiveType::Points), "Points");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PrimitiveType::PointSprites), "PointSprites");
+    }
+    
+    // ColorSpace
+    {
+        hect::Type& type = hect::Type::create<ColorSpace>(hect::Kind::Enum, "ColorSpace");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(ColorSpace::NonLinear), "NonLinear");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(ColorSpace::Linear), "Linear");
+    }
+    
+    // VertexAttributeSemantic
+    {
+        hect::Type& type = hect::Type::create<VertexAttributeSemantic>(hect::Kind::Enum, "VertexAttributeSemantic");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::Position), "Position");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::Normal), "Normal");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::Color), "Color");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::Tangent), "Tangent");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::Binormal), "Binormal");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::Weight0), "Weight0");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::Weight1), "Weight1");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::Weight2), "Weight2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::Weight3), "Weight3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::TextureCoords0), "TextureCoords0");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::TextureCoords1), "TextureCoords1");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::TextureCoords2), "TextureCoords2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeSemantic::TextureCoords3), "TextureCoords3");
+    }
+    
+    // VertexAttributeType
+    {
+        hect::Type& type = hect::Type::create<VertexAttributeType>(hect::Kind::Enum, "VertexAttributeType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::Int8), "Int8");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::UInt8), "UInt8");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::Int16), "Int16");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::UInt16), "UInt16");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::Int32), "Int32");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::UInt32), "UInt32");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::Float16), "Float16");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::Float32), "Float32");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::NormalizedInt16), "NormalizedInt16");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::NormalizedUInt16), "NormalizedUInt16");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VertexAttributeType::OctahedralInt16), "OctahedralInt16");
+    }
+    
+    // PixelType
+    {
+        hect::Type& type = hect::Type::create<PixelType>(hect::Kind::Enum, "PixelType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PixelType::Byte), "Byte");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PixelType::Float16), "Float16");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PixelType::Float32), "Float32");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PixelType::Bc1), "Bc1");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PixelType::Bc3), "Bc3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PixelType::Bc4), "Bc4");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PixelType::Bc5), "Bc5");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PixelType::Bc7), "Bc7");
+    }
+    
+    // BlendFactor
+    {
+        hect::Type& type = hect::Type::create<BlendFactor>(hect::Kind::Enum, "BlendFactor");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::Zero), "Zero");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::One), "One");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::SourceColor), "SourceColor");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::OneMinusSourceColor), "OneMinusSourceColor");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::DestinationColor), "DestinationColor");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::OneMinusDestinationColor), "OneMinusDestinationColor");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::SourceAlpha), "SourceAlpha");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::OneMinusSourceAlpha), "OneMinusSourceAlpha");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::DestinationAlpha), "DestinationAlpha");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(BlendFactor::OneMinusDestinationAlpha), "OneMinusDestinationAlpha");
+    }
+    
+    // IndexType
+    {
+        hect::Type& type = hect::Type::create<IndexType>(hect::Kind::Enum, "IndexType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(IndexType::UInt8), "UInt8");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(IndexType::UInt16), "UInt16");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(IndexType::UInt32), "UInt32");
+    }
+    
+    // CubeSide
+    {
+        hect::Type& type = hect::Type::create<CubeSide>(hect::Kind::Enum, "CubeSide");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(CubeSide::PositiveX), "PositiveX");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(CubeSide::NegativeX), "NegativeX");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(CubeSide::PositiveY), "PositiveY");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(CubeSide::NegativeY), "NegativeY");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(CubeSide::PositiveZ), "PositiveZ");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(CubeSide::NegativeZ), "NegativeZ");
+    }
+    
+    // FrameBufferAttachmentType
+    {
+        hect::Type& type = hect::Type::create<FrameBufferAttachmentType>(hect::Kind::Enum, "FrameBufferAttachmentType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferAttachmentType::Texture2), "Texture2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferAttachmentType::Texture3), "Texture3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrameBufferAttachmentType::TextureCube), "TextureCube");
+    }
+    
+    // TextureFilter
+    {
+        hect::Type& type = hect::Type::create<TextureFilter>(hect::Kind::Enum, "TextureFilter");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(TextureFilter::Nearest), "Nearest");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(TextureFilter::Linear), "Linear");
+    }
+    
+    // CullMode
+    {
+        hect::Type& type = hect::Type::create<CullMode>(hect::Kind::Enum, "CullMode");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(CullMode::CounterClockwise), "CounterClockwise");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(CullMode::Clockwise), "Clockwise");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(CullMode::None), "None");
+    }
+    
+    // FrustumTestResult
+    {
+        hect::Type& type = hect::Type::create<FrustumTestResult>(hect::Kind::Enum, "FrustumTestResult");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrustumTestResult::Outside), "Outside");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrustumTestResult::Inside), "Inside");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(FrustumTestResult::Intersect), "Intersect");
+    }
+    
+    // PeerState
+    {
+        hect::Type& type = hect::Type::create<PeerState>(hect::Kind::Enum, "PeerState");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::Disconnected), "Disconnected");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::Connecting), "Connecting");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::AcknowledgingConnect), "AcknowledgingConnect");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::ConnectionPending), "ConnectionPending");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::ConnectionSucceeded), "ConnectionSucceeded");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::Connected), "Connected");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::DisconnectLater), "DisconnectLater");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::Disconnecting), "Disconnecting");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::AcknowledgeDisconnect), "AcknowledgeDisconnect");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerState::Unknown), "Unknown");
+    }
+    
+    // PeerEventType
+    {
+        hect::Type& type = hect::Type::create<PeerEventType>(hect::Kind::Enum, "PeerEventType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerEventType::None), "None");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerEventType::Connect), "Connect");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerEventType::Disconnect), "Disconnect");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(PeerEventType::ReceivePacket), "ReceivePacket");
+    }
+    
+    // HorizontalAlign
+    {
+        hect::Type& type = hect::Type::create<HorizontalAlign>(hect::Kind::Enum, "HorizontalAlign");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(HorizontalAlign::None), "None");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(HorizontalAlign::Left), "Left");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(HorizontalAlign::Center), "Center");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(HorizontalAlign::Right), "Right");
+    }
+    
+    // StyleColor
+    {
+        hect::Type& type = hect::Type::create<StyleColor>(hect::Kind::Enum, "StyleColor");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::Background), "Background");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::BackgroundPressed), "BackgroundPressed");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::BackgroundSelected), "BackgroundSelected");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::BackgroundMouseOver), "BackgroundMouseOver");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::Foreground), "Foreground");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::ForegroundSelected), "ForegroundSelected");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::ForegroundPressed), "ForegroundPressed");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::ForegroundMouseOver), "ForegroundMouseOver");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::Border), "Border");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::BorderPressed), "BorderPressed");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(StyleColor::BorderMouseOver), "BorderMouseOver");
+    }
+    
+    // VerticalAlign
+    {
+        hect::Type& type = hect::Type::create<VerticalAlign>(hect::Kind::Enum, "VerticalAlign");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VerticalAlign::None), "None");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VerticalAlign::Bottom), "Bottom");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VerticalAlign::Center), "Center");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(VerticalAlign::Top), "Top");
+    }
+    
+    // ComponentEventType
+    {
+        hect::Type& type = hect::Type::create<ComponentEventType>(hect::Kind::Enum, "ComponentEventType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(ComponentEventType::Add), "Add");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(ComponentEventType::Remove), "Remove");
+    }
+    
+    // EntityEventType
+    {
+        hect::Type& type = hect::Type::create<EntityEventType>(hect::Kind::Enum, "EntityEventType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(EntityEventType::Create), "Create");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(EntityEventType::Activate), "Activate");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(EntityEventType::Destroy), "Destroy");
+    }
+    
+    // Mobility
+    {
+        hect::Type& type = hect::Type::create<Mobility>(hect::Kind::Enum, "Mobility");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Mobility::Dynamic), "Dynamic");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Mobility::Static), "Static");
+    }
+    
+    // LogLevel
+    {
+        hect::Type& type = hect::Type::create<LogLevel>(hect::Kind::Enum, "LogLevel");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(LogLevel::Info), "Info");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(LogLevel::Debug), "Debug");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(LogLevel::Warning), "Warning");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(LogLevel::Error), "Error");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(LogLevel::Trace), "Trace");
+    }
+    
+    // Kind
+    {
+        hect::Type& type = hect::Type::create<Kind>(hect::Kind::Enum, "Kind");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Kind::None), "None");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Kind::Namespace), "Namespace");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Kind::Class), "Class");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Kind::Enum), "Enum");
+    }
+    
+    // DataValueType
+    {
+        hect::Type& type = hect::Type::create<DataValueType>(hect::Kind::Enum, "DataValueType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(DataValueType::Null), "Null");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(DataValueType::Bool), "Bool");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(DataValueType::Number), "Number");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(DataValueType::String), "String");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(DataValueType::Array), "Array");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(DataValueType::Object), "Object");
+    }
+    
+    // MouseEventType
+    {
+        hect::Type& type = hect::Type::create<MouseEventType>(hect::Kind::Enum, "MouseEventType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseEventType::Movement), "Movement");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseEventType::ButtonDown), "ButtonDown");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseEventType::ButtonUp), "ButtonUp");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseEventType::ScrollDown), "ScrollDown");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseEventType::ScrollUp), "ScrollUp");
+    }
+    
+    // Key
+    {
+        hect::Type& type = hect::Type::create<Key>(hect::Kind::Enum, "Key");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Unknown), "Unknown");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::A), "A");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::B), "B");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::C), "C");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::D), "D");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::E), "E");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F), "F");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::G), "G");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::H), "H");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::I), "I");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::J), "J");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::K), "K");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::L), "L");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::M), "M");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::N), "N");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::O), "O");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::P), "P");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Q), "Q");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::R), "R");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::S), "S");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::T), "T");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::U), "U");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::V), "V");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::W), "W");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::X), "X");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Y), "Y");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Z), "Z");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num0), "Num0");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num1), "Num1");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num2), "Num2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num3), "Num3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num4), "Num4");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num5), "Num5");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num6), "Num6");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num7), "Num7");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num8), "Num8");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Num9), "Num9");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Esc), "Esc");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Space), "Space");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Enter), "Enter");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Backspace), "Backspace");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Tab), "Tab");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::Tick), "Tick");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F1), "F1");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F2), "F2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F3), "F3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F4), "F4");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F5), "F5");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F6), "F6");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F7), "F7");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F8), "F8");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F9), "F9");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F10), "F10");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F11), "F11");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::F12), "F12");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::LeftCtrl), "LeftCtrl");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::LeftShift), "LeftShift");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(Key::LeftAlt), "LeftAlt");
+    }
+    
+    // JoystickEventType
+    {
+        hect::Type& type = hect::Type::create<JoystickEventType>(hect::Kind::Enum, "JoystickEventType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickEventType::AxisMotion), "AxisMotion");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickEventType::ButtonDown), "ButtonDown");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickEventType::ButtonUp), "ButtonUp");
+    }
+    
+    // KeyboardEventType
+    {
+        hect::Type& type = hect::Type::create<KeyboardEventType>(hect::Kind::Enum, "KeyboardEventType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(KeyboardEventType::KeyDown), "KeyDown");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(KeyboardEventType::KeyUp), "KeyUp");
+    }
+    
+    // MouseButton
+    {
+        hect::Type& type = hect::Type::create<MouseButton>(hect::Kind::Enum, "MouseButton");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseButton::Button0), "Button0");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseButton::Button1), "Button1");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseButton::Button2), "Button2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseButton::Button3), "Button3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseButton::Button4), "Button4");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseButton::Button5), "Button5");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseButton::Button6), "Button6");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseButton::Button7), "Button7");
+    }
+    
+    // JoystickAxis
+    {
+        hect::Type& type = hect::Type::create<JoystickAxis>(hect::Kind::Enum, "JoystickAxis");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis0), "Axis0");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis1), "Axis1");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis2), "Axis2");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis3), "Axis3");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis4), "Axis4");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis5), "Axis5");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis6), "Axis6");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis7), "Axis7");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis8), "Axis8");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis9), "Axis9");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis11), "Axis11");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis12), "Axis12");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis13), "Axis13");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis14), "Axis14");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis15), "Axis15");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis16), "Axis16");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis17), "Axis17");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis18), "Axis18");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis19), "Axis19");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis20), "Axis20");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis21), "Axis21");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis22), "Axis22");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis23), "Axis23");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis24), "Axis24");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis25), "Axis25");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis26), "Axis26");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis27), "Axis27");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis28), "Axis28");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis29), "Axis29");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis30), "Axis30");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(JoystickAxis::Axis31), "Axis31");
+    }
+    
+    // InputAxisBindingType
+    {
+        hect::Type& type = hect::Type::create<InputAxisBindingType>(hect::Kind::Enum, "InputAxisBindingType");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(InputAxisBindingType::MouseMoveX), "MouseMoveX");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(InputAxisBindingType::MouseMoveY), "MouseMoveY");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(InputAxisBindingType::MouseButton), "MouseButton");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(InputAxisBindingType::MouseScroll), "MouseScroll");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(InputAxisBindingType::Key), "Key");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(InputAxisBindingType::JoystickAxis), "JoystickAxis");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(InputAxisBindingType::JoystickButton), "JoystickButton");
+    }
+    
+    // MouseMode
+    {
+        hect::Type& type = hect::Type::create<MouseMode>(hect::Kind::Enum, "MouseMode");
+        hect::Enum& enum_type = type.as_enum();
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseMode::Cursor), "Cursor");
+        enum_type.add_value(static_cast<hect::EnumValue::Type>(MouseMode::Relative), "Relative");
+    }
+
+    // Classes
+    
+    // DefaultScene
+    {
+        hect::Type& type = hect::Type::create<DefaultScene>(hect::Kind::Class, "DefaultScene");
+        (void)type;
+    }
+    
+    // RigidBodyComponent
+    {
+        hect::Type& type = hect::Type::create<RigidBodyComponent>(hect::Kind::Class, "RigidBodyComponent");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const RigidBodyComponent& typed_value = *reinterpret_cast<const RigidBodyComponent*>(value);
+            encoder << encode_value("mass", typed_value.mass);
+            encoder << encode_value("linear_velocity", typed_value.linear_velocity);
+            encoder << encode_value("angular_velocity", typed_value.angular_velocity);
+            encoder << encode_value("mesh", typed_value.mesh);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            RigidBodyComponent& typed_value = *reinterpret_cast<RigidBodyComponent*>(value);
+            decoder >> decode_value("mass", typed_value.mass, false);
+            decoder >> decode_value("linear_velocity", typed_value.linear_velocity, false);
+            decoder >> decode_value("angular_velocity", typed_value.angular_velocity, false);
+            decoder >> decode_value("mesh", typed_value.mesh, false);
+        });
+    }
+    
+    // TransformComponent
+    {
+        hect::Type& type = hect::Type::create<TransformComponent>(hect::Kind::Class, "TransformComponent");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const TransformComponent& typed_value = *reinterpret_cast<const TransformComponent*>(value);
+            encoder << encode_enum("mobility", typed_value.mobility);
+            encoder << encode_value("local_position", typed_value.local_position);
+            encoder << encode_value("local_scale", typed_value.local_scale);
+            encoder << encode_value("local_rotation", typed_value.local_rotation);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            TransformComponent& typed_value = *reinterpret_cast<TransformComponent*>(value);
+            decoder >> decode_enum("mobility", typed_value.mobility, false);
+            decoder >> decode_value("local_position", typed_value.local_position, false);
+            decoder >> decode_value("local_scale", typed_value.local_scale, false);
+            decoder >> decode_value("local_rotation", typed_value.local_rotation, false);
+        });
+    }
+    
+    // SkyBoxComponent
+    {
+        hect::Type& type = hect::Type::create<SkyBoxComponent>(hect::Kind::Class, "SkyBoxComponent");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const SkyBoxComponent& typed_value = *reinterpret_cast<const SkyBoxComponent*>(value);
+            encoder << encode_value("texture", typed_value.texture);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            SkyBoxComponent& typed_value = *reinterpret_cast<SkyBoxComponent*>(value);
+            decoder >> decode_value("texture", typed_value.texture, true);
+        });
+    }
+    
+    // LightProbeComponent
+    {
+        hect::Type& type = hect::Type::create<LightProbeComponent>(hect::Kind::Class, "LightProbeComponent");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const LightProbeComponent& typed_value = *reinterpret_cast<const LightProbeComponent*>(value);
+            encoder << encode_value("texture", typed_value.texture);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            LightProbeComponent& typed_value = *reinterpret_cast<LightProbeComponent*>(value);
+            decoder >> decode_value("texture", typed_value.texture, false);
+        });
+    }
+    
+    // CameraComponent
+    {
+        hect::Type& type = hect::Type::create<CameraComponent>(hect::Kind::Class, "CameraComponent");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const CameraComponent& typed_value = *reinterpret_cast<const CameraComponent*>(value);
+            encoder << encode_value("field_of_view", typed_value.field_of_view);
+            encoder << encode_value("aspect_ratio", typed_value.aspect_ratio);
+            encoder << encode_value("near_clip", typed_value.near_clip);
+            encoder << encode_value("far_clip", typed_value.far_clip);
+            encoder << encode_value("exposure", typed_value.exposure);
+            encoder << encode_value("gamma", typed_value.gamma);
+            encoder << encode_value("clear_color", typed_value.clear_color);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            CameraComponent& typed_value = *reinterpret_cast<CameraComponent*>(value);
+            decoder >> decode_value("field_of_view", typed_value.field_of_view, false);
+            decoder >> decode_value("aspect_ratio", typed_value.aspect_ratio, false);
+            decoder >> decode_value("near_clip", typed_value.near_clip, false);
+            decoder >> decode_value("far_clip", typed_value.far_clip, false);
+            decoder >> decode_value("exposure", typed_value.exposure, false);
+            decoder >> decode_value("gamma", typed_value.gamma, false);
+            decoder >> decode_value("clear_color", typed_value.clear_color, false);
+        });
+    }
+    
+    // BoundingBoxComponent
+    {
+        hect::Type& type = hect::Type::create<BoundingBoxComponent>(hect::Kind::Class, "BoundingBoxComponent");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const BoundingBoxComponent& typed_value = *reinterpret_cast<const BoundingBoxComponent*>(value);
+            encoder << encode_value("adaptive", typed_value.adaptive);
+            encoder << encode_value("local_extents", typed_value.local_extents);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            BoundingBoxComponent& typed_value = *reinterpret_cast<BoundingBoxComponent*>(value);
+            decoder >> decode_value("adaptive", typed_value.adaptive, false);
+            decoder >> decode_value("local_extents", typed_value.local_extents, false);
+        });
+    }
+    
+    // DirectionalLightComponent
+    {
+        hect::Type& type = hect::Type::create<DirectionalLightComponent>(hect::Kind::Class, "DirectionalLightComponent");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const DirectionalLightComponent& typed_value = *reinterpret_cast<const DirectionalLightComponent*>(value);
+            encoder << encode_value("direction", typed_value.direction);
+            encoder << encode_value("color", typed_value.color);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            DirectionalLightComponent& typed_value = *reinterpret_cast<DirectionalLightComponent*>(value);
+            decoder >> decode_value("direction", typed_value.direction, false);
+            decoder >> decode_value("color", typed_value.color, false);
+        });
+    }
+    
+    // GeometrySurface
+    {
+        hect::Type& type = hect::Type::create<GeometrySurface>(hect::Kind::Class, "GeometrySurface");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const GeometrySurface& typed_value = *reinterpret_cast<const GeometrySurface*>(value);
+            encoder << encode_value("mesh", typed_value.mesh);
+            encoder << encode_value("material", typed_value.material);
+            encoder << encode_value("visible", typed_value.visible);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            GeometrySurface& typed_value = *reinterpret_cast<GeometrySurface*>(value);
+            decoder >> decode_value("mesh", typed_value.mesh, false);
+            decoder >> decode_value("material", typed_value.material, false);
+            decoder >> decode_value("visible", typed_value.visible, false);
+        });
+    }
+    
+    // GeometryComponent
+    {
+        hect::Type& type = hect::Type::create<GeometryComponent>(hect::Kind::Class, "GeometryComponent");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const GeometryComponent& typed_value = *reinterpret_cast<const GeometryComponent*>(value);
+            encoder << encode_vector("surfaces", typed_value.surfaces);
+            encoder << encode_value("visible", typed_value.visible);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            GeometryComponent& typed_value = *reinterpret_cast<GeometryComponent*>(value);
+            decoder >> decode_vector("surfaces", typed_value.surfaces, false);
+            decoder >> decode_value("visible", typed_value.visible, false);
+        });
+    }
+    
+    // BoundingBoxSystem
+    {
+        hect::Type& type = hect::Type::create<BoundingBoxSystem>(hect::Kind::Class, "BoundingBoxSystem");
+        (void)type;
+    }
+    
+    // CameraSystem
+    {
+        hect::Type& type = hect::Type::create<CameraSystem>(hect::Kind::Class, "CameraSystem");
+        (void)type;
+    }
+    
+    // InputSystem
+    {
+        hect::Type& type = hect::Type::create<InputSystem>(hect::Kind::Class, "InputSystem");
+        (void)type;
+    }
+    
+    // ScriptSystem
+    {
+        hect::Type& type = hect::Type::create<ScriptSystem>(hect::Kind::Class, "ScriptSystem");
+        (void)type;
+    }
+    
+    // InterfaceSystem
+    {
+        hect::Type& type = hect::Type::create<InterfaceSystem>(hect::Kind::Class, "InterfaceSystem");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const InterfaceSystem& typed_value = *reinterpret_cast<const InterfaceSystem*>(value);
+            encoder << encode_value("default_font", typed_value.default_font);
+            encoder << encode_value("default_font_size", typed_value.default_font_size);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            InterfaceSystem& typed_value = *reinterpret_cast<InterfaceSystem*>(value);
+            decoder >> decode_value("default_font", typed_value.default_font, false);
+            decoder >> decode_value("default_font_size", typed_value.default_font_size, false);
+        });
+    }
+    
+    // DebugSystem
+    {
+        hect::Type& type = hect::Type::create<DebugSystem>(hect::Kind::Class, "DebugSystem");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const DebugSystem& typed_value = *reinterpret_cast<const DebugSystem*>(value);
+            encoder << encode_value("lines_material", typed_value.lines_material);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            DebugSystem& typed_value = *reinterpret_cast<DebugSystem*>(value);
+            decoder >> decode_value("lines_material", typed_value.lines_material, false);
+        });
+    }
+    
+    // TransformSystem
+    {
+        hect::Type& type = hect::Type::create<TransformSystem>(hect::Kind::Class, "TransformSystem");
+        (void)type;
+    }
+    
+    // PhysicsSystem
+    {
+        hect::Type& type = hect::Type::create<PhysicsSystem>(hect::Kind::Class, "PhysicsSystem");
+        (void)type;
+        type.set_encode_function([](const void* value, Encoder& encoder)
+        {
+            const PhysicsSystem& typed_value = *reinterpret_cast<const PhysicsSystem*>(value);
+            encoder << encode_value("gravity", typed_value.gravity);
+        });
+        type.set_decode_function([](void* value, Decoder& decoder)
+        {
+            PhysicsSystem& typed_value = *reinterpret_cast<PhysicsSystem*>(value);
+            decoder >> decode_value("gravity", typed_value.gravity, false);
+        });
+    }
+
+    // Components
+    hect::ComponentRegistry::register_type<RigidBodyComponent>();
+    hect::ComponentRegistry::register_type<TransformComponent>();
+    hect::ComponentRegistry::register_type<SkyBoxComponent>();
+    hect::ComponentRegistry::register_type<LightProbeComponent>();
+    hect::ComponentRegistry::register_type<CameraComponent>();
+    hect::ComponentRegistry::register_type<BoundingBoxComponent>();
+    hect::ComponentRegistry::register_type<DirectionalLightComponent>();
+    hect::ComponentRegistry::register_type<GeometryComponent>();
+
+    // Systems
+    hect::SystemRegistry::register_type<BoundingBoxSystem>();
+    hect::SystemRegistry::register_type<CameraSystem>();
+    hect::SystemRegistry::register_type<InputSystem>();
+    hect::SystemRegistry::register_type<ScriptSystem>();
+    hect::SystemRegistry::register_type<InterfaceSystem>();
+    hect::SystemRegistry::register_type<DebugSystem>();
+    hect::SystemRegistry::register_type<TransformSystem>();
+    hect::SystemRegistry::register_type<PhysicsSystem>();
+
+    // Scenes
+    hect::SceneRegistry::register_type<DefaultScene>();
+}
+
+}
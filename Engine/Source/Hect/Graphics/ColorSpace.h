@@ -33,8 +33,8 @@ enum class ColorSpace
     ///
     /// Non-linear color space (s_r_g_b).
     ///
-    /// \note Only an image with a pixel type of PixelType::Byte can
-    /// be non-linear.
+    /// \note Only an image with a pixel type of PixelType::Byte,
+    /// PixelType::Bc1, PixelType::Bc3, or PixelType::Bc7 can be non-linear.
     NonLinear,
 
     ///
@@ -23,13 +23,383 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Image.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <lodepng.h>
+#include <zlib123/zlib.h>
 
 #include "Hect/Core/Exception.h"
 #include "Hect/Core/Format.h"
+#include "Hect/Graphics/MipmapGenerator.h"
+#include "Hect/Graphics/PixelConversion.h"
+#include "Hect/Math/Quantization.h"
 
 using namespace hect;
 
+namespace
+{
+
+// The signature at the beginning of PNG data
+const uint8_t PngSignature[8] = { 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+
+// The signature at the beginning of cooked image data; the last byte is the
+// version of the format
+const uint8_t CookedImageSignature[8] = { 'H', 'E', 'C', 'T', 'I', 'M', 'G', 1 };
+
+// The alignment of the pixel data of each level of a cooked image
+const size_t CookedImageAlignment = 16;
+
+// The size of the header of a cooked image and of each entry in its table of
+// levels
+const size_t CookedImageHeaderSize = 16;
+const size_t CookedImageLevelSize = 24;
+
+size_t align_cooked_offset(size_t offset)
+{
+    return (offset + CookedImageAlignment - 1) & ~(CookedImageAlignment - 1);
+}
+
+// The largest size in bytes of the RGBA pixel data decoded from PNG data;
+// larger dimensions in a PNG header are rejected before allocating
+const size_t MaxDecodedPngSize = size_t(1) << 30;
+
+// PNG color types
+const unsigned PngGray = 0;
+const unsigned PngRgb = 2;
+const unsigned PngPalette = 3;
+const unsigned PngGrayAlpha = 4;
+const unsigned PngRgba = 6;
+
+// Inflates a zlib stream which is split across the data of multiple chunks
+class ChunkInflater
+{
+public:
+    ChunkInflater(const unsigned char* first_chunk, const unsigned char* end) :
+        _chunk(first_chunk),
+        _end(end)
+    {
+        if (inflateInit(&_stream) != Z_OK)
+        {
+            throw DecodeError("Failed to decode PNG data: failed to initialize zlib");
+        }
+    }
+
+    ~ChunkInflater()
+    {
+        inflateEnd(&_stream);
+    }
+
+    // Inflates exactly the given number of bytes
+    void inflate_bytes(unsigned char* data, size_t size)
+    {
+        _stream.next_out = data;
+        _stream.avail_out = static_cast<uInt>(size);
+        while (_stream.avail_out > 0)
+        {
+            if (_stream.avail_in == 0)
+            {
+                next_chunk();
+            }
+
+            const int result = inflate(&_stream, Z_NO_FLUSH);
+            check_result(result);
+            if (result == Z_STREAM_END)
+            {
+                _finished = true;
+                if (_stream.avail_out > 0)
+                {
+                    throw DecodeError("Failed to decode PNG data: image data is too small");
+                }
+            }
+        }
+    }
+
+    // Inflates the rest of the stream, which must hold no more image data,
+    // so that zlib verifies the Adler-32 checksum of the stream
+    void finish()
+    {
+        unsigned char extra_byte = 0;
+        while (!_finished)
+        {
+            if (_stream.avail_in == 0)
+            {
+                next_chunk();
+            }
+
+            _stream.next_out = &extra_byte;
+            _stream.avail_out = 1;
+
+            const int result = inflate(&_stream, Z_NO_FLUSH);
+            check_result(result);
+            if (_stream.avail_out == 0)
+            {
+                throw DecodeError("Failed to decode PNG data: image data is too large");
+            }
+
+            _finished = result == Z_STREAM_END;
+        }
+    }
+
+private:
+    void check_result(int result)
+    {
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+        {
+            throw DecodeError(format("Failed to decode PNG data: %s", _stream.msg ? _stream.msg : "invalid compressed data"));
+        }
+    }
+
+    // Feeds the data of the next image data chunk to the stream once its CRC
+    // is verified
+    void next_chunk()
+    {
+        while (_chunk && _chunk + 12 <= _end)
+        {
+            const unsigned char* chunk = _chunk;
+            _chunk = lodepng_chunk_type_equals(chunk, "IEND") ? nullptr : lodepng_chunk_next_const(chunk);
+            if (lodepng_chunk_type_equals(chunk, "IDAT"))
+            {
+                if (lodepng_chunk_check_crc(chunk))
+                {
+                    throw DecodeError("Failed to decode PNG data: CRC mismatch in image data");
+                }
+
+                _stream.next_in = const_cast<Bytef*>(lodepng_chunk_data_const(chunk));
+                _stream.avail_in = lodepng_chunk_length(chunk);
+                return;
+            }
+        }
+
+        throw DecodeError("Failed to decode PNG data: image data is too small");
+    }
+
+    const unsigned char* _chunk;
+    const unsigned char* _end;
+    z_stream _stream { };
+    bool _finished { false };
+};
+
+unsigned char paeth_predictor(int a, int b, int c)
+{
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+    {
+        return static_cast<unsigned char>(a);
+    }
+    else if (pb <= pc)
+    {
+        return static_cast<unsigned char>(b);
+    }
+    else
+    {
+        return static_cast<unsigned char>(c);
+    }
+}
+
+// Reverses the filter of a scanline given the unfiltered scanline above it
+// (null for the first scanline)
+void unfilter_scanline(unsigned char* row, const unsigned char* filtered_row, const unsigned char* previous_row, unsigned char filter, size_t bytes_per_pixel, size_t length)
+{
+    switch (filter)
+    {
+    case 0:
+        std::memcpy(row, filtered_row, length);
+        break;
+    case 1:
+        for (size_t i = 0; i < length; ++i)
+        {
+            row[i] = filtered_row[i] + (i >= bytes_per_pixel ? row[i - bytes_per_pixel] : 0);
+        }
+        break;
+    case 2:
+        for (size_t i = 0; i < length; ++i)
+        {
+            row[i] = filtered_row[i] + (previous_row ? previous_row[i] : 0);
+        }
+        break;
+    case 3:
+        for (size_t i = 0; i < length; ++i)
+        {
+            const int left = i >= bytes_per_pixel ? row[i - bytes_per_pixel] : 0;
+            const int up = previous_row ? previous_row[i] : 0;
+            row[i] = filtered_row[i] + static_cast<unsigned char>((left + up) / 2);
+        }
+        break;
+    case 4:
+        for (size_t i = 0; i < length; ++i)
+        {
+            const int left = i >= bytes_per_pixel ? row[i - bytes_per_pixel] : 0;
+            const int up = previous_row ? previous_row[i] : 0;
+            const int up_left = previous_row && i >= bytes_per_pixel ? previous_row[i - bytes_per_pixel] : 0;
+            row[i] = filtered_row[i] + paeth_predictor(left, up, up_left);
+        }
+        break;
+    default:
+        throw DecodeError(format("Failed to decode PNG data: invalid filter type %u", filter));
+    }
+}
+
+// Expands a row of 8-bit gray, gray-alpha, RGB, or palette pixels to RGBA
+void expand_to_rgba(unsigned char* rgba_row, const unsigned char* row, unsigned color_type, const ByteVector& palette, size_t palette_size, unsigned width)
+{
+    for (size_t x = 0; x < width; ++x)
+    {
+        unsigned char* pixel = &rgba_row[x * 4];
+        switch (color_type)
+        {
+        case PngGray:
+            pixel[0] = pixel[1] = pixel[2] = row[x];
+            pixel[3] = 255;
+            break;
+        case PngGrayAlpha:
+            pixel[0] = pixel[1] = pixel[2] = row[x * 2];
+            pixel[3] = row[x * 2 + 1];
+            break;
+        case PngRgb:
+            pixel[0] = row[x * 3];
+            pixel[1] = row[x * 3 + 1];
+            pixel[2] = row[x * 3 + 2];
+            pixel[3] = 255;
+            break;
+        case PngPalette:
+            if (row[x] >= palette_size)
+            {
+                throw DecodeError(format("Failed to decode PNG data: palette index %u is out of range", static_cast<unsigned>(row[x])));
+            }
+
+            std::memcpy(pixel, &palette[row[x] * 4], 4);
+            break;
+        }
+    }
+}
+
+// Decodes 8-bit non-interlaced PNG data to RGBA rows in bottom-to-top order,
+// inflating and unfiltering one scanline at a time directly into its
+// destination row; returns false without decoding if the data uses a feature
+// this path does not handle
+bool decode_png_flipped(const ByteVector& encoded_pixel_data, unsigned& width, unsigned& height, ByteVector& pixel_data)
+{
+    LodePNGState state;
+    lodepng_state_init(&state);
+    const unsigned error = lodepng_inspect(&width, &height, &state, encoded_pixel_data.data(), encoded_pixel_data.size());
+    const unsigned color_type = static_cast<unsigned>(state.info_png.color.colortype);
+    const unsigned bit_depth = state.info_png.color.bitdepth;
+    const size_t bytes_per_pixel = lodepng_get_channels(&state.info_png.color);
+    const unsigned interlace_method = state.info_png.interlace_method;
+    lodepng_state_cleanup(&state);
+    if (error)
+    {
+        throw DecodeError(format("Failed to decode PNG data: %s", lodepng_error_text(error)));
+    }
+    else if (width == 0 || height == 0 || static_cast<size_t>(width) * 4 > MaxDecodedPngSize / height)
+    {
+        throw DecodeError(format("Failed to decode PNG data: invalid dimensions %ux%u", width, height));
+    }
+
+    if (bit_depth != 8 || interlace_method != 0 || (color_type != PngGray && color_type != PngRgb && color_type != PngPalette && color_type != PngGrayAlpha && color_type != PngRgba))
+    {
+        return false;
+    }
+
+    // Validate the chunks and read the palette up front; palette entries are
+    // opaque unless a transparency chunk says otherwise
+    ByteVector palette;
+    size_t palette_size = 0;
+    if (color_type == PngPalette)
+    {
+        palette.resize(256 * 4, 0);
+        for (size_t i = 0; i < 256; ++i)
+        {
+            palette[i * 4 + 3] = 255;
+        }
+    }
+
+    const unsigned char* begin = encoded_pixel_data.data();
+    const unsigned char* end = begin + encoded_pixel_data.size();
+    for (const unsigned char* chunk = begin + 8; chunk + 12 <= end; chunk = lodepng_chunk_next_const(chunk))
+    {
+        const size_t chunk_length = lodepng_chunk_length(chunk);
+        const unsigned char* chunk_data = lodepng_chunk_data_const(chunk);
+        if (chunk_length > static_cast<size_t>(end - chunk) - 12)
+        {
+            throw DecodeError("Failed to decode PNG data: chunk length out of bounds");
+        }
+        else if (lodepng_chunk_type_equals(chunk, "PLTE") && color_type == PngPalette)
+        {
+            if (lodepng_chunk_check_crc(chunk))
+            {
+                throw DecodeError("Failed to decode PNG data: CRC mismatch in palette");
+            }
+            else if (chunk_length % 3 != 0 || chunk_length / 3 > 256)
+            {
+                throw DecodeError("Failed to decode PNG data: invalid palette size");
+            }
+
+            palette_size = chunk_length / 3;
+            for (size_t i = 0; i < palette_size; ++i)
+            {
+                std::memcpy(&palette[i * 4], &chunk_data[i * 3], 3);
+            }
+        }
+        else if (lodepng_chunk_type_equals(chunk, "tRNS"))
+        {
+            // Transparent color keys are left to LodePNG
+            if (color_type != PngPalette)
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < std::min(chunk_length, size_t(256)); ++i)
+            {
+                palette[i * 4 + 3] = chunk_data[i];
+            }
+        }
+        else if (lodepng_chunk_type_equals(chunk, "IEND"))
+        {
+            break;
+        }
+    }
+
+    const size_t scanline_size = static_cast<size_t>(width) * bytes_per_pixel;
+    const size_t rgba_row_size = static_cast<size_t>(width) * 4;
+    pixel_data.resize(rgba_row_size * height);
+
+    // Formats other than RGBA are unfiltered into alternating rows and then
+    // expanded into their destination
+    ByteVector filtered_scanline(scanline_size + 1);
+    ByteVector rows;
+    if (color_type != PngRgba)
+    {
+        rows.resize(scanline_size * 2);
+    }
+
+    ChunkInflater inflater(begin + 8, end);
+    const unsigned char* previous_row = nullptr;
+    for (unsigned y = 0; y < height; ++y)
+    {
+        inflater.inflate_bytes(filtered_scanline.data(), filtered_scanline.size());
+
+        unsigned char* destination_row = &pixel_data[rgba_row_size * (height - y - 1)];
+        unsigned char* row = color_type == PngRgba ? destination_row : &rows[scanline_size * (y % 2)];
+        unfilter_scanline(row, &filtered_scanline[1], previous_row, filtered_scanline[0], bytes_per_pixel, scanline_size);
+        if (color_type != PngRgba)
+        {
+            expand_to_rgba(destination_row, row, color_type, palette, palette_size, width);
+        }
+        previous_row = row;
+    }
+
+    inflater.finish();
+
+    return true;
+}
+
+}
+
 Image::Image()
 {
 }
@@ -43,15 +413,20 @@ Image::Image(unsigned width, unsigned height, const PixelFormat& pixel_format) :
 
 void Image::flip_vertical()
 {
+    ensure_uncompressed();
+    if (_pixel_data.empty())
+    {
+        return;
+    }
+
+    // Swap the rows in place
     size_t bytes_per_row = _pixel_format.size() * _width;
-    ByteVector new_pixel_data(_pixel_data.size(), 0);
-    for (unsigned i = 0; i < _height; ++i)
+    for (unsigned i = 0; i < _height / 2; ++i)
     {
-        size_t source_row_offset = bytes_per_row * i;
-        size_t dest_row_offset = bytes_per_row * (_height - i - 1);
-        std::memcpy(&new_pixel_data[source_row_offset], &_pixel_data[dest_row_offset], bytes_per_row);
+        auto source_row = _pixel_data.begin() + bytes_per_row * i;
+        auto dest_row = _pixel_data.begin() + bytes_per_row * (_height - i - 1);
+        std::swap_ranges(source_row, source_row + bytes_per_row, dest_row);
     }
-    _pixel_data = std::move(new_pixel_data);
 }
 
 bool Image::has_pixel_data() const
@@ -71,11 +446,12 @@ const ByteVector& Image::pixel_data() const
 
 void Image::set_pixel_data(ByteVector&& pixel_data)
 {
-    _pixel_data = pixel_data;
+    _pixel_data = std::move(pixel_data);
 }
 
 void Image::write_pixel(unsigned x, unsigned y, Color color)
 {
+    ensure_uncompressed();
     ensure_pixel_data();
 
     size_t offset = compute_pixel_offset(x, y);
@@ -90,10 +466,13 @@ void Image::write_pixel(unsigned x, unsigned y, Color color)
             _pixel_data[offset + component_index] = static_cast<uint8_t>(color[component_index] * 255);
             break;
         case PixelType::Float16:
-            throw InvalidOperation("16-bit floats are not implemented");
+            *reinterpret_cast<uint16_t*>(&_pixel_data[offset + (component_index * 2)]) = encode_float16(static_cast<float>(value));
+            break;
         case PixelType::Float32:
             *reinterpret_cast<float*>(&_pixel_data[offset + (component_index * 4)]) = static_cast<float>(value);
             break;
+        default:
+            break;
         }
     }
 }
@@ -107,6 +486,8 @@ void Image::write_pixel(Vector2 coords, Color color)
 
 Color Image::read_pixel(unsigned x, unsigned y) const
 {
+    ensure_uncompressed();
+
     Color color;
 
     if (has_pixel_data())
@@ -121,10 +502,13 @@ Color Image::read_pixel(unsigned x, unsigned y) const
                 color[component_index] = static_cast<double>(_pixel_data[offset + component_index]) / 255.0;
                 break;
             case PixelType::Float16:
-                throw InvalidOperation("16-bit floats are not implemented");
+                color[component_index] = decode_float16(*reinterpret_cast<const uint16_t*>(&_pixel_data[offset + (component_index * 2)]));
+                break;
             case PixelType::Float32:
                 color[component_index] = *reinterpret_cast<const float*>(&_pixel_data[offset + (component_index * 4)]);
                 break;
+            default:
+                break;
             }
         }
     }
@@ -139,6 +523,82 @@ Color Image::read_pixel(Vector2 coords) const
     return read_pixel(x, y);
 }
 
+void Image::write_region(unsigned x, unsigned y, unsigned width, unsigned height, const float* components)
+{
+    ensure_uncompressed();
+    ensure_in_bounds(x, y, width, height);
+    if (width == 0 || height == 0)
+    {
+        return;
+    }
+
+    ensure_pixel_data();
+
+    for (unsigned row = 0; row < height; ++row)
+    {
+        uint8_t* pixels = &_pixel_data[compute_pixel_offset(x, y + row)];
+        encode_pixels(components + static_cast<size_t>(row) * width * 4, _pixel_format, ColorSpace::Linear, pixels, width);
+    }
+}
+
+void Image::read_region(unsigned x, unsigned y, unsigned width, unsigned height, float* components) const
+{
+    ensure_uncompressed();
+    ensure_in_bounds(x, y, width, height);
+    if (width == 0 || height == 0)
+    {
+        return;
+    }
+
+    // Read each row of an image without pixel data from a row of zeros
+    ByteVector zero_row;
+    if (!has_pixel_data())
+    {
+        zero_row.resize(_pixel_format.size() * width, 0);
+    }
+
+    for (unsigned row = 0; row < height; ++row)
+    {
+        const uint8_t* pixels = zero_row.empty() ? &_pixel_data[compute_pixel_offset(x, y + row)] : zero_row.data();
+        decode_pixels(pixels, _pixel_format, ColorSpace::Linear, components + static_cast<size_t>(row) * width * 4, width);
+    }
+}
+
+void Image::write_row(unsigned y, const float* components)
+{
+    write_region(0, y, _width, 1, components);
+}
+
+void Image::read_row(unsigned y, float* components) const
+{
+    read_region(0, y, _width, 1, components);
+}
+
+void Image::convert(const PixelFormat& pixel_format, ColorSpace color_space)
+{
+    ensure_uncompressed();
+    if (pixel_format.is_compressed())
+    {
+        throw InvalidOperation("Cannot convert to a block-compressed pixel format");
+    }
+    ensure_compatible(pixel_format, color_space);
+
+    if (has_pixel_data())
+    {
+        ByteVector pixel_data(pixel_format.image_size(_width, _height));
+        convert_pixels(_pixel_data.data(), _pixel_format, _color_space, pixel_data.data(), pixel_format, color_space, static_cast<size_t>(_width) * _height);
+        _pixel_data = std::move(pixel_data);
+    }
+
+    _pixel_format = pixel_format;
+    _color_space = color_space;
+
+    for (Image& mipmap : _mipmaps)
+    {
+        mipmap.convert(pixel_format, color_space);
+    }
+}
+
 unsigned Image::width() const
 {
     return _width;
@@ -179,13 +639,68 @@ void Image::set_color_space(ColorSpace color_space)
 {
     ensure_compatible(_pixel_format, color_space);
     _color_space = color_space;
+
+    for (Image& mipmap : _mipmaps)
+    {
+        mipmap.set_color_space(color_space);
+    }
+}
+
+size_t Image::mipmap_count() const
+{
+    return _mipmaps.size() + 1;
+}
+
+Image& Image::mipmap(size_t level)
+{
+    return const_cast<Image&>(static_cast<const Image*>(this)->mipmap(level));
+}
+
+const Image& Image::mipmap(size_t level) const
+{
+    if (level == 0)
+    {
+        return *this;
+    }
+    else if (level > _mipmaps.size())
+    {
+        throw InvalidOperation(format("Image has no mipmap level %u", static_cast<unsigned>(level)));
+    }
+
+    return _mipmaps[level - 1];
+}
+
+void Image::add_mipmap(const Image& mipmap)
+{
+    const Image& previous_level = this->mipmap(_mipmaps.size());
+    const unsigned width = std::max(1u, previous_level.width() / 2);
+    const unsigned height = std::max(1u, previous_level.height() / 2);
+    if (mipmap.width() != width || mipmap.height() != height || mipmap.pixel_format() != _pixel_format)
+    {
+        throw InvalidOperation("Mipmap is incompatible with the image");
+    }
+
+    _mipmaps.push_back(mipmap);
+    _mipmaps.back().clear_mipmaps();
+    _mipmaps.back().set_color_space(_color_space);
+}
+
+void Image::clear_mipmaps()
+{
+    _mipmaps.clear();
+}
+
+void Image::generate_mipmaps()
+{
+    MipmapGenerator generator;
+    generator.generate(*this);
 }
 
 void Image::ensure_pixel_data()
 {
     if (_pixel_data.empty())
     {
-        _pixel_data = ByteVector(_width * _height * _pixel_format.size());
+        _pixel_data = ByteVector(_pixel_format.image_size(_width, _height));
     }
 }
 
@@ -196,27 +711,57 @@ size_t Image::compute_pixel_offset(unsigned x, unsigned y) const
     return offset;
 }
 
-void Image::ensure_compatible(const PixelFormat& pixel_format, ColorSpace color_space)
+void Image::ensure_uncompressed() const
+{
+    if (_pixel_format.is_compressed())
+    {
+        throw InvalidOperation("Cannot access the pixels of a block-compressed image");
+    }
+}
+
+void Image::ensure_in_bounds(unsigned x, unsigned y, unsigned width, unsigned height) const
+{
+    if (x > _width || width > _width - x || y > _height || height > _height - y)
+    {
+        throw InvalidOperation("Region is outside of the image");
+    }
+}
+
+bool Image::is_compatible(const PixelFormat& pixel_format, ColorSpace color_space)
 {
     if (color_space == ColorSpace::NonLinear)
     {
-        if (pixel_format.type() != PixelType::Byte ||
-                (pixel_format.cardinality() != 3 &&
-                 pixel_format.cardinality() != 4))
+        const PixelType type = pixel_format.type();
+        const bool compressed_color = type == PixelType::Bc1 || type == PixelType::Bc3 || type == PixelType::Bc7;
+        if (!compressed_color &&
+                (type != PixelType::Byte ||
+                 (pixel_format.cardinality() != 3 &&
+                  pixel_format.cardinality() != 4)))
         {
-            throw InvalidOperation("Color space is incompatible with pixel format");
+            return false;
         }
     }
+
+    return true;
+}
+
+void Image::ensure_compatible(const PixelFormat& pixel_format, ColorSpace color_space)
+{
+    if (!is_compatible(pixel_format, color_space))
+    {
+        throw InvalidOperation("Color space is incompatible with pixel format");
+    }
 }
 
 void Image::encode(Encoder& encoder) const
 {
     WriteStream& stream = encoder.binary_stream();
 
-    // Verify pixel format and type.
-    if (_pixel_format.type() != PixelType::Byte || _pixel_format.cardinality() != 4)
+    // Only 32-bit RGBA images without mipmaps can be encoded as PNG data
+    if (_pixel_format != PixelFormat::Rgba8 || !_mipmaps.empty())
     {
-        throw InvalidOperation("Cannot encode an image to PNG which does not conform to the 32-bit RGBA format");
+        encode_cooked(stream);
+        return;
     }
 
     // Flip the image from OpenGL ordering
@@ -238,6 +783,26 @@ void Image::encode(Encoder& encoder) const
 void Image::decode(Decoder& decoder)
 {
     ReadStream& stream = decoder.binary_stream();
+    clear_mipmaps();
+
+    // Cooked images are identified by their signature
+    const size_t position = stream.position();
+    if (stream.length() - position >= sizeof(CookedImageSignature))
+    {
+        uint8_t signature[sizeof(CookedImageSignature)];
+        stream.read(signature, sizeof(signature));
+        stream.seek(position);
+
+        if (std::memcmp(signature, CookedImageSignature, sizeof(signature)) == 0)
+        {
+            decode_cooked(stream);
+            return;
+        }
+        else if (std::memcmp(signature, PngSignature, sizeof(signature)) != 0)
+        {
+            throw DecodeError("Image data is neither PNG nor cooked image data");
+        }
+    }
 
     // Read all of the encoded data from the stream
     size_t length = stream.length();
@@ -246,13 +811,17 @@ void Image::decode(Decoder& decoder)
 
     ByteVector decoded_pixel_data;
 
-    // Decode the PNG pixel data
+    // Decode the PNG pixel data directly to OpenGL ordering if possible
     unsigned width = 0;
     unsigned height = 0;
-    unsigned error = lodepng::decode(decoded_pixel_data, width, height, encoded_pixel_data);
-    if (error)
+    const bool flipped = decode_png_flipped(encoded_pixel_data, width, height, decoded_pixel_data);
+    if (!flipped)
     {
-        throw DecodeError(format("Failed to decode PNG data: %s", lodepng_error_text(error)));
+        unsigned error = lodepng::decode(decoded_pixel_data, width, height, encoded_pixel_data);
+        if (error)
+        {
+            throw DecodeError(format("Failed to decode PNG data: %s", lodepng_error_text(error)));
+        }
     }
 
     // Set various properties for the image
@@ -262,5 +831,137 @@ void Image::decode(Decoder& decoder)
     set_pixel_data(std::move(decoded_pixel_data));
 
     // Flip the image to OpenGL ordering
-    flip_vertical();
+    if (!flipped)
+    {
+        flip_vertical();
+    }
+}
+
+void Image::encode_cooked(WriteStream& stream) const
+{
+    const size_t level_count = mipmap_count();
+
+    stream.write(CookedImageSignature, sizeof(CookedImageSignature));
+    stream << static_cast<uint8_t>(_pixel_format.type())
+           << static_cast<uint8_t>(_pixel_format.cardinality())
+           << static_cast<uint8_t>(_color_space)
+           << static_cast<uint8_t>(0)
+           << static_cast<uint32_t>(level_count);
+
+    // Lay out the levels after the table
+    size_t offset = align_cooked_offset(CookedImageHeaderSize + CookedImageLevelSize * level_count);
+    for (size_t level = 0; level < level_count; ++level)
+    {
+        const Image& image = mipmap(level);
+        const size_t size = _pixel_format.image_size(image.width(), image.height());
+        if (image.has_pixel_data() && image.pixel_data().size() != size)
+        {
+            throw EncodeError(format("Pixel data of mipmap level %u does not match its size", static_cast<unsigned>(level)));
+        }
+
+        stream << static_cast<uint32_t>(image.width())
+               << static_cast<uint32_t>(image.height())
+               << static_cast<uint64_t>(offset)
+               << static_cast<uint64_t>(size);
+
+        offset = align_cooked_offset(offset + size);
+    }
+
+    // Write the pixel data of each level, padding to the next aligned offset
+    static const uint8_t padding[CookedImageAlignment] = { };
+    size_t position = CookedImageHeaderSize + CookedImageLevelSize * level_count;
+    for (size_t level = 0; level < level_count; ++level)
+    {
+        const size_t aligned_position = align_cooked_offset(position);
+        stream.write(padding, aligned_position - position);
+
+        const Image& image = mipmap(level);
+        const size_t size = _pixel_format.image_size(image.width(), image.height());
+        if (image.has_pixel_data())
+        {
+            stream.write(image.pixel_data().data(), size);
+        }
+        else
+        {
+            for (size_t i = 0; i < size; i += CookedImageAlignment)
+            {
+                stream.write(padding, std::min(CookedImageAlignment, size - i));
+            }
+        }
+
+        position = aligned_position + size;
+    }
+}
+
+void Image::decode_cooked(ReadStream& stream)
+{
+    const size_t base_position = stream.position();
+
+    uint8_t signature[sizeof(CookedImageSignature)];
+    stream.read(signature, sizeof(signature));
+
+    uint8_t type = 0;
+    uint8_t cardinality = 0;
+    uint8_t color_space = 0;
+    uint8_t reserved = 0;
+    uint32_t level_count = 0;
+    stream >> type >> cardinality >> color_space >> reserved >> level_count;
+
+    if (type > static_cast<uint8_t>(PixelType::Bc7) || cardinality == 0 || cardinality > 4 || color_space > static_cast<uint8_t>(ColorSpace::Linear) || level_count == 0)
+    {
+        throw DecodeError("Invalid cooked image header");
+    }
+
+    const PixelFormat pixel_format(static_cast<PixelType>(type), cardinality);
+    if (!is_compatible(pixel_format, static_cast<ColorSpace>(color_space)))
+    {
+        throw DecodeError("Invalid cooked image header: color space is incompatible with pixel format");
+    }
+
+    // Read the table of levels before seeking to their data
+    std::vector<std::pair<uint32_t, uint32_t>> dimensions(level_count);
+    std::vector<std::pair<uint64_t, uint64_t>> ranges(level_count);
+    for (uint32_t level = 0; level < level_count; ++level)
+    {
+        stream >> dimensions[level].first >> dimensions[level].second >> ranges[level].first >> ranges[level].second;
+    }
+
+    for (uint32_t level = 0; level < level_count; ++level)
+    {
+        const uint32_t width = dimensions[level].first;
+        const uint32_t height = dimensions[level].second;
+        const uint64_t offset = ranges[level].first;
+        const uint64_t size = ranges[level].second;
+        // Each bound is checked separately so that a corrupt offset or size
+        // cannot wrap around
+        const uint64_t available = stream.length() - base_position;
+        const bool out_of_bounds = offset > available || size > available - offset;
+        const bool invalid_dimensions = level > 0 && (width != std::max(1u, dimensions[level - 1].first / 2) || height != std::max(1u, dimensions[level - 1].second / 2));
+        if (out_of_bounds || invalid_dimensions || size != pixel_format.image_size(width, height))
+        {
+            throw DecodeError(format("Invalid cooked image level %u", level));
+        }
+
+        ByteVector pixel_data(static_cast<size_t>(size));
+        stream.seek(static_cast<size_t>(base_position + offset));
+        if (size > 0)
+        {
+            stream.read(pixel_data.data(), static_cast<size_t>(size));
+        }
+
+        if (level == 0)
+        {
+            _width = width;
+            _height = height;
+            _pixel_format = pixel_format;
+            _color_space = static_cast<ColorSpace>(color_space);
+            _pixel_data = std::move(pixel_data);
+        }
+        else
+        {
+            Image image(width, height, pixel_format);
+            image.set_pixel_data(std::move(pixel_data));
+            add_mipmap(image);
+        }
+    }
 }
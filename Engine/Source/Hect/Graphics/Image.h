@@ -23,12 +23,16 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <vector>
+
 #include "Hect/Core/Export.h"
 #include "Hect/Graphics/Color.h"
 #include "Hect/Graphics/ColorSpace.h"
 #include "Hect/Graphics/PixelFormat.h"
 #include "Hect/IO/Asset.h"
 #include "Hect/IO/ByteVector.h"
+#include "Hect/IO/ReadStream.h"
+#include "Hect/IO/WriteStream.h"
 
 namespace hect
 {
@@ -54,6 +58,8 @@ public:
 
     ///
     /// Flips the image vertically.
+    ///
+    /// \throws InvalidOperation If the pixel format is block-compressed.
     void flip_vertical();
 
     ///
@@ -81,6 +87,8 @@ public:
     /// \param x The x coordinate.
     /// \param y The y coordinate.
     /// \param color The color to write to the pixel.
+    ///
+    /// \throws InvalidOperation If the pixel format is block-compressed.
     void write_pixel(unsigned x, unsigned y, Color color);
 
     ///
@@ -93,8 +101,12 @@ public:
     ///
     /// Reads a color value of a pixel.
     ///
+    /// \note Reading many pixels is faster with read_region().
+    ///
     /// \param x The x coordinate.
     /// \param y The y coordinate.
+    ///
+    /// \throws InvalidOperation If the pixel format is block-compressed.
     Color read_pixel(unsigned x, unsigned y) const;
 
     ///
@@ -103,6 +115,79 @@ public:
     /// \param coords The UV coordinates.
     Color read_pixel(Vector2 coords) const;
 
+    ///
+    /// Writes a rectangular region of pixels from four float components per
+    /// pixel.
+    ///
+    /// \note Writes the values as they are, as write_pixel() does, but
+    /// rounds 8-bit components to the nearest value.
+    ///
+    /// \param x The x coordinate of the region.
+    /// \param y The y coordinate of the region.
+    /// \param width The width of the region.
+    /// \param height The height of the region.
+    /// \param components The red, green, blue, and alpha components of each
+    /// pixel of the region, row by row.
+    ///
+    /// \throws InvalidOperation If the region is outside of the image or the
+    /// pixel format is block-compressed.
+    void write_region(unsigned x, unsigned y, unsigned width, unsigned height, const float* components);
+
+    ///
+    /// Reads a rectangular region of pixels to four float components per
+    /// pixel.
+    ///
+    /// \note Reads the values as they are, as read_pixel() does.  Components
+    /// missing from the pixel format read as zero, or one for alpha.  An
+    /// image without pixel data reads as if its pixel data were zero.
+    ///
+    /// \param x The x coordinate of the region.
+    /// \param y The y coordinate of the region.
+    /// \param width The width of the region.
+    /// \param height The height of the region.
+    /// \param components The array to store the red, green, blue, and alpha
+    /// components of each pixel of the region in, row by row.
+    ///
+    /// \throws InvalidOperation If the region is outside of the image or the
+    /// pixel format is block-compressed.
+    void read_region(unsigned x, unsigned y, unsigned width, unsigned height, float* components) const;
+
+    ///
+    /// Writes a row of pixels from four float components per pixel.
+    ///
+    /// \param y The y coordinate of the row.
+    /// \param components The red, green, blue, and alpha components of each
+    /// pixel of the row.
+    ///
+    /// \throws InvalidOperation If the row is outside of the image or the
+    /// pixel format is block-compressed.
+    void write_row(unsigned y, const float* components);
+
+    ///
+    /// Reads a row of pixels to four float components per pixel.
+    ///
+    /// \param y The y coordinate of the row.
+    /// \param components The array to store the red, green, blue, and alpha
+    /// components of each pixel of the row in.
+    ///
+    /// \throws InvalidOperation If the row is outside of the image or the
+    /// pixel format is block-compressed.
+    void read_row(unsigned y, float* components) const;
+
+    ///
+    /// Converts the pixel data of the image and its mipmaps to another pixel
+    /// format and color space.
+    ///
+    /// \note Unlike set_pixel_format() and set_color_space(), the pixel data
+    /// is converted; see convert_pixels().
+    ///
+    /// \param pixel_format The pixel format to convert to.
+    /// \param color_space The color space to convert to.
+    ///
+    /// \throws InvalidOperation If either pixel format is block-compressed
+    /// or the pixel format is incompatible with the color space.
+    void convert(const PixelFormat& pixel_format, ColorSpace color_space);
+
     ///
     /// Returns the width.
     unsigned width() const;
@@ -153,13 +238,65 @@ public:
     /// pixel format.
     void set_color_space(ColorSpace color_space);
 
+    ///
+    /// Returns the number of mipmap levels of the image, including the image
+    /// itself.
+    size_t mipmap_count() const;
+
+    ///
+    /// Returns the image of a mipmap level.
+    ///
+    /// \param level The level, where level zero is the image itself.
+    ///
+    /// \throws InvalidOperation If the level is out of range.
+    Image& mipmap(size_t level);
+
+    ///
+    /// \copydoc hect::Image::mipmap()
+    const Image& mipmap(size_t level) const;
+
+    ///
+    /// Adds the next mipmap level of the image.
+    ///
+    /// \param mipmap The image of the level.
+    ///
+    /// \throws InvalidOperation If the image is not half the size of the
+    /// previous level or has a different pixel format.
+    void add_mipmap(const Image& mipmap);
+
+    ///
+    /// Removes all mipmap levels of the image besides the image itself.
+    void clear_mipmaps();
+
+    ///
+    /// Replaces the mipmap levels of the image with a full chain down to one
+    /// pixel using a box filter.
+    ///
+    /// \note Use MipmapGenerator for other filters, normal maps, or to
+    /// generate on worker threads.
+    ///
+    /// \throws InvalidOperation If the image has no pixel data or its pixel
+    /// format is block-compressed.
+    void generate_mipmaps();
+
+    ///
+    /// \note Images in the 32-bit RGBA format without mipmaps are encoded
+    /// as PNG data.  All other images are encoded as cooked images: a header
+    /// and a table of levels followed by the pixel data of each level at
+    /// 16-byte aligned offsets, ready to upload without decoding.
     void encode(Encoder& encoder) const override;
     void decode(Decoder& decoder) override;
 
 private:
     void ensure_pixel_data();
+    static bool is_compatible(const PixelFormat& pixel_format, ColorSpace color_space);
     void ensure_compatible(const PixelFormat& pixel_format, ColorSpace color_space);
     size_t compute_pixel_offset(unsigned x, unsigned y) const;
+    void ensure_uncompressed() const;
+    void ensure_in_bounds(unsigned x, unsigned y, unsigned width, unsigned height) const;
+
+    void encode_cooked(WriteStream& stream) const;
+    void decode_cooked(ReadStream& stream);
 
     unsigned _width { 0 };
     unsigned _height { 0 };
@@ -169,6 +306,8 @@ private:
     ColorSpace _color_space { ColorSpace::Linear };
 
     ByteVector _pixel_data;
+
+    std::vector<Image> _mipmaps;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,806 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "ImageCompressor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "Hect/Core/Exception.h"
+#include "Hect/IO/DecodeError.h"
+
+using namespace hect;
+
+namespace
+{
+
+// The pixels of a 4x4 block as 8-bit RGBA
+typedef std::array<std::array<uint8_t, 4>, 16> BlockPixels;
+
+// The weights of the 16 interpolated colors of a BC7 mode 6 block out of 64
+const int Bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// Writes the bits of a block from the least significant bit of its first
+// byte onwards
+class BitWriter
+{
+public:
+    BitWriter(uint8_t* data) :
+        _data(data)
+    {
+    }
+
+    void write(uint32_t value, unsigned bit_count)
+    {
+        for (unsigned i = 0; i < bit_count; ++i, ++_position)
+        {
+            if (value & (1u << i))
+            {
+                _data[_position / 8] |= static_cast<uint8_t>(1u << (_position % 8));
+            }
+        }
+    }
+
+private:
+    uint8_t* _data;
+    unsigned _position { 0 };
+};
+
+// Reads the bits of a block written by BitWriter
+class BitReader
+{
+public:
+    BitReader(const uint8_t* data) :
+        _data(data)
+    {
+    }
+
+    uint32_t read(unsigned bit_count)
+    {
+        uint32_t value = 0;
+        for (unsigned i = 0; i < bit_count; ++i, ++_position)
+        {
+            value |= static_cast<uint32_t>((_data[_position / 8] >> (_position % 8)) & 1) << i;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* _data;
+    unsigned _position { 0 };
+};
+
+// Returns the direction along which a set of points varies most, using power
+// iteration on their covariance
+std::array<double, 4> principal_axis(const std::array<double, 4>* points, size_t count, unsigned dimensions, std::array<double, 4>& mean)
+{
+    mean = { { 0, 0, 0, 0 } };
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (unsigned c = 0; c < dimensions; ++c)
+        {
+            mean[c] += points[i][c] / count;
+        }
+    }
+
+    double covariance[4][4] = { };
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (unsigned a = 0; a < dimensions; ++a)
+        {
+            for (unsigned b = 0; b < dimensions; ++b)
+            {
+                covariance[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+            }
+        }
+    }
+
+    std::array<double, 4> axis = { { 1, 1, 1, 1 } };
+    for (unsigned iteration = 0; iteration < 8; ++iteration)
+    {
+        std::array<double, 4> next = { { 0, 0, 0, 0 } };
+        double length = 0;
+        for (unsigned a = 0; a < dimensions; ++a)
+        {
+            for (unsigned b = 0; b < dimensions; ++b)
+            {
+                next[a] += covariance[a][b] * axis[b];
+            }
+            length += next[a] * next[a];
+        }
+
+        if (length <= 0.0)
+        {
+            break;
+        }
+
+        length = std::sqrt(length);
+        for (unsigned a = 0; a < dimensions; ++a)
+        {
+            axis[a] = next[a] / length;
+        }
+    }
+
+    return axis;
+}
+
+// Finds the endpoints spanning a set of points along their principal axis
+void fit_endpoints(const std::array<double, 4>* points, size_t count, unsigned dimensions, std::array<double, 4>& e0, std::array<double, 4>& e1)
+{
+    std::array<double, 4> mean;
+    const std::array<double, 4> axis = principal_axis(points, count, dimensions, mean);
+
+    double min_t = 0;
+    double max_t = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        double t = 0;
+        for (unsigned c = 0; c < dimensions; ++c)
+        {
+            t += (points[i][c] - mean[c]) * axis[c];
+        }
+        min_t = std::min(min_t, t);
+        max_t = std::max(max_t, t);
+    }
+
+    for (unsigned c = 0; c < 4; ++c)
+    {
+        e0[c] = c < dimensions ? mean[c] + axis[c] * min_t : 0;
+        e1[c] = c < dimensions ? mean[c] + axis[c] * max_t : 0;
+    }
+}
+
+// Solves for the endpoints which best reproduce a set of points given the
+// interpolation weight of each point
+bool refit_endpoints(const std::array<double, 4>* points, const double* weights, size_t count, unsigned dimensions, std::array<double, 4>& e0, std::array<double, 4>& e1)
+{
+    double aa = 0, ab = 0, bb = 0;
+    std::array<double, 4> ax = { { 0, 0, 0, 0 } };
+    std::array<double, 4> bx = { { 0, 0, 0, 0 } };
+    for (size_t i = 0; i < count; ++i)
+    {
+        const double b = weights[i];
+        const double a = 1.0 - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (unsigned c = 0; c < dimensions; ++c)
+        {
+            ax[c] += a * points[i][c];
+            bx[c] += b * points[i][c];
+        }
+    }
+
+    const double determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1.0e-9)
+    {
+        return false;
+    }
+
+    for (unsigned c = 0; c < dimensions; ++c)
+    {
+        e0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+        e1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+    }
+    return true;
+}
+
+uint16_t pack_565(const std::array<double, 4>& color)
+{
+    const unsigned r = static_cast<unsigned>(std::min(31.0, std::max(0.0, std::round(color[0] * 31.0 / 255.0))));
+    const unsigned g = static_cast<unsigned>(std::min(63.0, std::max(0.0, std::round(color[1] * 63.0 / 255.0))));
+    const unsigned b = static_cast<unsigned>(std::min(31.0, std::max(0.0, std::round(color[2] * 31.0 / 255.0))));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+std::array<int, 3> unpack_565(uint16_t color)
+{
+    const int r = (color >> 11) & 31;
+    const int g = (color >> 5) & 63;
+    const int b = color & 31;
+    return { { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) } };
+}
+
+// Returns the colors of a BC1 block given its endpoints
+std::array<std::array<int, 4>, 4> bc1_palette(uint16_t c0, uint16_t c1, bool allow_transparency)
+{
+    const std::array<int, 3> a = unpack_565(c0);
+    const std::array<int, 3> b = unpack_565(c1);
+
+    std::array<std::array<int, 4>, 4> palette;
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        palette[0][c] = a[c];
+        palette[1][c] = b[c];
+        if (c0 > c1 || !allow_transparency)
+        {
+            palette[2][c] = (2 * a[c] + b[c]) / 3;
+            palette[3][c] = (a[c] + 2 * b[c]) / 3;
+        }
+        else
+        {
+            palette[2][c] = (a[c] + b[c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = c0 > c1 || !allow_transparency ? 255 : 0;
+    return palette;
+}
+
+// Encodes a BC1 block; transparent pixels are only encoded if allowed since
+// BC3 color blocks are always decoded in four-color mode
+void encode_bc1_block(const BlockPixels& pixels, uint8_t* block, bool allow_transparency)
+{
+    std::array<std::array<double, 4>, 16> points;
+    size_t count = 0;
+    bool transparent = false;
+    for (const std::array<uint8_t, 4>& pixel : pixels)
+    {
+        if (allow_transparency && pixel[3] < 128)
+        {
+            transparent = true;
+            continue;
+        }
+        points[count++] = { { static_cast<double>(pixel[0]), static_cast<double>(pixel[1]), static_cast<double>(pixel[2]), 0.0 } };
+    }
+
+    std::memset(block, 0, 8);
+    if (count == 0)
+    {
+        // Fully transparent: both endpoints black in three-color mode
+        std::memset(block + 4, 0xff, 4);
+        return;
+    }
+
+    std::array<double, 4> e0, e1;
+    fit_endpoints(points.data(), count, 3, e0, e1);
+
+    uint16_t best_c0 = 0, best_c1 = 0;
+    uint32_t best_indices = 0;
+    double best_error = -1;
+    for (unsigned attempt = 0; attempt < 2; ++attempt)
+    {
+        uint16_t c0 = pack_565(e1);
+        uint16_t c1 = pack_565(e0);
+
+        // The order of the endpoints selects the mode
+        if ((transparent && c0 > c1) || (!transparent && c0 < c1))
+        {
+            std::swap(c0, c1);
+        }
+
+        const std::array<std::array<int, 4>, 4> palette = bc1_palette(c0, c1, allow_transparency);
+        const unsigned color_count = transparent || (c0 == c1 && allow_transparency) ? 3 : 4;
+
+        uint32_t indices = 0;
+        double error = 0;
+        std::array<double, 16> weights;
+        size_t weight_count = 0;
+        for (size_t i = 0; i < 16; ++i)
+        {
+            const std::array<uint8_t, 4>& pixel = pixels[i];
+            unsigned best_index = 0;
+            if (transparent && pixel[3] < 128)
+            {
+                best_index = 3;
+            }
+            else
+            {
+                int best_distance = -1;
+                for (unsigned index = 0; index < color_count; ++index)
+                {
+                    int distance = 0;
+                    for (unsigned c = 0; c < 3; ++c)
+                    {
+                        const int d = palette[index][c] - pixel[c];
+                        distance += d * d;
+                    }
+                    if (best_distance < 0 || distance < best_distance)
+                    {
+                        best_distance = distance;
+                        best_index = index;
+                    }
+                }
+                error += best_distance;
+
+                // The weight of the second endpoint for each index
+                const double four_color_weights[4] = { 0.0, 1.0, 1.0 / 3.0, 2.0 / 3.0 };
+                const double three_color_weights[4] = { 0.0, 1.0, 0.5, 0.0 };
+                weights[weight_count++] = color_count == 4 ? four_color_weights[best_index] : three_color_weights[best_index];
+            }
+            indices |= best_index << (i * 2);
+        }
+
+        if (best_error < 0 || error < best_error)
+        {
+            best_error = error;
+            best_c0 = c0;
+            best_c1 = c1;
+            best_indices = indices;
+        }
+
+        // Refit the endpoints to the chosen indices; the endpoints are
+        // assigned so that the first decoded endpoint is e1
+        std::array<double, 4> refit0, refit1;
+        if (!refit_endpoints(points.data(), weights.data(), count, 3, refit0, refit1))
+        {
+            break;
+        }
+        e1 = refit0;
+        e0 = refit1;
+    }
+
+    block[0] = static_cast<uint8_t>(best_c0 & 0xff);
+    block[1] = static_cast<uint8_t>(best_c0 >> 8);
+    block[2] = static_cast<uint8_t>(best_c1 & 0xff);
+    block[3] = static_cast<uint8_t>(best_c1 >> 8);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        block[4 + i] = static_cast<uint8_t>((best_indices >> (i * 8)) & 0xff);
+    }
+}
+
+void decode_bc1_block(const uint8_t* block, BlockPixels& pixels, bool allow_transparency)
+{
+    const uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    const uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    const std::array<std::array<int, 4>, 4> palette = bc1_palette(c0, c1, allow_transparency);
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        const unsigned index = (block[4 + i / 4] >> ((i % 4) * 2)) & 3;
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            pixels[i][c] = static_cast<uint8_t>(palette[index][c]);
+        }
+    }
+}
+
+// Returns the eight values of a BC4 block given its endpoints
+std::array<int, 8> bc4_palette(int a0, int a1)
+{
+    std::array<int, 8> palette;
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1)
+    {
+        for (int i = 1; i < 7; ++i)
+        {
+            palette[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+        }
+    }
+    else
+    {
+        for (int i = 1; i < 5; ++i)
+        {
+            palette[i + 1] = ((5 - i) * a0 + i * a1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    return palette;
+}
+
+// Encodes one channel of a block as a BC4 block
+void encode_bc4_block(const BlockPixels& pixels, unsigned channel, uint8_t* block)
+{
+    int min_value = 255;
+    int max_value = 0;
+    for (const std::array<uint8_t, 4>& pixel : pixels)
+    {
+        min_value = std::min(min_value, static_cast<int>(pixel[channel]));
+        max_value = std::max(max_value, static_cast<int>(pixel[channel]));
+    }
+
+    std::memset(block, 0, 8);
+    block[0] = static_cast<uint8_t>(max_value);
+    block[1] = static_cast<uint8_t>(min_value);
+    if (min_value == max_value)
+    {
+        return;
+    }
+
+    const std::array<int, 8> palette = bc4_palette(max_value, min_value);
+    uint64_t indices = 0;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        const int value = pixels[i][channel];
+        unsigned best_index = 0;
+        for (unsigned index = 1; index < 8; ++index)
+        {
+            if (std::abs(palette[index] - value) < std::abs(palette[best_index] - value))
+            {
+                best_index = index;
+            }
+        }
+        indices |= static_cast<uint64_t>(best_index) << (i * 3);
+    }
+
+    for (unsigned i = 0; i < 6; ++i)
+    {
+        block[2 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xff);
+    }
+}
+
+void decode_bc4_block(const uint8_t* block, unsigned channel, BlockPixels& pixels)
+{
+    const std::array<int, 8> palette = bc4_palette(block[0], block[1]);
+
+    uint64_t indices = 0;
+    for (unsigned i = 0; i < 6; ++i)
+    {
+        indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+    }
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        pixels[i][channel] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+    }
+}
+
+// Quantizes an endpoint of a BC7 mode 6 block to 7 bits per component and a
+// shared least significant bit, choosing the bit with the least error
+void quantize_bc7_endpoint(const std::array<double, 4>& endpoint, std::array<int, 4>& quantized, int& p_bit)
+{
+    double best_error = -1;
+    for (int p = 0; p < 2; ++p)
+    {
+        std::array<int, 4> candidate;
+        double error = 0;
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            candidate[c] = static_cast<int>(std::min(127.0, std::max(0.0, std::round((endpoint[c] - p) / 2.0))));
+            const double d = ((candidate[c] << 1) | p) - endpoint[c];
+            error += d * d;
+        }
+
+        if (best_error < 0 || error < best_error)
+        {
+            best_error = error;
+            quantized = candidate;
+            p_bit = p;
+        }
+    }
+}
+
+void encode_bc7_block(const BlockPixels& pixels, uint8_t* block)
+{
+    std::array<std::array<double, 4>, 16> points;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            points[i][c] = pixels[i][c];
+        }
+    }
+
+    std::array<double, 4> e0, e1;
+    fit_endpoints(points.data(), 16, 4, e0, e1);
+
+    std::array<int, 4> best_q[2];
+    int best_p[2] = { 0, 0 };
+    std::array<unsigned, 16> best_indices;
+    double best_error = -1;
+    for (unsigned attempt = 0; attempt < 2; ++attempt)
+    {
+        std::array<int, 4> q[2];
+        int p[2];
+        quantize_bc7_endpoint(e0, q[0], p[0]);
+        quantize_bc7_endpoint(e1, q[1], p[1]);
+
+        std::array<int, 4> endpoints[2];
+        for (unsigned e = 0; e < 2; ++e)
+        {
+            for (unsigned c = 0; c < 4; ++c)
+            {
+                endpoints[e][c] = (q[e][c] << 1) | p[e];
+            }
+        }
+
+        std::array<unsigned, 16> indices;
+        std::array<double, 16> weights;
+        double error = 0;
+        for (size_t i = 0; i < 16; ++i)
+        {
+            int best_distance = -1;
+            for (unsigned index = 0; index < 16; ++index)
+            {
+                int distance = 0;
+                for (unsigned c = 0; c < 4; ++c)
+                {
+                    const int value = ((64 - Bc7Weights[index]) * endpoints[0][c] + Bc7Weights[index] * endpoints[1][c] + 32) >> 6;
+                    const int d = value - pixels[i][c];
+                    distance += d * d;
+                }
+                if (best_distance < 0 || distance < best_distance)
+                {
+                    best_distance = distance;
+                    indices[i] = index;
+                }
+            }
+            error += best_distance;
+            weights[i] = Bc7Weights[indices[i]] / 64.0;
+        }
+
+        if (best_error < 0 || error < best_error)
+        {
+            best_error = error;
+            best_q[0] = q[0];
+            best_q[1] = q[1];
+            best_p[0] = p[0];
+            best_p[1] = p[1];
+            best_indices = indices;
+        }
+
+        if (!refit_endpoints(points.data(), weights.data(), 16, 4, e0, e1))
+        {
+            break;
+        }
+    }
+
+    // The most significant bit of the first index is implied to be zero
+    if (best_indices[0] & 8)
+    {
+        std::swap(best_q[0], best_q[1]);
+        std::swap(best_p[0], best_p[1]);
+        for (unsigned& index : best_indices)
+        {
+            index = 15 - index;
+        }
+    }
+
+    std::memset(block, 0, 16);
+    BitWriter writer(block);
+    writer.write(1 << 6, 7);
+    for (unsigned c = 0; c < 4; ++c)
+    {
+        writer.write(static_cast<uint32_t>(best_q[0][c]), 7);
+        writer.write(static_cast<uint32_t>(best_q[1][c]), 7);
+    }
+    writer.write(static_cast<uint32_t>(best_p[0]), 1);
+    writer.write(static_cast<uint32_t>(best_p[1]), 1);
+    writer.write(best_indices[0], 3);
+    for (size_t i = 1; i < 16; ++i)
+    {
+        writer.write(best_indices[i], 4);
+    }
+}
+
+void decode_bc7_block(const uint8_t* block, BlockPixels& pixels)
+{
+    BitReader reader(block);
+    if (reader.read(7) != (1 << 6))
+    {
+        throw DecodeError("Only BC7 blocks in mode 6 can be decoded");
+    }
+
+    int q[2][4];
+    for (unsigned c = 0; c < 4; ++c)
+    {
+        q[0][c] = static_cast<int>(reader.read(7));
+        q[1][c] = static_cast<int>(reader.read(7));
+    }
+    const int p0 = static_cast<int>(reader.read(1));
+    const int p1 = static_cast<int>(reader.read(1));
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        const unsigned index = reader.read(i == 0 ? 3 : 4);
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            const int e0 = (q[0][c] << 1) | p0;
+            const int e1 = (q[1][c] << 1) | p1;
+            pixels[i][c] = static_cast<uint8_t>(((64 - Bc7Weights[index]) * e0 + Bc7Weights[index] * e1 + 32) >> 6);
+        }
+    }
+}
+
+}
+
+Image ImageCompressor::compress(const Image& image, const PixelFormat& pixel_format) const
+{
+    if (image.pixel_format().type() != PixelType::Byte)
+    {
+        throw InvalidOperation("Only images with 8-bit components can be compressed");
+    }
+    else if (!pixel_format.is_compressed())
+    {
+        throw InvalidOperation("Pixel format is not block-compressed");
+    }
+
+    Image compressed_image = compress_level(image, pixel_format);
+    for (size_t level = 1; level < image.mipmap_count(); ++level)
+    {
+        compressed_image.add_mipmap(compress_level(image.mipmap(level), pixel_format));
+    }
+
+    return compressed_image;
+}
+
+Image ImageCompressor::decompress(const Image& image) const
+{
+    if (!image.pixel_format().is_compressed())
+    {
+        throw InvalidOperation("Image is not block-compressed");
+    }
+
+    Image decompressed_image = decompress_level(image);
+    for (size_t level = 1; level < image.mipmap_count(); ++level)
+    {
+        decompressed_image.add_mipmap(decompress_level(image.mipmap(level)));
+    }
+
+    return decompressed_image;
+}
+
+Image ImageCompressor::compress_level(const Image& image, const PixelFormat& pixel_format) const
+{
+    const unsigned width = image.width();
+    const unsigned height = image.height();
+    const unsigned cardinality = image.pixel_format().cardinality();
+
+    Image compressed_image(width, height, pixel_format);
+    ByteVector pixel_data(pixel_format.image_size(width, height), 0);
+    if (!image.has_pixel_data() || width == 0 || height == 0)
+    {
+        compressed_image.set_pixel_data(std::move(pixel_data));
+        return compressed_image;
+    }
+
+    const ByteVector& source = image.pixel_data();
+    const unsigned block_size = pixel_format.block_size();
+    const unsigned blocks_wide = (width + 3) / 4;
+    const unsigned blocks_high = (height + 3) / 4;
+
+    BlockPixels pixels;
+    for (unsigned block_y = 0; block_y < blocks_high; ++block_y)
+    {
+        for (unsigned block_x = 0; block_x < blocks_wide; ++block_x)
+        {
+            // Gather the pixels of the block, repeating the edge pixels of
+            // partial blocks
+            for (unsigned i = 0; i < 16; ++i)
+            {
+                const unsigned x = std::min(block_x * 4 + i % 4, width - 1);
+                const unsigned y = std::min(block_y * 4 + i / 4, height - 1);
+                const uint8_t* pixel = &source[(static_cast<size_t>(y) * width + x) * cardinality];
+                pixels[i] = { { 0, 0, 0, 255 } };
+                std::memcpy(pixels[i].data(), pixel, cardinality);
+            }
+
+            uint8_t* block = &pixel_data[(static_cast<size_t>(block_y) * blocks_wide + block_x) * block_size];
+            switch (pixel_format.type())
+            {
+            case PixelType::Bc1:
+                encode_bc1_block(pixels, block, true);
+                break;
+            case PixelType::Bc3:
+                encode_bc4_block(pixels, 3, block);
+                encode_bc1_block(pixels, block + 8, false);
+                break;
+            case PixelType::Bc4:
+                encode_bc4_block(pixels, 0, block);
+                break;
+            case PixelType::Bc5:
+                encode_bc4_block(pixels, 0, block);
+                encode_bc4_block(pixels, 1, block + 8);
+                break;
+            case PixelType::Bc7:
+                encode_bc7_block(pixels, block);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    compressed_image.set_pixel_data(std::move(pixel_data));
+
+    // Single and dual-channel formats are always linear
+    if (pixel_format.cardinality() == 4)
+    {
+        compressed_image.set_color_space(image.color_space());
+    }
+    return compressed_image;
+}
+
+Image ImageCompressor::decompress_level(const Image& image) const
+{
+    const PixelFormat& compressed_format = image.pixel_format();
+    const unsigned width = image.width();
+    const unsigned height = image.height();
+
+    PixelFormat pixel_format = PixelFormat::Rgba8;
+    if (compressed_format.type() == PixelType::Bc4)
+    {
+        pixel_format = PixelFormat::R8;
+    }
+    else if (compressed_format.type() == PixelType::Bc5)
+    {
+        pixel_format = PixelFormat::Rg8;
+    }
+
+    Image decompressed_image(width, height, pixel_format);
+    ByteVector pixel_data(pixel_format.image_size(width, height), 0);
+    const unsigned cardinality = pixel_format.cardinality();
+
+    const ByteVector& source = image.pixel_data();
+    const unsigned block_size = compressed_format.block_size();
+    const unsigned blocks_wide = (width + 3) / 4;
+    const unsigned blocks_high = (height + 3) / 4;
+    if (image.has_pixel_data() && source.size() < compressed_format.image_size(width, height))
+    {
+        throw InvalidOperation("Pixel data is smaller than the image");
+    }
+
+    BlockPixels pixels;
+    for (unsigned block_y = 0; block_y < blocks_high && image.has_pixel_data(); ++block_y)
+    {
+        for (unsigned block_x = 0; block_x < blocks_wide; ++block_x)
+        {
+            const uint8_t* block = &source[(static_cast<size_t>(block_y) * blocks_wide + block_x) * block_size];
+            pixels.fill({ { 0, 0, 0, 255 } });
+            switch (compressed_format.type())
+            {
+            case PixelType::Bc1:
+                decode_bc1_block(block, pixels, true);
+                break;
+            case PixelType::Bc3:
+                decode_bc1_block(block + 8, pixels, false);
+                decode_bc4_block(block, 3, pixels);
+                break;
+            case PixelType::Bc4:
+                decode_bc4_block(block, 0, pixels);
+                break;
+            case PixelType::Bc5:
+                decode_bc4_block(block, 0, pixels);
+                decode_bc4_block(block + 8, 1, pixels);
+                break;
+            case PixelType::Bc7:
+                decode_bc7_block(block, pixels);
+                break;
+            default:
+                break;
+            }
+
+            // Scatter the pixels of the block which are within the image
+            for (unsigned i = 0; i < 16; ++i)
+            {
+                const unsigned x = block_x * 4 + i % 4;
+                const unsigned y = block_y * 4 + i / 4;
+                if (x < width && y < height)
+                {
+                    std::memcpy(&pixel_data[(static_cast<size_t>(y) * width + x) * cardinality], pixels[i].data(), cardinality);
+                }
+            }
+        }
+    }
+
+    decompressed_image.set_pixel_data(std::move(pixel_data));
+    decompressed_image.set_color_space(image.color_space());
+    return decompressed_image;
+}
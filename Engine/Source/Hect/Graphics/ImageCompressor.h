@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Hect/Core/Export.h"
+#include "Hect/Graphics/Image.h"
+
+namespace hect
+{
+
+///
+/// Converts an Image between uncompressed and block-compressed pixel
+/// formats.
+///
+/// \note Blocks are encoded by fitting the endpoints of each block along the
+/// principal axis of its colors and then refining them with a least-squares
+/// fit to the chosen indices.  BC7 blocks are always encoded in its
+/// single-subset RGBA mode (mode 6), which is also the only mode decoded.
+class HECT_EXPORT ImageCompressor
+{
+public:
+
+    ///
+    /// Returns a block-compressed copy of an image and its mipmaps.
+    ///
+    /// \note Components missing from the image are encoded as zero, or as
+    /// opaque for alpha.  Partial blocks at the edges are padded by
+    /// repeating the edge pixels.
+    ///
+    /// \param image The image to compress; must have 8-bit components.
+    /// \param pixel_format The block-compressed pixel format to compress to.
+    ///
+    /// \throws InvalidOperation If the image does not have 8-bit components
+    /// or the pixel format is not block-compressed.
+    Image compress(const Image& image, const PixelFormat& pixel_format) const;
+
+    ///
+    /// Returns an uncompressed copy of a block-compressed image and its
+    /// mipmaps.
+    ///
+    /// \note BC4 and BC5 images decompress to PixelFormat::R8 and
+    /// PixelFormat::Rg8; all others decompress to PixelFormat::Rgba8.
+    ///
+    /// \param image The image to decompress.
+    ///
+    /// \throws InvalidOperation If the image is not block-compressed.
+    /// \throws DecodeError If a BC7 block uses a mode other than mode 6.
+    Image decompress(const Image& image) const;
+
+private:
+    Image compress_level(const Image& image, const PixelFormat& pixel_format) const;
+    Image decompress_level(const Image& image) const;
+};
+
+}
@@ -0,0 +1,637 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "LightProbeConvolver.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "Hect/Concurrency/TaskPool.h"
+#include "Hect/Core/Configuration.h"
+#include "Hect/Core/Exception.h"
+#include "Hect/Graphics/PixelConversion.h"
+
+#ifdef HECT_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace hect;
+
+namespace
+{
+
+// The number of rows of a side in each block of work
+const unsigned RowsPerBlock = 16;
+
+const unsigned SideCount = 6;
+
+const double Pi = 3.14159265358979323846;
+
+// Pixels are convolved with four float components regardless of the
+// cardinality of the image so that each pixel is one SIMD vector
+typedef std::vector<float> PixelBuffer;
+
+// The pixels of each side of a cube map at one level
+typedef std::array<PixelBuffer, SideCount> CubeLevel;
+
+// The environment and its box-filtered mipmap levels in linear float pixels
+struct CubeChain
+{
+    std::vector<unsigned> sizes;
+    std::vector<CubeLevel> levels;
+};
+
+// A sample of a GGX lobe in the space of the lobe's axis, along with the
+// level of the chain to read it from
+struct LobeSample
+{
+    float x { 0.0f };
+    float y { 0.0f };
+    float z { 0.0f };
+    float weight { 0.0f };
+    float level { 0.0f };
+};
+
+// Performs an action on blocks of rows of each side of a cube map, split
+// across the worker threads of the task pool when there is one; the action
+// receives the index of the block so that results can be combined in a fixed
+// order
+template <typename ActionType>
+void for_each_block(TaskPool* task_pool, unsigned size, const ActionType& action)
+{
+    const unsigned blocks_per_side = (size + RowsPerBlock - 1) / RowsPerBlock;
+    const unsigned block_count = blocks_per_side * SideCount;
+
+    auto perform = [&action, size, blocks_per_side](unsigned begin, unsigned end)
+    {
+        for (unsigned block = begin; block < end; ++block)
+        {
+            const unsigned side = block / blocks_per_side;
+            const unsigned first_row = (block % blocks_per_side) * RowsPerBlock;
+            action(block, side, first_row, std::min(first_row + RowsPerBlock, size));
+        }
+    };
+
+    unsigned task_count = 1;
+    if (task_pool)
+    {
+        task_count = std::max(1u, std::min(static_cast<unsigned>(task_pool->thread_count()), block_count));
+    }
+
+    if (task_count == 1)
+    {
+        perform(0, block_count);
+        return;
+    }
+
+    std::vector<Task::Handle> tasks;
+    tasks.reserve(task_count);
+    for (unsigned i = 0; i < task_count; ++i)
+    {
+        const unsigned begin = block_count * i / task_count;
+        const unsigned end = block_count * (i + 1) / task_count;
+        tasks.push_back(task_pool->enqueue([&perform, begin, end]
+        {
+            perform(begin, end);
+        }));
+    }
+
+    for (Task::Handle& task : tasks)
+    {
+        task->wait();
+    }
+}
+
+// The unnormalized direction through a point on a side, where the point is
+// in [-1, 1] on both axes
+void side_direction(unsigned side, float sc, float tc, float* direction)
+{
+    switch (side)
+    {
+    case 0:
+        direction[0] = 1.0f;
+        direction[1] = -tc;
+        direction[2] = -sc;
+        break;
+    case 1:
+        direction[0] = -1.0f;
+        direction[1] = -tc;
+        direction[2] = sc;
+        break;
+    case 2:
+        direction[0] = sc;
+        direction[1] = 1.0f;
+        direction[2] = tc;
+        break;
+    case 3:
+        direction[0] = sc;
+        direction[1] = -1.0f;
+        direction[2] = -tc;
+        break;
+    case 4:
+        direction[0] = sc;
+        direction[1] = -tc;
+        direction[2] = 1.0f;
+        break;
+    default:
+        direction[0] = -sc;
+        direction[1] = -tc;
+        direction[2] = -1.0f;
+        break;
+    }
+}
+
+// The side that a direction points through and the UV coordinates of the
+// point on it
+unsigned locate_direction(const float* direction, float& s, float& t)
+{
+    const float x = direction[0];
+    const float y = direction[1];
+    const float z = direction[2];
+    const float ax = std::abs(x);
+    const float ay = std::abs(y);
+    const float az = std::abs(z);
+
+    unsigned side;
+    float sc, tc, major;
+    if (ax >= ay && ax >= az)
+    {
+        side = x > 0.0f ? 0 : 1;
+        sc = x > 0.0f ? -z : z;
+        tc = -y;
+        major = ax;
+    }
+    else if (ay >= az)
+    {
+        side = y > 0.0f ? 2 : 3;
+        sc = x;
+        tc = y > 0.0f ? z : -z;
+        major = ay;
+    }
+    else
+    {
+        side = z > 0.0f ? 4 : 5;
+        sc = z > 0.0f ? x : -x;
+        tc = -y;
+        major = az;
+    }
+
+    s = 0.5f * (sc / major + 1.0f);
+    t = 0.5f * (tc / major + 1.0f);
+    return side;
+}
+
+// The solid angle subtended by the part of a side between the origin and a
+// point, where the point is in [-1, 1] on both axes
+double corner_area(double x, double y)
+{
+    return std::atan2(x * y, std::sqrt(x * x + y * y + 1.0));
+}
+
+// The solid angle subtended by a pixel of a side
+double pixel_solid_angle(unsigned x, unsigned y, unsigned size)
+{
+    const double scale = 2.0 / size;
+    const double x0 = x * scale - 1.0;
+    const double y0 = y * scale - 1.0;
+    const double x1 = x0 + scale;
+    const double y1 = y0 + scale;
+    return corner_area(x0, y0) - corner_area(x0, y1) - corner_area(x1, y0) + corner_area(x1, y1);
+}
+
+// Adds a weighted pixel to a sum
+void accumulate(const float* pixel, float weight, float* sum)
+{
+#ifdef HECT_SIMD_SSE2
+    const __m128 result = _mm_add_ps(_mm_loadu_ps(sum), _mm_mul_ps(_mm_set1_ps(weight), _mm_loadu_ps(pixel)));
+    _mm_storeu_ps(sum, result);
+#else
+    for (unsigned c = 0; c < 4; ++c)
+    {
+        sum[c] += weight * pixel[c];
+    }
+#endif
+}
+
+// Adds a bilinearly filtered pixel of a side at one level to a sum, clamping
+// at the edges of the side
+void accumulate_bilinear(const PixelBuffer& pixels, unsigned size, float s, float t, float weight, float* sum)
+{
+    const float fx = s * size - 0.5f;
+    const float fy = t * size - 0.5f;
+    const float floor_x = std::floor(fx);
+    const float floor_y = std::floor(fy);
+    const float wx = fx - floor_x;
+    const float wy = fy - floor_y;
+
+    const int max = static_cast<int>(size) - 1;
+    const int x0 = std::min(std::max(static_cast<int>(floor_x), 0), max);
+    const int y0 = std::min(std::max(static_cast<int>(floor_y), 0), max);
+    const int x1 = std::min(std::max(static_cast<int>(floor_x) + 1, 0), max);
+    const int y1 = std::min(std::max(static_cast<int>(floor_y) + 1, 0), max);
+
+    const float* data = pixels.data();
+    accumulate(data + (static_cast<size_t>(y0) * size + x0) * 4, weight * (1.0f - wx) * (1.0f - wy), sum);
+    accumulate(data + (static_cast<size_t>(y0) * size + x1) * 4, weight * wx * (1.0f - wy), sum);
+    accumulate(data + (static_cast<size_t>(y1) * size + x0) * 4, weight * (1.0f - wx) * wy, sum);
+    accumulate(data + (static_cast<size_t>(y1) * size + x1) * 4, weight * wx * wy, sum);
+}
+
+// Adds a trilinearly filtered sample of the environment in a direction to a
+// sum
+void accumulate_environment(const CubeChain& chain, const float* direction, float level, float weight, float* sum)
+{
+    float s, t;
+    const unsigned side = locate_direction(direction, s, t);
+
+    const unsigned level0 = static_cast<unsigned>(level);
+    const unsigned level1 = std::min(level0 + 1, static_cast<unsigned>(chain.levels.size()) - 1);
+    const float blend = level - level0;
+
+    accumulate_bilinear(chain.levels[level0][side], chain.sizes[level0], s, t, weight * (1.0f - blend), sum);
+    if (blend > 0.0f)
+    {
+        accumulate_bilinear(chain.levels[level1][side], chain.sizes[level1], s, t, weight * blend, sum);
+    }
+}
+
+// Halves the size of a side with a box filter
+void downsample(const PixelBuffer& source, unsigned source_size, PixelBuffer& dest, unsigned size)
+{
+    dest.resize(static_cast<size_t>(size) * size * 4);
+    const unsigned max = source_size - 1;
+    for (unsigned y = 0; y < size; ++y)
+    {
+        const unsigned y0 = std::min(y * 2, max);
+        const unsigned y1 = std::min(y * 2 + 1, max);
+        for (unsigned x = 0; x < size; ++x)
+        {
+            const unsigned x0 = std::min(x * 2, max);
+            const unsigned x1 = std::min(x * 2 + 1, max);
+
+            float* pixel = &dest[(static_cast<size_t>(y) * size + x) * 4];
+            std::fill(pixel, pixel + 4, 0.0f);
+            accumulate(&source[(static_cast<size_t>(y0) * source_size + x0) * 4], 0.25f, pixel);
+            accumulate(&source[(static_cast<size_t>(y0) * source_size + x1) * 4], 0.25f, pixel);
+            accumulate(&source[(static_cast<size_t>(y1) * source_size + x0) * 4], 0.25f, pixel);
+            accumulate(&source[(static_cast<size_t>(y1) * source_size + x1) * 4], 0.25f, pixel);
+        }
+    }
+}
+
+// Converts the sides of a cube map to linear float pixels
+CubeLevel convert_to_linear(TaskPool* task_pool, TextureCube& texture)
+{
+    std::array<const Image*, SideCount> images;
+    for (unsigned side = 0; side < SideCount; ++side)
+    {
+        images[side] = &texture.image(static_cast<CubeSide>(side));
+    }
+
+    const unsigned size = images[0]->width();
+    CubeLevel level;
+    for (PixelBuffer& pixels : level)
+    {
+        pixels.resize(static_cast<size_t>(size) * size * 4);
+    }
+
+    for_each_block(task_pool, size, [&](unsigned, unsigned side, unsigned begin, unsigned end)
+    {
+        const Image& image = *images[side];
+        const PixelFormat& pixel_format = image.pixel_format();
+        const uint8_t* data = image.pixel_data().data() + static_cast<size_t>(begin) * size * pixel_format.size();
+        decode_pixels(data, pixel_format, image.color_space(), &level[side][static_cast<size_t>(begin) * size * 4], static_cast<size_t>(end - begin) * size);
+    });
+
+    return level;
+}
+
+// Builds the box-filtered chain of the environment down to one pixel
+CubeChain build_chain(TaskPool* task_pool, TextureCube& texture)
+{
+    CubeChain chain;
+    chain.sizes.push_back(texture.image(CubeSide::PositiveX).width());
+    chain.levels.push_back(convert_to_linear(task_pool, texture));
+
+    while (chain.sizes.back() > 1)
+    {
+        const unsigned source_size = chain.sizes.back();
+        const unsigned size = source_size / 2;
+
+        CubeLevel level;
+        const CubeLevel& source = chain.levels.back();
+        for (unsigned side = 0; side < SideCount; ++side)
+        {
+            downsample(source[side], source_size, level[side], size);
+        }
+
+        chain.sizes.push_back(size);
+        chain.levels.push_back(std::move(level));
+    }
+
+    return chain;
+}
+
+// The radical inverse of an integer in base two
+double radical_inverse(unsigned i)
+{
+    i = (i << 16u) | (i >> 16u);
+    i = ((i & 0x55555555u) << 1u) | ((i & 0xAAAAAAAAu) >> 1u);
+    i = ((i & 0x33333333u) << 2u) | ((i & 0xCCCCCCCCu) >> 2u);
+    i = ((i & 0x0F0F0F0Fu) << 4u) | ((i & 0xF0F0F0F0u) >> 4u);
+    i = ((i & 0x00FF00FFu) << 8u) | ((i & 0xFF00FF00u) >> 8u);
+    return i * 2.3283064365386963e-10;
+}
+
+// Samples a GGX lobe by importance on a Hammersley sequence, assuming that
+// the view direction and the normal are both the axis of the lobe
+std::vector<LobeSample> compute_lobe_samples(double roughness, unsigned sample_count, const CubeChain& chain)
+{
+    const double alpha = roughness * roughness;
+    const double alpha_squared = alpha * alpha;
+    const double texel_solid_angle = 4.0 * Pi / (SideCount * static_cast<double>(chain.sizes[0]) * chain.sizes[0]);
+    const double max_level = static_cast<double>(chain.levels.size() - 1);
+
+    std::vector<LobeSample> samples;
+    samples.reserve(sample_count);
+
+    double total_weight = 0.0;
+    for (unsigned i = 0; i < sample_count; ++i)
+    {
+        const double phi = 2.0 * Pi * (i + 0.5) / sample_count;
+        const double u = radical_inverse(i);
+        const double cos_theta = std::sqrt((1.0 - u) / (1.0 + (alpha_squared - 1.0) * u));
+        const double sin_theta = std::sqrt(1.0 - cos_theta * cos_theta);
+
+        // Reflect the axis about the half vector
+        const double n_dot_l = 2.0 * cos_theta * cos_theta - 1.0;
+        if (n_dot_l <= 0.0)
+        {
+            continue;
+        }
+
+        // Read samples from the level whose pixels cover about the solid
+        // angle of the sample, which suppresses the noise of bright
+        // details
+        const double d = cos_theta * cos_theta * (alpha_squared - 1.0) + 1.0;
+        const double distribution = alpha_squared / (Pi * d * d);
+        const double sample_solid_angle = 4.0 / (sample_count * distribution);
+        const double level = std::min(std::max(0.5 * std::log2(sample_solid_angle / texel_solid_angle) + 1.0, 0.0), max_level);
+
+        LobeSample sample;
+        sample.x = static_cast<float>(2.0 * cos_theta * sin_theta * std::cos(phi));
+        sample.y = static_cast<float>(2.0 * cos_theta * sin_theta * std::sin(phi));
+        sample.z = static_cast<float>(n_dot_l);
+        sample.weight = static_cast<float>(n_dot_l);
+        sample.level = static_cast<float>(level);
+        samples.push_back(sample);
+
+        total_weight += n_dot_l;
+    }
+
+    for (LobeSample& sample : samples)
+    {
+        sample.weight = static_cast<float>(sample.weight / total_weight);
+    }
+
+    return samples;
+}
+
+// Convolves the environment with a GGX lobe about the direction of a pixel
+void prefilter_pixel(const CubeChain& chain, const std::vector<LobeSample>& samples, const float* axis, float* result)
+{
+    // A tangent frame about the axis
+    float tangent[3];
+    if (std::abs(axis[2]) < 0.999f)
+    {
+        tangent[0] = -axis[1];
+        tangent[1] = axis[0];
+        tangent[2] = 0.0f;
+    }
+    else
+    {
+        tangent[0] = 0.0f;
+        tangent[1] = -axis[2];
+        tangent[2] = axis[1];
+    }
+    const float scale = 1.0f / std::sqrt(tangent[0] * tangent[0] + tangent[1] * tangent[1] + tangent[2] * tangent[2]);
+    for (float& component : tangent)
+    {
+        component *= scale;
+    }
+
+    const float bitangent[3] =
+    {
+        axis[1] * tangent[2] - axis[2] * tangent[1],
+        axis[2] * tangent[0] - axis[0] * tangent[2],
+        axis[0] * tangent[1] - axis[1] * tangent[0]
+    };
+
+    std::fill(result, result + 4, 0.0f);
+    for (const LobeSample& sample : samples)
+    {
+        float direction[3];
+        for (unsigned c = 0; c < 3; ++c)
+        {
+            direction[c] = tangent[c] * sample.x + bitangent[c] * sample.y + axis[c] * sample.z;
+        }
+        accumulate_environment(chain, direction, sample.level, sample.weight, result);
+    }
+}
+
+}
+
+LightProbeConvolver::LightProbeConvolver()
+{
+}
+
+LightProbeConvolver::LightProbeConvolver(TaskPool& task_pool) :
+    _task_pool(&task_pool)
+{
+}
+
+unsigned LightProbeConvolver::sample_count() const
+{
+    return _sample_count;
+}
+
+void LightProbeConvolver::set_sample_count(unsigned sample_count)
+{
+    if (sample_count == 0)
+    {
+        throw InvalidOperation("Sample count must be greater than zero");
+    }
+    _sample_count = sample_count;
+}
+
+SphericalHarmonics LightProbeConvolver::project_irradiance(TextureCube& texture) const
+{
+    ensure_supported(texture);
+
+    const CubeLevel pixels = convert_to_linear(_task_pool, texture);
+    const unsigned size = texture.image(CubeSide::PositiveX).width();
+
+    // Project each block separately and sum the blocks in order so that the
+    // result does not depend on the number of threads
+    const unsigned block_count = (size + RowsPerBlock - 1) / RowsPerBlock * SideCount;
+    std::vector<SphericalHarmonics> block_projections(block_count);
+    std::vector<double> block_solid_angles(block_count, 0.0);
+
+    for_each_block(_task_pool, size, [&](unsigned block, unsigned side, unsigned begin, unsigned end)
+    {
+        SphericalHarmonics& projection = block_projections[block];
+        double& total_solid_angle = block_solid_angles[block];
+        for (unsigned y = begin; y < end; ++y)
+        {
+            const float tc = 2.0f * (y + 0.5f) / size - 1.0f;
+            for (unsigned x = 0; x < size; ++x)
+            {
+                const float sc = 2.0f * (x + 0.5f) / size - 1.0f;
+
+                float direction[3];
+                side_direction(side, sc, tc, direction);
+
+                const float* pixel = &pixels[side][(static_cast<size_t>(y) * size + x) * 4];
+                const double solid_angle = pixel_solid_angle(x, y, size);
+                projection.add_sample(Vector3(direction[0], direction[1], direction[2]).normalized(), Vector3(pixel[0], pixel[1], pixel[2]), solid_angle);
+                total_solid_angle += solid_angle;
+            }
+        }
+    });
+
+    SphericalHarmonics projection;
+    double total_solid_angle = 0.0;
+    for (unsigned block = 0; block < block_count; ++block)
+    {
+        projection += block_projections[block];
+        total_solid_angle += block_solid_angles[block];
+    }
+
+    // Correct for the error of the summed solid angles
+    projection *= 4.0 * Pi / total_solid_angle;
+    return projection.irradiance();
+}
+
+void LightProbeConvolver::prefilter_specular(TextureCube& texture) const
+{
+    ensure_supported(texture);
+
+    const CubeChain chain = build_chain(_task_pool, texture);
+    const size_t level_count = chain.levels.size();
+
+    std::array<Image*, SideCount> images;
+    for (unsigned side = 0; side < SideCount; ++side)
+    {
+        images[side] = &texture.image(static_cast<CubeSide>(side));
+        images[side]->clear_mipmaps();
+    }
+
+    for (size_t level = 1; level < level_count; ++level)
+    {
+        const unsigned size = chain.sizes[level];
+        const std::vector<LobeSample> samples = compute_lobe_samples(level_roughness(level, level_count), _sample_count, chain);
+
+        std::array<ByteVector, SideCount> pixel_data;
+        for (unsigned side = 0; side < SideCount; ++side)
+        {
+            pixel_data[side].resize(images[side]->pixel_format().image_size(size, size));
+        }
+
+        for_each_block(_task_pool, size, [&](unsigned, unsigned side, unsigned begin, unsigned end)
+        {
+            const Image& image = *images[side];
+            const PixelFormat& pixel_format = image.pixel_format();
+
+            PixelBuffer row(static_cast<size_t>(size) * 4);
+            for (unsigned y = begin; y < end; ++y)
+            {
+                const float tc = 2.0f * (y + 0.5f) / size - 1.0f;
+                for (unsigned x = 0; x < size; ++x)
+                {
+                    const float sc = 2.0f * (x + 0.5f) / size - 1.0f;
+
+                    float axis[3];
+                    side_direction(side, sc, tc, axis);
+                    const float scale = 1.0f / std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+                    for (float& component : axis)
+                    {
+                        component *= scale;
+                    }
+
+                    prefilter_pixel(chain, samples, axis, &row[x * 4]);
+                }
+
+                uint8_t* data = pixel_data[side].data() + static_cast<size_t>(y) * size * pixel_format.size();
+                encode_pixels(row.data(), pixel_format, image.color_space(), data, size);
+            }
+        });
+
+        for (unsigned side = 0; side < SideCount; ++side)
+        {
+            Image mipmap(size, size, images[side]->pixel_format());
+            mipmap.set_color_space(images[side]->color_space());
+            mipmap.set_pixel_data(std::move(pixel_data[side]));
+            images[side]->add_mipmap(mipmap);
+        }
+    }
+
+    texture.set_mipmapped(true);
+}
+
+double LightProbeConvolver::level_roughness(size_t level, size_t level_count)
+{
+    if (level_count <= 1)
+    {
+        return 0.0;
+    }
+    return static_cast<double>(std::min(level, level_count - 1)) / (level_count - 1);
+}
+
+Vector3 LightProbeConvolver::direction(CubeSide side, Vector2 coords)
+{
+    float direction[3];
+    side_direction(static_cast<unsigned>(side), static_cast<float>(coords.x * 2.0 - 1.0), static_cast<float>(coords.y * 2.0 - 1.0), direction);
+    return Vector3(direction[0], direction[1], direction[2]).normalized();
+}
+
+void LightProbeConvolver::ensure_supported(TextureCube& texture) const
+{
+    for (unsigned side = 0; side < SideCount; ++side)
+    {
+        const Image& image = texture.image(static_cast<CubeSide>(side));
+        if (image.pixel_format().is_compressed())
+        {
+            throw InvalidOperation("Cannot convolve a block-compressed cube map");
+        }
+        else if (!image.has_pixel_data())
+        {
+            throw InvalidOperation("Cube map side has no pixel data");
+        }
+        else if (image.width() != image.height() || image.width() != texture.image(CubeSide::PositiveX).width() || image.width() == 0)
+        {
+            throw InvalidOperation("Cube map sides must be square and of equal size");
+        }
+    }
+}
@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Hect/Core/Export.h"
+#include "Hect/Graphics/CubeSide.h"
+#include "Hect/Graphics/SphericalHarmonics.h"
+#include "Hect/Graphics/TextureCube.h"
+#include "Hect/Math/Vector2.h"
+#include "Hect/Math/Vector3.h"
+
+namespace hect
+{
+
+class TaskPool;
+
+///
+/// Convolves the images of a cube map on the CPU into the diffuse and
+/// specular lighting of a light probe.
+///
+/// \note The sides of a cube map are expected to be oriented as rendered by
+/// PhysicallyBasedSceneRenderer::render_to_texture_cube(), following the
+/// OpenGL conventions with the first row of each image at the bottom.
+/// Pixels are convolved in linear space: the color components of images in
+/// ColorSpace::NonLinear are converted from sRGB before convolving.
+class HECT_EXPORT LightProbeConvolver
+{
+public:
+
+    ///
+    /// Constructs a light probe convolver which convolves on the calling
+    /// thread.
+    LightProbeConvolver();
+
+    ///
+    /// Constructs a light probe convolver which splits the sides of a cube
+    /// map into blocks of rows across the worker threads of a task pool.
+    ///
+    /// \note The convolver waits on the tasks it enqueues, so it must not be
+    /// used from within a task of the same pool.
+    ///
+    /// \param task_pool The task pool.
+    LightProbeConvolver(TaskPool& task_pool);
+
+    ///
+    /// Returns the number of samples of the environment taken for each
+    /// pixel of a prefiltered specular level.
+    unsigned sample_count() const;
+
+    ///
+    /// Sets the number of samples of the environment taken for each pixel
+    /// of a prefiltered specular level.
+    ///
+    /// \param sample_count The new sample count.
+    ///
+    /// \throws InvalidOperation If the sample count is zero.
+    void set_sample_count(unsigned sample_count);
+
+    ///
+    /// Projects the irradiance of the environment of a cube map onto
+    /// spherical harmonics.
+    ///
+    /// \note The radiance of a Lambertian surface with a normal is its
+    /// albedo times the evaluated irradiance divided by pi.
+    ///
+    /// \param texture The cube map.
+    ///
+    /// \throws InvalidOperation If the sides of the cube map are not
+    /// square, lack pixel data, or have block-compressed pixels.
+    SphericalHarmonics project_irradiance(TextureCube& texture) const;
+
+    ///
+    /// Replaces the mipmap levels of the sides of a cube map with the
+    /// environment prefiltered by a GGX lobe of increasing roughness.
+    ///
+    /// \note The roughness of each level is given by level_roughness(); the
+    /// first level is left as it is, as a perfect mirror.  Each pixel is
+    /// sampled by importance, reading from a box-filtered chain of the
+    /// environment whose level depends on the density of each sample.  The
+    /// cube map is marked as mipmapped.
+    ///
+    /// \param texture The cube map.
+    ///
+    /// \throws InvalidOperation If the cube map is unsupported (see
+    /// project_irradiance()).
+    void prefilter_specular(TextureCube& texture) const;
+
+    ///
+    /// Returns the roughness that a mipmap level of a prefiltered cube map
+    /// is filtered with.
+    ///
+    /// \param level The level.
+    /// \param level_count The number of levels, including the first.
+    static double level_roughness(size_t level, size_t level_count);
+
+    ///
+    /// Returns the unit direction through a point on a side of a cube map.
+    ///
+    /// \param side The side.
+    /// \param coords The UV coordinates on the side.
+    static Vector3 direction(CubeSide side, Vector2 coords);
+
+private:
+    void ensure_supported(TextureCube& texture) const;
+
+    TaskPool* _task_pool { nullptr };
+    unsigned _sample_count { 128 };
+};
+
+}
@@ -89,11 +89,47 @@ void Material::set_uniform_value(Name name, const UniformValue& value)
 
     // Set the value
     _uniform_values[index] = value;
+    _uniform_blocks_modified = true;
 }
 
 void Material::clear_uniform_values()
 {
     _uniform_values.clear();
+    _uniform_blocks_modified = true;
+}
+
+void Material::update_uniform_blocks()
+{
+    if (!_shader)
+    {
+        throw InvalidOperation("Material does not have a shader set");
+    }
+
+    if (_uniform_blocks_modified)
+    {
+        build_uniform_blocks();
+    }
+}
+
+UniformBlock& Material::uniform_block(UniformBlockIndex index)
+{
+    if (!_shader)
+    {
+        throw InvalidOperation("Material does not have a shader set");
+    }
+
+    const std::vector<UniformBlockLayout>& layouts = _shader->uniform_blocks();
+    if (index >= layouts.size() || layouts[index].is_bound())
+    {
+        throw InvalidOperation(format("Shader '%s' does not have an unbound uniform block at index %d", _shader->name().data(), static_cast<int>(index)));
+    }
+
+    if (_uniform_blocks_modified)
+    {
+        throw InvalidOperation(format("Uniform blocks of material '%s' are out of date", name().data()));
+    }
+
+    return _uniform_blocks[index];
 }
 
 CullMode Material::cull_mode() const
@@ -245,4 +281,70 @@ void Material::decode(Decoder& decoder)
         }
         decoder >> end_array();
     }
+
+    _uniform_blocks_modified = true;
+}
+
+void Material::build_uniform_blocks()
+{
+    const Shader& shader = *_shader;
+    const std::vector<UniformBlockLayout>& layouts = shader.uniform_blocks();
+
+    // The uploaded data of a block refers to the block so the blocks must be
+    // destroyed before they can be moved
+    if (_uniform_blocks.size() != layouts.size())
+    {
+        for (UniformBlock& block : _uniform_blocks)
+        {
+            if (block.is_uploaded())
+            {
+                block.renderer().destroy_uniform_block(block);
+            }
+        }
+
+        _uniform_blocks.clear();
+        _uniform_blocks.resize(layouts.size());
+    }
+
+    for (const UniformBlockLayout& layout : layouts)
+    {
+        if (layout.is_bound())
+        {
+            continue;
+        }
+
+        // Keep the existing block when possible so that it stays uploaded
+        // and is only updated with the changed values
+        UniformBlock& block = _uniform_blocks[layout.index()];
+        if (block.size() != layout.size())
+        {
+            if (block.is_uploaded())
+            {
+                block.renderer().destroy_uniform_block(block);
+            }
+
+            block = UniformBlock(layout);
+        }
+
+        // Write each value of the material, falling back to the default
+        // value of the uniform
+        for (UniformIndex uniform_index : layout.uniform_indices())
+        {
+            const Uniform& uniform = shader.uniform(uniform_index);
+
+            UniformValue value(uniform.type());
+            if (uniform_index < _uniform_values.size() && _uniform_values[uniform_index])
+            {
+                value = _uniform_values[uniform_index];
+            }
+            else if (uniform.value())
+            {
+                value = uniform.value();
+            }
+
+            block.set_value(uniform, value);
+        }
+    }
+
+    _uniform_blocks_modified = false;
 }
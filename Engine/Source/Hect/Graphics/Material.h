@@ -26,6 +26,7 @@
 #include "Hect/Core/Export.h"
 #include "Hect/IO/Asset.h"
 #include "Hect/Graphics/Shader.h"
+#include "Hect/Graphics/UniformBlock.h"
 
 namespace hect
 {
@@ -67,6 +68,9 @@ public:
 
     ///
     /// Returns the values for the shader's uniforms.
+    ///
+    /// \note Values changed through the sequence are not written to the
+    /// uniform blocks of the material; use set_uniform_value() instead.
     UniformValueSequence uniform_values();
 
     ///
@@ -88,6 +92,30 @@ public:
     /// Clears all set uniform values.
     void clear_uniform_values();
 
+    ///
+    /// Rebuilds the uniform blocks of the material if its shader or uniform
+    /// values have changed since they were last built.
+    ///
+    /// \note An unchanged material keeps its blocks, so it is only uploaded
+    /// once.
+    ///
+    /// \throws InvalidOperation If no shader is set.
+    void update_uniform_blocks();
+
+    ///
+    /// Returns the uniform block holding the material's values for an
+    /// unbound uniform block of the shader.
+    ///
+    /// \note The block is never rebuilt here, so it may be accessed from
+    /// multiple threads once update_uniform_blocks() has been called.
+    ///
+    /// \param index The index of the uniform block within the shader.
+    ///
+    /// \throws InvalidOperation If no shader is set, the shader does not
+    /// have an unbound uniform block at the specified index, or the blocks
+    /// are out of date.
+    UniformBlock& uniform_block(UniformBlockIndex index);
+
     ///
     /// Returns the cull mode used for surfaces using this material.
     CullMode cull_mode() const;
@@ -118,8 +146,13 @@ public:
     void decode(Decoder& decoder) override;
 
 private:
+    void build_uniform_blocks();
+
     AssetHandle<Shader> _shader;
     UniformValueContainer _uniform_values;
+
+    std::vector<UniformBlock> _uniform_blocks;
+    bool _uniform_blocks_modified { true };
     CullMode _cull_mode { CullMode::CounterClockwise };
 };
 
@@ -23,13 +23,30 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Mesh.h"
 
+#include <cstring>
+
 #include "Hect/Core/Exception.h"
+#include "Hect/Core/Format.h"
 #include "Hect/Graphics/MeshReader.h"
 #include "Hect/Graphics/MeshWriter.h"
 #include "Hect/Graphics/Renderer.h"
 
 using namespace hect;
 
+namespace
+{
+
+// The signature at the beginning of binary mesh data followed by the version
+// of the format; meshes encoded before the signature was added have neither
+const uint8_t BinaryMeshSignature[4] = { 'H', 'M', 'S', 'H' };
+
+// The version of the binary mesh format
+//
+// 1: Added the simplification error and levels of detail
+const uint32_t BinaryMeshVersion = 1;
+
+}
+
 Mesh::Descriptor::Descriptor()
 {
 }
@@ -248,6 +265,26 @@ size_t Mesh::vertex_count() const
     return _vertex_count;
 }
 
+void Mesh::copy_attribute_data(VertexAttributeSemantic semantic, std::vector<Vector3>& values) const
+{
+    values.resize(_vertex_count);
+
+    if (has_attribute_view<FloatVector3>(semantic))
+    {
+        attribute_view<FloatVector3>(semantic).convert_to(values.data());
+    }
+    else
+    {
+        // Fall back to converting each component of each vertex
+        MeshReader mesh_reader(*this);
+        for (Vector3& value : values)
+        {
+            mesh_reader.next_vertex();
+            value = mesh_reader.read_attribute_vector3(semantic);
+        }
+    }
+}
+
 const Mesh::IndexData& Mesh::index_data() const
 {
     return _index_data;
@@ -280,6 +317,24 @@ size_t Mesh::index_count() const
     return _index_count;
 }
 
+void Mesh::copy_index_data(std::vector<uint32_t>& indices) const
+{
+    indices.resize(_index_count);
+
+    switch (_index_type)
+    {
+    case IndexType::UInt8:
+        index_view<uint8_t>().convert_to(indices.data());
+        break;
+    case IndexType::UInt16:
+        index_view<uint16_t>().convert_to(indices.data());
+        break;
+    case IndexType::UInt32:
+        index_view<uint32_t>().copy_to(indices.data());
+        break;
+    }
+}
+
 unsigned Mesh::index_size() const
 {
     switch (_index_type)
@@ -304,6 +359,95 @@ const AxisAlignedBox& Mesh::axis_aligned_box() const
     return _axis_aligned_box;
 }
 
+bool Mesh::has_quantized_positions() const
+{
+    if (_vertex_layout.has_attribute_with_semantic(VertexAttributeSemantic::Position))
+    {
+        VertexAttributeType type = _vertex_layout.attribute_with_semantic(VertexAttributeSemantic::Position).type();
+        return type == VertexAttributeType::NormalizedInt16 || type == VertexAttributeType::NormalizedUInt16;
+    }
+
+    return false;
+}
+
+Vector3 Mesh::dequantization_offset() const
+{
+    return _dequantization_offset;
+}
+
+double Mesh::dequantization_scale() const
+{
+    return _dequantization_scale;
+}
+
+void Mesh::set_dequantization(Vector3 offset, double scale)
+{
+    if (_vertex_data.size() != 0)
+    {
+        throw InvalidOperation("Cannot change the dequantization of a mesh with vertex data");
+    }
+
+    _dequantization_offset = offset;
+    _dequantization_scale = scale;
+}
+
+Matrix4 Mesh::dequantization_matrix() const
+{
+    return Matrix4::from_translation(_dequantization_offset) * Matrix4::from_scale(Vector3(_dequantization_scale));
+}
+
+size_t Mesh::level_of_detail_count() const
+{
+    return _levels_of_detail.size() + 1;
+}
+
+Mesh& Mesh::level_of_detail(size_t level)
+{
+    const Mesh& mesh = *this;
+    return const_cast<Mesh&>(mesh.level_of_detail(level));
+}
+
+const Mesh& Mesh::level_of_detail(size_t level) const
+{
+    if (level == 0)
+    {
+        return *this;
+    }
+    else if (level > _levels_of_detail.size())
+    {
+        throw InvalidOperation(format("Mesh does not have level of detail %u", static_cast<unsigned>(level)));
+    }
+
+    return _levels_of_detail[level - 1];
+}
+
+void Mesh::add_level_of_detail(const Mesh& mesh)
+{
+    _levels_of_detail.push_back(mesh);
+    _levels_of_detail.back().clear_levels_of_detail();
+}
+
+void Mesh::clear_levels_of_detail()
+{
+    _levels_of_detail.clear();
+}
+
+double Mesh::simplification_error() const
+{
+    return _simplification_error;
+}
+
+void Mesh::set_simplification_error(double error)
+{
+    _simplification_error = error;
+}
+
+MeshOptimizer::Metrics Mesh::optimize()
+{
+    MeshOptimizer optimizer;
+    return optimizer.optimize(*this);
+}
+
 bool Mesh::operator==(const Mesh& mesh) const
 {
     // Vertex layout
@@ -318,6 +462,12 @@ bool Mesh::operator==(const Mesh& mesh) const
         return false;
     }
 
+    // Dequantization
+    if (_dequantization_offset != mesh._dequantization_offset || _dequantization_scale != mesh._dequantization_scale)
+    {
+        return false;
+    }
+
     // Vertex/index counts
     if (_vertex_count != mesh._vertex_count || _index_count != mesh._index_count)
     {
@@ -342,6 +492,12 @@ bool Mesh::operator==(const Mesh& mesh) const
         }
     }
 
+    // Levels of detail
+    if (_simplification_error != mesh._simplification_error || _levels_of_detail != mesh._levels_of_detail)
+    {
+        return false;
+    }
+
     return true;
 }
 
@@ -352,10 +508,25 @@ bool Mesh::operator!=(const Mesh& mesh) const
 
 void Mesh::encode(Encoder& encoder) const
 {
+    if (encoder.is_binary_stream())
+    {
+        WriteStream& stream = encoder.binary_stream();
+        stream.write(BinaryMeshSignature, sizeof(BinaryMeshSignature));
+        stream << BinaryMeshVersion;
+    }
+
     encoder << encode_value("vertex_layout", _vertex_layout)
             << encode_enum("index_type", _index_type)
             << encode_enum("primitive_type", _primitive_type);
 
+    // Only meshes with quantized positions have a dequantization transform
+    // so that the format of other meshes is unchanged
+    if (has_quantized_positions())
+    {
+        encoder << encode_value("dequantization_offset", _dequantization_offset)
+                << encode_value("dequantization_scale", _dequantization_scale);
+    }
+
     if (encoder.is_binary_stream())
     {
         WriteStream& stream = encoder.binary_stream();
@@ -375,6 +546,14 @@ void Mesh::encode(Encoder& encoder) const
         {
             stream.write(&_index_data[0], index_data_size);
         }
+
+        // Levels of detail
+        stream << _simplification_error;
+        stream << static_cast<uint32_t>(_levels_of_detail.size());
+        for (const Mesh& level_of_detail : _levels_of_detail)
+        {
+            level_of_detail.encode(encoder);
+        }
     }
     else
     {
@@ -431,6 +610,24 @@ void Mesh::encode(Encoder& encoder) const
             encoder << encode_value(reader.read_index_uint32());
         }
         encoder << end_array();
+
+        // Levels of detail
+        if (!_levels_of_detail.empty())
+        {
+            encoder << begin_array("levels_of_detail");
+            for (const Mesh& level_of_detail : _levels_of_detail)
+            {
+                encoder << begin_object();
+                level_of_detail.encode(encoder);
+                encoder << end_object();
+            }
+            encoder << end_array();
+        }
+
+        if (_simplification_error != 0.0)
+        {
+            encoder << encode_value("simplification_error", _simplification_error);
+        }
     }
 }
 
@@ -439,10 +636,42 @@ void Mesh::decode(Decoder& decoder)
     // Clear any data the mesh already had
     *this = Mesh(name());
 
+    // Binary meshes without a signature predate the versioned format; the
+    // first bytes of such a mesh are the attribute count of its vertex layout
+    uint32_t version = 0;
+    if (decoder.is_binary_stream())
+    {
+        ReadStream& stream = decoder.binary_stream();
+        const size_t position = stream.position();
+        if (stream.length() - position >= sizeof(BinaryMeshSignature))
+        {
+            uint8_t signature[sizeof(BinaryMeshSignature)];
+            stream.read(signature, sizeof(signature));
+            if (std::memcmp(signature, BinaryMeshSignature, sizeof(signature)) == 0)
+            {
+                stream >> version;
+                if (version == 0 || version > BinaryMeshVersion)
+                {
+                    throw DecodeError(format("Unsupported binary mesh version %u", version));
+                }
+            }
+            else
+            {
+                stream.seek(position);
+            }
+        }
+    }
+
     decoder >> decode_value("vertex_layout", _vertex_layout)
             >> decode_enum("index_type", _index_type)
             >> decode_enum("primitive_type", _primitive_type);
 
+    if (has_quantized_positions())
+    {
+        decoder >> decode_value("dequantization_offset", _dequantization_offset, true)
+                >> decode_value("dequantization_scale", _dequantization_scale, true);
+    }
+
     // Vertex and index data
     if (decoder.is_binary_stream())
     {
@@ -471,12 +700,25 @@ void Mesh::decode(Decoder& decoder)
         set_index_data(index_data);
 
         // Compute the bounding box based on the vertex positions
-        MeshReader mesh_reader(*this);
-        while (mesh_reader.next_vertex())
+        std::vector<Vector3> positions;
+        copy_attribute_data(VertexAttributeSemantic::Position, positions);
+        for (Vector3 position : positions)
         {
-            Vector3 position = mesh_reader.read_attribute_vector3(VertexAttributeSemantic::Position);
             _axis_aligned_box.expand_to_include(position);
         }
+
+        // Levels of detail
+        if (version >= 1)
+        {
+            uint32_t level_of_detail_count;
+            stream >> _simplification_error >> level_of_detail_count;
+            for (uint32_t i = 0; i < level_of_detail_count; ++i)
+            {
+                Mesh level_of_detail(name());
+                level_of_detail.decode(decoder);
+                _levels_of_detail.push_back(std::move(level_of_detail));
+            }
+        }
     }
     else
     {
@@ -558,5 +800,22 @@ void Mesh::decode(Decoder& decoder)
             }
             decoder >> end_array();
         }
+
+        // Levels of detail
+        if (decoder.select_member("levels_of_detail"))
+        {
+            decoder >> begin_array();
+            while (decoder.has_more_elements())
+            {
+                Mesh level_of_detail(name());
+                decoder >> begin_object();
+                level_of_detail.decode(decoder);
+                decoder >> end_object();
+                _levels_of_detail.push_back(std::move(level_of_detail));
+            }
+            decoder >> end_array();
+        }
+
+        decoder >> decode_value("simplification_error", _simplification_error);
     }
 }
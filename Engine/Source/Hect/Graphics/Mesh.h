@@ -23,14 +23,20 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <vector>
+
 #include "Hect/Core/Export.h"
+#include "Hect/Core/StridedView.h"
 #include "Hect/Graphics/IndexType.h"
+#include "Hect/Graphics/MeshOptimizer.h"
 #include "Hect/Graphics/PrimitiveType.h"
 #include "Hect/Graphics/Renderer.h"
+#include "Hect/Graphics/VertexAttributeTraits.h"
 #include "Hect/Graphics/VertexLayout.h"
 #include "Hect/IO/Asset.h"
 #include "Hect/IO/ByteVector.h"
 #include "Hect/Math/AxisAlignedBox.h"
+#include "Hect/Math/Matrix4.h"
 
 namespace hect
 {
@@ -171,6 +177,37 @@ public:
     /// Returns the number of vertices.
     size_t vertex_count() const;
 
+    ///
+    /// Returns a view of the values of a vertex attribute across all
+    /// vertices.
+    ///
+    /// \param semantic The semantic of the attribute.
+    ///
+    /// \throws InvalidOperation If the vertex layout does not have an
+    /// attribute with the semantic or if the attribute is not stored as
+    /// the type of the view.
+    template <typename Type>
+    StridedView<Type> attribute_view(VertexAttributeSemantic semantic) const;
+
+    ///
+    /// Returns whether the vertex layout has an attribute with the given
+    /// semantic stored as the given type.
+    ///
+    /// \param semantic The semantic of the attribute.
+    template <typename Type>
+    bool has_attribute_view(VertexAttributeSemantic semantic) const;
+
+    ///
+    /// Copies the values of a vertex attribute across all vertices into a
+    /// vector, converting from the type the attribute is stored as.
+    ///
+    /// \note Vertices are read as zero if the vertex layout does not have
+    /// an attribute with the semantic, matching MeshReader.
+    ///
+    /// \param semantic The semantic of the attribute.
+    /// \param values The vector to store the values in.
+    void copy_attribute_data(VertexAttributeSemantic semantic, std::vector<Vector3>& values) const;
+
     ///
     /// Returns the raw index data.
     const IndexData& index_data() const;
@@ -197,6 +234,20 @@ public:
     /// Returns the size of an index in bytes.
     unsigned index_size() const;
 
+    ///
+    /// Returns a view of the indices.
+    ///
+    /// \throws InvalidOperation If the index type does not match the type
+    /// of the view.
+    template <typename Type>
+    StridedView<Type> index_view() const;
+
+    ///
+    /// Copies all indices into a vector, widening from the index type.
+    ///
+    /// \param indices The vector to store the indices in.
+    void copy_index_data(std::vector<uint32_t>& indices) const;
+
     ///
     /// Returns an axis aligned box bounding the mesh.
     AxisAlignedBox& axis_aligned_box();
@@ -205,6 +256,84 @@ public:
     /// Returns an axis aligned box bounding the mesh.
     const AxisAlignedBox& axis_aligned_box() const;
 
+    ///
+    /// Returns whether the positions of the mesh are stored as normalized
+    /// integers which are mapped to model space by the dequantization
+    /// transform.
+    bool has_quantized_positions() const;
+
+    ///
+    /// Returns the translation of the dequantization transform.
+    Vector3 dequantization_offset() const;
+
+    ///
+    /// Returns the uniform scale of the dequantization transform.
+    double dequantization_scale() const;
+
+    ///
+    /// Sets the transform mapping quantized positions to model space.
+    ///
+    /// \note The scale is uniform so that the transform can be applied
+    /// through the model matrix without distorting normals.
+    ///
+    /// \param offset The translation.
+    /// \param scale The uniform scale.
+    ///
+    /// \throws InvalidOperation If the mesh has vertex data.
+    void set_dequantization(Vector3 offset, double scale);
+
+    ///
+    /// Returns the dequantization transform as a matrix.
+    Matrix4 dequantization_matrix() const;
+
+    ///
+    /// Returns the number of levels of detail, including the mesh itself.
+    size_t level_of_detail_count() const;
+
+    ///
+    /// Returns a level of detail of the mesh.
+    ///
+    /// \param level The level; zero is the mesh itself and each following
+    /// level is simpler than the last.
+    ///
+    /// \throws InvalidOperation If the mesh does not have the level.
+    Mesh& level_of_detail(size_t level);
+
+    ///
+    /// \copydoc hect::Mesh::level_of_detail()
+    const Mesh& level_of_detail(size_t level) const;
+
+    ///
+    /// Adds a simplified version of the mesh as the next level of detail.
+    ///
+    /// \note Any levels of detail of the simplified mesh are discarded.
+    ///
+    /// \param mesh The simplified mesh; must be simpler than the last level.
+    void add_level_of_detail(const Mesh& mesh);
+
+    ///
+    /// Removes all levels of detail except the mesh itself.
+    void clear_levels_of_detail();
+
+    ///
+    /// Returns the largest distance the surface of the mesh deviates from
+    /// the mesh it was simplified from, relative to the radius of the
+    /// bounding box of that mesh.
+    double simplification_error() const;
+
+    ///
+    /// Sets the simplification error.
+    ///
+    /// \param error The error.
+    void set_simplification_error(double error);
+
+    ///
+    /// Welds duplicate vertices and reorders the triangles and vertices of
+    /// the mesh for efficient rendering.
+    ///
+    /// \returns The measurements of the mesh before and after optimizing.
+    MeshOptimizer::Metrics optimize();
+
     ///
     /// Returns whether the mesh is equivalent to another.
     ///
@@ -236,6 +365,14 @@ private:
     size_t _index_count { 0 };
 
     AxisAlignedBox _axis_aligned_box;
+
+    Vector3 _dequantization_offset;
+    double _dequantization_scale { 1 };
+
+    std::vector<Mesh> _levels_of_detail;
+    double _simplification_error { 0 };
 };
 
 }
+
+#include "Mesh.inl"
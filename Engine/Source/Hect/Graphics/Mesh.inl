@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect/Core/Exception.h"
+#include "Hect/Core/Format.h"
+#include "Hect/Reflection/Enum.h"
+
+namespace hect
+{
+
+template <typename Type>
+StridedView<Type> Mesh::attribute_view(VertexAttributeSemantic semantic) const
+{
+    const VertexAttribute& attribute = _vertex_layout.attribute_with_semantic(semantic);
+    if (attribute.type() != VertexAttributeTraits<Type>::type || attribute.cardinality() != VertexAttributeTraits<Type>::cardinality)
+    {
+        throw InvalidOperation(format("Vertex attribute with semantic '%s' is not stored as the type of the view", Enum::to_string(semantic).data()));
+    }
+
+    const uint8_t* data = _vertex_data.empty() ? nullptr : &_vertex_data[0] + attribute.offset();
+    return StridedView<Type>(data, _vertex_layout.vertex_size(), _vertex_count);
+}
+
+template <typename Type>
+bool Mesh::has_attribute_view(VertexAttributeSemantic semantic) const
+{
+    if (!_vertex_layout.has_attribute_with_semantic(semantic))
+    {
+        return false;
+    }
+
+    const VertexAttribute& attribute = _vertex_layout.attribute_with_semantic(semantic);
+    return attribute.type() == VertexAttributeTraits<Type>::type && attribute.cardinality() == VertexAttributeTraits<Type>::cardinality;
+}
+
+template <typename Type>
+StridedView<Type> Mesh::index_view() const
+{
+    if (sizeof(Type) != index_size())
+    {
+        throw InvalidOperation("Index type of mesh does not match the type of the view");
+    }
+
+    const uint8_t* data = _index_data.empty() ? nullptr : &_index_data[0];
+    return StridedView<Type>(data, sizeof(Type), _index_count);
+}
+
+}
@@ -0,0 +1,1076 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+#include "Hect/Graphics/Mesh.h"
+#include "Hect/Graphics/MeshReader.h"
+#include "Hect/Graphics/MeshWriter.h"
+
+using namespace hect;
+
+namespace
+{
+
+// The number of entries in the LRU cache simulated when ordering triangles
+const size_t OrderingCacheSize = 32;
+
+// Hashes the data of a vertex given its index
+class VertexHash
+{
+public:
+    VertexHash(const uint8_t* data, size_t vertex_size) :
+        _data(data),
+        _vertex_size(vertex_size)
+    {
+    }
+
+    size_t operator()(uint32_t index) const
+    {
+        // FNV-1a
+        const uint8_t* vertex = _data + index * _vertex_size;
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < _vertex_size; ++i)
+        {
+            hash = (hash ^ vertex[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+private:
+    const uint8_t* _data;
+    size_t _vertex_size;
+};
+
+// Compares the data of two vertices given their indices
+class VertexEqual
+{
+public:
+    VertexEqual(const uint8_t* data, size_t vertex_size) :
+        _data(data),
+        _vertex_size(vertex_size)
+    {
+    }
+
+    bool operator()(uint32_t a, uint32_t b) const
+    {
+        return std::memcmp(_data + a * _vertex_size, _data + b * _vertex_size, _vertex_size) == 0;
+    }
+
+private:
+    const uint8_t* _data;
+    size_t _vertex_size;
+};
+
+// The score of a vertex for the linear-speed vertex cache optimization
+// described by Tom Forsyth
+float vertex_score(int cache_position, size_t remaining_triangles)
+{
+    if (remaining_triangles == 0)
+    {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cache_position >= 0)
+    {
+        if (cache_position < 3)
+        {
+            // The vertices of the most recent triangle are scored equally
+            // to discourage strips
+            score = 0.75f;
+        }
+        else
+        {
+            const float scale = 1.0f / (OrderingCacheSize - 3);
+            score = std::pow(1.0f - (cache_position - 3) * scale, 1.5f);
+        }
+    }
+
+    // Prefer vertices with few remaining triangles to avoid leaving
+    // isolated triangles behind
+    score += 2.0f / std::sqrt(static_cast<float>(remaining_triangles));
+    return score;
+}
+
+// The number of triangles below which no further level of detail is
+// generated
+const size_t MinLevelOfDetailTriangleCount = 8;
+
+// The sum of squared distances to a set of planes
+class Quadric
+{
+public:
+    Quadric()
+    {
+    }
+
+    Quadric(Vector3 normal, double distance) :
+        _xx(normal.x * normal.x), _xy(normal.x * normal.y), _xz(normal.x * normal.z), _xw(normal.x * distance),
+        _yy(normal.y * normal.y), _yz(normal.y * normal.z), _yw(normal.y * distance),
+        _zz(normal.z * normal.z), _zw(normal.z * distance),
+        _ww(distance * distance)
+    {
+    }
+
+    double error(Vector3 p) const
+    {
+        const double error =
+            p.x * (_xx * p.x + 2.0 * (_xy * p.y + _xz * p.z + _xw)) +
+            p.y * (_yy * p.y + 2.0 * (_yz * p.z + _yw)) +
+            p.z * (_zz * p.z + 2.0 * _zw) +
+            _ww;
+        return std::max(0.0, error);
+    }
+
+    Quadric& operator+=(const Quadric& quadric)
+    {
+        _xx += quadric._xx;
+        _xy += quadric._xy;
+        _xz += quadric._xz;
+        _xw += quadric._xw;
+        _yy += quadric._yy;
+        _yz += quadric._yz;
+        _yw += quadric._yw;
+        _zz += quadric._zz;
+        _zw += quadric._zw;
+        _ww += quadric._ww;
+        return *this;
+    }
+
+private:
+    double _xx { 0 }, _xy { 0 }, _xz { 0 }, _xw { 0 };
+    double _yy { 0 }, _yz { 0 }, _yw { 0 };
+    double _zz { 0 }, _zw { 0 };
+    double _ww { 0 };
+};
+
+// A candidate collapse of one vertex onto another
+class Collapse
+{
+public:
+    double cost { 0 };
+    uint32_t from { 0 };
+    uint32_t to { 0 };
+
+    bool operator<(const Collapse& collapse) const
+    {
+        return cost < collapse.cost;
+    }
+};
+
+uint64_t edge_key(uint32_t a, uint32_t b)
+{
+    return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+}
+
+// Returns the compact equivalent of a vertex attribute
+VertexAttribute quantized_attribute(const VertexAttribute& attribute)
+{
+    const VertexAttributeSemantic semantic = attribute.semantic();
+    const unsigned cardinality = attribute.cardinality();
+    if (attribute.type() != VertexAttributeType::Float32)
+    {
+        return attribute;
+    }
+
+    switch (semantic)
+    {
+    case VertexAttributeSemantic::Position:
+        if (cardinality == 3)
+        {
+            return VertexAttribute(semantic, VertexAttributeType::NormalizedInt16, 4);
+        }
+        break;
+    case VertexAttributeSemantic::Normal:
+    case VertexAttributeSemantic::Tangent:
+    case VertexAttributeSemantic::Binormal:
+        if (cardinality == 3)
+        {
+            return VertexAttribute(semantic, VertexAttributeType::OctahedralInt16, 3);
+        }
+        break;
+    case VertexAttributeSemantic::TextureCoords0:
+    case VertexAttributeSemantic::TextureCoords1:
+    case VertexAttributeSemantic::TextureCoords2:
+    case VertexAttributeSemantic::TextureCoords3:
+        if (cardinality == 2 || cardinality == 4)
+        {
+            return VertexAttribute(semantic, VertexAttributeType::Float16, cardinality);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return attribute;
+}
+
+}
+
+double MeshOptimizer::compute_acmr(const Mesh& mesh, size_t cache_size)
+{
+    if (mesh.primitive_type() != PrimitiveType::Triangles)
+    {
+        return 0.0;
+    }
+
+    return compute_acmr(read_indices(mesh), mesh.vertex_count(), cache_size);
+}
+
+MeshOptimizer::Metrics MeshOptimizer::optimize(Mesh& mesh) const
+{
+    Metrics metrics;
+    metrics.vertex_count_before = mesh.vertex_count();
+    metrics.acmr_before = compute_acmr(mesh);
+
+    weld_vertices(mesh);
+    optimize_vertex_cache(mesh);
+    optimize_overdraw(mesh);
+    optimize_vertex_fetch(mesh);
+
+    metrics.vertex_count_after = mesh.vertex_count();
+    metrics.acmr_after = compute_acmr(mesh);
+    return metrics;
+}
+
+void MeshOptimizer::weld_vertices(Mesh& mesh) const
+{
+    const size_t vertex_count = mesh.vertex_count();
+    if (vertex_count == 0)
+    {
+        return;
+    }
+
+    const size_t vertex_size = mesh.vertex_layout().vertex_size();
+    const uint8_t* data = &mesh.vertex_data()[0];
+
+    // Map each vertex to the first vertex with identical data
+    std::unordered_map<uint32_t, uint32_t, VertexHash, VertexEqual> unique_vertices(vertex_count, VertexHash(data, vertex_size), VertexEqual(data, vertex_size));
+    std::vector<uint32_t> remap(vertex_count);
+    Mesh::VertexData vertex_data;
+    vertex_data.reserve(mesh.vertex_data().size());
+
+    for (uint32_t i = 0; i < vertex_count; ++i)
+    {
+        const uint32_t unique_index = static_cast<uint32_t>(unique_vertices.size());
+        auto result = unique_vertices.emplace(i, unique_index);
+        if (result.second)
+        {
+            const uint8_t* vertex = data + i * vertex_size;
+            vertex_data.insert(vertex_data.end(), vertex, vertex + vertex_size);
+        }
+        remap[i] = result.first->second;
+    }
+
+    std::vector<uint32_t> indices = read_indices(mesh);
+    for (uint32_t& index : indices)
+    {
+        index = remap[index];
+    }
+
+    mesh.set_vertex_data(vertex_data);
+    write_indices(mesh, indices);
+}
+
+void MeshOptimizer::optimize_vertex_cache(Mesh& mesh) const
+{
+    if (mesh.primitive_type() != PrimitiveType::Triangles)
+    {
+        return;
+    }
+
+    const std::vector<uint32_t> indices = read_indices(mesh);
+    const size_t triangle_count = indices.size() / 3;
+    const size_t vertex_count = mesh.vertex_count();
+    if (triangle_count == 0)
+    {
+        return;
+    }
+
+    // Build the triangles adjacent to each vertex
+    std::vector<size_t> remaining_triangles(vertex_count, 0);
+    for (size_t i = 0; i < triangle_count * 3; ++i)
+    {
+        ++remaining_triangles[indices[i]];
+    }
+
+    std::vector<size_t> adjacency_offsets(vertex_count + 1, 0);
+    std::partial_sum(remaining_triangles.begin(), remaining_triangles.end(), adjacency_offsets.begin() + 1);
+
+    std::vector<uint32_t> adjacency(triangle_count * 3);
+    std::vector<size_t> adjacency_fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+    for (size_t i = 0; i < triangle_count * 3; ++i)
+    {
+        adjacency[adjacency_fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    std::vector<int> cache_positions(vertex_count, -1);
+    std::vector<float> vertex_scores(vertex_count);
+    for (size_t i = 0; i < vertex_count; ++i)
+    {
+        vertex_scores[i] = vertex_score(-1, remaining_triangles[i]);
+    }
+
+    std::vector<float> triangle_scores(triangle_count);
+    for (size_t i = 0; i < triangle_count; ++i)
+    {
+        const uint32_t* triangle = &indices[i * 3];
+        triangle_scores[i] = vertex_scores[triangle[0]] + vertex_scores[triangle[1]] + vertex_scores[triangle[2]];
+    }
+
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> new_cache;
+    std::vector<uint32_t> ordered_indices;
+    ordered_indices.reserve(triangle_count * 3);
+
+    size_t next_unemitted = 0;
+    size_t best_triangle = std::max_element(triangle_scores.begin(), triangle_scores.end()) - triangle_scores.begin();
+
+    for (size_t emitted_count = 0; emitted_count < triangle_count; ++emitted_count)
+    {
+        // Emit the best triangle
+        const uint32_t* triangle = &indices[best_triangle * 3];
+        ordered_indices.insert(ordered_indices.end(), triangle, triangle + 3);
+        emitted[best_triangle] = true;
+
+        // Move its vertices to the front of the cache
+        new_cache.assign(triangle, triangle + 3);
+        for (uint32_t vertex : cache)
+        {
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+            {
+                new_cache.push_back(vertex);
+            }
+        }
+
+        // Remove the triangle from the adjacency of its vertices
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const uint32_t vertex = triangle[i];
+            uint32_t* begin = &adjacency[adjacency_offsets[vertex]];
+            uint32_t* end = begin + remaining_triangles[vertex];
+            uint32_t* it = std::find(begin, end, static_cast<uint32_t>(best_triangle));
+            if (it != end)
+            {
+                std::swap(*it, *(end - 1));
+                --remaining_triangles[vertex];
+            }
+        }
+
+        // Vertices pushed out of the cache lose their position
+        for (size_t i = 0; i < new_cache.size(); ++i)
+        {
+            cache_positions[new_cache[i]] = i < OrderingCacheSize ? static_cast<int>(i) : -1;
+        }
+
+        // Update the scores of the vertices in the cache and of their
+        // triangles, tracking the best triangle among them
+        float best_score = -1.0f;
+        best_triangle = triangle_count;
+        for (uint32_t vertex : new_cache)
+        {
+            const float score = vertex_score(cache_positions[vertex], remaining_triangles[vertex]);
+            const float delta = score - vertex_scores[vertex];
+            vertex_scores[vertex] = score;
+
+            const size_t offset = adjacency_offsets[vertex];
+            for (size_t j = 0; j < remaining_triangles[vertex]; ++j)
+            {
+                const uint32_t adjacent = adjacency[offset + j];
+                triangle_scores[adjacent] += delta;
+                if (triangle_scores[adjacent] > best_score)
+                {
+                    best_score = triangle_scores[adjacent];
+                    best_triangle = adjacent;
+                }
+            }
+        }
+
+        if (new_cache.size() > OrderingCacheSize)
+        {
+            new_cache.resize(OrderingCacheSize);
+        }
+        cache.swap(new_cache);
+
+        // If no triangle in the cache is available then continue with the
+        // next triangle in the original order
+        if (best_triangle == triangle_count)
+        {
+            while (next_unemitted < triangle_count && emitted[next_unemitted])
+            {
+                ++next_unemitted;
+            }
+            best_triangle = next_unemitted;
+        }
+    }
+
+    write_indices(mesh, ordered_indices);
+}
+
+void MeshOptimizer::optimize_overdraw(Mesh& mesh, double threshold) const
+{
+    if (mesh.primitive_type() != PrimitiveType::Triangles)
+    {
+        return;
+    }
+
+    const std::vector<uint32_t> indices = read_indices(mesh);
+    const size_t triangle_count = indices.size() / 3;
+    const size_t vertex_count = mesh.vertex_count();
+    if (triangle_count == 0)
+    {
+        return;
+    }
+
+    std::vector<Vector3> positions;
+    mesh.copy_attribute_data(VertexAttributeSemantic::Position, positions);
+
+    // Split the triangles into clusters which begin wherever all vertices
+    // of a triangle miss the cache so that reordering the clusters keeps
+    // most of the cache locality
+    std::vector<size_t> cluster_begins;
+    std::vector<size_t> cache_timestamps(vertex_count, 0);
+    size_t timestamp = MeasuredCacheSize + 1;
+    for (size_t i = 0; i < triangle_count; ++i)
+    {
+        size_t misses = 0;
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const uint32_t vertex = indices[i * 3 + j];
+            if (timestamp - cache_timestamps[vertex] > MeasuredCacheSize)
+            {
+                cache_timestamps[vertex] = timestamp++;
+                ++misses;
+            }
+        }
+
+        if (i == 0 || misses == 3)
+        {
+            cluster_begins.push_back(i);
+        }
+    }
+
+    const size_t cluster_count = cluster_begins.size();
+    cluster_begins.push_back(triangle_count);
+
+    Vector3 mesh_centroid;
+    for (uint32_t index : indices)
+    {
+        mesh_centroid += positions[index];
+    }
+    mesh_centroid /= static_cast<double>(indices.size());
+
+    // Sort the clusters by how far they face away from the center of the
+    // mesh since those are the least likely to be occluded
+    std::vector<double> sort_keys(cluster_count, 0.0);
+    for (size_t i = 0; i < cluster_count; ++i)
+    {
+        Vector3 centroid;
+        Vector3 normal;
+        double total_area = 0.0;
+        for (size_t j = cluster_begins[i]; j < cluster_begins[i + 1]; ++j)
+        {
+            const Vector3 p0 = positions[indices[j * 3]];
+            const Vector3 p1 = positions[indices[j * 3 + 1]];
+            const Vector3 p2 = positions[indices[j * 3 + 2]];
+
+            const Vector3 cross = (p1 - p0).cross(p2 - p0);
+            const double area = cross.length();
+            centroid += (p0 + p1 + p2) * (area / 3.0);
+            normal += cross;
+            total_area += area;
+        }
+
+        if (total_area > 0.0 && normal.length() > 0.0)
+        {
+            centroid /= total_area;
+            sort_keys[i] = (centroid - mesh_centroid).dot(normal.normalized());
+        }
+    }
+
+    std::vector<size_t> cluster_order(cluster_count);
+    std::iota(cluster_order.begin(), cluster_order.end(), 0);
+    std::stable_sort(cluster_order.begin(), cluster_order.end(), [&](size_t a, size_t b)
+    {
+        return sort_keys[a] > sort_keys[b];
+    });
+
+    std::vector<uint32_t> ordered_indices;
+    ordered_indices.reserve(indices.size());
+    for (size_t cluster : cluster_order)
+    {
+        ordered_indices.insert(ordered_indices.end(), indices.begin() + cluster_begins[cluster] * 3, indices.begin() + cluster_begins[cluster + 1] * 3);
+    }
+
+    const double acmr = compute_acmr(indices, vertex_count, MeasuredCacheSize);
+    const double ordered_acmr = compute_acmr(ordered_indices, vertex_count, MeasuredCacheSize);
+    if (ordered_acmr <= acmr * threshold)
+    {
+        write_indices(mesh, ordered_indices);
+    }
+}
+
+void MeshOptimizer::optimize_vertex_fetch(Mesh& mesh) const
+{
+    const size_t vertex_count = mesh.vertex_count();
+    if (vertex_count == 0 || mesh.index_count() == 0)
+    {
+        return;
+    }
+
+    const size_t vertex_size = mesh.vertex_layout().vertex_size();
+    const uint8_t* data = &mesh.vertex_data()[0];
+
+    std::vector<uint32_t> indices = read_indices(mesh);
+    std::vector<uint32_t> remap(vertex_count, std::numeric_limits<uint32_t>::max());
+    Mesh::VertexData vertex_data;
+    vertex_data.reserve(mesh.vertex_data().size());
+
+    uint32_t next_index = 0;
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == std::numeric_limits<uint32_t>::max())
+        {
+            remap[index] = next_index++;
+            const uint8_t* vertex = data + index * vertex_size;
+            vertex_data.insert(vertex_data.end(), vertex, vertex + vertex_size);
+        }
+        index = remap[index];
+    }
+
+    mesh.set_vertex_data(vertex_data);
+    write_indices(mesh, indices);
+}
+
+void MeshOptimizer::quantize_vertices(Mesh& mesh) const
+{
+    const VertexLayout& vertex_layout = mesh.vertex_layout();
+
+    VertexLayout quantized_layout;
+    for (const VertexAttribute& attribute : vertex_layout.attributes())
+    {
+        quantized_layout.add_attribute(quantized_attribute(attribute));
+    }
+
+    if (quantized_layout == vertex_layout)
+    {
+        return;
+    }
+
+    Mesh::Descriptor descriptor;
+    descriptor.name = mesh.name();
+    descriptor.vertex_layout = quantized_layout;
+    descriptor.primitive_type = mesh.primitive_type();
+    descriptor.index_type = mesh.index_type();
+
+    Mesh quantized_mesh(descriptor);
+
+    // Map the bounds of the positions to the normalized range using a
+    // uniform scale
+    if (quantized_mesh.has_quantized_positions() && mesh.vertex_count() > 0)
+    {
+        std::vector<Vector3> positions;
+        mesh.copy_attribute_data(VertexAttributeSemantic::Position, positions);
+
+        AxisAlignedBox bounds;
+        for (Vector3 position : positions)
+        {
+            bounds.expand_to_include(position);
+        }
+
+        const Vector3 extents = (bounds.maximum() - bounds.minimum()) * 0.5;
+        double scale = std::max(extents.x, std::max(extents.y, extents.z));
+        if (scale <= 0.0)
+        {
+            scale = 1.0;
+        }
+
+        quantized_mesh.set_dequantization(bounds.center(), scale);
+    }
+
+    // Convert each attribute of each vertex
+    MeshReader mesh_reader(mesh);
+    MeshWriter mesh_writer(quantized_mesh);
+    while (mesh_reader.next_vertex())
+    {
+        mesh_writer.add_vertex();
+
+        for (const VertexAttribute& attribute : vertex_layout.attributes())
+        {
+            const VertexAttributeSemantic semantic = attribute.semantic();
+            switch (attribute.cardinality())
+            {
+            case 1:
+                mesh_writer.write_attribute_data(semantic, mesh_reader.read_attribute_double(semantic));
+                break;
+            case 2:
+                mesh_writer.write_attribute_data(semantic, mesh_reader.read_attribute_vector2(semantic));
+                break;
+            case 3:
+                mesh_writer.write_attribute_data(semantic, mesh_reader.read_attribute_vector3(semantic));
+                break;
+            case 4:
+                mesh_writer.write_attribute_data(semantic, mesh_reader.read_attribute_vector4(semantic));
+                break;
+            }
+        }
+    }
+
+    quantized_mesh.set_index_data(mesh.index_data());
+
+    // Each level of detail has its own bounds to quantize positions within
+    quantized_mesh.set_simplification_error(mesh.simplification_error());
+    for (size_t level = 1; level < mesh.level_of_detail_count(); ++level)
+    {
+        Mesh level_of_detail = mesh.level_of_detail(level);
+        quantize_vertices(level_of_detail);
+        quantized_mesh.add_level_of_detail(level_of_detail);
+    }
+
+    mesh = quantized_mesh;
+}
+
+Mesh MeshOptimizer::simplify(const Mesh& mesh, size_t target_index_count) const
+{
+    Mesh simplified_mesh = mesh;
+    simplified_mesh.clear_levels_of_detail();
+    simplified_mesh.set_simplification_error(0.0);
+
+    const size_t vertex_count = mesh.vertex_count();
+    if (mesh.primitive_type() != PrimitiveType::Triangles || vertex_count == 0)
+    {
+        return simplified_mesh;
+    }
+
+    std::vector<uint32_t> indices = read_indices(mesh);
+    const size_t triangle_count = indices.size() / 3;
+    const size_t target_triangle_count = target_index_count / 3;
+    if (triangle_count <= target_triangle_count)
+    {
+        return simplified_mesh;
+    }
+
+    std::vector<Vector3> positions;
+    mesh.copy_attribute_data(VertexAttributeSemantic::Position, positions);
+
+    // Identify the vertices which share a position with another vertex;
+    // collapsing these would tear the seam between them
+    std::vector<uint32_t> position_ids(vertex_count);
+    std::vector<bool> locked(vertex_count, false);
+    {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(positions.data());
+        std::unordered_map<uint32_t, uint32_t, VertexHash, VertexEqual> unique_positions(vertex_count, VertexHash(data, sizeof(Vector3)), VertexEqual(data, sizeof(Vector3)));
+        std::vector<uint32_t> position_vertex_counts(vertex_count, 0);
+        for (uint32_t i = 0; i < vertex_count; ++i)
+        {
+            position_ids[i] = unique_positions.emplace(i, i).first->second;
+            ++position_vertex_counts[position_ids[i]];
+        }
+
+        for (uint32_t i = 0; i < vertex_count; ++i)
+        {
+            locked[i] = position_vertex_counts[position_ids[i]] > 1;
+        }
+    }
+
+    // Lock the vertices on open or non-manifold edges
+    {
+        std::unordered_map<uint64_t, uint32_t> edge_counts;
+        for (size_t i = 0; i < triangle_count * 3; i += 3)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                ++edge_counts[edge_key(position_ids[indices[i + j]], position_ids[indices[i + (j + 1) % 3]])];
+            }
+        }
+
+        for (size_t i = 0; i < triangle_count * 3; i += 3)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const uint32_t a = indices[i + j];
+                const uint32_t b = indices[i + (j + 1) % 3];
+                if (edge_counts[edge_key(position_ids[a], position_ids[b])] != 2)
+                {
+                    locked[a] = true;
+                    locked[b] = true;
+                }
+            }
+        }
+    }
+
+    // Accumulate the planes of the triangles around each vertex
+    std::vector<Quadric> quadrics(vertex_count);
+    std::vector<std::vector<uint32_t>> vertex_triangles(vertex_count);
+    for (uint32_t i = 0; i < triangle_count; ++i)
+    {
+        const uint32_t* triangle = &indices[i * 3];
+        const Vector3 p0 = positions[triangle[0]];
+        const Vector3 normal = (positions[triangle[1]] - p0).cross(positions[triangle[2]] - p0);
+        const double length = normal.length();
+        if (length > 0.0)
+        {
+            const Vector3 unit_normal = normal / length;
+            const Quadric quadric(unit_normal, -unit_normal.dot(p0));
+            for (size_t j = 0; j < 3; ++j)
+            {
+                quadrics[triangle[j]] += quadric;
+            }
+        }
+
+        for (size_t j = 0; j < 3; ++j)
+        {
+            vertex_triangles[triangle[j]].push_back(i);
+        }
+    }
+
+    std::vector<bool> removed_triangles(triangle_count, false);
+    std::vector<bool> collapsed(vertex_count, false);
+    std::vector<bool> touched(vertex_count, false);
+    std::vector<Collapse> collapses;
+    std::vector<uint32_t> neighbors;
+    size_t remaining_triangle_count = triangle_count;
+    double max_cost = 0.0;
+
+    // Returns whether moving a vertex flips or degenerates any of the
+    // triangles around it which are not removed by the collapse
+    auto flips_triangles = [&](uint32_t from, uint32_t to)
+    {
+        for (uint32_t triangle_index : vertex_triangles[from])
+        {
+            const uint32_t* triangle = &indices[triangle_index * 3];
+            if (removed_triangles[triangle_index] || position_ids[triangle[0]] == position_ids[to] || position_ids[triangle[1]] == position_ids[to] || position_ids[triangle[2]] == position_ids[to])
+            {
+                continue;
+            }
+
+            Vector3 p[3] = { positions[triangle[0]], positions[triangle[1]], positions[triangle[2]] };
+            const Vector3 normal = (p[1] - p[0]).cross(p[2] - p[0]);
+            for (size_t j = 0; j < 3; ++j)
+            {
+                if (triangle[j] == from)
+                {
+                    p[j] = positions[to];
+                }
+            }
+
+            const Vector3 moved_normal = (p[1] - p[0]).cross(p[2] - p[0]);
+            if (normal.dot(moved_normal) <= 0.0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    // Returns whether the collapse keeps the surface manifold: the two
+    // vertices may only share the two neighbors opposite the edge
+    auto is_manifold_collapse = [&](uint32_t from, uint32_t to)
+    {
+        neighbors.clear();
+        for (uint32_t triangle_index : vertex_triangles[from])
+        {
+            if (!removed_triangles[triangle_index])
+            {
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    neighbors.push_back(position_ids[indices[triangle_index * 3 + j]]);
+                }
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+        size_t shared_count = 0;
+        std::vector<uint32_t> counted;
+        for (uint32_t triangle_index : vertex_triangles[to])
+        {
+            if (!removed_triangles[triangle_index])
+            {
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    const uint32_t neighbor = position_ids[indices[triangle_index * 3 + j]];
+                    if (neighbor != position_ids[from] && neighbor != position_ids[to] && std::binary_search(neighbors.begin(), neighbors.end(), neighbor) && std::find(counted.begin(), counted.end(), neighbor) == counted.end())
+                    {
+                        counted.push_back(neighbor);
+                        ++shared_count;
+                    }
+                }
+            }
+        }
+
+        return shared_count == 2;
+    };
+
+    // Collapse the cheapest edges in passes, only collapsing edges of
+    // vertices which were not changed earlier in the same pass
+    while (remaining_triangle_count > target_triangle_count)
+    {
+        collapses.clear();
+        for (uint32_t i = 0; i < triangle_count; ++i)
+        {
+            if (removed_triangles[i])
+            {
+                continue;
+            }
+
+            for (size_t j = 0; j < 3; ++j)
+            {
+                const uint32_t from = indices[i * 3 + j];
+                if (!locked[from])
+                {
+                    for (size_t k = 1; k < 3; ++k)
+                    {
+                        const uint32_t to = indices[i * 3 + (j + k) % 3];
+                        Collapse collapse;
+                        collapse.cost = quadrics[from].error(positions[to]);
+                        collapse.from = from;
+                        collapse.to = to;
+                        collapses.push_back(collapse);
+                    }
+                }
+            }
+        }
+
+        std::sort(collapses.begin(), collapses.end());
+        std::fill(touched.begin(), touched.end(), false);
+
+        // Only collapse the cheapest eighth of the edges in each pass so that
+        // costs do not become too stale; each collapse removes two triangles
+        const size_t pass_collapse_count = std::max(size_t(1), std::min(remaining_triangle_count - target_triangle_count, remaining_triangle_count / 8) / 2);
+        size_t collapse_count = 0;
+        for (const Collapse& collapse : collapses)
+        {
+            if (remaining_triangle_count <= target_triangle_count || collapse_count >= pass_collapse_count)
+            {
+                break;
+            }
+
+            const uint32_t from = collapse.from;
+            const uint32_t to = collapse.to;
+            if (collapsed[from] || collapsed[to] || touched[from] || touched[to] || flips_triangles(from, to) || !is_manifold_collapse(from, to))
+            {
+                continue;
+            }
+
+            // Move the triangles of the collapsed vertex to the vertex it is
+            // collapsed onto, removing the triangles which degenerate
+            for (uint32_t triangle_index : vertex_triangles[from])
+            {
+                if (removed_triangles[triangle_index])
+                {
+                    continue;
+                }
+
+                uint32_t* triangle = &indices[triangle_index * 3];
+                bool degenerate = false;
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    if (triangle[j] == from)
+                    {
+                        triangle[j] = to;
+                    }
+                    else if (position_ids[triangle[j]] == position_ids[to])
+                    {
+                        degenerate = true;
+                    }
+                }
+
+                if (degenerate)
+                {
+                    removed_triangles[triangle_index] = true;
+                    --remaining_triangle_count;
+                }
+                else
+                {
+                    vertex_triangles[to].push_back(triangle_index);
+                }
+
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    touched[triangle[j]] = true;
+                }
+            }
+
+            quadrics[to] += quadrics[from];
+            collapsed[from] = true;
+            touched[from] = true;
+            touched[to] = true;
+            max_cost = std::max(max_cost, collapse.cost);
+            ++collapse_count;
+        }
+
+        if (collapse_count == 0)
+        {
+            break;
+        }
+    }
+
+    std::vector<uint32_t> simplified_indices;
+    simplified_indices.reserve(remaining_triangle_count * 3);
+    for (size_t i = 0; i < triangle_count; ++i)
+    {
+        if (!removed_triangles[i])
+        {
+            simplified_indices.insert(simplified_indices.end(), indices.begin() + i * 3, indices.begin() + i * 3 + 3);
+        }
+    }
+
+    write_indices(simplified_mesh, simplified_indices);
+    optimize_vertex_cache(simplified_mesh);
+    optimize_vertex_fetch(simplified_mesh);
+
+    // The error is relative to the size of the mesh so that it can be
+    // projected to the screen
+    const AxisAlignedBox& bounds = mesh.axis_aligned_box();
+    const double radius = bounds.has_size() ? (bounds.maximum() - bounds.minimum()).length() * 0.5 : 0.0;
+    simplified_mesh.set_simplification_error(radius > 0.0 ? std::sqrt(max_cost) / radius : 0.0);
+
+    return simplified_mesh;
+}
+
+void MeshOptimizer::generate_levels_of_detail(Mesh& mesh, size_t max_level_count, double reduction) const
+{
+    mesh.clear_levels_of_detail();
+    if (mesh.primitive_type() != PrimitiveType::Triangles)
+    {
+        return;
+    }
+
+    size_t index_count = mesh.index_count() > 0 ? mesh.index_count() : mesh.vertex_count();
+    for (size_t level = 1; level < max_level_count; ++level)
+    {
+        const size_t target_triangle_count = static_cast<size_t>(index_count / 3 * reduction);
+        if (target_triangle_count < MinLevelOfDetailTriangleCount)
+        {
+            break;
+        }
+
+        // Each level is simplified from the full mesh so that errors do not
+        // compound
+        Mesh level_of_detail = simplify(mesh, target_triangle_count * 3);
+
+        // Stop once the simplification stalls on locked vertices
+        if (level_of_detail.index_count() > index_count * (1.0 + reduction) / 2.0)
+        {
+            break;
+        }
+
+        index_count = level_of_detail.index_count();
+        mesh.add_level_of_detail(level_of_detail);
+    }
+}
+
+std::vector<uint32_t> MeshOptimizer::read_indices(const Mesh& mesh)
+{
+    std::vector<uint32_t> indices;
+    if (mesh.index_count() > 0)
+    {
+        mesh.copy_index_data(indices);
+    }
+    else
+    {
+        // An unindexed mesh refers to each vertex in order
+        indices.resize(mesh.vertex_count());
+        std::iota(indices.begin(), indices.end(), 0);
+    }
+    return indices;
+}
+
+void MeshOptimizer::write_indices(Mesh& mesh, const std::vector<uint32_t>& indices)
+{
+    // Use the smallest index type of at least 16 bits unless the mesh
+    // already uses 8-bit indices which are still large enough
+    IndexType index_type = IndexType::UInt32;
+    const size_t vertex_count = mesh.vertex_count();
+    if (mesh.index_type() == IndexType::UInt8 && vertex_count <= 0x100)
+    {
+        index_type = IndexType::UInt8;
+    }
+    else if (vertex_count <= 0x10000)
+    {
+        index_type = IndexType::UInt16;
+    }
+
+    mesh.clear_index_data();
+    mesh.set_index_type(index_type);
+
+    Mesh::IndexData index_data(indices.size() * mesh.index_size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        switch (index_type)
+        {
+        case IndexType::UInt8:
+            index_data[i] = static_cast<uint8_t>(indices[i]);
+            break;
+        case IndexType::UInt16:
+        {
+            const uint16_t index = static_cast<uint16_t>(indices[i]);
+            std::memcpy(&index_data[i * sizeof(uint16_t)], &index, sizeof(uint16_t));
+        }
+        break;
+        case IndexType::UInt32:
+            std::memcpy(&index_data[i * sizeof(uint32_t)], &indices[i], sizeof(uint32_t));
+            break;
+        }
+    }
+
+    mesh.set_index_data(index_data);
+}
+
+double MeshOptimizer::compute_acmr(const std::vector<uint32_t>& indices, size_t vertex_count, size_t cache_size)
+{
+    const size_t triangle_count = indices.size() / 3;
+    if (triangle_count == 0)
+    {
+        return 0.0;
+    }
+
+    // A vertex is in the FIFO cache if fewer vertices than the size of the
+    // cache were added after it
+    std::vector<size_t> cache_timestamps(vertex_count, 0);
+    size_t timestamp = cache_size + 1;
+    size_t misses = 0;
+    for (size_t i = 0; i < triangle_count * 3; ++i)
+    {
+        const uint32_t vertex = indices[i];
+        if (timestamp - cache_timestamps[vertex] > cache_size)
+        {
+            cache_timestamps[vertex] = timestamp++;
+            ++misses;
+        }
+    }
+
+    return static_cast<double>(misses) / triangle_count;
+}
@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Hect/Core/Export.h"
+
+namespace hect
+{
+
+class Mesh;
+
+///
+/// Processes the vertices and indices of a Mesh to reduce its size and to
+/// improve the efficiency of rendering it.
+class HECT_EXPORT MeshOptimizer
+{
+public:
+
+    ///
+    /// Measurements of a mesh before and after it is optimized.
+    class HECT_EXPORT Metrics
+    {
+    public:
+
+        ///
+        /// The number of vertices before optimizing.
+        size_t vertex_count_before { 0 };
+
+        ///
+        /// The number of vertices after optimizing.
+        size_t vertex_count_after { 0 };
+
+        ///
+        /// The average cache miss ratio before optimizing.
+        double acmr_before { 0 };
+
+        ///
+        /// The average cache miss ratio after optimizing.
+        double acmr_after { 0 };
+    };
+
+    ///
+    /// The number of entries in the post-transform vertex cache simulated
+    /// when measuring the average cache miss ratio.
+    static const size_t MeasuredCacheSize = 16;
+
+    ///
+    /// Returns the average cache miss ratio of a mesh: the number of
+    /// vertices transformed per triangle when the vertex shader results are
+    /// kept in a FIFO cache.
+    ///
+    /// \note Meshes which are not triangle lists have a ratio of zero.
+    ///
+    /// \param mesh The mesh.
+    /// \param cache_size The number of entries in the simulated cache.
+    static double compute_acmr(const Mesh& mesh, size_t cache_size = MeasuredCacheSize);
+
+    ///
+    /// Applies all optimizations to a mesh.
+    ///
+    /// \param mesh The mesh to optimize.
+    ///
+    /// \returns The measurements of the mesh before and after optimizing.
+    Metrics optimize(Mesh& mesh) const;
+
+    ///
+    /// Merges vertices with identical data and indexes the mesh if it is
+    /// not already indexed.
+    ///
+    /// \param mesh The mesh.
+    void weld_vertices(Mesh& mesh) const;
+
+    ///
+    /// Reorders the triangles of a triangle list to reuse recently
+    /// transformed vertices.
+    ///
+    /// \param mesh The mesh.
+    void optimize_vertex_cache(Mesh& mesh) const;
+
+    ///
+    /// Reorders clusters of triangles of a triangle list so that triangles
+    /// facing outwards are drawn first, reducing overdraw.
+    ///
+    /// \note The reordering is discarded if it raises the average cache
+    /// miss ratio by more than the given threshold.
+    ///
+    /// \param mesh The mesh.
+    /// \param threshold The largest allowed ratio of the average cache miss
+    /// ratio after reordering to the ratio before.
+    void optimize_overdraw(Mesh& mesh, double threshold = 1.05) const;
+
+    ///
+    /// Reorders the vertices in the order they are first referenced by the
+    /// indices and removes vertices which are not referenced.
+    ///
+    /// \param mesh The mesh.
+    void optimize_vertex_fetch(Mesh& mesh) const;
+
+    ///
+    /// Converts the vertex attributes of a mesh to compact types: positions
+    /// to normalized 16-bit integers mapped through the dequantization
+    /// transform of the mesh, normals, tangents, and binormals to
+    /// octahedral 16-bit integers, and texture coordinates to 16-bit
+    /// floats.
+    ///
+    /// \note Only 32-bit float attributes with three components (or two or
+    /// four for texture coordinates) are converted.  Positions are padded to
+    /// four components to keep the following attributes aligned.
+    ///
+    /// \param mesh The mesh.
+    void quantize_vertices(Mesh& mesh) const;
+
+    ///
+    /// Returns a simplified copy of a triangle list by collapsing the edges
+    /// which least change its surface.
+    ///
+    /// \note Vertices on open borders or on seams between vertices sharing
+    /// a position are kept in place so that simplifying does not open gaps.
+    /// The simplification error of the copy is set and it is optimized for
+    /// the vertex cache and vertex fetch.
+    ///
+    /// \param mesh The mesh.
+    /// \param target_index_count The number of indices to reduce the mesh
+    /// to; the result may have more if no further edges can be collapsed.
+    ///
+    /// \returns The simplified mesh.
+    Mesh simplify(const Mesh& mesh, size_t target_index_count) const;
+
+    ///
+    /// Replaces the levels of detail of a triangle list with successively
+    /// simplified versions of it.
+    ///
+    /// \note Fewer levels are generated if the mesh cannot be simplified
+    /// further.
+    ///
+    /// \param mesh The mesh.
+    /// \param max_level_count The largest number of levels of detail,
+    /// including the mesh itself.
+    /// \param reduction The ratio of the triangle count of each level to
+    /// the count of the level before it.
+    void generate_levels_of_detail(Mesh& mesh, size_t max_level_count = 4, double reduction = 0.5) const;
+
+private:
+    static std::vector<uint32_t> read_indices(const Mesh& mesh);
+    static void write_indices(Mesh& mesh, const std::vector<uint32_t>& indices);
+    static double compute_acmr(const std::vector<uint32_t>& indices, size_t vertex_count, size_t cache_size);
+};
+
+}
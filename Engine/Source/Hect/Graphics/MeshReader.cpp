@@ -23,6 +23,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "MeshReader.h"
 
+#include "Hect/Math/Quantization.h"
+
 using namespace hect;
 
 MeshReader::MeshReader(const Mesh& mesh) :
@@ -294,13 +296,54 @@ float MeshReader::read_component_value(const VertexAttribute& attribute, unsigne
         value = static_cast<float>(read_value);
     }
     break;
-    case VertexAttributeType::Reserved:
-        // Float 16
-        break;
+    case VertexAttributeType::Float16:
+    {
+        _vertex_stream.seek(offset + index * sizeof(uint16_t));
+        uint16_t read_value;
+        _vertex_stream >> read_value;
+        value = decode_float16(read_value);
+    }
+    break;
     case VertexAttributeType::Float32:
         _vertex_stream.seek(offset + index * sizeof(float));
         _vertex_stream >> value;
         break;
+    case VertexAttributeType::NormalizedInt16:
+    {
+        _vertex_stream.seek(offset + index * sizeof(int16_t));
+        int16_t read_value;
+        _vertex_stream >> read_value;
+        value = static_cast<float>(dequantize(attribute, index, decode_normalized_int16(read_value)));
+    }
+    break;
+    case VertexAttributeType::NormalizedUInt16:
+    {
+        _vertex_stream.seek(offset + index * sizeof(uint16_t));
+        uint16_t read_value;
+        _vertex_stream >> read_value;
+        value = static_cast<float>(dequantize(attribute, index, decode_normalized_uint16(read_value)));
+    }
+    break;
+    case VertexAttributeType::OctahedralInt16:
+        if (index < 3)
+        {
+            _vertex_stream.seek(offset);
+            int16_t encoded[2];
+            _vertex_stream >> encoded[0] >> encoded[1];
+            value = static_cast<float>(decode_octahedral(encoded)[index]);
+        }
+        break;
+    }
+
+    return value;
+}
+
+double MeshReader::dequantize(const VertexAttribute& attribute, unsigned index, double value) const
+{
+    // Only positions are mapped through the dequantization transform
+    if (attribute.semantic() == VertexAttributeSemantic::Position && index < 3)
+    {
+        value = value * _mesh.dequantization_scale() + _mesh.dequantization_offset()[index];
     }
 
     return value;
@@ -122,6 +122,7 @@ private:
     void check_index_boundary() const;
 
     float read_component_value(const VertexAttribute& attribute, unsigned index) const;
+    double dequantize(const VertexAttribute& attribute, unsigned index, double value) const;
 
     const Mesh& _mesh;
 
@@ -24,6 +24,7 @@
 #include "MeshWriter.h"
 
 #include "Hect/Core/Exception.h"
+#include "Hect/Math/Quantization.h"
 
 using namespace hect;
 
@@ -90,6 +91,11 @@ void MeshWriter::write_attribute_data(VertexAttributeSemantic semantic, Vector3
     if (vertex_layout.has_attribute_with_semantic(semantic))
     {
         const VertexAttribute& attribute = vertex_layout.attribute_with_semantic(semantic);
+        if (attribute.type() == VertexAttributeType::OctahedralInt16)
+        {
+            set_octahedral_value(attribute, value);
+            return;
+        }
 
         unsigned cardinality = attribute.cardinality();
 
@@ -116,6 +122,11 @@ void MeshWriter::write_attribute_data(VertexAttributeSemantic semantic, Vector4
     if (vertex_layout.has_attribute_with_semantic(semantic))
     {
         const VertexAttribute& attribute = vertex_layout.attribute_with_semantic(semantic);
+        if (attribute.type() == VertexAttributeType::OctahedralInt16)
+        {
+            set_octahedral_value(attribute, Vector3(value.x, value.y, value.z));
+            return;
+        }
 
         unsigned cardinality = attribute.cardinality();
 
@@ -197,14 +208,51 @@ void MeshWriter::set_component_value(const VertexAttribute& attribute, unsigned
         _vertex_stream.seek(offset + index * sizeof(uint32_t));
         _vertex_stream << static_cast<uint32_t>(value);
         break;
-    case VertexAttributeType::Reserved:
-        // Float 16
+    case VertexAttributeType::Float16:
+        _vertex_stream.seek(offset + index * sizeof(uint16_t));
+        _vertex_stream << encode_float16(value);
         break;
     case VertexAttributeType::Float32:
         _vertex_stream.seek(offset + index * sizeof(float));
         _vertex_stream << value;
         break;
+    case VertexAttributeType::NormalizedInt16:
+        _vertex_stream.seek(offset + index * sizeof(int16_t));
+        _vertex_stream << encode_normalized_int16(quantize(attribute, index, value));
+        break;
+    case VertexAttributeType::NormalizedUInt16:
+        _vertex_stream.seek(offset + index * sizeof(uint16_t));
+        _vertex_stream << encode_normalized_uint16(quantize(attribute, index, value));
+        break;
+    case VertexAttributeType::OctahedralInt16:
+        // Written as a whole direction by set_octahedral_value()
+        break;
     }
 
     _vertex_stream.seek(position);
+}
+
+void MeshWriter::set_octahedral_value(const VertexAttribute& attribute, Vector3 value)
+{
+    size_t position = _vertex_stream.position();
+
+    int16_t encoded[2];
+    encode_octahedral(value, encoded);
+
+    _vertex_stream.seek(_vertex_position + attribute.offset());
+    _vertex_stream << encoded[0] << encoded[1];
+
+    _vertex_stream.seek(position);
+}
+
+double MeshWriter::quantize(const VertexAttribute& attribute, unsigned index, double value) const
+{
+    // Only positions are mapped through the inverse of the dequantization
+    // transform
+    if (attribute.semantic() == VertexAttributeSemantic::Position && index < 3)
+    {
+        value = (value - _mesh.dequantization_offset()[index]) / _mesh.dequantization_scale();
+    }
+
+    return value;
 }
\ No newline at end of file
@@ -82,6 +82,8 @@ public:
 
 private:
     void set_component_value(const VertexAttribute& attribute, unsigned index, float value);
+    void set_octahedral_value(const VertexAttribute& attribute, Vector3 value);
+    double quantize(const VertexAttribute& attribute, unsigned index, double value) const;
 
     Mesh& _mesh;
     size_t _vertex_position { 0 };
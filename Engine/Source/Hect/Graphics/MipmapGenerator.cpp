@@ -0,0 +1,420 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "MipmapGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Hect/Concurrency/TaskPool.h"
+#include "Hect/Core/Configuration.h"
+#include "Hect/Core/Exception.h"
+#include "Hect/Graphics/PixelConversion.h"
+
+#ifdef HECT_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace hect;
+
+namespace
+{
+
+// The minimum number of rows filtered by each task
+const unsigned MinRowsPerTask = 32;
+
+// The radius of the Kaiser filter in pixels of the smaller image and the
+// shape parameter of its window
+const double KaiserRadius = 2.0;
+const double KaiserAlpha = 4.0;
+
+const double Pi = 3.14159265358979323846;
+
+// Pixels are filtered with four float components regardless of the
+// cardinality of the image so that each pixel is one SIMD vector
+typedef std::vector<float> PixelBuffer;
+
+// The source pixels contributing to each pixel along one axis of a resampled
+// image; each pixel has the same number of taps, padded with zero weights
+struct FilterTaps
+{
+    unsigned tap_count { 0 };
+    std::vector<unsigned> indices;
+    std::vector<float> weights;
+};
+
+// The zeroth-order modified Bessel function of the first kind
+double bessel_i0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (unsigned k = 1; k < 32; ++k)
+    {
+        const double factor = x / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+        if (term < sum * 1e-12)
+        {
+            break;
+        }
+    }
+    return sum;
+}
+
+// The Kaiser-windowed sinc at a distance in pixels of the smaller image
+double kaiser_weight(double t)
+{
+    const double ratio = t / KaiserRadius;
+    if (ratio <= -1.0 || ratio >= 1.0)
+    {
+        return 0.0;
+    }
+
+    const double sinc = t == 0.0 ? 1.0 : std::sin(Pi * t) / (Pi * t);
+    const double window = bessel_i0(KaiserAlpha * std::sqrt(1.0 - ratio * ratio)) / bessel_i0(KaiserAlpha);
+    return sinc * window;
+}
+
+FilterTaps compute_filter_taps(MipmapFilter filter, unsigned source_size, unsigned size)
+{
+    // The filter is stretched to cover the footprint of each pixel when
+    // downsampling
+    const double scale = static_cast<double>(source_size) / size;
+    const double footprint = std::max(scale, 1.0);
+    const double radius = filter == MipmapFilter::Box ? 0.5 * footprint : KaiserRadius * footprint;
+
+    FilterTaps taps;
+    taps.tap_count = static_cast<unsigned>(std::ceil(2.0 * radius)) + 1;
+    taps.indices.resize(size * taps.tap_count);
+    taps.weights.resize(size * taps.tap_count, 0.0f);
+
+    std::vector<double> weights(taps.tap_count);
+    for (unsigned i = 0; i < size; ++i)
+    {
+        const double center = (i + 0.5) * scale;
+        const int first = static_cast<int>(std::floor(center - radius));
+
+        double total = 0.0;
+        for (unsigned k = 0; k < taps.tap_count; ++k)
+        {
+            const int j = first + static_cast<int>(k);
+            if (filter == MipmapFilter::Box)
+            {
+                // The overlap of the source pixel with the footprint
+                const double begin = std::max(static_cast<double>(j), center - radius);
+                const double end = std::min(static_cast<double>(j + 1), center + radius);
+                weights[k] = std::max(0.0, end - begin);
+            }
+            else
+            {
+                weights[k] = kaiser_weight((j + 0.5 - center) / footprint);
+            }
+            total += weights[k];
+        }
+
+        // Pixels beyond the edges repeat the edge pixels
+        for (unsigned k = 0; k < taps.tap_count; ++k)
+        {
+            const int j = std::min(std::max(first + static_cast<int>(k), 0), static_cast<int>(source_size) - 1);
+            taps.indices[i * taps.tap_count + k] = static_cast<unsigned>(j);
+            taps.weights[i * taps.tap_count + k] = static_cast<float>(weights[k] / total);
+        }
+    }
+
+    return taps;
+}
+
+// Computes the weighted sum of the pixels at each tap, where the index of a
+// tap is multiplied by the stride to find its pixel
+void filter_pixel(const float* source, size_t stride, const unsigned* indices, const float* weights, unsigned tap_count, float* result)
+{
+#ifdef HECT_SIMD_SSE2
+    __m128 sum = _mm_setzero_ps();
+    for (unsigned k = 0; k < tap_count; ++k)
+    {
+        const __m128 pixel = _mm_loadu_ps(source + indices[k] * stride);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), pixel));
+    }
+    _mm_storeu_ps(result, sum);
+#else
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (unsigned k = 0; k < tap_count; ++k)
+    {
+        const float* pixel = source + indices[k] * stride;
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            sum[c] += weights[k] * pixel[c];
+        }
+    }
+    std::copy(sum, sum + 4, result);
+#endif
+}
+
+// Performs an action on ranges of rows, split across the worker threads of
+// the task pool when there is one and the rows are worth splitting
+template <typename ActionType>
+void for_each_row_range(TaskPool* task_pool, unsigned row_count, const ActionType& action)
+{
+    const unsigned max_task_count = (row_count + MinRowsPerTask - 1) / MinRowsPerTask;
+    unsigned task_count = 1;
+    if (task_pool)
+    {
+        task_count = std::max(1u, std::min(static_cast<unsigned>(task_pool->thread_count()), max_task_count));
+    }
+
+    if (task_count == 1)
+    {
+        action(0u, row_count);
+        return;
+    }
+
+    std::vector<Task::Handle> tasks;
+    tasks.reserve(task_count);
+    for (unsigned i = 0; i < task_count; ++i)
+    {
+        const unsigned begin = row_count * i / task_count;
+        const unsigned end = row_count * (i + 1) / task_count;
+        tasks.push_back(task_pool->enqueue([&action, begin, end]
+        {
+            action(begin, end);
+        }));
+    }
+
+    for (Task::Handle& task : tasks)
+    {
+        task->wait();
+    }
+}
+
+// Resamples pixels separably, horizontally first and then vertically
+void resample_pixels(TaskPool* task_pool, MipmapFilter filter, const PixelBuffer& source, unsigned source_width, unsigned source_height, PixelBuffer& dest, unsigned width, unsigned height)
+{
+    const FilterTaps horizontal_taps = compute_filter_taps(filter, source_width, width);
+    const FilterTaps vertical_taps = compute_filter_taps(filter, source_height, height);
+
+    PixelBuffer intermediate(static_cast<size_t>(width) * source_height * 4);
+    for_each_row_range(task_pool, source_height, [&](unsigned begin, unsigned end)
+    {
+        const unsigned tap_count = horizontal_taps.tap_count;
+        for (unsigned y = begin; y < end; ++y)
+        {
+            const float* source_row = &source[static_cast<size_t>(y) * source_width * 4];
+            float* row = &intermediate[static_cast<size_t>(y) * width * 4];
+            for (unsigned x = 0; x < width; ++x)
+            {
+                filter_pixel(source_row, 4, &horizontal_taps.indices[x * tap_count], &horizontal_taps.weights[x * tap_count], tap_count, row + x * 4);
+            }
+        }
+    });
+
+    dest.resize(static_cast<size_t>(width) * height * 4);
+    for_each_row_range(task_pool, height, [&](unsigned begin, unsigned end)
+    {
+        const unsigned tap_count = vertical_taps.tap_count;
+        const size_t stride = static_cast<size_t>(width) * 4;
+        for (unsigned y = begin; y < end; ++y)
+        {
+            const unsigned* indices = &vertical_taps.indices[y * tap_count];
+            const float* weights = &vertical_taps.weights[y * tap_count];
+            float* row = &dest[y * stride];
+            for (unsigned x = 0; x < width; ++x)
+            {
+                filter_pixel(&intermediate[x * 4], stride, indices, weights, tap_count, row + x * 4);
+            }
+        }
+    });
+}
+
+// Converts the pixels of an image to linear float pixels
+void convert_to_linear(TaskPool* task_pool, const Image& image, PixelBuffer& pixels)
+{
+    const size_t width = image.width();
+    const PixelFormat& pixel_format = image.pixel_format();
+    const uint8_t* data = image.pixel_data().data();
+
+    pixels.resize(width * image.height() * 4);
+    for_each_row_range(task_pool, image.height(), [&](unsigned begin, unsigned end)
+    {
+        decode_pixels(data + begin * width * pixel_format.size(), pixel_format, image.color_space(), &pixels[begin * width * 4], (end - begin) * width);
+    });
+}
+
+// Rescales the normal in the first components of a pixel to unit length, or
+// only shortens it for two-component normals
+void renormalize(float* pixel, unsigned cardinality, bool byte)
+{
+    const unsigned count = std::min(cardinality, 3u);
+
+    float normal[3] = { 0.0f, 0.0f, 0.0f };
+    float length_squared = 0.0f;
+    for (unsigned c = 0; c < count; ++c)
+    {
+        normal[c] = byte ? pixel[c] * 2.0f - 1.0f : pixel[c];
+        length_squared += normal[c] * normal[c];
+    }
+
+    if (length_squared <= 0.0f || (count < 3 && length_squared <= 1.0f))
+    {
+        return;
+    }
+
+    const float scale = 1.0f / std::sqrt(length_squared);
+    for (unsigned c = 0; c < count; ++c)
+    {
+        const float value = normal[c] * scale;
+        pixel[c] = byte ? value * 0.5f + 0.5f : value;
+    }
+}
+
+// Converts linear float pixels to the pixel data of an image
+void convert_from_linear(TaskPool* task_pool, const PixelBuffer& pixels, Image& image, bool normal_map)
+{
+    const size_t width = image.width();
+    const PixelFormat& pixel_format = image.pixel_format();
+    const bool byte = pixel_format.type() == PixelType::Byte;
+
+    ByteVector pixel_data(pixel_format.image_size(image.width(), image.height()));
+    uint8_t* data = pixel_data.data();
+    for_each_row_range(task_pool, image.height(), [&](unsigned begin, unsigned end)
+    {
+        if (!normal_map)
+        {
+            encode_pixels(&pixels[begin * width * 4], pixel_format, image.color_space(), data + begin * width * pixel_format.size(), (end - begin) * width);
+            return;
+        }
+
+        // Renormalize a copy of each row so that the next level is still
+        // filtered from the unnormalized pixels
+        PixelBuffer row(width * 4);
+        for (size_t y = begin; y < end; ++y)
+        {
+            std::copy(&pixels[y * width * 4], &pixels[y * width * 4] + width * 4, row.begin());
+            for (size_t x = 0; x < width; ++x)
+            {
+                renormalize(&row[x * 4], pixel_format.cardinality(), byte);
+            }
+            encode_pixels(row.data(), pixel_format, image.color_space(), data + y * width * pixel_format.size(), width);
+        }
+    });
+
+    image.set_pixel_data(std::move(pixel_data));
+}
+
+}
+
+MipmapGenerator::MipmapGenerator()
+{
+}
+
+MipmapGenerator::MipmapGenerator(TaskPool& task_pool) :
+    _task_pool(&task_pool)
+{
+}
+
+MipmapFilter MipmapGenerator::filter() const
+{
+    return _filter;
+}
+
+void MipmapGenerator::set_filter(MipmapFilter filter)
+{
+    _filter = filter;
+}
+
+bool MipmapGenerator::is_normal_map() const
+{
+    return _normal_map;
+}
+
+void MipmapGenerator::set_normal_map(bool normal_map)
+{
+    _normal_map = normal_map;
+}
+
+void MipmapGenerator::generate(Image& image) const
+{
+    ensure_supported(image);
+    image.clear_mipmaps();
+
+    PixelBuffer pixels;
+    convert_to_linear(_task_pool, image, pixels);
+
+    unsigned width = image.width();
+    unsigned height = image.height();
+    while (width > 1 || height > 1)
+    {
+        const unsigned level_width = std::max(1u, width / 2);
+        const unsigned level_height = std::max(1u, height / 2);
+
+        PixelBuffer level_pixels;
+        resample_pixels(_task_pool, _filter, pixels, width, height, level_pixels, level_width, level_height);
+
+        Image mipmap(level_width, level_height, image.pixel_format());
+        mipmap.set_color_space(image.color_space());
+        convert_from_linear(_task_pool, level_pixels, mipmap, _normal_map);
+        image.add_mipmap(mipmap);
+
+        // Filter the next level from the unquantized pixels
+        pixels.swap(level_pixels);
+        width = level_width;
+        height = level_height;
+    }
+}
+
+Image MipmapGenerator::resample(const Image& image, unsigned width, unsigned height) const
+{
+    ensure_supported(image);
+    if (width == 0 || height == 0)
+    {
+        throw InvalidOperation("Cannot resample an image to zero size");
+    }
+
+    PixelBuffer pixels;
+    convert_to_linear(_task_pool, image, pixels);
+
+    PixelBuffer resampled_pixels;
+    resample_pixels(_task_pool, _filter, pixels, image.width(), image.height(), resampled_pixels, width, height);
+
+    Image resampled_image(width, height, image.pixel_format());
+    resampled_image.set_color_space(image.color_space());
+    convert_from_linear(_task_pool, resampled_pixels, resampled_image, _normal_map);
+    return resampled_image;
+}
+
+void MipmapGenerator::ensure_supported(const Image& image) const
+{
+    const PixelFormat& pixel_format = image.pixel_format();
+    if (pixel_format.is_compressed())
+    {
+        throw InvalidOperation("Cannot filter a block-compressed image");
+    }
+    else if (!image.has_pixel_data())
+    {
+        throw InvalidOperation("Image has no pixel data");
+    }
+    else if (_normal_map && image.color_space() == ColorSpace::NonLinear)
+    {
+        throw InvalidOperation("Normal maps must be in linear color space");
+    }
+}
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Hect/Core/Export.h"
+#include "Hect/Graphics/Image.h"
+#include "Hect/Graphics/MipmapFilter.h"
+
+namespace hect
+{
+
+class TaskPool;
+
+///
+/// Resamples an Image and generates its mipmap levels on the CPU.
+///
+/// \note Pixels are filtered in linear space: the color components of images
+/// in ColorSpace::NonLinear are converted from sRGB before filtering and back
+/// after, while alpha is always filtered as is.  Each level is filtered from
+/// the unquantized pixels of the level above.
+class HECT_EXPORT MipmapGenerator
+{
+public:
+
+    ///
+    /// Constructs a mipmap generator which filters on the calling thread.
+    MipmapGenerator();
+
+    ///
+    /// Constructs a mipmap generator which splits the rows of each level
+    /// across the worker threads of a task pool.
+    ///
+    /// \note The generator waits on the tasks it enqueues, so it must not be
+    /// used from within a task of the same pool.
+    ///
+    /// \param task_pool The task pool.
+    MipmapGenerator(TaskPool& task_pool);
+
+    ///
+    /// Returns the filter used to downsample each level.
+    MipmapFilter filter() const;
+
+    ///
+    /// Sets the filter used to downsample each level.
+    ///
+    /// \param filter The new filter.
+    void set_filter(MipmapFilter filter);
+
+    ///
+    /// Returns whether images are treated as normal maps.
+    bool is_normal_map() const;
+
+    ///
+    /// Sets whether images are treated as normal maps.
+    ///
+    /// \note The normals of each filtered pixel are renormalized to unit
+    /// length.  Normals in 8-bit components are expected to be mapped from
+    /// [-1, 1] to [0, 1]; normals in floating point components are used as
+    /// is.  Two-component normals are only shortened to at most unit length.
+    ///
+    /// \param normal_map Whether images are treated as normal maps.
+    void set_normal_map(bool normal_map);
+
+    ///
+    /// Replaces the mipmap levels of an image with a full chain down to one
+    /// pixel.
+    ///
+    /// \param image The image.
+    ///
+    /// \throws InvalidOperation If the image has no pixel data, has
+    /// block-compressed pixels, or is a normal map in a non-linear color
+    /// space.
+    void generate(Image& image) const;
+
+    ///
+    /// Returns a resampled copy of an image without its mipmaps.
+    ///
+    /// \param image The image to resample.
+    /// \param width The width of the resampled image.
+    /// \param height The height of the resampled image.
+    ///
+    /// \throws InvalidOperation If the image is unsupported (see generate())
+    /// or either dimension is zero.
+    Image resample(const Image& image, unsigned width, unsigned height) const;
+
+private:
+    void ensure_supported(const Image& image) const;
+
+    TaskPool* _task_pool { nullptr };
+    MipmapFilter _filter { MipmapFilter::Box };
+    bool _normal_map { false };
+};
+
+}
@@ -27,6 +27,7 @@
 
 #ifdef HECT_RENDERER_OPENGL
 
+#include <cstring>
 #include <set>
 #include <GL/glew.h>
 
@@ -41,6 +42,8 @@
 #include "Hect/Graphics/Texture2.h"
 #include "Hect/Graphics/Texture3.h"
 #include "Hect/Graphics/TextureCube.h"
+#include "Hect/Graphics/UniformBlock.h"
+#include "Hect/Math/Quantization.h"
 #include "Hect/Runtime/Window.h"
 
 using namespace hect;
@@ -58,6 +61,98 @@ Mesh _viewport_mesh;
 FrameBuffer* _current_frame_buffer { nullptr };
 std::set<Mesh*> _uploaded_meshes;
 
+// The first vertex attribute location of the per-instance model matrix
+// used in Renderer::Frame::render_mesh_instanced()
+const GLuint _instance_attribute_index = 12;
+
+// The buffer streaming the per-instance model matrices
+GLuint _instance_buffer_id { 0 };
+
+// Returns whether a linked program reads a four-by-four matrix attribute at
+// the locations the per-instance model matrix is streamed to
+bool has_instance_attribute(GLuint program_id)
+{
+    GLint attribute_count = 0;
+    GL_ASSERT(glGetProgramiv(program_id, GL_ACTIVE_ATTRIBUTES, &attribute_count));
+
+    GLint max_name_length = 0;
+    GL_ASSERT(glGetProgramiv(program_id, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_name_length));
+
+    std::string name(static_cast<size_t>(max_name_length) + 1, '\0');
+    for (GLint index = 0; index < attribute_count; ++index)
+    {
+        GLsizei name_length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        GL_ASSERT(glGetActiveAttrib(program_id, static_cast<GLuint>(index), static_cast<GLsizei>(name.size()), &name_length, &size, &type, &name[0]));
+
+        if (type == GL_FLOAT_MAT4)
+        {
+            GL_ASSERT(GLint location = glGetAttribLocation(program_id, name.data()));
+            if (location == static_cast<GLint>(_instance_attribute_index))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Expands octahedral attributes of a mesh to 32-bit floats since shaders
+// read directions as three components; returns whether the mesh had any
+bool expand_octahedral_attributes(const Mesh& mesh, VertexLayout& vertex_layout, ByteVector& vertex_data)
+{
+    const VertexLayout& mesh_vertex_layout = mesh.vertex_layout();
+
+    bool has_octahedral_attributes = false;
+    for (const VertexAttribute& attribute : mesh_vertex_layout.attributes())
+    {
+        if (attribute.type() == VertexAttributeType::OctahedralInt16)
+        {
+            vertex_layout.add_attribute(VertexAttribute(attribute.semantic(), VertexAttributeType::Float32, 3));
+            has_octahedral_attributes = true;
+        }
+        else
+        {
+            vertex_layout.add_attribute(attribute);
+        }
+    }
+
+    if (!has_octahedral_attributes)
+    {
+        return false;
+    }
+
+    vertex_data.resize(vertex_layout.vertex_size() * mesh.vertex_count());
+    for (size_t i = 0; i < mesh.vertex_count(); ++i)
+    {
+        const uint8_t* source = &mesh.vertex_data()[i * mesh_vertex_layout.vertex_size()];
+        uint8_t* destination = &vertex_data[i * vertex_layout.vertex_size()];
+
+        auto expanded_attribute = vertex_layout.attributes().begin();
+        for (const VertexAttribute& attribute : mesh_vertex_layout.attributes())
+        {
+            if (attribute.type() == VertexAttributeType::OctahedralInt16)
+            {
+                int16_t encoded[2];
+                std::memcpy(encoded, source + attribute.offset(), sizeof(encoded));
+
+                const Vector3 direction = decode_octahedral(encoded);
+                const float components[3] = { static_cast<float>(direction.x), static_cast<float>(direction.y), static_cast<float>(direction.z) };
+                std::memcpy(destination + expanded_attribute->offset(), components, sizeof(components));
+            }
+            else
+            {
+                std::memcpy(destination + expanded_attribute->offset(), source + attribute.offset(), attribute.size());
+            }
+            ++expanded_attribute;
+        }
+    }
+
+    return true;
+}
+
 Mesh create_viewport_mesh()
 {
     Mesh viewport_mesh("Viewport");
@@ -121,9 +216,10 @@ class Texture2Data :
     public Renderer::Data<Texture2>
 {
 public:
-    Texture2Data(Renderer& renderer, Texture2& object, GLuint texture_id) :
+    Texture2Data(Renderer& renderer, Texture2& object, GLuint texture_id, size_t uploaded_size) :
         Renderer::Data<Texture2>(renderer, object),
-        texture_id(texture_id)
+        texture_id(texture_id),
+        uploaded_size(uploaded_size)
     {
     }
 
@@ -137,6 +233,7 @@ public:
     }
 
     GLuint texture_id;
+    size_t uploaded_size;
 };
 
 // OpenGL-specific data for a texture
@@ -167,9 +264,10 @@ class TextureCubeData :
     public Renderer::Data<TextureCube>
 {
 public:
-    TextureCubeData(Renderer& renderer, TextureCube& object, GLuint texture_id) :
+    TextureCubeData(Renderer& renderer, TextureCube& object, GLuint texture_id, size_t uploaded_size) :
         Renderer::Data<TextureCube>(renderer, object),
-        texture_id(texture_id)
+        texture_id(texture_id),
+        uploaded_size(uploaded_size)
     {
     }
 
@@ -183,6 +281,7 @@ public:
     }
 
     GLuint texture_id;
+    size_t uploaded_size;
 };
 
 // OpenGL-specific data for a frame buffer
@@ -235,7 +334,30 @@ public:
     GLuint index_buffer_id;
 };
 
-GLenum _vertex_attribute_type_look_up[8] =
+// OpenGL-specific data for a uniform block
+class UniformBlockData :
+    public Renderer::Data<UniformBlock>
+{
+public:
+    UniformBlockData(Renderer& renderer, UniformBlock& object, GLuint buffer_id) :
+        Renderer::Data<UniformBlock>(renderer, object),
+        buffer_id(buffer_id)
+    {
+    }
+
+    ~UniformBlockData()
+    {
+        // Destroy the uniform block if it is uploaded
+        if (object && object->is_uploaded())
+        {
+            renderer->destroy_uniform_block(*object);
+        }
+    }
+
+    GLuint buffer_id;
+};
+
+GLenum _vertex_attribute_type_look_up[11] =
 {
     GL_BYTE, // Int8
     GL_UNSIGNED_BYTE, // UInt8
@@ -244,7 +366,10 @@ GLenum _vertex_attribute_type_look_up[8] =
     GL_INT, // Int32
     GL_UNSIGNED_INT, // UInt32
     GL_HALF_FLOAT, // Float16
-    GL_FLOAT // Float32
+    GL_FLOAT, // Float32
+    GL_SHORT, // NormalizedInt16
+    GL_UNSIGNED_SHORT, // NormalizedUInt16
+    GL_SHORT // OctahedralInt16 (expanded to GL_FLOAT on upload)
 };
 
 GLenum _index_type_look_up[3] =
@@ -421,6 +546,95 @@ void check_g_l_error()
     }
 }
 
+// Returns the OpenGL internal format of a block-compressed pixel format
+GLenum compressed_internal_format(const PixelFormat& pixel_format, ColorSpace color_space)
+{
+    const bool non_linear = color_space == ColorSpace::NonLinear;
+    switch (pixel_format.type())
+    {
+    case PixelType::Bc1:
+        return non_linear ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case PixelType::Bc3:
+        return non_linear ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case PixelType::Bc4:
+        return GL_COMPRESSED_RED_RGTC1;
+    case PixelType::Bc5:
+        return GL_COMPRESSED_RG_RGTC2;
+    case PixelType::Bc7:
+        return non_linear ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+    default:
+        break;
+    }
+
+    throw InvalidOperation("Pixel format is not block-compressed");
+}
+
+// Uploads each mipmap of an image to a target of the bound texture and
+// returns the number of bytes uploaded
+size_t upload_image_mipmaps(GLenum target, Image& image, GLint internal_format, GLenum format, GLenum type)
+{
+    const PixelFormat& pixel_format = image.pixel_format();
+
+    size_t uploaded_size = 0;
+    for (size_t level = 0; level < image.mipmap_count(); ++level)
+    {
+        Image& mipmap = image.mipmap(level);
+        const size_t image_size = pixel_format.image_size(mipmap.width(), mipmap.height());
+        const void* pixel_data = mipmap.has_pixel_data() ? &mipmap.pixel_data()[0] : 0;
+
+        if (pixel_format.is_compressed())
+        {
+            GL_ASSERT(
+                glCompressedTexImage2D(
+                    target,
+                    static_cast<GLint>(level),
+                    compressed_internal_format(pixel_format, image.color_space()),
+                    mipmap.width(),
+                    mipmap.height(),
+                    0,
+                    static_cast<GLsizei>(image_size),
+                    pixel_data
+                )
+            );
+        }
+        else
+        {
+            GL_ASSERT(
+                glTexImage2D(
+                    target,
+                    static_cast<GLint>(level),
+                    internal_format,
+                    mipmap.width(),
+                    mipmap.height(),
+                    0,
+                    format,
+                    type,
+                    pixel_data
+                )
+            );
+        }
+
+        uploaded_size += image_size;
+    }
+
+    return uploaded_size;
+}
+
+// Generates the mipmaps of the bound texture unless the images already
+// provide them; block-compressed images cannot be mipmapped by OpenGL
+void complete_mipmaps(GLenum texture_type, const Image& image)
+{
+    const size_t mipmap_count = image.mipmap_count();
+    if (mipmap_count > 1 || image.pixel_format().is_compressed())
+    {
+        GL_ASSERT(glTexParameteri(texture_type, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipmap_count - 1)));
+    }
+    else
+    {
+        GL_ASSERT(glGenerateMipmap(texture_type));
+    }
+}
+
 void upload_texture(Renderer& renderer, Texture2& texture, bool depth_component)
 {
     if (texture.is_uploaded())
@@ -463,50 +677,44 @@ void upload_texture(Renderer& renderer, Texture2& texture, bool depth_component)
     Image& image = texture.image();
     const PixelFormat& pixel_format = image.pixel_format();
 
-    GLint internal_format = _internal_image_format_look_up[(int)image.color_space()][(int)pixel_format.cardinality()][(int)pixel_format.type()];
-    if (depth_component)
+    GLint internal_format = GLint(-1);
+    GLenum format = GLenum(-1);
+    GLenum type = GLenum(-1);
+    if (!pixel_format.is_compressed())
     {
-        if (pixel_format.type() == PixelType::Float16)
+        internal_format = _internal_image_format_look_up[(int)image.color_space()][(int)pixel_format.cardinality()][(int)pixel_format.type()];
+        if (depth_component)
         {
-            internal_format = GL_DEPTH_COMPONENT16;
+            if (pixel_format.type() == PixelType::Float16)
+            {
+                internal_format = GL_DEPTH_COMPONENT16;
+            }
+            else if (pixel_format.type() == PixelType::Float32)
+            {
+                internal_format = GL_DEPTH_COMPONENT32;
+            }
         }
-        else if (pixel_format.type() == PixelType::Float32)
+
+        format = _pixel_format_look_up[(int)pixel_format.cardinality()];
+        if (depth_component)
         {
-            internal_format = GL_DEPTH_COMPONENT32;
+            format = GL_DEPTH_COMPONENT;
         }
-    }
 
-    GLenum format = _pixel_format_look_up[(int)pixel_format.cardinality()];
-    if (depth_component)
-    {
-        format = GL_DEPTH_COMPONENT;
+        type = _pixel_type_look_up[(int)pixel_format.type()];
     }
 
-    GLenum type = _pixel_type_look_up[(int)pixel_format.type()];
-
-    GL_ASSERT(
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            internal_format,
-            image.width(),
-            image.height(),
-            0,
-            format,
-            type,
-            image.has_pixel_data() ? &image.pixel_data()[0] : 0
-        )
-    );
+    const size_t uploaded_size = upload_image_mipmaps(GL_TEXTURE_2D, image, internal_format, format, type);
 
     if (texture.is_mipmapped())
     {
-        GL_ASSERT(glGenerateMipmap(GL_TEXTURE_2D));
+        complete_mipmaps(GL_TEXTURE_2D, image);
     }
 
     GL_ASSERT(glBindTexture(GL_TEXTURE_2D, 0));
 
-    texture.set_as_uploaded(renderer, new Texture2Data(renderer, texture, texture_id));
-    renderer.statistics().memory_usage += texture.width() * texture.height() * texture.pixel_format().size();
+    texture.set_as_uploaded(renderer, new Texture2Data(renderer, texture, texture_id, uploaded_size));
+    renderer.statistics().memory_usage += uploaded_size;
 
     HECT_TRACE(::format("Uploaded texture '%s'", texture.name().data()));
 
@@ -682,11 +890,24 @@ void Renderer::upload_shader(Shader& shader)
         }
     }
 
+    // An instanced shader must read its model matrix from the locations the
+    // instance buffer is bound to
+    if (shader.is_instanced() && !has_instance_attribute(program_id))
+    {
+        throw InvalidOperation(format("Invalid shader: Instanced shader '%s' does not declare a 'mat4' vertex attribute at location %u", shader.name().data(), _instance_attribute_index));
+    }
+
     GL_ASSERT(glUseProgram(program_id));
 
     // Get the locations of each uniform
     for (Uniform& uniform : shader.uniforms())
     {
+        // Uniforms in blocks are submitted through the block
+        if (uniform.is_in_block())
+        {
+            continue;
+        }
+
         GL_ASSERT(int location = glGetUniformLocation(program_id, uniform.name().data()));
 
         if (location != -1)
@@ -699,6 +920,21 @@ void Renderer::upload_shader(Shader& shader)
         }
     }
 
+    // Assign each uniform block to the binding point of its index
+    for (const UniformBlockLayout& layout : shader.uniform_blocks())
+    {
+        GL_ASSERT(GLuint block_index = glGetUniformBlockIndex(program_id, layout.name().data()));
+
+        if (block_index != GL_INVALID_INDEX)
+        {
+            GL_ASSERT(glUniformBlockBinding(program_id, block_index, static_cast<GLuint>(layout.index())));
+        }
+        else
+        {
+            HECT_WARNING(format("Uniform block '%s' is not referenced in shader '%s'", layout.name().data(), shader.name().data()));
+        }
+    }
+
     GL_ASSERT(glUseProgram(0));
 
     shader.set_as_uploaded(*this, new ShaderData(*this, shader, program_id, shader_ids));
@@ -742,6 +978,11 @@ void Renderer::upload_texture(Texture3& texture)
         return;
     }
 
+    if (texture.pixel_format().is_compressed())
+    {
+        throw InvalidOperation("3-dimensional textures cannot be block-compressed");
+    }
+
     GLuint texture_id = 0;
     GL_ASSERT(glGenTextures(1, &texture_id));
     GL_ASSERT(glBindTexture(GL_TEXTURE_3D, texture_id));
@@ -871,37 +1112,39 @@ void Renderer::upload_texture(TextureCube& texture)
         CubeSide::NegativeZ
     };
 
+    size_t uploaded_size = 0;
     for (CubeSide side : sides)
     {
         Image& image = texture.image(side);
         const PixelFormat& pixel_format = image.pixel_format();
 
-        GL_ASSERT(
-            glTexImage2D(
+        if (pixel_format.is_compressed())
+        {
+            uploaded_size += upload_image_mipmaps(target, image, GLint(-1), GLenum(-1), GLenum(-1));
+        }
+        else
+        {
+            uploaded_size += upload_image_mipmaps(
                 target,
-                0,
+                image,
                 _internal_image_format_look_up[(int)image.color_space()][(int)pixel_format.cardinality()][(int)pixel_format.type()],
-                image.width(),
-                image.height(),
-                0,
                 _pixel_format_look_up[(int)pixel_format.cardinality()],
-                _pixel_type_look_up[(int)pixel_format.type()],
-                image.has_pixel_data() ? &image.pixel_data()[0] : 0
-            )
-        );
+                _pixel_type_look_up[(int)pixel_format.type()]
+            );
+        }
 
         ++target;
     }
 
     if (texture.is_mipmapped())
     {
-        GL_ASSERT(glGenerateMipmap(type));
+        complete_mipmaps(type, texture.image(CubeSide::PositiveX));
     }
 
     GL_ASSERT(glBindTexture(type, 0));
 
-    texture.set_as_uploaded(*this, new TextureCubeData(*this, texture, texture_id));
-    statistics().memory_usage += texture.width() * texture.height() * texture.pixel_format().size();
+    texture.set_as_uploaded(*this, new TextureCubeData(*this, texture, texture_id, uploaded_size));
+    statistics().memory_usage += uploaded_size;
 
     HECT_TRACE(format("Uploaded texture '%s'", texture.name().data()));
 
@@ -924,7 +1167,7 @@ void Renderer::destroy_texture(Texture2& texture, bool download_image)
     auto data = texture.data_as<Texture2Data>();
     GL_ASSERT(glDeleteTextures(1, &data->texture_id));
 
-    statistics().memory_usage -= texture.width() * texture.height() * texture.pixel_format().size();
+    statistics().memory_usage -= data->uploaded_size;
     texture.set_as_destroyed();
 
     HECT_TRACE(format("Destroyed texture '%s'", texture.name().data()));
@@ -967,7 +1210,7 @@ void Renderer::destroy_texture(TextureCube& texture, bool download_image)
     auto data = texture.data_as<TextureCubeData>();
     GL_ASSERT(glDeleteTextures(1, &data->texture_id));
 
-    statistics().memory_usage -= texture.width() * texture.height() * texture.pixel_format().size();
+    statistics().memory_usage -= data->uploaded_size;
     texture.set_as_destroyed();
 
     HECT_TRACE(format("Destroyed texture '%s'", texture.name().data()));
@@ -995,18 +1238,26 @@ void Renderer::download_texture_image(Texture2& texture)
     if (!image.has_pixel_data())
     {
         // Allocate the expected amount of pixel data
-        ByteVector pixel_data(pixel_format.size() * width * height, 0);
+        ByteVector pixel_data(pixel_format.image_size(width, height), 0);
         image.set_pixel_data(std::move(pixel_data));
     }
-    GL_ASSERT(
-        glGetTexImage(
-            GL_TEXTURE_2D,
-            0,
-            _pixel_format_look_up[(int)texture.pixel_format().cardinality()],
-            _pixel_type_look_up[(int)texture.pixel_format().type()],
-            &image.pixel_data()[0]
-        )
-    );
+
+    if (pixel_format.is_compressed())
+    {
+        GL_ASSERT(glGetCompressedTexImage(GL_TEXTURE_2D, 0, &image.pixel_data()[0]));
+    }
+    else
+    {
+        GL_ASSERT(
+            glGetTexImage(
+                GL_TEXTURE_2D,
+                0,
+                _pixel_format_look_up[(int)texture.pixel_format().cardinality()],
+                _pixel_type_look_up[(int)texture.pixel_format().type()],
+                &image.pixel_data()[0]
+            )
+        );
+    }
 
     GL_ASSERT(glBindTexture(GL_TEXTURE_2D, 0));
 }
@@ -1076,35 +1327,43 @@ void Renderer::upload_mesh(Mesh& mesh)
     GL_ASSERT(glGenBuffers(1, &vertex_buffer_id));
     GL_ASSERT(glGenBuffers(1, &index_buffer_id));
 
+    // Octahedral attributes are decoded before uploading
+    VertexLayout expanded_vertex_layout;
+    ByteVector expanded_vertex_data;
+    const bool expanded = expand_octahedral_attributes(mesh, expanded_vertex_layout, expanded_vertex_data);
+    const VertexLayout& vertex_layout = expanded ? expanded_vertex_layout : mesh.vertex_layout();
+    const ByteVector& vertex_data = expanded ? expanded_vertex_data : mesh.vertex_data();
+
     // Upload the vertex data
     GL_ASSERT(glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_id));
     GL_ASSERT(
         glBufferData(
             GL_ARRAY_BUFFER,
-            mesh.vertex_layout().vertex_size() * mesh.vertex_count(),
-            !mesh.vertex_data().empty() ? &mesh.vertex_data()[0] : nullptr,
+            vertex_layout.vertex_size() * mesh.vertex_count(),
+            !vertex_data.empty() ? &vertex_data[0] : nullptr,
             GL_STATIC_DRAW
         )
     );
 
     // Describe the vertex layout
     GLuint attribute_index = 0;
-    const VertexLayout& vertex_layout = mesh.vertex_layout();
     for (const VertexAttribute& attribute : vertex_layout.attributes())
     {
         GL_ASSERT(glEnableVertexAttribArray(attribute_index));
 
         size_t offset = attribute.offset();
 
-        if (attribute.type() == VertexAttributeType::Float32)
+        VertexAttributeType type = attribute.type();
+        if (type == VertexAttributeType::Float32 || type == VertexAttributeType::Float16 || type == VertexAttributeType::NormalizedInt16 || type == VertexAttributeType::NormalizedUInt16)
         {
+            const bool normalized = type == VertexAttributeType::NormalizedInt16 || type == VertexAttributeType::NormalizedUInt16;
 
             GL_ASSERT(
                 glVertexAttribPointer(
                     attribute_index,
                     attribute.cardinality(),
                     _vertex_attribute_type_look_up[(int)attribute.type()],
-                    GL_FALSE,
+                    normalized ? GL_TRUE : GL_FALSE,
                     vertex_layout.vertex_size(),
                     reinterpret_cast<GLvoid*>(offset)
                 )
@@ -1166,6 +1425,42 @@ void Renderer::destroy_mesh(Mesh& mesh)
     HECT_TRACE(format("Destroyed mesh '%s'", mesh.name().data()));
 }
 
+void Renderer::upload_uniform_block(UniformBlock& uniform_block)
+{
+    if (uniform_block.is_uploaded())
+    {
+        return;
+    }
+
+    GLuint buffer_id = 0;
+    GL_ASSERT(glGenBuffers(1, &buffer_id));
+    GL_ASSERT(glBindBuffer(GL_UNIFORM_BUFFER, buffer_id));
+    GL_ASSERT(
+        glBufferData(
+            GL_UNIFORM_BUFFER,
+            uniform_block.size(),
+            !uniform_block.data().empty() ? &uniform_block.data()[0] : nullptr,
+            GL_DYNAMIC_DRAW
+        )
+    );
+    GL_ASSERT(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+
+    uniform_block.set_as_uploaded(*this, new UniformBlockData(*this, uniform_block, buffer_id));
+}
+
+void Renderer::destroy_uniform_block(UniformBlock& uniform_block)
+{
+    if (!uniform_block.is_uploaded())
+    {
+        return;
+    }
+
+    auto data = uniform_block.data_as<UniformBlockData>();
+    GL_ASSERT(glDeleteBuffers(1, &data->buffer_id));
+
+    uniform_block.set_as_destroyed();
+}
+
 void Renderer::initialize()
 {
     glewExperimental = GL_TRUE;
@@ -1203,6 +1498,12 @@ void Renderer::initialize()
 
 void Renderer::shutdown()
 {
+    if (_instance_buffer_id)
+    {
+        GL_ASSERT(glDeleteBuffers(1, &_instance_buffer_id));
+        _instance_buffer_id = 0;
+    }
+
     const std::vector<Mesh*> meshes_to_destroy(_uploaded_meshes.begin(), _uploaded_meshes.end());
     for (Mesh* mesh : meshes_to_destroy)
     {
@@ -1353,9 +1654,11 @@ void Renderer::set_shader(Shader& shader)
     // Bind the shader
     auto data = shader.data_as<ShaderData>();
     GL_ASSERT(glUseProgram(data->program_id));
+}
 
+void Renderer::set_blend_mode(const BlendMode& blend_mode)
+{
     // If the blend mode is non-trivial
-    const BlendMode& blend_mode = shader.blend_mode();
     if (blend_mode != BlendMode())
     {
         GL_ASSERT(glEnable(GL_BLEND));
@@ -1373,9 +1676,12 @@ void Renderer::set_shader(Shader& shader)
     {
         GL_ASSERT(glDisable(GL_BLEND));
     }
+}
 
+void Renderer::set_depth_tested(bool depth_tested)
+{
     // Enable or disable depth testing
-    if (shader.is_depth_tested())
+    if (depth_tested)
     {
         GL_ASSERT(glEnable(GL_DEPTH_TEST));
         GL_ASSERT(glDepthMask(GL_TRUE));
@@ -1387,6 +1693,22 @@ void Renderer::set_shader(Shader& shader)
     }
 }
 
+void Renderer::set_point_sprites(bool point_sprites)
+{
+    if (point_sprites)
+    {
+        // Set up the point rendering profile
+        GL_ASSERT(glEnable(GL_PROGRAM_POINT_SIZE));
+        GL_ASSERT(glEnable(GL_POINT_SPRITE));
+        GL_ASSERT(glPointParameteri(GL_POINT_SPRITE_COORD_ORIGIN, GL_LOWER_LEFT));
+    }
+    else
+    {
+        GL_ASSERT(glDisable(GL_PROGRAM_POINT_SIZE));
+        GL_ASSERT(glDisable(GL_POINT_SPRITE));
+    }
+}
+
 void Renderer::set_uniform(const Uniform& uniform, int value)
 {
     const int location = uniform.location();
@@ -1396,60 +1718,48 @@ void Renderer::set_uniform(const Uniform& uniform, int value)
     }
 }
 
-void Renderer::set_uniform(const Uniform& uniform, double value)
+void Renderer::set_uniform(const Uniform& uniform, float value)
 {
     const int location = uniform.location();
     if (location >= 0)
     {
-        GLfloat temp = GLfloat(value);
-        GL_ASSERT(glUniform1f(location, temp));
+        GL_ASSERT(glUniform1f(location, value));
     }
 }
 
-void Renderer::set_uniform(const Uniform& uniform, Vector2 value)
+void Renderer::set_uniform(const Uniform& uniform, FloatVector2 value)
 {
     const int location = uniform.location();
     if (location >= 0)
     {
-        GLfloat temp[2] = { GLfloat(value[0]), GLfloat(value[1]) };
-        GL_ASSERT(glUniform2fv(location, 1, temp));
+        GL_ASSERT(glUniform2f(location, value.x, value.y));
     }
 }
 
-void Renderer::set_uniform(const Uniform& uniform, Vector3 value)
+void Renderer::set_uniform(const Uniform& uniform, FloatVector3 value)
 {
     const int location = uniform.location();
     if (location >= 0)
     {
-        GLfloat temp[3] = { GLfloat(value[0]), GLfloat(value[1]), GLfloat(value[2]) };
-        GL_ASSERT(glUniform3fv(location, 1, temp));
+        GL_ASSERT(glUniform3f(location, value.x, value.y, value.z));
     }
 }
 
-void Renderer::set_uniform(const Uniform& uniform, Vector4 value)
+void Renderer::set_uniform(const Uniform& uniform, FloatVector4 value)
 {
     const int location = uniform.location();
     if (location >= 0)
     {
-        GLfloat temp[4] = { GLfloat(value[0]), GLfloat(value[1]), GLfloat(value[2]), GLfloat(value[3]) };
-        GL_ASSERT(glUniform4fv(location, 1, temp));
+        GL_ASSERT(glUniform4f(location, value.x, value.y, value.z, value.w));
     }
 }
 
-void Renderer::set_uniform(const Uniform& uniform, const Matrix4& value)
+void Renderer::set_uniform(const Uniform& uniform, const FloatMatrix4& value)
 {
     const int location = uniform.location();
     if (location >= 0)
     {
-        GLfloat temp[16] =
-        {
-            GLfloat(value[0]), GLfloat(value[1]), GLfloat(value[2]), GLfloat(value[3]),
-            GLfloat(value[4]), GLfloat(value[5]), GLfloat(value[6]), GLfloat(value[7]),
-            GLfloat(value[8]), GLfloat(value[9]), GLfloat(value[10]), GLfloat(value[11]),
-            GLfloat(value[12]), GLfloat(value[13]), GLfloat(value[14]), GLfloat(value[15])
-        };
-
-        GL_ASSERT(glUniformMatrix4fv(location, 1, false, temp));
+        GL_ASSERT(glUniformMatrix4fv(location, 1, false, &value[0]));
     }
 }
 
@@ -1538,29 +1848,33 @@ void Renderer::set_uniform(const Uniform& uniform, TextureCube& value)
     }
 }
 
-void Renderer::render_mesh(Mesh& mesh)
+void Renderer::bind_uniform_block(const UniformBlockLayout& layout, UniformBlock& uniform_block)
+{
+    auto data = uniform_block.data_as<UniformBlockData>();
+    GL_ASSERT(glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(layout.index()), data->buffer_id));
+}
+
+void Renderer::update_uniform_block(UniformBlock& uniform_block)
+{
+    auto data = uniform_block.data_as<UniformBlockData>();
+    GL_ASSERT(glBindBuffer(GL_UNIFORM_BUFFER, data->buffer_id));
+    GL_ASSERT(glBufferSubData(GL_UNIFORM_BUFFER, 0, uniform_block.size(), &uniform_block.data()[0]));
+    GL_ASSERT(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+}
+
+void Renderer::bind_mesh(Mesh& mesh)
 {
     if (!mesh.is_uploaded())
     {
         upload_mesh(mesh);
     }
 
-    if (mesh.primitive_type() == PrimitiveType::PointSprites)
-    {
-        // Set up the point rendering profile
-        GL_ASSERT(glEnable(GL_PROGRAM_POINT_SIZE));
-        GL_ASSERT(glEnable(GL_POINT_SPRITE));
-        GL_ASSERT(glPointParameteri(GL_POINT_SPRITE_COORD_ORIGIN, GL_LOWER_LEFT));
-    }
-    else
-    {
-        GL_ASSERT(glDisable(GL_PROGRAM_POINT_SIZE));
-        GL_ASSERT(glDisable(GL_POINT_SPRITE));
-    }
-
     auto data = mesh.data_as<MeshData>();
     GL_ASSERT(glBindVertexArray(data->vertex_array_id));
+}
 
+void Renderer::render_mesh(Mesh& mesh)
+{
     GL_ASSERT(
         glDrawElements(
             _primitive_type_look_up[static_cast<int>(mesh.primitive_type())],
@@ -1571,8 +1885,68 @@ void Renderer::render_mesh(Mesh& mesh)
     );
 }
 
+void Renderer::render_mesh_instanced(Mesh& mesh, const FloatMatrix4* model_matrices, size_t instance_count)
+{
+    static_assert(sizeof(FloatMatrix4) == 16 * sizeof(GLfloat), "Model matrices must be tightly packed single-precision matrices");
+
+    if (!_instance_buffer_id)
+    {
+        GL_ASSERT(glGenBuffers(1, &_instance_buffer_id));
+    }
+
+    // The model matrices are already single-precision so they are streamed
+    // into the buffer as they are
+    GL_ASSERT(glBindBuffer(GL_ARRAY_BUFFER, _instance_buffer_id));
+    GL_ASSERT(
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            instance_count * sizeof(FloatMatrix4),
+            model_matrices,
+            GL_STREAM_DRAW
+        )
+    );
+
+    // Describe the model matrix as four per-instance column attributes on
+    // the bound vertex array
+    const GLsizei stride = 16 * sizeof(GLfloat);
+    for (GLuint column = 0; column < 4; ++column)
+    {
+        const GLuint attribute_index = _instance_attribute_index + column;
+        GL_ASSERT(glEnableVertexAttribArray(attribute_index));
+        GL_ASSERT(
+            glVertexAttribPointer(
+                attribute_index,
+                4,
+                GL_FLOAT,
+                GL_FALSE,
+                stride,
+                reinterpret_cast<GLvoid*>(column * 4 * sizeof(GLfloat))
+            )
+        );
+        GL_ASSERT(glVertexAttribDivisor(attribute_index, 1));
+    }
+
+    GL_ASSERT(
+        glDrawElementsInstanced(
+            _primitive_type_look_up[static_cast<int>(mesh.primitive_type())],
+            static_cast<GLsizei>(mesh.index_count()),
+            _index_type_look_up[static_cast<int>(mesh.index_type())],
+            0,
+            static_cast<GLsizei>(instance_count)
+        )
+    );
+
+    // Restore the vertex array so non-instanced render calls are unaffected
+    for (GLuint column = 0; column < 4; ++column)
+    {
+        GL_ASSERT(glDisableVertexAttribArray(_instance_attribute_index + column));
+    }
+}
+
 void Renderer::render_viewport()
 {
+    set_point_sprites(false);
+    bind_mesh(_viewport_mesh);
     render_mesh(_viewport_mesh);
 }
 
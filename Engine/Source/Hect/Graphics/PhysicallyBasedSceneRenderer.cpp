@@ -24,7 +24,9 @@
 #include "PhysicallyBasedSceneRenderer.h"
 
 #include <algorithm>
+#include <cmath>
 
+#include "Hect/Core/RadixSort.h"
 #include "Hect/Math/Constants.h"
 #include "Hect/Runtime/Engine.h"
 #include "Hect/Scene/Components/BoundingBoxComponent.h"
@@ -35,6 +37,128 @@
 
 using namespace hect;
 
+namespace
+{
+
+// The layout of a render call sort key from the most significant bit:
+//
+// Opaque:      stage | priority | shader | material | mesh | depth
+// Translucent: stage | priority | depth (inverted) | shader | material | mesh
+//
+// Opaque calls are grouped by state and then rendered front-to-back while
+// translucent calls must be rendered back-to-front regardless of state
+const unsigned StageBits = 2;
+const unsigned PriorityBits = 8;
+const unsigned ShaderBits = 12;
+const unsigned MaterialBits = 14;
+const unsigned MeshBits = 12;
+const unsigned DepthBits = 16;
+
+static_assert(StageBits + PriorityBits + ShaderBits + MaterialBits + MeshBits + DepthBits == 64, "Render call sort key must be 64 bits");
+
+const unsigned StageShift = 64 - StageBits;
+const unsigned PriorityShift = StageShift - PriorityBits;
+
+// The fewest geometry components worth building render calls for in a
+// separate task
+const size_t MinGeometryPerTask = 64;
+
+// The largest simplification error in pixels tolerated when selecting the
+// level of detail of a mesh
+const double LevelOfDetailPixelError = 1.0;
+
+// The fraction of the tolerated error by which the error of a level of detail
+// must cross the threshold before a different level is selected
+const double LevelOfDetailHysteresis = 0.25;
+
+// The number of frames a camera may go without rendering a surface before
+// the level of detail it last rendered the surface at is dropped
+const uint64_t LevelOfDetailRetainedFrames = 120;
+
+// The most cameras a surface keeps the last rendered level of detail for
+const size_t MaxLevelOfDetailCameras = 4;
+
+// Returns the level of detail last rendered for a surface by a camera,
+// adding it as the most detailed level if the camera has not rendered the
+// surface recently; levels of cameras which were destroyed or have not
+// rendered the surface recently are dropped along the way
+size_t& level_of_detail_for_camera(GeometrySurface& surface, const EntityHandle& camera, uint64_t frame)
+{
+    typedef GeometrySurface::CameraLevelOfDetail CameraLevelOfDetail;
+    std::vector<CameraLevelOfDetail>& levels_of_detail = surface.levels_of_detail;
+
+    // Every frame is rendered from the entity of a camera, so the entries are
+    // never shared by frames without a camera
+    assert(camera);
+
+    // Drop the levels of cameras which were destroyed or have not rendered
+    // the surface recently
+    levels_of_detail.erase(std::remove_if(levels_of_detail.begin(), levels_of_detail.end(), [&](const CameraLevelOfDetail& level_of_detail)
+    {
+        return level_of_detail.camera != camera && (frame - level_of_detail.frame > LevelOfDetailRetainedFrames || !level_of_detail.camera);
+    }), levels_of_detail.end());
+
+    auto it = std::find_if(levels_of_detail.begin(), levels_of_detail.end(), [&](const CameraLevelOfDetail& level_of_detail)
+    {
+        return level_of_detail.camera == camera;
+    });
+
+    if (it == levels_of_detail.end())
+    {
+        // Replace the level of the camera which rendered the surface least
+        // recently if there are too many
+        if (levels_of_detail.size() >= MaxLevelOfDetailCameras)
+        {
+            levels_of_detail.erase(std::min_element(levels_of_detail.begin(), levels_of_detail.end(), [](const CameraLevelOfDetail& a, const CameraLevelOfDetail& b)
+            {
+                return a.frame < b.frame;
+            }));
+        }
+
+        CameraLevelOfDetail level_of_detail;
+        level_of_detail.camera = camera;
+        levels_of_detail.push_back(level_of_detail);
+        it = levels_of_detail.end() - 1;
+    }
+
+    it->frame = frame;
+    return it->level;
+}
+
+// Returns the model matrix of a transform; computed while building render
+// calls rather than stored in every transform
+Matrix4 compute_model_matrix(const TransformComponent& transform)
+{
+    Matrix4 matrix;
+
+    // Translate the matrix to the global position
+    if (transform.global_position != Vector3::Zero)
+    {
+        matrix.translate(transform.global_position);
+    }
+
+    // Scale the matrix by the global scale
+    if (transform.global_scale != Vector3::Zero)
+    {
+        matrix.scale(transform.global_scale);
+    }
+
+    // Rotate the matrix by the global rotation
+    if (transform.global_rotation != Quaternion())
+    {
+        matrix.rotate(transform.global_rotation);
+    }
+
+    return matrix;
+}
+
+uint64_t max_value(unsigned bits)
+{
+    return (uint64_t(1) << bits) - 1;
+}
+
+}
+
 PhysicallyBasedSceneRenderer::PhysicallyBasedSceneRenderer(AssetCache& asset_cache, TaskPool& task_pool) :
     _task_pool(task_pool),
     _composite_shader(asset_cache, HECT_ASSET("Hect/Rendering/Composite.shader")),
@@ -57,22 +181,9 @@ void PhysicallyBasedSceneRenderer::enqueue_render_call(const TransformComponent&
 
 void PhysicallyBasedSceneRenderer::enqueue_render_call(const TransformComponent& transform, Mesh& mesh, Material& material)
 {
-    const AssetHandle<Shader>& shader = material.shader();
-    if (shader)
+    if (material.shader())
     {
-        switch (shader->render_stage())
-        {
-        case RenderStage::PrePhysicalGeometry:
-            _frame_data.pre_physical_geometry.emplace_back(transform, mesh, material);
-            break;
-        case RenderStage::PhysicalGeometry:
-            _frame_data.opaque_physical_geometry.emplace_back(transform, mesh, material);
-            break;
-        case RenderStage::PostPhysicalGeometry:
-        case RenderStage::None:
-            _frame_data.post_physical_geometry.emplace_back(transform, mesh, material);
-            break;
-        }
+        route_render_call(RenderCall(transform, compute_model_matrix(transform), mesh, material));
     }
 }
 
@@ -160,9 +271,14 @@ void PhysicallyBasedSceneRenderer::prepare_frame(Scene& scene, CameraSystem& cam
     // next frame
     _frame_data.clear();
     _frame_data.geometry_buffer = &geometry_buffer;
+    ++_frame_index;
 
-    // Update the camera transform
+    // Update the camera transform; the sky box is rendered around it
     _frame_data.camera_transform.global_position = camera.position;
+    _frame_data.camera_entity = camera.entity().handle();
+    _frame_data.camera_front = camera.front;
+    _frame_data.camera_far_clip = camera.far_clip;
+    _frame_data.level_of_detail_scale = target.height() * 0.5 / std::tan(Radians(camera.field_of_view).value * 0.5);
 
     // Update the camera's aspect ratio if needed
     if (camera.aspect_ratio != target.aspect_ratio())
@@ -172,6 +288,10 @@ void PhysicallyBasedSceneRenderer::prepare_frame(Scene& scene, CameraSystem& cam
         camera_system.update_camera(camera);
     }
 
+    // Compute the camera products shared by all render calls of the frame
+    _frame_data.view_projection_matrix = camera.projection_matrix * camera.view_matrix;
+    _frame_data.camera_one_over_gamma = 1.0 / camera.gamma;
+
     // Get the cube map of the active light probe
     auto light_probe = scene.components<LightProbeComponent>().begin();
     if (light_probe && light_probe->texture)
@@ -186,13 +306,19 @@ void PhysicallyBasedSceneRenderer::prepare_frame(Scene& scene, CameraSystem& cam
         _frame_data.sky_box_texture = &*sky_box->texture;
     }
 
-    // Build all render calls and sort by priority
-    for (Entity& entity : scene.entities())
+    // Build all render calls
+    build_render_calls(camera, scene);
+
+    // Fill the bound uniform blocks of every shader used in the frame once
+    // so that each render call only needs to bind them
+    for (Shader* shader : { &*_composite_shader, &*_directional_light_shader, &*_environment_shader, &*_expose_shader })
     {
-        if (!entity.parent())
-        {
-            build_render_calls(camera, entity);
-        }
+        prepare_bound_uniform_blocks(*shader);
+    }
+
+    for (Shader* shader : _frame_data.uniform_block_shaders)
+    {
+        fill_bound_uniform_blocks(*shader, camera, target);
     }
 
     // Add each directional light to the frame data
@@ -201,31 +327,19 @@ void PhysicallyBasedSceneRenderer::prepare_frame(Scene& scene, CameraSystem& cam
         _frame_data.directional_lights.push_back(&light);
     }
 
-    std::vector<Task::Handle> sorting_tasks;
-
-    // Spin up a task to sort the pre-physical geometry render calls
-    sorting_tasks.push_back(_task_pool.enqueue([this]
-    {
-        std::vector<RenderCall>& render_calls = _frame_data.pre_physical_geometry;
-        std::sort(render_calls.begin(), render_calls.end());
-    }));
-
-    // Spin up a task to sort the opaque physical geometry render calls
-    sorting_tasks.push_back(_task_pool.enqueue([this]
-    {
-        std::vector<RenderCall>& render_calls = _frame_data.opaque_physical_geometry;
-        std::sort(render_calls.begin(), render_calls.end());
-    }));
-
-    // Spin up a task to sort the translucent physical geometry render calls
-    sorting_tasks.push_back(_task_pool.enqueue([this]
+    // Spin up a task to compute the sort keys of and sort the render calls
+    // of each queue
+    _tasks.clear();
+    for (RenderCallQueue* queue : { &_frame_data.pre_physical_geometry, &_frame_data.opaque_physical_geometry, &_frame_data.translucent_physical_geometry, &_frame_data.post_physical_geometry })
     {
-        std::vector<RenderCall>& render_calls = _frame_data.translucent_physical_geometry;
-        std::sort(render_calls.begin(), render_calls.end());
-    }));
+        _tasks.push_back(_task_pool.enqueue([this, queue]
+        {
+            sort_queued_calls(*queue);
+        }));
+    }
 
     // Wait until all sorting tasks complete
-    for (Task::Handle& task : sorting_tasks)
+    for (Task::Handle& task : _tasks)
     {
         task->wait();
     }
@@ -235,86 +349,96 @@ void PhysicallyBasedSceneRenderer::render_frame(CameraComponent& camera, Rendere
 {
     GeometryBuffer& geometry_buffer = *_frame_data.geometry_buffer;
 
+    // Record the commands for the opaque geometry stages in parallel
+    Task::Handle pre_physical_task = record_queued_calls_async(camera, target, _frame_data.pre_physical_geometry);
+    Task::Handle opaque_physical_task = record_queued_calls_async(camera, target, _frame_data.opaque_physical_geometry);
+
     // Opaque geometry rendering
     {
         Renderer::Frame frame = renderer.begin_frame(geometry_buffer.frame_buffer());
         frame.clear(camera.clear_color);
 
         // Render pre-physical geometry
-        for (RenderCall& render_call : _frame_data.pre_physical_geometry)
-        {
-            render_mesh(frame, camera, target, *render_call.material, *render_call.mesh, *render_call.transform);
-        }
+        pre_physical_task->wait();
+        frame.submit(_frame_data.pre_physical_geometry.commands);
 
         // Render opaque physical geometry
-        for (RenderCall& render_call : _frame_data.opaque_physical_geometry)
-        {
-            render_mesh(frame, camera, target, *render_call.material, *render_call.mesh, *render_call.transform);
-        }
+        opaque_physical_task->wait();
+        frame.submit(_frame_data.opaque_physical_geometry.commands);
     }
 
     // Light rendering
     {
-        Renderer::Frame frame = renderer.begin_frame(geometry_buffer.back_frame_buffer());
-        frame.clear(Color::Zero, false);
+        _commands.clear();
 
         // Render environment light
         if (_frame_data.light_probe_texture)
         {
-            frame.set_shader(*_environment_shader);
-            set_bound_uniforms(frame, *_environment_shader, camera, target, TransformComponent::Identity);
-            frame.render_viewport();
+            _commands.set_shader(*_environment_shader);
+            set_bound_uniforms(_commands, *_environment_shader, camera, target, Matrix4());
+            _commands.render_viewport();
         }
 
         // Render each directional light in the scene
         if (!_frame_data.directional_lights.empty())
         {
-            frame.set_shader(*_directional_light_shader);
+            _commands.set_shader(*_directional_light_shader);
             for (const DirectionalLightComponent* light : _frame_data.directional_lights)
             {
                 _frame_data.primary_light_direction = light->direction;
                 _frame_data.primary_light_color = light->color;
-                set_bound_uniforms(frame, *_directional_light_shader, camera, target, TransformComponent::Identity);
-                frame.render_viewport();
+                set_bound_uniforms(_commands, *_directional_light_shader, camera, target, Matrix4());
+                _commands.render_viewport();
             }
         }
+
+        Renderer::Frame frame = renderer.begin_frame(geometry_buffer.back_frame_buffer());
+        frame.clear(Color::Zero, false);
+        frame.submit(_commands);
     }
 
     geometry_buffer.swap_back_buffers();
 
+    // Record the commands for the translucent and post-physical geometry
+    // stages in parallel; this must follow the swap since the stages may
+    // sample the last back buffer
+    Task::Handle translucent_physical_task = record_queued_calls_async(camera, target, _frame_data.translucent_physical_geometry);
+    Task::Handle post_physical_task = record_queued_calls_async(camera, target, _frame_data.post_physical_geometry);
+
     // Composite
     {
+        _commands.clear();
+        _commands.set_shader(*_composite_shader);
+        set_bound_uniforms(_commands, *_composite_shader, camera, target, Matrix4());
+        _commands.render_viewport();
+
         Renderer::Frame frame = renderer.begin_frame(geometry_buffer.back_frame_buffer());
         frame.clear(Color::Zero, false);
 
         // Composite
-        frame.set_shader(*_composite_shader);
-        set_bound_uniforms(frame, *_composite_shader, camera, target, TransformComponent::Identity);
-        frame.render_viewport();
+        frame.submit(_commands);
 
         // Render translucent geometry
-        for (RenderCall& render_call : _frame_data.translucent_physical_geometry)
-        {
-            render_mesh(frame, camera, target, *render_call.material, *render_call.mesh, *render_call.transform);
-        }
+        translucent_physical_task->wait();
+        frame.submit(_frame_data.translucent_physical_geometry.commands);
 
         // Render post-physical geometry
-        for (RenderCall& render_call : _frame_data.post_physical_geometry)
-        {
-            render_mesh(frame, camera, target, *render_call.material, *render_call.mesh, *render_call.transform);
-        }
+        post_physical_task->wait();
+        frame.submit(_frame_data.post_physical_geometry.commands);
     }
 
     geometry_buffer.swap_back_buffers();
 
     // Expose
     {
+        _commands.clear();
+        _commands.set_shader(*_expose_shader);
+        set_bound_uniforms(_commands, *_expose_shader, camera, target, Matrix4());
+        _commands.render_viewport();
+
         Renderer::Frame frame = renderer.begin_frame(target);
         frame.clear(camera.clear_color);
-        frame.set_shader(*_expose_shader);
-        set_bound_uniforms(frame, *_expose_shader, camera, target, TransformComponent::Identity);
-
-        frame.render_viewport();
+        frame.submit(_commands);
     }
 }
 
@@ -327,7 +451,10 @@ void PhysicallyBasedSceneRenderer::upload_render_objects_for_scene(Scene& scene,
             Mesh& mesh = *surface.mesh;
             Material& material = *surface.material;
 
-            renderer.upload_mesh(mesh);
+            for (size_t level = 0; level < mesh.level_of_detail_count(); ++level)
+            {
+                renderer.upload_mesh(mesh.level_of_detail(level));
+            }
             renderer.upload_shader(*material.shader());
             for (UniformValue& uniform_value : material.uniform_values())
             {
@@ -345,232 +472,698 @@ void PhysicallyBasedSceneRenderer::upload_render_objects_for_scene(Scene& scene,
     }
 }
 
-void PhysicallyBasedSceneRenderer::build_render_calls(CameraComponent& camera, Entity& entity, bool frustum_test)
+void PhysicallyBasedSceneRenderer::build_render_calls(const CameraComponent& camera, Scene& scene)
 {
-    // By default, assume that the entity is visible
-    bool visible = true;
+    // Gather the geometry so it can be split into ranges
+    _geometry_components.clear();
+    for (GeometryComponent& geometry : scene.components<GeometryComponent>())
+    {
+        _geometry_components.push_back(&geometry);
+    }
 
-    // If we need to test this entity against the frustum
-    if (frustum_test)
+    // Split the geometry into one range per worker thread unless the ranges
+    // would be too small to be worth the overhead of a task
+    const size_t geometry_count = _geometry_components.size();
+    const size_t max_task_count = (geometry_count + MinGeometryPerTask - 1) / MinGeometryPerTask;
+    const size_t task_count = std::max(size_t(1), std::min(_task_pool.thread_count(), max_task_count));
+    if (_render_call_arenas.size() < task_count)
     {
-        if (entity.has_component<BoundingBoxComponent>())
-        {
-            auto& bounding_box = entity.component<BoundingBoxComponent>();
+        _render_call_arenas.resize(task_count);
+    }
 
-            // Test the bounding box against the frustum
-            FrustumTestResult result = camera.frustum.test_axis_aligned_box(bounding_box.globalExtents);
-            if (result == FrustumTestResult::Inside)
-            {
-                // No need to test any children
-                frustum_test = false;
-            }
-            else if (result == FrustumTestResult::Intersect)
-            {
-                // Need to test children
-                frustum_test = true;
-            }
-            else
-            {
-                // The entity is outside of the frustum
-                visible = false;
-            }
+    // Test each entity with children against the frustum once so that the
+    // tasks do not re-test the ancestors of every entity
+    for (const Entity& entity : scene.entities())
+    {
+        if (!entity.parent())
+        {
+            test_ancestor_frustums(camera, entity, FrustumTestResult::Intersect);
         }
     }
 
-    // If the entity is visible
-    if (visible)
+    // Resolve the default material before any asset is accessed concurrently
+    Material& default_material = *_default_material;
+
+    // Spin up a task to build the render calls of each range into its own
+    // arena
+    _tasks.clear();
+    for (size_t i = 0; i < task_count; ++i)
     {
-        if (entity.has_component<GeometryComponent>())
+        const size_t begin = geometry_count * i / task_count;
+        const size_t end = geometry_count * (i + 1) / task_count;
+        RenderCallArena& arena = _render_call_arenas[i];
+
+        _tasks.push_back(_task_pool.enqueue([this, &camera, &default_material, begin, end, &arena]
         {
-            auto& geometry = entity.component<GeometryComponent>();
-            if (geometry.visible)
-            {
-                // Render the mesh surfaces
-                for (const GeometrySurface& surface : geometry.surfaces)
-                {
-                    if (!surface.visible)
-                    {
-                        continue;
-                    }
-
-                    Mesh& mesh = *surface.mesh;
-
-                    TransformComponent transform = TransformComponent::Identity;
-
-                    if (entity.has_component<TransformComponent>())
-                    {
-                        auto& transform_component = entity.component<TransformComponent>();
-                        transform = transform_component;
-                    }
-
-                    if (surface.material)
-                    {
-                        enqueue_render_call(transform, mesh, *surface.material);
-                    }
-                    else
-                    {
-                        enqueue_render_call(transform, mesh);
-                    }
-                }
-            }
+            build_arena_render_calls(camera, default_material, begin, end, arena);
+        }));
+    }
+
+    // Merge the arenas in order so the result does not depend on the
+    // scheduling of the tasks
+    for (size_t i = 0; i < task_count; ++i)
+    {
+        _tasks[i]->wait();
+
+        for (const RenderCall& render_call : _render_call_arenas[i].render_calls)
+        {
+            route_render_call(render_call);
         }
+    }
 
-        if (entity.has_component<SkyBoxComponent>())
+    // Render sky boxes around the camera
+    for (const SkyBoxComponent& sky_box : scene.components<SkyBoxComponent>())
+    {
+        if (test_frustum(camera, sky_box.entity()) != FrustumTestResult::Outside)
         {
             enqueue_render_call(_frame_data.camera_transform, *_sky_box_mesh, *_sky_box_material);
         }
+    }
+}
+
+void PhysicallyBasedSceneRenderer::build_arena_render_calls(const CameraComponent& camera, Material& default_material, size_t begin, size_t end, RenderCallArena& arena)
+{
+    arena.render_calls.clear();
 
-        // Render all children
-        for (Entity& child : entity.children())
+    for (size_t i = begin; i < end; ++i)
+    {
+        GeometryComponent& geometry = *_geometry_components[i];
+        if (!geometry.visible)
+        {
+            continue;
+        }
+
+        const Entity& entity = geometry.entity();
+        if (test_frustum(camera, entity) == FrustumTestResult::Outside)
+        {
+            continue;
+        }
+
+        // The render call refers to the transform until the frame is
+        // rendered so it must not be a temporary
+        const TransformComponent* transform = &TransformComponent::Identity;
+        if (entity.has_component<TransformComponent>())
+        {
+            transform = &entity.component<TransformComponent>();
+        }
+
+        // The model matrix is shared by all surfaces of the geometry
+        const Matrix4 model = compute_model_matrix(*transform);
+
+        // Render the mesh surfaces
+        for (GeometrySurface& surface : geometry.surfaces)
         {
-            build_render_calls(camera, child, frustum_test);
+            if (!surface.visible)
+            {
+                continue;
+            }
+
+            Material& material = surface.material ? *surface.material : default_material;
+            if (material.shader())
+            {
+                Mesh& mesh = *surface.mesh;
+                size_t& level_of_detail = level_of_detail_for_camera(surface, _frame_data.camera_entity, _frame_index);
+                level_of_detail = select_level_of_detail(mesh, model, *transform, level_of_detail);
+                arena.render_calls.push_back(RenderCall(*transform, model, mesh.level_of_detail(level_of_detail), material));
+            }
         }
     }
 }
 
-void PhysicallyBasedSceneRenderer::render_mesh(Renderer::Frame& frame, const CameraComponent& camera, const RenderTarget& target, Material& material, Mesh& mesh, const TransformComponent& transform)
+size_t PhysicallyBasedSceneRenderer::select_level_of_detail(const Mesh& mesh, const Matrix4& model, const TransformComponent& transform, size_t last_level) const
 {
-    Shader& shader = *material.shader();
+    const size_t level_count = mesh.level_of_detail_count();
+    const AxisAlignedBox& bounds = mesh.axis_aligned_box();
+    if (level_count == 1 || !bounds.has_size())
+    {
+        return 0;
+    }
 
-    // Set the shader
-    frame.set_shader(shader);
-    set_bound_uniforms(frame, shader, camera, target, transform);
+    // Project the error of a level, which is relative to the radius of the
+    // mesh, to the number of pixels it spans on the screen
+    const Vector3 scale = transform.global_scale;
+    const double radius = (bounds.maximum() - bounds.minimum()).length() * 0.5 * std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z)));
+    const Vector3 center = model * bounds.center();
+    const double distance = (center - _frame_data.camera_transform.global_position).length();
+    if (distance <= radius)
+    {
+        return 0;
+    }
 
-    // Set the uniform values of the material
-    UniformIndex index = 0;
-    for (const UniformValue& value : material.uniform_values())
+    const double pixels_per_error = radius * _frame_data.level_of_detail_scale / distance;
+    auto projected_error = [&](size_t level)
     {
-        if (value)
+        return mesh.level_of_detail(level).simplification_error() * pixels_per_error;
+    };
+
+    // Only switch once the error is clearly past the threshold so that a
+    // mesh near the threshold does not alternate between levels
+    size_t level = std::min(last_level, level_count - 1);
+    while (level > 0 && projected_error(level) > LevelOfDetailPixelError * (1.0 + LevelOfDetailHysteresis))
+    {
+        --level;
+    }
+    while (level + 1 < level_count && projected_error(level + 1) < LevelOfDetailPixelError * (1.0 - LevelOfDetailHysteresis))
+    {
+        ++level;
+    }
+
+    return level;
+}
+
+void PhysicallyBasedSceneRenderer::test_ancestor_frustums(const CameraComponent& camera, const Entity& entity, FrustumTestResult parent_result)
+{
+    if (!entity.has_children())
+    {
+        return;
+    }
+
+    // The descendants of an entity inside or outside of the frustum share
+    // its result without being tested
+    FrustumTestResult result = parent_result;
+    if (result == FrustumTestResult::Intersect && entity.has_component<BoundingBoxComponent>())
+    {
+        const auto& bounding_box = entity.component<BoundingBoxComponent>();
+        result = camera.frustum.test_axis_aligned_box(bounding_box.globalExtents);
+    }
+
+    const EntityId id = entity.id();
+    if (id >= _ancestor_frustum_results.size())
+    {
+        _ancestor_frustum_results.resize(id + 1, FrustumTestResult::Intersect);
+    }
+    _ancestor_frustum_results[id] = result;
+
+    for (const Entity& child : entity.children())
+    {
+        test_ancestor_frustums(camera, child, result);
+    }
+}
+
+FrustumTestResult PhysicallyBasedSceneRenderer::test_frustum(const CameraComponent& camera, const Entity& entity) const
+{
+    // An entity is only tested if its parent intersects the frustum; the
+    // results of all parents were found before culling began
+    EntityHandle parent = entity.parent();
+    if (parent)
+    {
+        assert(parent->id() < _ancestor_frustum_results.size());
+        const FrustumTestResult result = _ancestor_frustum_results[parent->id()];
+        if (result != FrustumTestResult::Intersect)
         {
-            const Uniform& uniform = shader.uniform(index);
-            frame.set_uniform(uniform, value);
+            return result;
         }
-        ++index;
     }
 
-    // Render the mesh
-    frame.set_cull_mode(material.cull_mode());
-    frame.render_mesh(mesh);
+    // Entities without a bounding box are assumed to be visible
+    if (entity.has_component<BoundingBoxComponent>())
+    {
+        const auto& bounding_box = entity.component<BoundingBoxComponent>();
+        return camera.frustum.test_axis_aligned_box(bounding_box.globalExtents);
+    }
+
+    return FrustumTestResult::Intersect;
 }
 
-void PhysicallyBasedSceneRenderer::set_bound_uniforms(Renderer::Frame& frame, Shader& shader, const CameraComponent& camera, const RenderTarget& target, const TransformComponent& transform)
+void PhysicallyBasedSceneRenderer::route_render_call(const RenderCall& render_call)
 {
-    // Buid the model matrix
-    Matrix4 model;
+    // Uniform blocks are built while routing since routing is serial and
+    // recording is not
+    prepare_uniform_blocks(*render_call.material);
 
-    // Translate the matrix to the global position
-    if (transform.global_position != Vector3::Zero)
+    switch (render_call.material->shader()->render_stage())
     {
-        model.translate(transform.global_position);
+    case RenderStage::PrePhysicalGeometry:
+        _frame_data.pre_physical_geometry.enqueue(render_call);
+        break;
+    case RenderStage::PhysicalGeometry:
+        _frame_data.opaque_physical_geometry.enqueue(render_call);
+        break;
+    case RenderStage::PostPhysicalGeometry:
+    case RenderStage::None:
+        _frame_data.post_physical_geometry.enqueue(render_call);
+        break;
     }
+}
 
-    // Scale the matrix by the global scale
-    if (transform.global_scale != Vector3::Zero)
+void PhysicallyBasedSceneRenderer::render_mesh(RenderCommandBuffer& commands, const CameraComponent& camera, const RenderTarget& target, Material& material, Mesh& mesh, const FloatMatrix4& model)
+{
+    set_material(commands, camera, target, material, model);
+
+    // Render the mesh
+    commands.render_mesh(mesh);
+}
+
+void PhysicallyBasedSceneRenderer::render_mesh_instanced(RenderCommandBuffer& commands, const CameraComponent& camera, const RenderTarget& target, Material& material, Mesh& mesh, const std::vector<FloatMatrix4>& model_matrices)
+{
+    // The model matrix of each instance is read from the instance buffer
+    set_material(commands, camera, target, material, Matrix4());
+
+    // Render all instances of the mesh
+    commands.render_mesh_instanced(mesh, model_matrices.data(), model_matrices.size());
+}
+
+void PhysicallyBasedSceneRenderer::set_material(RenderCommandBuffer& commands, const CameraComponent& camera, const RenderTarget& target, Material& material, const Matrix4& model)
+{
+    Shader& shader = *material.shader();
+
+    // Set the shader
+    commands.set_shader(shader);
+    set_bound_uniforms(commands, shader, camera, target, model);
+
+    // Set the uniform values of the material which are not in a block
+    UniformIndex index = 0;
+    for (const UniformValue& value : material.uniform_values())
     {
-        model.scale(transform.global_scale);
+        if (value)
+        {
+            const Uniform& uniform = shader.uniform(index);
+            if (!uniform.is_in_block())
+            {
+                commands.set_uniform(uniform, value);
+            }
+        }
+        ++index;
     }
 
-    // Rotate the matrix by the global rotation
-    if (transform.global_rotation != Quaternion())
+    // Set the uniform blocks of the material
+    for (const UniformBlockLayout& layout : shader.uniform_blocks())
     {
-        model.rotate(transform.global_rotation);
+        if (!layout.is_bound())
+        {
+            commands.set_uniform_block(layout, material.uniform_block(layout.index()));
+        }
     }
 
-    for (const Uniform& uniform : shader.uniforms())
+    commands.set_cull_mode(material.cull_mode());
+}
+
+void PhysicallyBasedSceneRenderer::set_bound_uniforms(RenderCommandBuffer& commands, Shader& shader, const CameraComponent& camera, const RenderTarget& target, const Matrix4& model)
+{
+    for (UniformIndex index : shader.bound_uniform_indices())
     {
-        UniformBinding binding = uniform.binding();
-        switch (binding)
+        const Uniform& uniform = shader.uniform(index);
+        switch (uniform.binding())
         {
         case UniformBinding::None:
             break;
         case UniformBinding::RenderTargetSize:
-            frame.set_uniform(uniform, Vector2(static_cast<double>(target.width()), static_cast<double>(target.height())));
+            commands.set_uniform(uniform, Vector2(static_cast<double>(target.width()), static_cast<double>(target.height())));
             break;
         case UniformBinding::CameraPosition:
-            frame.set_uniform(uniform, camera.position);
+            commands.set_uniform(uniform, camera.position);
             break;
         case UniformBinding::CameraFront:
-            frame.set_uniform(uniform, camera.front);
+            commands.set_uniform(uniform, camera.front);
             break;
         case UniformBinding::CameraUp:
-            frame.set_uniform(uniform, camera.up);
+            commands.set_uniform(uniform, camera.up);
             break;
         case UniformBinding::CameraExposure:
-            frame.set_uniform(uniform, camera.exposure);
+            commands.set_uniform(uniform, camera.exposure);
             break;
         case UniformBinding::CameraOneOverGamma:
-            frame.set_uniform(uniform, 1.0 / camera.gamma);
+            commands.set_uniform(uniform, _frame_data.camera_one_over_gamma);
             break;
         case UniformBinding::PrimaryLightDirection:
-            frame.set_uniform(uniform, _frame_data.primary_light_direction);
+            commands.set_uniform(uniform, _frame_data.primary_light_direction);
             break;
         case UniformBinding::PrimaryLightColor:
-            frame.set_uniform(uniform, _frame_data.primary_light_color);
+            commands.set_uniform(uniform, _frame_data.primary_light_color);
             break;
         case UniformBinding::ViewMatrix:
-            frame.set_uniform(uniform, camera.view_matrix);
+            commands.set_uniform(uniform, camera.view_matrix);
             break;
         case UniformBinding::ProjectionMatrix:
-            frame.set_uniform(uniform, camera.projection_matrix);
+            commands.set_uniform(uniform, camera.projection_matrix);
             break;
         case UniformBinding::ViewProjectionMatrix:
-            frame.set_uniform(uniform, camera.projection_matrix * camera.view_matrix);
+            commands.set_uniform(uniform, _frame_data.view_projection_matrix);
             break;
         case UniformBinding::ModelMatrix:
-            frame.set_uniform(uniform, model);
+            commands.set_uniform(uniform, model);
             break;
         case UniformBinding::ModelViewMatrix:
-            frame.set_uniform(uniform, camera.view_matrix * model);
+            commands.set_uniform(uniform, camera.view_matrix * model);
             break;
         case UniformBinding::ModelViewProjectionMatrix:
-            frame.set_uniform(uniform, camera.projection_matrix * (camera.view_matrix * model));
+            commands.set_uniform(uniform, _frame_data.view_projection_matrix * model);
             break;
         case UniformBinding::LightProbeTexture:
             assert(_frame_data.light_probe_texture);
-            frame.set_uniform(uniform, *_frame_data.light_probe_texture);
+            commands.set_uniform(uniform, *_frame_data.light_probe_texture);
             break;
         case UniformBinding::SkyBoxTexture:
             assert(_frame_data.sky_box_texture);
-            frame.set_uniform(uniform, *_frame_data.sky_box_texture);
+            commands.set_uniform(uniform, *_frame_data.sky_box_texture);
             break;
         case UniformBinding::DiffuseBuffer:
             assert(_frame_data.geometry_buffer);
-            frame.set_uniform(uniform, _frame_data.geometry_buffer->diffuse_buffer());
+            commands.set_uniform(uniform, _frame_data.geometry_buffer->diffuse_buffer());
             break;
         case UniformBinding::MaterialBuffer:
             assert(_frame_data.geometry_buffer);
-            frame.set_uniform(uniform, _frame_data.geometry_buffer->material_buffer());
+            commands.set_uniform(uniform, _frame_data.geometry_buffer->material_buffer());
             break;
         case UniformBinding::PositionBuffer:
             assert(_frame_data.geometry_buffer);
-            frame.set_uniform(uniform, _frame_data.geometry_buffer->position_buffer());
+            commands.set_uniform(uniform, _frame_data.geometry_buffer->position_buffer());
             break;
         case UniformBinding::NormalBuffer:
             assert(_frame_data.geometry_buffer);
-            frame.set_uniform(uniform, _frame_data.geometry_buffer->normal_buffer());
+            commands.set_uniform(uniform, _frame_data.geometry_buffer->normal_buffer());
             break;
         case UniformBinding::BackBuffer:
             assert(_frame_data.geometry_buffer);
-            frame.set_uniform(uniform, _frame_data.geometry_buffer->last_back_buffer());
+            commands.set_uniform(uniform, _frame_data.geometry_buffer->last_back_buffer());
             break;
         }
     }
+
+    // Set the bound uniform blocks filled for the frame
+    if (!shader.uniform_blocks().empty())
+    {
+        auto it = _bound_uniform_blocks.find(&shader);
+        if (it != _bound_uniform_blocks.end() && it->second.frame == _frame_index)
+        {
+            std::vector<UniformBlock>& blocks = it->second.blocks;
+            for (const UniformBlockLayout& layout : shader.uniform_blocks())
+            {
+                if (layout.is_bound())
+                {
+                    commands.set_uniform_block(layout, blocks[layout.index()]);
+                }
+            }
+        }
+    }
+}
+
+void PhysicallyBasedSceneRenderer::prepare_uniform_blocks(Material& material)
+{
+    Shader& shader = *material.shader();
+
+    // Rebuild the blocks of the material if its values have changed
+    if (!shader.uniform_blocks().empty())
+    {
+        material.update_uniform_blocks();
+    }
+
+    prepare_bound_uniform_blocks(shader);
+}
+
+void PhysicallyBasedSceneRenderer::prepare_bound_uniform_blocks(Shader& shader)
+{
+    const std::vector<UniformBlockLayout>& layouts = shader.uniform_blocks();
+    bool has_bound_blocks = false;
+    for (const UniformBlockLayout& layout : layouts)
+    {
+        has_bound_blocks |= layout.is_bound();
+    }
+
+    if (!has_bound_blocks)
+    {
+        return;
+    }
+
+    // Queue the shader to have its blocks filled the first time it is used
+    // in the frame
+    BoundUniformBlocks& bound_blocks = _bound_uniform_blocks[&shader];
+    if (bound_blocks.frame != _frame_index)
+    {
+        bound_blocks.frame = _frame_index;
+        _frame_data.uniform_block_shaders.push_back(&shader);
+    }
+}
+
+void PhysicallyBasedSceneRenderer::fill_bound_uniform_blocks(Shader& shader, const CameraComponent& camera, const RenderTarget& target)
+{
+    const std::vector<UniformBlockLayout>& layouts = shader.uniform_blocks();
+    std::vector<UniformBlock>& blocks = _bound_uniform_blocks[&shader].blocks;
+
+    // The uploaded data of a block refers to the block so the blocks must be
+    // destroyed before they can be moved
+    if (blocks.size() != layouts.size())
+    {
+        for (UniformBlock& block : blocks)
+        {
+            if (block.is_uploaded())
+            {
+                block.renderer().destroy_uniform_block(block);
+            }
+        }
+
+        blocks.clear();
+        blocks.resize(layouts.size());
+    }
+
+    for (const UniformBlockLayout& layout : layouts)
+    {
+        if (!layout.is_bound())
+        {
+            continue;
+        }
+
+        UniformBlock& block = blocks[layout.index()];
+        if (block.size() != layout.size())
+        {
+            if (block.is_uploaded())
+            {
+                block.renderer().destroy_uniform_block(block);
+            }
+
+            block = UniformBlock(layout);
+        }
+
+        // Only per-frame bindings are allowed in a uniform block
+        for (UniformIndex index : layout.uniform_indices())
+        {
+            const Uniform& uniform = shader.uniform(index);
+            switch (uniform.binding())
+            {
+            case UniformBinding::RenderTargetSize:
+                block.set_value(uniform, Vector2(static_cast<double>(target.width()), static_cast<double>(target.height())));
+                break;
+            case UniformBinding::CameraPosition:
+                block.set_value(uniform, camera.position);
+                break;
+            case UniformBinding::CameraFront:
+                block.set_value(uniform, camera.front);
+                break;
+            case UniformBinding::CameraUp:
+                block.set_value(uniform, camera.up);
+                break;
+            case UniformBinding::CameraExposure:
+                block.set_value(uniform, camera.exposure);
+                break;
+            case UniformBinding::CameraOneOverGamma:
+                block.set_value(uniform, _frame_data.camera_one_over_gamma);
+                break;
+            case UniformBinding::ViewMatrix:
+                block.set_value(uniform, camera.view_matrix);
+                break;
+            case UniformBinding::ProjectionMatrix:
+                block.set_value(uniform, camera.projection_matrix);
+                break;
+            case UniformBinding::ViewProjectionMatrix:
+                block.set_value(uniform, _frame_data.view_projection_matrix);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+uint64_t PhysicallyBasedSceneRenderer::compute_sort_key(RenderCallQueue& queue, const RenderCall& render_call)
+{
+    const TransformComponent& transform = *render_call.transform;
+    Material& material = *render_call.material;
+    Shader& shader = *material.shader();
+    const RenderStage stage = shader.render_stage();
+
+    // Higher priorities render first
+    const int priority = std::max(-128, std::min(127, shader.priority()));
+    const uint64_t priority_bits = static_cast<uint64_t>(127 - priority);
+
+    const uint64_t shader_id = queue.shader_sort_ids.id_of(&shader, max_value(ShaderBits));
+    const uint64_t material_id = queue.material_sort_ids.id_of(&material, max_value(MaterialBits));
+    const uint64_t mesh_id = queue.mesh_sort_ids.id_of(render_call.mesh, max_value(MeshBits));
+
+    // Quantize the view-space depth over the range of the camera
+    const Vector3 offset = transform.global_position - _frame_data.camera_transform.global_position;
+    double depth = 0.0;
+    if (_frame_data.camera_far_clip > 0.0)
+    {
+        depth = offset.dot(_frame_data.camera_front) / _frame_data.camera_far_clip;
+        depth = std::max(0.0, std::min(1.0, depth));
+    }
+    uint64_t depth_bits = static_cast<uint64_t>(depth * max_value(DepthBits));
+
+    uint64_t key = static_cast<uint64_t>(stage) << StageShift;
+    key |= priority_bits << PriorityShift;
+
+    const bool translucent = shader.blend_mode() != BlendMode();
+    if (translucent)
+    {
+        // Back-to-front
+        depth_bits = max_value(DepthBits) - depth_bits;
+
+        key |= depth_bits << (ShaderBits + MaterialBits + MeshBits);
+        key |= shader_id << (MaterialBits + MeshBits);
+        key |= material_id << MeshBits;
+        key |= mesh_id;
+    }
+    else
+    {
+        // Front-to-back
+        key |= shader_id << (MaterialBits + MeshBits + DepthBits);
+        key |= material_id << (MeshBits + DepthBits);
+        key |= mesh_id << DepthBits;
+        key |= depth_bits;
+    }
+
+    return key;
+}
+
+void PhysicallyBasedSceneRenderer::sort_queued_calls(RenderCallQueue& queue)
+{
+    for (RenderCallSortKey& sort_key : queue.sort_keys)
+    {
+        sort_key.key = compute_sort_key(queue, queue.render_calls[sort_key.index]);
+    }
+
+    queue.sort();
+}
+
+void PhysicallyBasedSceneRenderer::record_queued_calls(const CameraComponent& camera, const RenderTarget& target, RenderCallQueue& queue)
+{
+    queue.commands.clear();
+
+    const size_t count = queue.sort_keys.size();
+    size_t i = 0;
+    while (i < count)
+    {
+        RenderCall& render_call = queue.render_calls[queue.sort_keys[i].index];
+        Mesh& mesh = *render_call.mesh;
+        Material& material = *render_call.material;
+
+        // Find the run of sorted calls sharing the mesh and material; the
+        // sort keys place these next to each other whenever doing so does
+        // not break the required draw order
+        size_t end = i + 1;
+        if (material.shader()->is_instanced())
+        {
+            while (end < count)
+            {
+                const RenderCall& next_call = queue.render_calls[queue.sort_keys[end].index];
+                if (next_call.mesh != &mesh || next_call.material != &material)
+                {
+                    break;
+                }
+                ++end;
+            }
+        }
+
+        // An instanced shader expects its model matrices as instance data,
+        // even for a lone call
+        if (material.shader()->is_instanced())
+        {
+            queue.instance_model_matrices.clear();
+            for (size_t j = i; j < end; ++j)
+            {
+                const RenderCall& instance_call = queue.render_calls[queue.sort_keys[j].index];
+                queue.instance_model_matrices.push_back(instance_call.model);
+            }
+
+            render_mesh_instanced(queue.commands, camera, target, material, mesh, queue.instance_model_matrices);
+        }
+        else
+        {
+            render_mesh(queue.commands, camera, target, material, mesh, render_call.model);
+        }
+
+        i = end;
+    }
 }
 
-bool PhysicallyBasedSceneRenderer::RenderCall::operator<(const RenderCall& other) const
+Task::Handle PhysicallyBasedSceneRenderer::record_queued_calls_async(const CameraComponent& camera, const RenderTarget& target, RenderCallQueue& queue)
 {
-    return material->shader()->priority() > other.material->shader()->priority();
+    return _task_pool.enqueue([this, &camera, &target, &queue]
+    {
+        record_queued_calls(camera, target, queue);
+    });
 }
 
 PhysicallyBasedSceneRenderer::RenderCall::RenderCall()
 {
 }
 
-PhysicallyBasedSceneRenderer::RenderCall::RenderCall(const TransformComponent& transform, Mesh& mesh, Material& material) :
+PhysicallyBasedSceneRenderer::RenderCall::RenderCall(const TransformComponent& transform, const Matrix4& model, Mesh& mesh, Material& material) :
     transform(&transform),
     mesh(&mesh),
     material(&material)
 {
+    // Positions stored as normalized integers are mapped to model space
+    // through the model matrix
+    if (mesh.has_quantized_positions())
+    {
+        this->model = model * mesh.dequantization_matrix();
+    }
+    else
+    {
+        this->model = model;
+    }
+}
+
+void PhysicallyBasedSceneRenderer::RenderCallQueue::clear()
+{
+    render_calls.clear();
+    sort_keys.clear();
+    shader_sort_ids.clear();
+    material_sort_ids.clear();
+    mesh_sort_ids.clear();
+}
+
+void PhysicallyBasedSceneRenderer::RenderCallQueue::enqueue(const RenderCall& render_call)
+{
+    RenderCallSortKey sort_key;
+    sort_key.index = static_cast<uint32_t>(render_calls.size());
+
+    render_calls.push_back(render_call);
+    sort_keys.push_back(sort_key);
+}
+
+void PhysicallyBasedSceneRenderer::RenderCallQueue::sort()
+{
+    radix_sort(sort_keys, _scratch_sort_keys, [](const RenderCallSortKey& sort_key)
+    {
+        return sort_key.key;
+    });
+}
+
+void PhysicallyBasedSceneRenderer::SortIdTable::clear()
+{
+    _ids.clear();
+}
+
+uint64_t PhysicallyBasedSceneRenderer::SortIdTable::id_of(const void* object, uint64_t max_id)
+{
+    auto it = _ids.find(object);
+    if (it != _ids.end())
+    {
+        return it->second;
+    }
+
+    // Start over once the ids are exhausted; this only affects how well
+    // the calls of the frame are grouped
+    if (_ids.size() > max_id)
+    {
+        _ids.clear();
+    }
+
+    const uint64_t id = _ids.size();
+    _ids[object] = id;
+    return id;
 }
 
 void PhysicallyBasedSceneRenderer::FrameData::clear()
@@ -581,8 +1174,15 @@ void PhysicallyBasedSceneRenderer::FrameData::clear()
     post_physical_geometry.clear();
 
     directional_lights.clear();
+    uniform_block_shaders.clear();
 
     camera_transform = TransformComponent();
+    camera_entity = EntityHandle();
+    camera_front = Vector3();
+    camera_far_clip = 0.0;
+    level_of_detail_scale = 0.0;
+    view_projection_matrix = Matrix4();
+    camera_one_over_gamma = 1.0;
     primary_light_direction = Vector3();
     primary_light_color = Color();
     light_probe_texture = nullptr;
@@ -24,18 +24,23 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 #include "Hect/Core/Export.h"
 #include "Hect/Graphics/FrameBuffer.h"
 #include "Hect/Graphics/GeometryBuffer.h"
 #include "Hect/Graphics/Material.h"
 #include "Hect/Graphics/Mesh.h"
+#include "Hect/Graphics/RenderCommandBuffer.h"
 #include "Hect/Graphics/Renderer.h"
 #include "Hect/Scene/System.h"
 #include "Hect/Scene/Systems/CameraSystem.h"
 #include "Hect/Scene/Systems/DebugSystem.h"
 #include "Hect/Scene/Components/CameraComponent.h"
 #include "Hect/Scene/Components/DirectionalLightComponent.h"
+#include "Hect/Scene/Components/GeometryComponent.h"
 #include "Hect/Scene/Components/TransformComponent.h"
 #include "Hect/Scene/Components/LightProbeComponent.h"
 
@@ -93,21 +98,113 @@ private:
 
     void upload_render_objects_for_scene(Scene& scene, Renderer& renderer);
 
-    void build_render_calls(CameraComponent& camera, Entity& entity, bool frustum_test = true);
-    void render_mesh(Renderer::Frame& frame, const CameraComponent& camera, const RenderTarget& target, Material& material, Mesh& mesh, const TransformComponent& transform);
-    void set_bound_uniforms(Renderer::Frame& frame, Shader& shader, const CameraComponent& camera, const RenderTarget& target, const TransformComponent& transform);
+    void build_render_calls(const CameraComponent& camera, Scene& scene);
+    void test_ancestor_frustums(const CameraComponent& camera, const Entity& entity, FrustumTestResult parent_result);
+    FrustumTestResult test_frustum(const CameraComponent& camera, const Entity& entity) const;
+    void render_mesh(RenderCommandBuffer& commands, const CameraComponent& camera, const RenderTarget& target, Material& material, Mesh& mesh, const FloatMatrix4& model);
+    void render_mesh_instanced(RenderCommandBuffer& commands, const CameraComponent& camera, const RenderTarget& target, Material& material, Mesh& mesh, const std::vector<FloatMatrix4>& model_matrices);
+    void set_material(RenderCommandBuffer& commands, const CameraComponent& camera, const RenderTarget& target, Material& material, const Matrix4& model);
+    void set_bound_uniforms(RenderCommandBuffer& commands, Shader& shader, const CameraComponent& camera, const RenderTarget& target, const Matrix4& model);
+
+    void prepare_uniform_blocks(Material& material);
+    void prepare_bound_uniform_blocks(Shader& shader);
+    void fill_bound_uniform_blocks(Shader& shader, const CameraComponent& camera, const RenderTarget& target);
 
     class RenderCall
     {
     public:
         RenderCall();
-        RenderCall(const TransformComponent& transform, Mesh& mesh, Material& material);
+        RenderCall(const TransformComponent& transform, const Matrix4& model, Mesh& mesh, Material& material);
 
         const TransformComponent* transform { nullptr };
         Mesh* mesh { nullptr };
         Material* material { nullptr };
 
-        bool operator<(const RenderCall& other) const;
+        // The model matrix of the call in the precision it is submitted in
+        FloatMatrix4 model;
+    };
+
+    // Compacts object addresses into small ids for use in sort keys; ids are
+    // only valid within a frame since an address may be re-used by a
+    // different object once its asset is freed
+    class SortIdTable
+    {
+    public:
+        void clear();
+        uint64_t id_of(const void* object, uint64_t max_id);
+
+    private:
+        std::unordered_map<const void*, uint64_t> _ids;
+    };
+
+    // The packed key of a render call which orders the call by stage,
+    // priority, shader, material, mesh, and depth
+    class RenderCallSortKey
+    {
+    public:
+        uint64_t key { 0 };
+        uint32_t index { 0 };
+    };
+
+    // The render calls of a single stage along with their sort keys and
+    // the commands recorded to render them
+    class RenderCallQueue
+    {
+    public:
+        void clear();
+        void enqueue(const RenderCall& render_call);
+        void sort();
+
+        // The render calls in the order they were enqueued
+        std::vector<RenderCall> render_calls;
+
+        // The keys of the render calls; in sorted order after sort()
+        std::vector<RenderCallSortKey> sort_keys;
+
+        // The ids used in the sort keys; each queue has its own so the keys
+        // of all queues can be computed in parallel
+        SortIdTable shader_sort_ids;
+        SortIdTable material_sort_ids;
+        SortIdTable mesh_sort_ids;
+
+        // The commands rendering the calls in sorted order
+        RenderCommandBuffer commands;
+
+        // The model matrices of the instances in the batch being recorded,
+        // converted to the precision they are submitted in
+        std::vector<FloatMatrix4> instance_model_matrices;
+
+    private:
+        std::vector<RenderCallSortKey> _scratch_sort_keys;
+    };
+
+    // The render calls built by a single task before they are merged into
+    // the queues of the frame
+    class RenderCallArena
+    {
+    public:
+        std::vector<RenderCall> render_calls;
+    };
+
+    size_t select_level_of_detail(const Mesh& mesh, const Matrix4& model, const TransformComponent& transform, size_t last_level) const;
+    void build_arena_render_calls(const CameraComponent& camera, Material& default_material, size_t begin, size_t end, RenderCallArena& arena);
+    void route_render_call(const RenderCall& render_call);
+
+    uint64_t compute_sort_key(RenderCallQueue& queue, const RenderCall& render_call);
+    void sort_queued_calls(RenderCallQueue& queue);
+    void record_queued_calls(const CameraComponent& camera, const RenderTarget& target, RenderCallQueue& queue);
+    Task::Handle record_queued_calls_async(const CameraComponent& camera, const RenderTarget& target, RenderCallQueue& queue);
+
+    // The uniform blocks holding the per-frame bound uniforms of a shader
+    class BoundUniformBlocks
+    {
+    public:
+        // The frame the blocks were last filled for
+        uint64_t frame { 0 };
+
+        // The blocks indexed by the index of their layout in the shader;
+        // unbound blocks are left empty
+        std::vector<UniformBlock> blocks;
     };
 
     // Data required to render a frame
@@ -116,14 +213,26 @@ private:
     public:
         void clear();
 
-        std::vector<RenderCall> pre_physical_geometry;
-        std::vector<RenderCall> opaque_physical_geometry;
-        std::vector<RenderCall> translucent_physical_geometry;
-        std::vector<RenderCall> post_physical_geometry;
+        RenderCallQueue pre_physical_geometry;
+        RenderCallQueue opaque_physical_geometry;
+        RenderCallQueue translucent_physical_geometry;
+        RenderCallQueue post_physical_geometry;
 
         std::vector<const DirectionalLightComponent*> directional_lights;
 
+        // The shaders with bound uniform blocks used in the frame
+        std::vector<Shader*> uniform_block_shaders;
+
         TransformComponent camera_transform;
+        EntityHandle camera_entity;
+        Vector3 camera_front;
+        double camera_far_clip { 0.0 };
+
+        // The number of pixels spanned by a unit length at a unit distance
+        // from the camera
+        double level_of_detail_scale { 0.0 };
+        Matrix4 view_projection_matrix;
+        double camera_one_over_gamma { 1.0 };
         Vector3 primary_light_direction;
         Color primary_light_color;
         TextureCube* light_probe_texture { nullptr };
@@ -133,6 +242,22 @@ private:
 
     TaskPool& _task_pool;
 
+    // Retained between frames so that building render calls does not
+    // allocate once the scene reaches a steady state
+    std::vector<GeometryComponent*> _geometry_components;
+    std::vector<RenderCallArena> _render_call_arenas;
+    std::vector<Task::Handle> _tasks;
+
+    // The frustum test result of each entity with children for the current
+    // frame, indexed by entity id; filled before the culling tasks start so
+    // that they only read it
+    std::vector<FrustumTestResult> _ancestor_frustum_results;
+
+    // The bound uniform blocks of each shader; filled once per frame before
+    // the render calls are recorded and only read while recording
+    std::unordered_map<const Shader*, BoundUniformBlocks> _bound_uniform_blocks;
+    uint64_t _frame_index { 0 };
+
     // The shader used to composite all components of the image into the final
     // image
     AssetHandle<Shader> _composite_shader;
@@ -161,6 +286,9 @@ private:
     AssetHandle<Shader> _sky_box_shader;
 
     std::unique_ptr<GeometryBuffer> _geometry_buffer;
+
+    // The commands for the lighting, composite, and expose passes
+    RenderCommandBuffer _commands;
 };
 
 }
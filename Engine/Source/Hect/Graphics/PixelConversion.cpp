@@ -0,0 +1,370 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "PixelConversion.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "Hect/Core/Configuration.h"
+#include "Hect/Core/Exception.h"
+#include "Hect/Math/Quantization.h"
+
+#ifdef HECT_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace hect;
+
+namespace
+{
+
+// The number of pixels converted through linear floats at a time
+const size_t ConversionChunkSize = 256;
+
+double srgb_to_linear(double value)
+{
+    return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+// The float value of each 8-bit value, either from sRGB or as is
+struct ByteDecodeTables
+{
+    ByteDecodeTables()
+    {
+        for (unsigned i = 0; i < 256; ++i)
+        {
+            srgb[i] = static_cast<float>(srgb_to_linear(i / 255.0));
+            linear[i] = static_cast<float>(i) * (1.0f / 255.0f);
+        }
+    }
+
+    std::array<float, 256> srgb;
+    std::array<float, 256> linear;
+};
+
+const ByteDecodeTables& byte_decode_tables()
+{
+    static const ByteDecodeTables tables;
+    return tables;
+}
+
+// Encodes linear values as the nearest 8-bit sRGB values
+class SrgbEncoder
+{
+public:
+    SrgbEncoder()
+    {
+        // The linear values halfway between consecutive sRGB values; the
+        // nearest sRGB value is the number of thresholds at or below
+        for (unsigned i = 0; i < 255; ++i)
+        {
+            _thresholds[i] = static_cast<float>(srgb_to_linear((i + 0.5) / 255.0));
+        }
+
+        // The nearest sRGB value at the start of each step of linear values,
+        // which is at most a step or two below the nearest sRGB value of any
+        // linear value within the step
+        unsigned value = 0;
+        for (unsigned i = 0; i <= StepCount; ++i)
+        {
+            while (value < 255 && static_cast<float>(i) / StepCount >= _thresholds[value])
+            {
+                ++value;
+            }
+            _first_values[i] = static_cast<uint8_t>(value);
+        }
+    }
+
+    uint8_t encode(float linear) const
+    {
+        linear = std::min(1.0f, std::max(0.0f, linear));
+
+        unsigned value = _first_values[static_cast<unsigned>(linear * StepCount)];
+        while (value < 255 && linear >= _thresholds[value])
+        {
+            ++value;
+        }
+        return static_cast<uint8_t>(value);
+    }
+
+private:
+    static const unsigned StepCount = 4096;
+
+    std::array<float, 255> _thresholds;
+    std::array<uint8_t, StepCount + 1> _first_values;
+};
+
+const SrgbEncoder& srgb_encoder()
+{
+    static const SrgbEncoder encoder;
+    return encoder;
+}
+
+void ensure_uncompressed(const PixelFormat& pixel_format)
+{
+    if (pixel_format.is_compressed())
+    {
+        throw InvalidOperation("Cannot convert block-compressed pixels");
+    }
+}
+
+void set_default_components(float* pixel)
+{
+    pixel[0] = 0.0f;
+    pixel[1] = 0.0f;
+    pixel[2] = 0.0f;
+    pixel[3] = 1.0f;
+}
+
+uint8_t encode_linear_byte(float value)
+{
+    // Matches the clamping and rounding of the SIMD kernel, including NaN
+    // becoming zero
+    return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, value * 255.0f + 0.5f)));
+}
+
+void decode_bytes(const uint8_t* pixels, unsigned cardinality, bool srgb, float* components, size_t pixel_count)
+{
+    size_t i = 0;
+
+#ifdef HECT_SIMD_SSE2
+    if (cardinality == 4 && !srgb)
+    {
+        // Widen 16 bytes at a time to four pixels of floats
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+        for (; i + 4 <= pixel_count; i += 4)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+            const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+            const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+            float* pixel = components + i * 4;
+            _mm_storeu_ps(pixel, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+            _mm_storeu_ps(pixel + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+            _mm_storeu_ps(pixel + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+            _mm_storeu_ps(pixel + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+        }
+    }
+#endif
+
+    // Alpha is never in sRGB
+    const ByteDecodeTables& tables = byte_decode_tables();
+    const float* color_table = srgb ? tables.srgb.data() : tables.linear.data();
+    const unsigned color_count = std::min(cardinality, 3u);
+    for (; i < pixel_count; ++i)
+    {
+        const uint8_t* source = pixels + i * cardinality;
+        float* pixel = components + i * 4;
+        set_default_components(pixel);
+        for (unsigned c = 0; c < color_count; ++c)
+        {
+            pixel[c] = color_table[source[c]];
+        }
+        if (cardinality == 4)
+        {
+            pixel[3] = tables.linear[source[3]];
+        }
+    }
+}
+
+void encode_bytes(const float* components, unsigned cardinality, bool srgb, uint8_t* pixels, size_t pixel_count)
+{
+    size_t i = 0;
+
+#ifdef HECT_SIMD_SSE2
+    if (cardinality == 4 && !srgb)
+    {
+        // Narrow four pixels of floats at a time to 16 bytes
+        const __m128 scale = _mm_set1_ps(255.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 min = _mm_setzero_ps();
+        const __m128 max = _mm_set1_ps(255.0f);
+        __m128i values[4];
+        for (; i + 4 <= pixel_count; i += 4)
+        {
+            const float* pixel = components + i * 4;
+            for (unsigned j = 0; j < 4; ++j)
+            {
+                __m128 value = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(pixel + j * 4), scale), half);
+                value = _mm_min_ps(_mm_max_ps(value, min), max);
+                values[j] = _mm_cvttps_epi32(value);
+            }
+
+            const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i * 4), packed);
+        }
+    }
+#endif
+
+    const SrgbEncoder& encoder = srgb_encoder();
+    const unsigned srgb_count = srgb ? std::min(cardinality, 3u) : 0;
+    for (; i < pixel_count; ++i)
+    {
+        const float* pixel = components + i * 4;
+        uint8_t* dest = pixels + i * cardinality;
+
+        unsigned c = 0;
+        for (; c < srgb_count; ++c)
+        {
+            dest[c] = encoder.encode(pixel[c]);
+        }
+        for (; c < cardinality; ++c)
+        {
+            dest[c] = encode_linear_byte(pixel[c]);
+        }
+    }
+}
+
+template <typename ComponentType, typename DecodeType>
+void decode_floats(const uint8_t* pixels, unsigned cardinality, float* components, size_t pixel_count, DecodeType decode)
+{
+    for (size_t i = 0; i < pixel_count; ++i)
+    {
+        const uint8_t* source = pixels + i * cardinality * sizeof(ComponentType);
+        float* pixel = components + i * 4;
+        set_default_components(pixel);
+        for (unsigned c = 0; c < cardinality; ++c)
+        {
+            ComponentType value;
+            std::memcpy(&value, source + c * sizeof(ComponentType), sizeof(ComponentType));
+            pixel[c] = decode(value);
+        }
+    }
+}
+
+template <typename ComponentType, typename EncodeType>
+void encode_floats(const float* components, unsigned cardinality, uint8_t* pixels, size_t pixel_count, EncodeType encode)
+{
+    for (size_t i = 0; i < pixel_count; ++i)
+    {
+        const float* pixel = components + i * 4;
+        uint8_t* dest = pixels + i * cardinality * sizeof(ComponentType);
+        for (unsigned c = 0; c < cardinality; ++c)
+        {
+            const ComponentType value = encode(pixel[c]);
+            std::memcpy(dest + c * sizeof(ComponentType), &value, sizeof(ComponentType));
+        }
+    }
+}
+
+float identity(float value)
+{
+    return value;
+}
+
+}
+
+void hect::decode_pixels(const uint8_t* pixels, const PixelFormat& pixel_format, ColorSpace color_space, float* components, size_t pixel_count)
+{
+    ensure_uncompressed(pixel_format);
+
+    const unsigned cardinality = pixel_format.cardinality();
+    switch (pixel_format.type())
+    {
+    case PixelType::Byte:
+        decode_bytes(pixels, cardinality, color_space == ColorSpace::NonLinear, components, pixel_count);
+        break;
+    case PixelType::Float16:
+        decode_floats<uint16_t>(pixels, cardinality, components, pixel_count, decode_float16);
+        break;
+    case PixelType::Float32:
+        decode_floats<float>(pixels, cardinality, components, pixel_count, identity);
+        break;
+    default:
+        break;
+    }
+}
+
+void hect::encode_pixels(const float* components, const PixelFormat& pixel_format, ColorSpace color_space, uint8_t* pixels, size_t pixel_count)
+{
+    ensure_uncompressed(pixel_format);
+
+    const unsigned cardinality = pixel_format.cardinality();
+    switch (pixel_format.type())
+    {
+    case PixelType::Byte:
+        encode_bytes(components, cardinality, color_space == ColorSpace::NonLinear, pixels, pixel_count);
+        break;
+    case PixelType::Float16:
+        encode_floats<uint16_t>(components, cardinality, pixels, pixel_count, encode_float16);
+        break;
+    case PixelType::Float32:
+        encode_floats<float>(components, cardinality, pixels, pixel_count, identity);
+        break;
+    default:
+        break;
+    }
+}
+
+void hect::convert_pixels(const uint8_t* source, const PixelFormat& source_pixel_format, ColorSpace source_color_space, uint8_t* dest, const PixelFormat& dest_pixel_format, ColorSpace dest_color_space, size_t pixel_count)
+{
+    ensure_uncompressed(source_pixel_format);
+    ensure_uncompressed(dest_pixel_format);
+
+    const unsigned source_size = source_pixel_format.size();
+    const unsigned dest_size = dest_pixel_format.size();
+
+    if (source_pixel_format == dest_pixel_format && source_color_space == dest_color_space)
+    {
+        std::memcpy(dest, source, source_size * pixel_count);
+        return;
+    }
+
+    // Adding or dropping alpha of 8-bit pixels leaves the colors as they are
+    if (source_color_space == dest_color_space)
+    {
+        if (source_pixel_format == PixelFormat::Rgb8 && dest_pixel_format == PixelFormat::Rgba8)
+        {
+            for (size_t i = 0; i < pixel_count; ++i)
+            {
+                dest[i * 4] = source[i * 3];
+                dest[i * 4 + 1] = source[i * 3 + 1];
+                dest[i * 4 + 2] = source[i * 3 + 2];
+                dest[i * 4 + 3] = 255;
+            }
+            return;
+        }
+        else if (source_pixel_format == PixelFormat::Rgba8 && dest_pixel_format == PixelFormat::Rgb8)
+        {
+            for (size_t i = 0; i < pixel_count; ++i)
+            {
+                dest[i * 3] = source[i * 4];
+                dest[i * 3 + 1] = source[i * 4 + 1];
+                dest[i * 3 + 2] = source[i * 4 + 2];
+            }
+            return;
+        }
+    }
+
+    float components[ConversionChunkSize * 4];
+    for (size_t first = 0; first < pixel_count; first += ConversionChunkSize)
+    {
+        const size_t count = std::min(ConversionChunkSize, pixel_count - first);
+        decode_pixels(source + first * source_size, source_pixel_format, source_color_space, components, count);
+        encode_pixels(components, dest_pixel_format, dest_color_space, dest + first * dest_size, count);
+    }
+}
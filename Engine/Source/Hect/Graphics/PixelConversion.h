@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Hect/Core/Export.h"
+#include "Hect/Graphics/ColorSpace.h"
+#include "Hect/Graphics/PixelFormat.h"
+
+namespace hect
+{
+
+///
+/// Decodes pixels to four float components per pixel in linear space.
+///
+/// \note The color components of 8-bit pixels in ColorSpace::NonLinear are
+/// converted from sRGB; alpha never is.  Components missing from the pixel
+/// format decode as zero, or one for alpha.
+///
+/// \param pixels The pixel data to decode.
+/// \param pixel_format The pixel format of the pixel data.
+/// \param color_space The color space of the pixel data.
+/// \param components The array to store the red, green, blue, and alpha
+/// components of each pixel in.
+/// \param pixel_count The number of pixels.
+///
+/// \throws InvalidOperation If the pixel format is block-compressed.
+HECT_EXPORT void decode_pixels(const uint8_t* pixels, const PixelFormat& pixel_format, ColorSpace color_space, float* components, size_t pixel_count);
+
+///
+/// Encodes four float components per pixel in linear space to pixels.
+///
+/// \note The color components of 8-bit pixels in ColorSpace::NonLinear are
+/// converted to the nearest sRGB value.  8-bit components are clamped to
+/// [0, 1] and rounded to the nearest value.  Components missing from the
+/// pixel format are dropped.
+///
+/// \param components The red, green, blue, and alpha components of each
+/// pixel.
+/// \param pixel_format The pixel format to encode to.
+/// \param color_space The color space to encode to.
+/// \param pixels The array to store the pixel data in.
+/// \param pixel_count The number of pixels.
+///
+/// \throws InvalidOperation If the pixel format is block-compressed.
+HECT_EXPORT void encode_pixels(const float* components, const PixelFormat& pixel_format, ColorSpace color_space, uint8_t* pixels, size_t pixel_count);
+
+///
+/// Converts pixels from one pixel format and color space to another.
+///
+/// \note Equivalent to decoding and then encoding the pixels, but converts
+/// between identical formats and between 8-bit RGB and RGBA in the same
+/// color space directly.
+///
+/// \param source The pixel data to convert.
+/// \param source_pixel_format The pixel format of the pixel data.
+/// \param source_color_space The color space of the pixel data.
+/// \param dest The array to store the converted pixel data in; must not
+/// overlap the source pixel data.
+/// \param dest_pixel_format The pixel format to convert to.
+/// \param dest_color_space The color space to convert to.
+/// \param pixel_count The number of pixels.
+///
+/// \throws InvalidOperation If either pixel format is block-compressed.
+HECT_EXPORT void convert_pixels(const uint8_t* source, const PixelFormat& source_pixel_format, ColorSpace source_color_space, uint8_t* dest, const PixelFormat& dest_pixel_format, ColorSpace dest_color_space, size_t pixel_count);
+
+}
@@ -37,6 +37,11 @@ const PixelFormat PixelFormat::Rgb32 = PixelFormat(PixelType::Float32, 3);
 const PixelFormat PixelFormat::Rgba8 = PixelFormat(PixelType::Byte, 4);
 const PixelFormat PixelFormat::Rgba16 = PixelFormat(PixelType::Float16, 4);
 const PixelFormat PixelFormat::Rgba32 = PixelFormat(PixelType::Float32, 4);
+const PixelFormat PixelFormat::Bc1 = PixelFormat(PixelType::Bc1, 4);
+const PixelFormat PixelFormat::Bc3 = PixelFormat(PixelType::Bc3, 4);
+const PixelFormat PixelFormat::Bc4 = PixelFormat(PixelType::Bc4, 1);
+const PixelFormat PixelFormat::Bc5 = PixelFormat(PixelType::Bc5, 2);
+const PixelFormat PixelFormat::Bc7 = PixelFormat(PixelType::Bc7, 4);
 
 PixelFormat::PixelFormat()
 {
@@ -79,6 +84,40 @@ unsigned PixelFormat::size() const
     return 0;
 }
 
+bool PixelFormat::is_compressed() const
+{
+    return block_size() > 0;
+}
+
+unsigned PixelFormat::block_size() const
+{
+    switch (_type)
+    {
+    case PixelType::Bc1:
+    case PixelType::Bc4:
+        return 8;
+    case PixelType::Bc3:
+    case PixelType::Bc5:
+    case PixelType::Bc7:
+        return 16;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+size_t PixelFormat::image_size(unsigned width, unsigned height) const
+{
+    if (is_compressed())
+    {
+        const size_t block_count = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+        return block_count * block_size();
+    }
+
+    return static_cast<size_t>(width) * height * size();
+}
+
 bool PixelFormat::operator==(const PixelFormat& pixel_format) const
 {
     return _type == pixel_format._type && _cardinality == pixel_format._cardinality;
@@ -85,6 +85,26 @@ public:
     /// 32-bit floating-point red/green/blue/alpha pixel format.
     static const PixelFormat Rgba32;
 
+    ///
+    /// BC1 block-compressed red/green/blue/alpha pixel format.
+    static const PixelFormat Bc1;
+
+    ///
+    /// BC3 block-compressed red/green/blue/alpha pixel format.
+    static const PixelFormat Bc3;
+
+    ///
+    /// BC4 block-compressed single-channel pixel format.
+    static const PixelFormat Bc4;
+
+    ///
+    /// BC5 block-compressed dual-channel pixel format.
+    static const PixelFormat Bc5;
+
+    ///
+    /// BC7 block-compressed red/green/blue/alpha pixel format.
+    static const PixelFormat Bc7;
+
     ///
     /// Constructs a default pixel format (PixelFormat::Rgba8).
     PixelFormat();
@@ -108,8 +128,27 @@ public:
 
     ///
     /// Returns the total size in bytes in a pixel.
+    ///
+    /// \note Block-compressed formats have no size per pixel and return
+    /// zero; see image_size().
     unsigned size() const;
 
+    ///
+    /// Returns whether the format stores pixels in compressed 4x4 blocks.
+    bool is_compressed() const;
+
+    ///
+    /// Returns the size in bytes of a 4x4 block of a block-compressed
+    /// format, or zero if the format is not block-compressed.
+    unsigned block_size() const;
+
+    ///
+    /// Returns the size in bytes of the pixel data of an image in the format.
+    ///
+    /// \param width The width of the image.
+    /// \param height The height of the image.
+    size_t image_size(unsigned width, unsigned height) const;
+
     ///
     /// Returns whether the format is equivalent to another.
     ///
@@ -40,7 +40,29 @@ enum class PixelType
 
     ///
     /// 32-bit floating point.
-    Float32
+    Float32,
+
+    ///
+    /// 4x4 blocks of 8 bytes encoding color with 1-bit alpha (BC1/DXT1).
+    Bc1,
+
+    ///
+    /// 4x4 blocks of 16 bytes encoding color and interpolated alpha
+    /// (BC3/DXT5).
+    Bc3,
+
+    ///
+    /// 4x4 blocks of 8 bytes encoding a single channel (BC4/RGTC1).
+    Bc4,
+
+    ///
+    /// 4x4 blocks of 16 bytes encoding two channels (BC5/RGTC2).
+    Bc5,
+
+    ///
+    /// 4x4 blocks of 16 bytes encoding color and alpha at high quality
+    /// (BC7/BPTC).
+    Bc7
 };
 
 }
\ No newline at end of file
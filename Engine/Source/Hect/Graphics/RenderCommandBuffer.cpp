@@ -0,0 +1,344 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "RenderCommandBuffer.h"
+
+#include <cstring>
+
+#include "Hect/Graphics/Mesh.h"
+#include "Hect/Graphics/Shader.h"
+#include "Hect/Graphics/Texture2.h"
+#include "Hect/Graphics/Texture3.h"
+#include "Hect/Graphics/TextureCube.h"
+#include "Hect/Graphics/Uniform.h"
+#include "Hect/Graphics/UniformBlock.h"
+
+using namespace hect;
+
+void RenderCommandBuffer::set_cull_mode(CullMode cull_mode)
+{
+    Command command;
+    command.type = CommandType::SetCullMode;
+    command.cull_mode = cull_mode;
+    _commands.push_back(command);
+}
+
+void RenderCommandBuffer::set_shader(Shader& shader)
+{
+    Command command;
+    command.type = CommandType::SetShader;
+    command.object = &shader;
+    _commands.push_back(command);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, const UniformValue& value)
+{
+    switch (value.type())
+    {
+    case UniformType::Int:
+        set_uniform(uniform, value.as_int());
+        break;
+    case UniformType::Float:
+        set_uniform(uniform, value.as_double());
+        break;
+    case UniformType::Vector2:
+        set_uniform(uniform, value.as_vector2());
+        break;
+    case UniformType::Vector3:
+        set_uniform(uniform, value.as_vector3());
+        break;
+    case UniformType::Vector4:
+        set_uniform(uniform, value.as_vector4());
+        break;
+    case UniformType::Matrix4:
+        set_uniform(uniform, value.as_matrix4());
+        break;
+    case UniformType::Color:
+        set_uniform(uniform, value.as_color());
+        break;
+    case UniformType::Texture2:
+    {
+        AssetHandle<Texture2> texture = value.as_texture2();
+        if (texture)
+        {
+            set_uniform(uniform, *texture);
+        }
+    }
+    break;
+    case UniformType::Texture3:
+    {
+        AssetHandle<Texture3> texture = value.as_texture3();
+        if (texture)
+        {
+            set_uniform(uniform, *texture);
+        }
+    }
+    break;
+    case UniformType::TextureCube:
+    {
+        AssetHandle<TextureCube> texture = value.as_texture_cube();
+        if (texture)
+        {
+            set_uniform(uniform, *texture);
+        }
+    }
+    break;
+    }
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, int value)
+{
+    // Record the bits of the integer since a float cannot represent every
+    // integer value
+    float values[1];
+    static_assert(sizeof(int) == sizeof(float), "Integer uniforms must fit in a float value");
+    std::memcpy(values, &value, sizeof(int));
+    record_uniform(uniform, UniformType::Int, values, 1);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, double value)
+{
+    set_uniform(uniform, static_cast<float>(value));
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, Vector2 value)
+{
+    set_uniform(uniform, static_cast<FloatVector2>(value));
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, Vector3 value)
+{
+    set_uniform(uniform, static_cast<FloatVector3>(value));
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, Vector4 value)
+{
+    set_uniform(uniform, static_cast<FloatVector4>(value));
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, const Matrix4& value)
+{
+    set_uniform(uniform, static_cast<FloatMatrix4>(value));
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, float value)
+{
+    record_uniform(uniform, UniformType::Float, &value, 1);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, FloatVector2 value)
+{
+    const float values[2] = { value.x, value.y };
+    record_uniform(uniform, UniformType::Vector2, values, 2);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, FloatVector3 value)
+{
+    const float values[3] = { value.x, value.y, value.z };
+    record_uniform(uniform, UniformType::Vector3, values, 3);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, FloatVector4 value)
+{
+    const float values[4] = { value.x, value.y, value.z, value.w };
+    record_uniform(uniform, UniformType::Vector4, values, 4);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, const FloatMatrix4& value)
+{
+    record_uniform(uniform, UniformType::Matrix4, &value[0], 16);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, Color value)
+{
+    const float values[4] = { static_cast<float>(value.r), static_cast<float>(value.g), static_cast<float>(value.b), static_cast<float>(value.a) };
+    record_uniform(uniform, UniformType::Color, values, 4);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, Texture2& value)
+{
+    record_uniform_texture(uniform, UniformType::Texture2, &value);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, Texture3& value)
+{
+    record_uniform_texture(uniform, UniformType::Texture3, &value);
+}
+
+void RenderCommandBuffer::set_uniform(const Uniform& uniform, TextureCube& value)
+{
+    record_uniform_texture(uniform, UniformType::TextureCube, &value);
+}
+
+void RenderCommandBuffer::set_uniform_block(const UniformBlockLayout& layout, UniformBlock& block)
+{
+    Command command;
+    command.type = CommandType::SetUniformBlock;
+    command.layout = &layout;
+    command.object = &block;
+    _commands.push_back(command);
+}
+
+void RenderCommandBuffer::render_mesh(Mesh& mesh)
+{
+    Command command;
+    command.type = CommandType::RenderMesh;
+    command.object = &mesh;
+    _commands.push_back(command);
+}
+
+void RenderCommandBuffer::render_mesh_instanced(Mesh& mesh, const FloatMatrix4* model_matrices, size_t instance_count)
+{
+    Command command;
+    command.type = CommandType::RenderMeshInstanced;
+    command.object = &mesh;
+    command.value_index = static_cast<uint32_t>(_instances.size());
+    command.count = static_cast<uint32_t>(instance_count);
+    _commands.push_back(command);
+
+    _instances.insert(_instances.end(), model_matrices, model_matrices + instance_count);
+}
+
+void RenderCommandBuffer::render_viewport()
+{
+    Command command;
+    command.type = CommandType::RenderViewport;
+    _commands.push_back(command);
+}
+
+void RenderCommandBuffer::clear()
+{
+    _commands.clear();
+    _values.clear();
+    _instances.clear();
+}
+
+size_t RenderCommandBuffer::command_count() const
+{
+    return _commands.size();
+}
+
+void RenderCommandBuffer::record_uniform(const Uniform& uniform, UniformType type, const float* values, size_t count)
+{
+    if (uniform.type() != type)
+    {
+        throw InvalidOperation("Invalid value for uniform");
+    }
+
+    Command command;
+    command.type = CommandType::SetUniform;
+    command.uniform = &uniform;
+    command.value_index = static_cast<uint32_t>(_values.size());
+    _commands.push_back(command);
+
+    _values.insert(_values.end(), values, values + count);
+}
+
+void RenderCommandBuffer::record_uniform_texture(const Uniform& uniform, UniformType type, void* texture)
+{
+    if (uniform.type() != type)
+    {
+        throw InvalidOperation("Invalid value for uniform");
+    }
+
+    Command command;
+    command.type = CommandType::SetUniform;
+    command.uniform = &uniform;
+    command.object = texture;
+    _commands.push_back(command);
+}
+
+void RenderCommandBuffer::submit(Renderer::Frame& frame) const
+{
+    for (const Command& command : _commands)
+    {
+        switch (command.type)
+        {
+        case CommandType::SetCullMode:
+            frame.set_cull_mode(command.cull_mode);
+            break;
+        case CommandType::SetShader:
+            frame.set_shader(*static_cast<Shader*>(command.object));
+            break;
+        case CommandType::SetUniform:
+        {
+            const Uniform& uniform = *command.uniform;
+            const float* values = _values.data() + command.value_index;
+            switch (uniform.type())
+            {
+            case UniformType::Int:
+            {
+                int value;
+                std::memcpy(&value, values, sizeof(int));
+                frame.set_uniform(uniform, value);
+            }
+            break;
+            case UniformType::Float:
+                frame.set_uniform(uniform, values[0]);
+                break;
+            case UniformType::Vector2:
+                frame.set_uniform(uniform, FloatVector2(values[0], values[1]));
+                break;
+            case UniformType::Vector3:
+                frame.set_uniform(uniform, FloatVector3(values[0], values[1], values[2]));
+                break;
+            case UniformType::Vector4:
+                frame.set_uniform(uniform, FloatVector4(values[0], values[1], values[2], values[3]));
+                break;
+            case UniformType::Matrix4:
+            {
+                FloatMatrix4 matrix;
+                std::memcpy(&matrix[0], values, sizeof(FloatMatrix4));
+                frame.set_uniform(uniform, matrix);
+            }
+            break;
+            case UniformType::Color:
+                frame.set_uniform(uniform, Color(values[0], values[1], values[2], values[3]));
+                break;
+            case UniformType::Texture2:
+                frame.set_uniform(uniform, *static_cast<Texture2*>(command.object));
+                break;
+            case UniformType::Texture3:
+                frame.set_uniform(uniform, *static_cast<Texture3*>(command.object));
+                break;
+            case UniformType::TextureCube:
+                frame.set_uniform(uniform, *static_cast<TextureCube*>(command.object));
+                break;
+            }
+        }
+        break;
+        case CommandType::SetUniformBlock:
+            frame.set_uniform_block(*command.layout, *static_cast<UniformBlock*>(command.object));
+            break;
+        case CommandType::RenderMesh:
+            frame.render_mesh(*static_cast<Mesh*>(command.object));
+            break;
+        case CommandType::RenderMeshInstanced:
+            frame.render_mesh_instanced(*static_cast<Mesh*>(command.object), _instances.data() + command.value_index, command.count);
+            break;
+        case CommandType::RenderViewport:
+            frame.render_viewport();
+            break;
+        }
+    }
+}
@@ -0,0 +1,226 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Hect/Core/Export.h"
+#include "Hect/Graphics/Color.h"
+#include "Hect/Graphics/CullMode.h"
+#include "Hect/Graphics/Renderer.h"
+#include "Hect/Math/Matrix4.h"
+#include "Hect/Math/Vector2.h"
+#include "Hect/Math/Vector3.h"
+#include "Hect/Math/Vector4.h"
+
+namespace hect
+{
+
+class Mesh;
+class Shader;
+class Texture2;
+class Texture3;
+class TextureCube;
+class Uniform;
+class UniformBlock;
+class UniformBlockLayout;
+class UniformValue;
+
+///
+/// A recording of render commands which can be submitted to a
+/// Renderer::Frame at a later time.
+///
+/// Recording does not interact with the underlying graphics API, so separate
+/// command buffers can be recorded in parallel on worker threads and then
+/// submitted in order by the thread owning the frame.  Uniform values are
+/// captured in single precision when they are recorded, so converting from
+/// the double-precision types of the scene happens once per value.
+///
+/// \note The shaders, meshes, textures, and uniforms referenced by the
+/// commands must out-live the submission of the command buffer.
+class HECT_EXPORT RenderCommandBuffer
+{
+    friend class Renderer;
+public:
+
+    ///
+    /// Records setting the active cull mode.
+    ///
+    /// \param cull_mode The cull mode.
+    void set_cull_mode(CullMode cull_mode);
+
+    ///
+    /// Records setting the active shader.
+    ///
+    /// \param shader The shader to set.
+    void set_shader(Shader& shader);
+
+    ///
+    /// Records setting the value for a uniform of the active shader.
+    ///
+    /// \param uniform The uniform to set the value for.
+    /// \param value The value.
+    ///
+    /// \throws InvalidOperation If the specified value type differs from
+    /// the uniform type.
+    void set_uniform(const Uniform& uniform, const UniformValue& value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, int value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, double value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, Vector2 value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, Vector3 value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, Vector4 value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, const Matrix4& value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, float value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, FloatVector2 value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, FloatVector3 value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, FloatVector4 value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, const FloatMatrix4& value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, Color value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, Texture2& value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, Texture3& value);
+
+    ///
+    /// \copydoc hect::RenderCommandBuffer::set_uniform()
+    void set_uniform(const Uniform& uniform, TextureCube& value);
+
+    ///
+    /// Records binding a uniform block.
+    ///
+    /// \note The values of the block are not captured; they are uploaded
+    /// when the command buffer is submitted.
+    ///
+    /// \param layout The layout of the block in the active shader.
+    /// \param block The block to bind.
+    void set_uniform_block(const UniformBlockLayout& layout, UniformBlock& block);
+
+    ///
+    /// Records rendering a mesh.
+    ///
+    /// \param mesh The mesh to render.
+    void render_mesh(Mesh& mesh);
+
+    ///
+    /// Records rendering multiple instances of a mesh in a single render
+    /// call.
+    ///
+    /// \note The model matrices are copied into the command buffer.
+    ///
+    /// \param mesh The mesh to render.
+    /// \param model_matrices A pointer to the contiguous model matrices of
+    /// the instances.
+    /// \param instance_count The number of instances to render.
+    void render_mesh_instanced(Mesh& mesh, const FloatMatrix4* model_matrices, size_t instance_count);
+
+    ///
+    /// Records rendering the viewport.
+    void render_viewport();
+
+    ///
+    /// Removes all recorded commands.
+    ///
+    /// \note The memory of the command buffer is retained.
+    void clear();
+
+    ///
+    /// Returns the number of recorded commands.
+    size_t command_count() const;
+
+private:
+    enum class CommandType : uint8_t
+    {
+        SetCullMode,
+        SetShader,
+        SetUniform,
+        SetUniformBlock,
+        RenderMesh,
+        RenderMeshInstanced,
+        RenderViewport
+    };
+
+    class Command
+    {
+    public:
+        CommandType type { CommandType::RenderViewport };
+        CullMode cull_mode { CullMode::CounterClockwise };
+        const Uniform* uniform { nullptr };
+        const UniformBlockLayout* layout { nullptr };
+        void* object { nullptr };
+        uint32_t value_index { 0 };
+        uint32_t count { 0 };
+    };
+
+    void record_uniform(const Uniform& uniform, UniformType type, const float* values, size_t count);
+    void record_uniform_texture(const Uniform& uniform, UniformType type, void* texture);
+
+    void submit(Renderer::Frame& frame) const;
+
+    std::vector<Command> _commands;
+    std::vector<float> _values;
+    std::vector<FloatMatrix4> _instances;
+};
+
+}
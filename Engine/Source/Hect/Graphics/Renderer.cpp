@@ -23,11 +23,72 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Renderer.h"
 
+#include <cstring>
+
 #include "Hect/Graphics/Mesh.h"
+#include "Hect/Graphics/RenderCommandBuffer.h"
 #include "Hect/Graphics/Shader.h"
+#include "Hect/Graphics/UniformBlock.h"
 
 using namespace hect;
 
+namespace
+{
+
+// Copies the components of a uniform value into an array of floats, which is
+// the precision the values are submitted in
+template <typename ValueType>
+size_t copy_components(const ValueType& value, size_t size, std::array<float, 16>& components)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        components[i] = static_cast<float>(value[i]);
+    }
+    return size;
+}
+
+size_t copy_components(int value, std::array<float, 16>& components)
+{
+    // Copy the bits of the integer since a float cannot represent every
+    // integer value
+    static_assert(sizeof(int) == sizeof(float), "Integer uniforms must fit in a float component");
+    std::memcpy(&components[0], &value, sizeof(int));
+    return 1;
+}
+
+size_t copy_components(float value, std::array<float, 16>& components)
+{
+    components[0] = value;
+    return 1;
+}
+
+size_t copy_components(FloatVector2 value, std::array<float, 16>& components)
+{
+    return copy_components(value, 2, components);
+}
+
+size_t copy_components(FloatVector3 value, std::array<float, 16>& components)
+{
+    return copy_components(value, 3, components);
+}
+
+size_t copy_components(FloatVector4 value, std::array<float, 16>& components)
+{
+    return copy_components(value, 4, components);
+}
+
+size_t copy_components(const FloatMatrix4& value, std::array<float, 16>& components)
+{
+    return copy_components(value, 16, components);
+}
+
+size_t copy_components(Color value, std::array<float, 16>& components)
+{
+    return copy_components(value, 4, components);
+}
+
+}
+
 Renderer::Frame::~Frame()
 {
     _renderer.on_end_frame();
@@ -42,22 +103,83 @@ Renderer::Frame::Frame(Frame&& frame) :
 Renderer::Frame::Frame(Renderer& renderer, RenderTarget& target) :
     _renderer(renderer)
 {
+    // The state left over from before the frame is unknown
+    renderer._frame_state.reset();
     renderer.on_begin_frame(target);
 }
 
 void Renderer::Frame::set_cull_mode(CullMode cull_mode)
 {
+    FrameState& state = _renderer._frame_state;
+    Statistics& statistics = _renderer._statistics;
+
+    if (state.has_cull_mode && state.cull_mode == cull_mode)
+    {
+        ++statistics.redundant_state_changes;
+        return;
+    }
+
     _renderer.set_cull_mode(cull_mode);
+    state.has_cull_mode = true;
+    state.cull_mode = cull_mode;
+    ++statistics.state_changes;
 }
 
 void Renderer::Frame::set_shader(Shader& shader)
 {
-    _renderer.set_shader(shader);
+    FrameState& state = _renderer._frame_state;
+    Statistics& statistics = _renderer._statistics;
+
+    // Upload the shader first so that a re-uploaded shader is not mistaken
+    // for the active one
+    if (!shader.is_uploaded())
+    {
+        _renderer.upload_shader(shader);
+    }
+
+    const void* shader_data = shader.data_as<void>();
+    if (state.shader == shader_data)
+    {
+        ++statistics.redundant_shader_changes;
+    }
+    else
+    {
+        _renderer.set_shader(shader);
+        state.shader = shader_data;
+        ++statistics.shader_changes;
+    }
+
+    const BlendMode& blend_mode = shader.blend_mode();
+    if (state.has_blend_mode && state.blend_mode == blend_mode)
+    {
+        ++statistics.redundant_state_changes;
+    }
+    else
+    {
+        _renderer.set_blend_mode(blend_mode);
+        state.has_blend_mode = true;
+        state.blend_mode = blend_mode;
+        ++statistics.state_changes;
+    }
 
-    // Set the values for each unbound uniform
+    const bool depth_tested = shader.is_depth_tested();
+    if (state.has_depth_tested && state.depth_tested == depth_tested)
+    {
+        ++statistics.redundant_state_changes;
+    }
+    else
+    {
+        _renderer.set_depth_tested(depth_tested);
+        state.has_depth_tested = true;
+        state.depth_tested = depth_tested;
+        ++statistics.state_changes;
+    }
+
+    // Set the values for each unbound uniform; uniforms in a block are set
+    // through the block
     for (const Uniform& uniform : shader.uniforms())
     {
-        if (uniform.binding() == UniformBinding::None)
+        if (uniform.binding() == UniformBinding::None && !uniform.is_in_block())
         {
             set_uniform(uniform, uniform.value());
         }
@@ -126,56 +248,111 @@ void Renderer::Frame::set_uniform(const Uniform& uniform, int value)
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_uniform_redundant(uniform, value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
 void Renderer::Frame::set_uniform(const Uniform& uniform, double value)
+{
+    set_uniform(uniform, static_cast<float>(value));
+}
+
+void Renderer::Frame::set_uniform(const Uniform& uniform, Vector2 value)
+{
+    set_uniform(uniform, static_cast<FloatVector2>(value));
+}
+
+void Renderer::Frame::set_uniform(const Uniform& uniform, Vector3 value)
+{
+    set_uniform(uniform, static_cast<FloatVector3>(value));
+}
+
+void Renderer::Frame::set_uniform(const Uniform& uniform, Vector4 value)
+{
+    set_uniform(uniform, static_cast<FloatVector4>(value));
+}
+
+void Renderer::Frame::set_uniform(const Uniform& uniform, const Matrix4& value)
+{
+    set_uniform(uniform, static_cast<FloatMatrix4>(value));
+}
+
+void Renderer::Frame::set_uniform(const Uniform& uniform, float value)
 {
     if (uniform.type() != UniformType::Float)
     {
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_uniform_redundant(uniform, value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
-void Renderer::Frame::set_uniform(const Uniform& uniform, Vector2 value)
+void Renderer::Frame::set_uniform(const Uniform& uniform, FloatVector2 value)
 {
     if (uniform.type() != UniformType::Vector2)
     {
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_uniform_redundant(uniform, value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
-void Renderer::Frame::set_uniform(const Uniform& uniform, Vector3 value)
+void Renderer::Frame::set_uniform(const Uniform& uniform, FloatVector3 value)
 {
     if (uniform.type() != UniformType::Vector3)
     {
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_uniform_redundant(uniform, value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
-void Renderer::Frame::set_uniform(const Uniform& uniform, Vector4 value)
+void Renderer::Frame::set_uniform(const Uniform& uniform, FloatVector4 value)
 {
     if (uniform.type() != UniformType::Vector4)
     {
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_uniform_redundant(uniform, value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
-void Renderer::Frame::set_uniform(const Uniform& uniform, const Matrix4& value)
+void Renderer::Frame::set_uniform(const Uniform& uniform, const FloatMatrix4& value)
 {
     if (uniform.type() != UniformType::Matrix4)
     {
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_uniform_redundant(uniform, value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
@@ -186,6 +363,11 @@ void Renderer::Frame::set_uniform(const Uniform& uniform, Color value)
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_uniform_redundant(uniform, value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
@@ -196,6 +378,11 @@ void Renderer::Frame::set_uniform(const Uniform& uniform, Texture2& value)
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_texture_redundant(uniform, &value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
@@ -206,6 +393,11 @@ void Renderer::Frame::set_uniform(const Uniform& uniform, Texture3& value)
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_texture_redundant(uniform, &value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
@@ -216,17 +408,85 @@ void Renderer::Frame::set_uniform(const Uniform& uniform, TextureCube& value)
         throw InvalidOperation("Invalid value for uniform");
     }
 
+    if (is_texture_redundant(uniform, &value))
+    {
+        return;
+    }
+
     _renderer.set_uniform(uniform, value);
 }
 
+void Renderer::Frame::set_uniform_block(const UniformBlockLayout& layout, UniformBlock& block)
+{
+    FrameState& state = _renderer._frame_state;
+    Statistics& statistics = _renderer._statistics;
+
+    if (!block.is_uploaded())
+    {
+        _renderer.upload_uniform_block(block);
+        ++statistics.uniform_block_uploads;
+    }
+    else if (block.is_modified())
+    {
+        _renderer.update_uniform_block(block);
+        ++statistics.uniform_block_uploads;
+    }
+    block.set_as_synchronized();
+
+    // Binding points are shared between shaders so only the block bound to
+    // the point needs to match
+    const size_t index = layout.index();
+    if (index >= state.uniform_blocks.size())
+    {
+        state.uniform_blocks.resize(index + 1, nullptr);
+    }
+
+    const void* block_data = block.data_as<void>();
+    if (state.uniform_blocks[index] == block_data)
+    {
+        ++statistics.redundant_uniform_block_binds;
+    }
+    else
+    {
+        _renderer.bind_uniform_block(layout, block);
+        state.uniform_blocks[index] = block_data;
+        ++statistics.uniform_block_binds;
+    }
+}
+
 void Renderer::Frame::render_mesh(Mesh& mesh)
 {
+    prepare_mesh(mesh);
+
     _renderer.render_mesh(mesh);
+    ++_renderer._statistics.render_calls;
+}
+
+void Renderer::Frame::render_mesh_instanced(Mesh& mesh, const FloatMatrix4* model_matrices, size_t instance_count)
+{
+    if (instance_count == 0)
+    {
+        return;
+    }
+
+    prepare_mesh(mesh);
+
+    _renderer.render_mesh_instanced(mesh, model_matrices, instance_count);
+
+    Statistics& statistics = _renderer._statistics;
+    ++statistics.render_calls;
+    statistics.rendered_instances += instance_count;
 }
 
 void Renderer::Frame::render_viewport()
 {
     _renderer.render_viewport();
+    ++_renderer._statistics.render_calls;
+
+    // The viewport is rendered with a mesh internal to the renderer
+    FrameState& state = _renderer._frame_state;
+    state.mesh = nullptr;
+    state.has_point_sprites = false;
 }
 
 void Renderer::Frame::clear(Color color, bool depth)
@@ -234,6 +494,130 @@ void Renderer::Frame::clear(Color color, bool depth)
     _renderer.clear(color, depth);
 }
 
+void Renderer::Frame::submit(const RenderCommandBuffer& command_buffer)
+{
+    command_buffer.submit(*this);
+    _renderer._statistics.submitted_commands += command_buffer.command_count();
+}
+
+template <typename ValueType>
+bool Renderer::Frame::is_uniform_redundant(const Uniform& uniform, const ValueType& value)
+{
+    Statistics& statistics = _renderer._statistics;
+
+    std::array<float, 16> components;
+    const size_t size = copy_components(value, components);
+
+    UniformState& uniform_state = _renderer._frame_state.uniforms[&uniform];
+    if (uniform_state.submitted && uniform_state.type == uniform.type() && !uniform_state.texture && std::memcmp(uniform_state.components.data(), components.data(), size * sizeof(float)) == 0)
+    {
+        ++statistics.redundant_uniform_changes;
+        return true;
+    }
+
+    uniform_state.submitted = true;
+    uniform_state.type = uniform.type();
+    uniform_state.components = components;
+    uniform_state.texture = nullptr;
+    ++statistics.uniform_changes;
+    return false;
+}
+
+bool Renderer::Frame::is_texture_redundant(const Uniform& uniform, const void* texture)
+{
+    FrameState& state = _renderer._frame_state;
+    Statistics& statistics = _renderer._statistics;
+
+    // Texture units are shared between shaders so the texture bound to the
+    // unit must also match
+    const size_t index = uniform.texture_index();
+    if (index >= state.textures.size())
+    {
+        state.textures.resize(index + 1, nullptr);
+    }
+
+    UniformState& uniform_state = state.uniforms[&uniform];
+    if (uniform_state.submitted && uniform_state.type == uniform.type() && uniform_state.texture == texture && state.textures[index] == texture)
+    {
+        ++statistics.redundant_uniform_changes;
+        return true;
+    }
+
+    uniform_state.submitted = true;
+    uniform_state.type = uniform.type();
+    uniform_state.texture = texture;
+    state.textures[index] = texture;
+    ++statistics.uniform_changes;
+    return false;
+}
+
+void Renderer::Frame::prepare_mesh(Mesh& mesh)
+{
+    FrameState& state = _renderer._frame_state;
+    Statistics& statistics = _renderer._statistics;
+
+    const bool point_sprites = mesh.primitive_type() == PrimitiveType::PointSprites;
+    if (state.has_point_sprites && state.point_sprites == point_sprites)
+    {
+        ++statistics.redundant_state_changes;
+    }
+    else
+    {
+        _renderer.set_point_sprites(point_sprites);
+        state.has_point_sprites = true;
+        state.point_sprites = point_sprites;
+        ++statistics.state_changes;
+    }
+
+    if (!mesh.is_uploaded())
+    {
+        _renderer.upload_mesh(mesh);
+    }
+
+    const void* mesh_data = mesh.data_as<void>();
+    if (state.mesh == mesh_data)
+    {
+        ++statistics.redundant_mesh_binds;
+    }
+    else
+    {
+        _renderer.bind_mesh(mesh);
+        state.mesh = mesh_data;
+        ++statistics.mesh_binds;
+    }
+}
+
+void Renderer::Statistics::reset_counters()
+{
+    render_calls = 0;
+    rendered_instances = 0;
+    submitted_commands = 0;
+    shader_changes = 0;
+    redundant_shader_changes = 0;
+    state_changes = 0;
+    redundant_state_changes = 0;
+    uniform_changes = 0;
+    redundant_uniform_changes = 0;
+    uniform_block_binds = 0;
+    redundant_uniform_block_binds = 0;
+    uniform_block_uploads = 0;
+    mesh_binds = 0;
+    redundant_mesh_binds = 0;
+}
+
+void Renderer::FrameState::reset()
+{
+    shader = nullptr;
+    mesh = nullptr;
+    has_blend_mode = false;
+    has_depth_tested = false;
+    has_cull_mode = false;
+    has_point_sprites = false;
+    uniforms.clear();
+    textures.clear();
+    uniform_blocks.clear();
+}
+
 Renderer::~Renderer()
 {
     shutdown();
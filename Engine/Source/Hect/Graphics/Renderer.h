@@ -23,12 +23,21 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <array>
+#include <unordered_map>
+#include <vector>
+
 #include "Hect/Core/Export.h"
 #include "Hect/Core/Uncopyable.h"
+#include "Hect/Graphics/BlendMode.h"
 #include "Hect/Graphics/Color.h"
 #include "Hect/Graphics/CullMode.h"
 #include "Hect/Graphics/Image.h"
+#include "Hect/Graphics/UniformType.h"
+#include "Hect/Math/Matrix4.h"
 #include "Hect/Math/Vector2.h"
+#include "Hect/Math/Vector3.h"
+#include "Hect/Math/Vector4.h"
 #include "Hect/Math/Rectangle.h"
 
 namespace hect
@@ -36,8 +45,11 @@ namespace hect
 
 class FrameBuffer;
 class Uniform;
+class UniformBlock;
+class UniformBlockLayout;
 class UniformValue;
 class Mesh;
+class RenderCommandBuffer;
 class RenderTarget;
 class Shader;
 class Texture2;
@@ -72,6 +84,71 @@ public:
         ///
         /// The number of bytes allocated on the GPU.
         size_t memory_usage { 0 };
+
+        ///
+        /// The number of meshes rendered.
+        size_t render_calls { 0 };
+
+        ///
+        /// The number of mesh instances rendered through instanced render
+        /// calls.
+        size_t rendered_instances { 0 };
+
+        ///
+        /// The number of commands submitted from RenderCommandBuffer%s.
+        size_t submitted_commands { 0 };
+
+        ///
+        /// The number of shader changes submitted.
+        size_t shader_changes { 0 };
+
+        ///
+        /// The number of redundant shader changes which were dropped.
+        size_t redundant_shader_changes { 0 };
+
+        ///
+        /// The number of blend, depth, cull, and point sprite state changes
+        /// submitted.
+        size_t state_changes { 0 };
+
+        ///
+        /// The number of redundant blend, depth, cull, and point sprite state
+        /// changes which were dropped.
+        size_t redundant_state_changes { 0 };
+
+        ///
+        /// The number of uniform values submitted.
+        size_t uniform_changes { 0 };
+
+        ///
+        /// The number of redundant uniform values which were dropped.
+        size_t redundant_uniform_changes { 0 };
+
+        ///
+        /// The number of uniform blocks bound.
+        size_t uniform_block_binds { 0 };
+
+        ///
+        /// The number of redundant uniform block binds which were dropped.
+        size_t redundant_uniform_block_binds { 0 };
+
+        ///
+        /// The number of times the values of a uniform block were uploaded.
+        size_t uniform_block_uploads { 0 };
+
+        ///
+        /// The number of meshes bound.
+        size_t mesh_binds { 0 };
+
+        ///
+        /// The number of redundant mesh binds which were dropped.
+        size_t redundant_mesh_binds { 0 };
+
+        ///
+        /// Resets all counters to zero.
+        ///
+        /// \note The memory usage is not affected.
+        void reset_counters();
     };
 
     ///
@@ -199,6 +276,10 @@ public:
 
     ///
     /// Provides a context for rendering to a target.
+    ///
+    /// The frame remembers the state it has submitted and drops changes to
+    /// the shader, blend mode, depth testing, cull mode, bound mesh, and
+    /// uniform values which would have no effect.
     class HECT_EXPORT Frame :
         public Uncopyable
     {
@@ -259,6 +340,26 @@ public:
         /// \copydoc hect::Renderer::Frame::set_uniform()
         void set_uniform(const Uniform& uniform, const Matrix4& value);
 
+        ///
+        /// \copydoc hect::Renderer::Frame::set_uniform()
+        void set_uniform(const Uniform& uniform, float value);
+
+        ///
+        /// \copydoc hect::Renderer::Frame::set_uniform()
+        void set_uniform(const Uniform& uniform, FloatVector2 value);
+
+        ///
+        /// \copydoc hect::Renderer::Frame::set_uniform()
+        void set_uniform(const Uniform& uniform, FloatVector3 value);
+
+        ///
+        /// \copydoc hect::Renderer::Frame::set_uniform()
+        void set_uniform(const Uniform& uniform, FloatVector4 value);
+
+        ///
+        /// \copydoc hect::Renderer::Frame::set_uniform()
+        void set_uniform(const Uniform& uniform, const FloatMatrix4& value);
+
         ///
         /// \copydoc hect::Renderer::Frame::set_uniform()
         void set_uniform(const Uniform& uniform, Color value);
@@ -275,6 +376,19 @@ public:
         /// \copydoc hect::Renderer::Frame::set_uniform()
         void set_uniform(const Uniform& uniform, TextureCube& value);
 
+        ///
+        /// Binds a uniform block for subsequent render calls within the
+        /// frame.
+        ///
+        /// \note The block will be uploaded if it was not already uploaded
+        /// and its values will be re-uploaded if they were modified.
+        ///
+        /// \param layout The layout of the block in the active shader.
+        /// \param block The block to bind.
+        ///
+        /// \throws InvalidOperation If the block does not match the layout.
+        void set_uniform_block(const UniformBlockLayout& layout, UniformBlock& block);
+
         ///
         /// Render a mesh using the active state of the frame.
         ///
@@ -283,6 +397,19 @@ public:
         /// \param mesh The mesh to set.
         void render_mesh(Mesh& mesh);
 
+        ///
+        /// Render multiple instances of a mesh in a single render call using
+        /// the active state of the frame.
+        ///
+        /// \note The bound shader is expected to read the model matrix of
+        /// each instance from the per-instance vertex attributes.
+        ///
+        /// \param mesh The mesh to render.
+        /// \param model_matrices A pointer to the contiguous model matrices of
+        /// the instances, which are submitted without conversion.
+        /// \param instance_count The number of instances to render.
+        void render_mesh_instanced(Mesh& mesh, const FloatMatrix4* model_matrices, size_t instance_count);
+
         ///
         /// Render a viewport using the active state of the frame.
         void render_viewport();
@@ -294,9 +421,21 @@ public:
         /// \param depth Whether the depth channel is cleared.
         void clear(Color color = Color::Zero, bool depth = true);
 
+        ///
+        /// Executes the commands recorded in a command buffer using the
+        /// active state of the frame.
+        ///
+        /// \param command_buffer The command buffer to submit.
+        void submit(const RenderCommandBuffer& command_buffer);
+
     private:
         Frame(Renderer& renderer, RenderTarget& target);
 
+        template <typename ValueType>
+        bool is_uniform_redundant(const Uniform& uniform, const ValueType& value);
+        bool is_texture_redundant(const Uniform& uniform, const void* texture);
+        void prepare_mesh(Mesh& mesh);
+
         Renderer& _renderer;
     };
 
@@ -418,6 +557,21 @@ public:
     /// \param mesh The mesh to destroy.
     void destroy_mesh(Mesh& mesh);
 
+    ///
+    /// Uploads a uniform block.
+    ///
+    /// \note If the uniform block is already uploaded then no action is
+    /// taken.
+    ///
+    /// \param uniform_block The uniform block to upload.
+    void upload_uniform_block(UniformBlock& uniform_block);
+
+    ///
+    /// Destroys a uniform block.
+    ///
+    /// \param uniform_block The uniform block to destroy.
+    void destroy_uniform_block(UniformBlock& uniform_block);
+
     ///
     /// Returns the capabilities of the underlying hardware.
     Capabilities& capabilities();
@@ -450,26 +604,73 @@ private:
     void set_cull_mode(CullMode cull_mode);
 
     void set_shader(Shader& shader);
+    void set_blend_mode(const BlendMode& blend_mode);
+    void set_depth_tested(bool depth_tested);
+    void set_point_sprites(bool point_sprites);
 
     void set_uniform(const Uniform& uniform, int value);
-    void set_uniform(const Uniform& uniform, double value);
-    void set_uniform(const Uniform& uniform, Vector2 value);
-    void set_uniform(const Uniform& uniform, Vector3 value);
-    void set_uniform(const Uniform& uniform, Vector4 value);
-    void set_uniform(const Uniform& uniform, const Matrix4& value);
+    void set_uniform(const Uniform& uniform, float value);
+    void set_uniform(const Uniform& uniform, FloatVector2 value);
+    void set_uniform(const Uniform& uniform, FloatVector3 value);
+    void set_uniform(const Uniform& uniform, FloatVector4 value);
+    void set_uniform(const Uniform& uniform, const FloatMatrix4& value);
     void set_uniform(const Uniform& uniform, Color value);
     void set_uniform(const Uniform& uniform, Texture2& value);
     void set_uniform(const Uniform& uniform, Texture3& value);
     void set_uniform(const Uniform& uniform, TextureCube& value);
 
+    void bind_uniform_block(const UniformBlockLayout& layout, UniformBlock& uniform_block);
+    void update_uniform_block(UniformBlock& uniform_block);
+
+    void bind_mesh(Mesh& mesh);
     void render_mesh(Mesh& mesh);
+    void render_mesh_instanced(Mesh& mesh, const FloatMatrix4* model_matrices, size_t instance_count);
 
     void render_viewport();
 
     void clear(Color color, bool depth);
 
+    // The last value submitted for a uniform, in the precision it was
+    // submitted in
+    class UniformState
+    {
+    public:
+        bool submitted { false };
+        UniformType type { UniformType::Float };
+        std::array<float, 16> components;
+        const void* texture { nullptr };
+    };
+
+    // The state submitted within the active frame; any unset state is
+    // unknown and will be submitted regardless of its value
+    class FrameState
+    {
+    public:
+        void reset();
+
+        const void* shader { nullptr };
+        const void* mesh { nullptr };
+
+        bool has_blend_mode { false };
+        BlendMode blend_mode;
+
+        bool has_depth_tested { false };
+        bool depth_tested { false };
+
+        bool has_cull_mode { false };
+        CullMode cull_mode { CullMode::CounterClockwise };
+
+        bool has_point_sprites { false };
+        bool point_sprites { false };
+
+        std::unordered_map<const Uniform*, UniformState> uniforms;
+        std::vector<const void*> textures;
+        std::vector<const void*> uniform_blocks;
+    };
+
     Capabilities _capabilities;
     Statistics _statistics;
+    FrameState _frame_state;
     bool _in_frame { false };
 };
 
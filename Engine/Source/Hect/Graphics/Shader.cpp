@@ -23,8 +23,37 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Shader.h"
 
+#include "Hect/Core/Exception.h"
+#include "Hect/Core/Format.h"
+
 using namespace hect;
 
+namespace
+{
+
+// Returns whether a binding has the same value for every render call within
+// a frame, which is required for a bound uniform to be in a uniform block
+bool is_per_frame_binding(UniformBinding binding)
+{
+    switch (binding)
+    {
+    case UniformBinding::RenderTargetSize:
+    case UniformBinding::CameraPosition:
+    case UniformBinding::CameraFront:
+    case UniformBinding::CameraUp:
+    case UniformBinding::CameraExposure:
+    case UniformBinding::CameraOneOverGamma:
+    case UniformBinding::ViewMatrix:
+    case UniformBinding::ProjectionMatrix:
+    case UniformBinding::ViewProjectionMatrix:
+        return true;
+    default:
+        return false;
+    }
+}
+
+}
+
 Shader::Shader()
 {
 }
@@ -71,7 +100,18 @@ UniformIndex Shader::add_uniform(const Uniform& uniform)
     }
 
     _uniforms.push_back(uniform);
-    resolve_uniforms();
+
+    try
+    {
+        resolve_uniforms();
+    }
+    catch (const InvalidOperation&)
+    {
+        // Restore the uniforms to how they were before the uniform was added
+        _uniforms.pop_back();
+        resolve_uniforms();
+        throw;
+    }
 
     return _uniforms.size() - 1;
 }
@@ -86,6 +126,16 @@ const Shader::UniformSequence Shader::uniforms() const
     return _uniforms;
 }
 
+const std::vector<UniformIndex>& Shader::bound_uniform_indices() const
+{
+    return _bound_uniform_indices;
+}
+
+const std::vector<UniformBlockLayout>& Shader::uniform_blocks() const
+{
+    return _uniform_blocks;
+}
+
 Uniform& Shader::uniform(UniformIndex index)
 {
     if (index >= _uniforms.size())
@@ -166,6 +216,16 @@ void Shader::set_priority(int priority)
     _priority = priority;
 }
 
+bool Shader::is_instanced() const
+{
+    return _instanced;
+}
+
+void Shader::set_instanced(bool instanced)
+{
+    _instanced = instanced;
+}
+
 bool Shader::operator==(const Shader& shader) const
 {
     // Module count
@@ -216,6 +276,12 @@ bool Shader::operator==(const Shader& shader) const
         return false;
     }
 
+    // Instanced
+    if (_instanced != shader._instanced)
+    {
+        return false;
+    }
+
     return true;
 }
 
@@ -231,7 +297,8 @@ void Shader::encode(Encoder& encoder) const
             << encode_vector("uniforms", _uniforms)
             << encode_value("depth_tested", _depth_tested)
             << encode_value("blend_mode", _blend_mode)
-            << encode_value("priority", _priority);
+            << encode_value("priority", _priority)
+            << encode_value("instanced", _instanced);
 }
 
 void Shader::decode(Decoder& decoder)
@@ -261,13 +328,17 @@ void Shader::decode(Decoder& decoder)
             >> decode_vector("uniforms", _uniforms)
             >> decode_value("depth_tested", _depth_tested)
             >> decode_value("blend_mode", _blend_mode)
-            >> decode_value("priority", _priority);
+            >> decode_value("priority", _priority)
+            >> decode_value("instanced", _instanced);
 
     resolve_uniforms();
 }
 
 void Shader::resolve_uniforms()
 {
+    _bound_uniform_indices.clear();
+    _uniform_blocks.clear();
+
     size_t texture_index = 0;
     for (UniformIndex index = 0; index < _uniforms.size(); ++index)
     {
@@ -275,6 +346,13 @@ void Shader::resolve_uniforms()
         uniform._index = index;
 
         _uniform_indices[uniform._name] = index;
+
+        if (uniform.is_in_block())
+        {
+            resolve_uniform_block(uniform);
+            continue;
+        }
+
         if (uniform.type() == UniformType::Texture2 ||
                 uniform.type() == UniformType::Texture3 ||
                 uniform.type() == UniformType::TextureCube)
@@ -282,5 +360,47 @@ void Shader::resolve_uniforms()
             uniform._texture_index = texture_index;
             ++texture_index;
         }
+
+        if (uniform.binding() != UniformBinding::None)
+        {
+            _bound_uniform_indices.push_back(index);
+        }
+    }
+}
+
+void Shader::resolve_uniform_block(Uniform& uniform)
+{
+    const bool bound = uniform.binding() != UniformBinding::None;
+    if (bound && !is_per_frame_binding(uniform.binding()))
+    {
+        throw InvalidOperation(format("Uniform '%s' has a binding which cannot be in a uniform block", uniform.name().data()));
+    }
+
+    // Find the block or add it if this is its first uniform
+    UniformBlockLayout* layout = nullptr;
+    for (UniformBlockLayout& existing_layout : _uniform_blocks)
+    {
+        if (existing_layout.name() == uniform.block())
+        {
+            layout = &existing_layout;
+            break;
+        }
+    }
+
+    if (!layout)
+    {
+        UniformBlockLayout new_layout(uniform.block());
+        new_layout._index = _uniform_blocks.size();
+        new_layout._bound = bound;
+        _uniform_blocks.push_back(new_layout);
+        layout = &_uniform_blocks.back();
     }
+    else if (layout->is_bound() != bound)
+    {
+        throw InvalidOperation(format("Uniform block '%s' mixes bound and unbound uniforms", uniform.block().data()));
+    }
+
+    uniform._block_index = layout->index();
+    uniform._block_offset = layout->add_member(uniform.type());
+    layout->_uniform_indices.push_back(uniform.index());
 }
@@ -34,6 +34,7 @@
 #include "Hect/Graphics/ShaderModule.h"
 #include "Hect/Graphics/RenderStage.h"
 #include "Hect/Graphics/Uniform.h"
+#include "Hect/Graphics/UniformBlockLayout.h"
 
 namespace hect
 {
@@ -103,6 +104,9 @@ public:
     /// \param uniform The uniform to add.
     ///
     /// \returns The index of the added uniform.
+    ///
+    /// \throws InvalidOperation If the uniform cannot be packed into the
+    /// uniform block it names.
     UniformIndex add_uniform(const Uniform& uniform);
 
     ///
@@ -113,6 +117,16 @@ public:
     /// Returns the uniforms.
     const UniformSequence uniforms() const;
 
+    ///
+    /// Returns the indices of the uniforms which have a UniformBinding, in
+    /// the order the uniforms were added.
+    const std::vector<UniformIndex>& bound_uniform_indices() const;
+
+    ///
+    /// Returns the layouts of the uniform blocks resolved from the uniforms
+    /// naming a block, in the order the blocks were first named.
+    const std::vector<UniformBlockLayout>& uniform_blocks() const;
+
     ///
     /// Returns the uniform at the specified index.
     ///
@@ -190,6 +204,19 @@ public:
     /// \param priority The priority.
     void set_priority(int priority);
 
+    ///
+    /// Returns whether the shader reads its model matrix from per-instance
+    /// vertex attributes, allowing identical geometry to be batched into a
+    /// single instanced draw.
+    bool is_instanced() const;
+
+    ///
+    /// Sets whether the shader reads its model matrix from per-instance
+    /// vertex attributes.
+    ///
+    /// \param instanced True if the shader is instanced; false otherwise.
+    void set_instanced(bool instanced);
+
     ///
     /// Returns whether the shader is equivalent to another.
     ///
@@ -211,15 +238,19 @@ public:
 
 private:
     void resolve_uniforms();
+    void resolve_uniform_block(Uniform& uniform);
 
     RenderStage _render_stage { RenderStage::None };
 
     ModuleContainer _modules;
     UniformContainer _uniforms;
     std::unordered_map<Name, UniformIndex> _uniform_indices;
+    std::vector<UniformIndex> _bound_uniform_indices;
+    std::vector<UniformBlockLayout> _uniform_blocks;
 
     BlendMode _blend_mode;
     bool _depth_tested { true };
+    bool _instanced { false };
 
     int _priority { 0 };
 };
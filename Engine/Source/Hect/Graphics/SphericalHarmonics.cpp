@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "SphericalHarmonics.h"
+
+using namespace hect;
+
+namespace
+{
+
+const double Pi = 3.14159265358979323846;
+
+// The basis functions of the first three bands in a direction
+void evaluate_basis(Vector3 d, double* basis)
+{
+    basis[0] = 0.282094792;
+    basis[1] = 0.488602512 * d.y;
+    basis[2] = 0.488602512 * d.z;
+    basis[3] = 0.488602512 * d.x;
+    basis[4] = 1.092548431 * d.x * d.y;
+    basis[5] = 1.092548431 * d.y * d.z;
+    basis[6] = 0.315391565 * (3.0 * d.z * d.z - 1.0);
+    basis[7] = 1.092548431 * d.x * d.z;
+    basis[8] = 0.546274215 * (d.x * d.x - d.y * d.y);
+}
+
+}
+
+SphericalHarmonics::SphericalHarmonics()
+{
+}
+
+void SphericalHarmonics::add_sample(Vector3 direction, Vector3 value, double weight)
+{
+    double basis[CoefficientCount];
+    evaluate_basis(direction, basis);
+
+    for (size_t i = 0; i < CoefficientCount; ++i)
+    {
+        _coefficients[i] += value * (basis[i] * weight);
+    }
+}
+
+SphericalHarmonics SphericalHarmonics::irradiance() const
+{
+    // The clamped cosine lobe scales each band by a constant
+    const double band_scales[] = { Pi, 2.0 * Pi / 3.0, Pi / 4.0 };
+
+    SphericalHarmonics result;
+    for (size_t i = 0; i < CoefficientCount; ++i)
+    {
+        const size_t band = i == 0 ? 0 : (i < 4 ? 1 : 2);
+        result._coefficients[i] = _coefficients[i] * band_scales[band];
+    }
+    return result;
+}
+
+Vector3 SphericalHarmonics::evaluate(Vector3 direction) const
+{
+    double basis[CoefficientCount];
+    evaluate_basis(direction, basis);
+
+    Vector3 result;
+    for (size_t i = 0; i < CoefficientCount; ++i)
+    {
+        result += _coefficients[i] * basis[i];
+    }
+    return result;
+}
+
+SphericalHarmonics SphericalHarmonics::operator+(const SphericalHarmonics& sh) const
+{
+    SphericalHarmonics result(*this);
+    result += sh;
+    return result;
+}
+
+SphericalHarmonics SphericalHarmonics::operator*(double value) const
+{
+    SphericalHarmonics result(*this);
+    result *= value;
+    return result;
+}
+
+SphericalHarmonics& SphericalHarmonics::operator+=(const SphericalHarmonics& sh)
+{
+    for (size_t i = 0; i < CoefficientCount; ++i)
+    {
+        _coefficients[i] += sh._coefficients[i];
+    }
+    return *this;
+}
+
+SphericalHarmonics& SphericalHarmonics::operator*=(double value)
+{
+    for (Vector3& coefficient : _coefficients)
+    {
+        coefficient *= value;
+    }
+    return *this;
+}
+
+Vector3& SphericalHarmonics::operator[](size_t index)
+{
+    return _coefficients[index];
+}
+
+const Vector3& SphericalHarmonics::operator[](size_t index) const
+{
+    return _coefficients[index];
+}
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <array>
+
+#include "Hect/Core/Export.h"
+#include "Hect/Math/Vector3.h"
+
+namespace hect
+{
+
+///
+/// The coefficients of the first three bands of the real spherical
+/// harmonics projection of an RGB function over the unit sphere.
+///
+/// \note Nine coefficients capture the irradiance of an environment to
+/// within a few percent, so they are a compact stand-in for a diffuse
+/// convolution of a cube map.
+class HECT_EXPORT SphericalHarmonics
+{
+public:
+
+    ///
+    /// The number of coefficients.
+    static const size_t CoefficientCount = 9;
+
+    ///
+    /// Constructs spherical harmonics with all coefficients equal to zero.
+    SphericalHarmonics();
+
+    ///
+    /// Adds the projection of a sample of the function to the coefficients.
+    ///
+    /// \param direction The unit direction of the sample.
+    /// \param value The RGB value of the function in the direction.
+    /// \param weight The solid angle that the sample covers.
+    void add_sample(Vector3 direction, Vector3 value, double weight);
+
+    ///
+    /// Returns the coefficients of the irradiance of the function, assuming
+    /// it is the radiance arriving from each direction.
+    ///
+    /// \note The irradiance is the function convolved with a clamped cosine
+    /// lobe, which leaves only a scale on each band.
+    SphericalHarmonics irradiance() const;
+
+    ///
+    /// Evaluates the projected function in a direction.
+    ///
+    /// \param direction The unit direction.
+    Vector3 evaluate(Vector3 direction) const;
+
+    ///
+    /// Returns the sum of the coefficients and the coefficients of other
+    /// spherical harmonics.
+    ///
+    /// \param sh The other spherical harmonics.
+    SphericalHarmonics operator+(const SphericalHarmonics& sh) const;
+
+    ///
+    /// Returns the coefficients scaled by a value.
+    ///
+    /// \param value The value to scale by.
+    SphericalHarmonics operator*(double value) const;
+
+    ///
+    /// Adds the coefficients of other spherical harmonics.
+    ///
+    /// \param sh The other spherical harmonics.
+    ///
+    /// \returns A reference to the spherical harmonics.
+    SphericalHarmonics& operator+=(const SphericalHarmonics& sh);
+
+    ///
+    /// Scales the coefficients by a value.
+    ///
+    /// \param value The value to scale by.
+    ///
+    /// \returns A reference to the spherical harmonics.
+    SphericalHarmonics& operator*=(double value);
+
+    ///
+    /// Returns a reference to the coefficient at the given index.
+    ///
+    /// \note Coefficients are ordered by band and then by order, from -l to
+    /// l.
+    ///
+    /// \param index The index.
+    Vector3& operator[](size_t index);
+
+    ///
+    /// Returns a constant reference to the coefficient at the given index.
+    ///
+    /// \param index The index.
+    const Vector3& operator[](size_t index) const;
+
+private:
+    std::array<Vector3, CoefficientCount> _coefficients;
+};
+
+}
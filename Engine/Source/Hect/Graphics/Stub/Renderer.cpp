@@ -27,12 +27,14 @@
 
 #ifndef HECT_RENDERER_OPENGL
 
+#include "Hect/Core/Format.h"
 #include "Hect/Graphics/FrameBuffer.h"
 #include "Hect/Graphics/Mesh.h"
 #include "Hect/Graphics/RenderTarget.h"
 #include "Hect/Graphics/Shader.h"
 #include "Hect/Graphics/Texture2.h"
 #include "Hect/Graphics/Texture3.h"
+#include "Hect/Graphics/UniformBlock.h"
 #include "Hect/Runtime/Window.h"
 
 using namespace hect;
@@ -158,6 +160,27 @@ public:
     }
 };
 
+class UniformBlockData :
+    public Renderer::Data<UniformBlock>
+{
+public:
+    UniformBlockData(Renderer& renderer, UniformBlock& object) :
+        Renderer::Data<UniformBlock>(renderer, object),
+        size(object.size())
+    {
+    }
+
+    ~UniformBlockData()
+    {
+        if (object && object->is_uploaded())
+        {
+            renderer->destroy_uniform_block(*object);
+        }
+    }
+
+    size_t size;
+};
+
 }
 
 void Renderer::upload_frame_buffer(FrameBuffer& frame_buffer)
@@ -321,6 +344,26 @@ void Renderer::destroy_mesh(Mesh& mesh)
     mesh.set_as_destroyed();
 }
 
+void Renderer::upload_uniform_block(UniformBlock& uniform_block)
+{
+    if (uniform_block.is_uploaded())
+    {
+        return;
+    }
+
+    uniform_block.set_as_uploaded(*this, new UniformBlockData(*this, uniform_block));
+}
+
+void Renderer::destroy_uniform_block(UniformBlock& uniform_block)
+{
+    if (!uniform_block.is_uploaded())
+    {
+        return;
+    }
+
+    uniform_block.set_as_destroyed();
+}
+
 void Renderer::initialize()
 {
 }
@@ -370,37 +413,52 @@ void Renderer::set_shader(Shader& shader)
     }
 }
 
+void Renderer::set_blend_mode(const BlendMode& blend_mode)
+{
+    (void)blend_mode;
+}
+
+void Renderer::set_depth_tested(bool depth_tested)
+{
+    (void)depth_tested;
+}
+
+void Renderer::set_point_sprites(bool point_sprites)
+{
+    (void)point_sprites;
+}
+
 void Renderer::set_uniform(const Uniform& uniform, int value)
 {
     (void)uniform;
     (void)value;
 }
 
-void Renderer::set_uniform(const Uniform& uniform, double value)
+void Renderer::set_uniform(const Uniform& uniform, float value)
 {
     (void)uniform;
     (void)value;
 }
 
-void Renderer::set_uniform(const Uniform& uniform, Vector2 value)
+void Renderer::set_uniform(const Uniform& uniform, FloatVector2 value)
 {
     (void)uniform;
     (void)value;
 }
 
-void Renderer::set_uniform(const Uniform& uniform, Vector3 value)
+void Renderer::set_uniform(const Uniform& uniform, FloatVector3 value)
 {
     (void)uniform;
     (void)value;
 }
 
-void Renderer::set_uniform(const Uniform& uniform, Vector4 value)
+void Renderer::set_uniform(const Uniform& uniform, FloatVector4 value)
 {
     (void)uniform;
     (void)value;
 }
 
-void Renderer::set_uniform(const Uniform& uniform, const Matrix4& value)
+void Renderer::set_uniform(const Uniform& uniform, const FloatMatrix4& value)
 {
     (void)uniform;
     (void)value;
@@ -430,11 +488,47 @@ void Renderer::set_uniform(const Uniform& uniform, TextureCube& value)
     (void)value;
 }
 
+void Renderer::bind_uniform_block(const UniformBlockLayout& layout, UniformBlock& uniform_block)
+{
+    // Validate the layout as a hardware-accelerated API would when the block
+    // is used by a draw
+    auto data = uniform_block.data_as<UniformBlockData>();
+    if (data->size != layout.size())
+    {
+        throw InvalidOperation(format("Uniform block of %d bytes does not match the %d byte layout of '%s'", static_cast<int>(data->size), static_cast<int>(layout.size()), layout.name().data()));
+    }
+}
+
+void Renderer::update_uniform_block(UniformBlock& uniform_block)
+{
+    // The size of a block is fixed once uploaded
+    auto data = uniform_block.data_as<UniformBlockData>();
+    if (data->size != uniform_block.size())
+    {
+        throw InvalidOperation("The size of an uploaded uniform block cannot change");
+    }
+}
+
+void Renderer::bind_mesh(Mesh& mesh)
+{
+    if (!mesh.is_uploaded())
+    {
+        upload_mesh(mesh);
+    }
+}
+
 void Renderer::render_mesh(Mesh& mesh)
 {
     (void)mesh;
 }
 
+void Renderer::render_mesh_instanced(Mesh& mesh, const FloatMatrix4* model_matrices, size_t instance_count)
+{
+    (void)mesh;
+    (void)model_matrices;
+    (void)instance_count;
+}
+
 void Renderer::render_viewport()
 {
 }
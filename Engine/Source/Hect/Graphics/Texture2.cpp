@@ -207,7 +207,8 @@ bool Texture2::operator!=(const Texture2& texture) const
 
 void Texture2::encode(Encoder& encoder) const
 {
-    encoder << encode_value("image", _image)
+    encoder << encode_enum("color_space", _image ? _image->color_space() : ColorSpace::NonLinear)
+            << encode_value("image", _image)
             << encode_enum("min_filter", _min_filter)
             << encode_enum("mag_filter", _mag_filter)
             << encode_value("wrapped", _wrapped)
@@ -217,7 +217,8 @@ bool Texture3::operator!=(const Texture3& texture) const
 
 void Texture3::encode(Encoder& encoder) const
 {
-    encoder << encode_vector("image", _images)
+    encoder << encode_enum("color_space", !_images.empty() && _images[0] ? _images[0]->color_space() : ColorSpace::NonLinear)
+            << encode_vector("images", _images)
             << encode_enum("min_filter", _min_filter)
             << encode_enum("mag_filter", _mag_filter)
             << encode_value("wrapped", _wrapped)
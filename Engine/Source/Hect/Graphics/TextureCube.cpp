@@ -175,7 +175,8 @@ bool TextureCube::operator!=(const TextureCube& texture) const
 
 void TextureCube::encode(Encoder& encoder) const
 {
-    encoder << begin_object("images")
+    encoder << encode_enum("color_space", _images[0] ? _images[0]->color_space() : ColorSpace::NonLinear)
+            << begin_object("images")
             << encode_value("positive_x", _images[0])
             << encode_value("negative_x", _images[1])
             << encode_value("positive_y", _images[2])
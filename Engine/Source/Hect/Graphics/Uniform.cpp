@@ -77,6 +77,31 @@ void Uniform::set_value(const UniformValue& value)
     _value = value;
 }
 
+Name Uniform::block() const
+{
+    return _block;
+}
+
+void Uniform::set_block(Name block)
+{
+    _block = block;
+}
+
+bool Uniform::is_in_block() const
+{
+    return _block != Name::Unnamed;
+}
+
+UniformBlockIndex Uniform::block_index() const
+{
+    return _block_index;
+}
+
+size_t Uniform::block_offset() const
+{
+    return _block_offset;
+}
+
 UniformIndex Uniform::index() const
 {
     return _index;
@@ -124,6 +149,12 @@ bool Uniform::operator==(const Uniform& uniform) const
         return false;
     }
 
+    // Block
+    if (_block != uniform._block)
+    {
+        return false;
+    }
+
     return true;
 }
 
@@ -151,6 +182,11 @@ void Uniform::encode(Encoder& encoder) const
         encoder << encode_value("name", _name);
         _value.encode(encoder);
     }
+
+    if (encoder.is_binary_stream() || is_in_block())
+    {
+        encoder << encode_value("block", _block);
+    }
 }
 
 void Uniform::decode(Decoder& decoder)
@@ -170,6 +206,8 @@ void Uniform::decode(Decoder& decoder)
             decoder >> decode_value("name", _name);
             _value.decode(decoder);
         }
+
+        decoder >> decode_value("block", _block);
     }
     else
     {
@@ -177,6 +215,8 @@ void Uniform::decode(Decoder& decoder)
                 >> decode_enum("binding", _binding);
 
         _value.decode(decoder);
+
+        decoder >> decode_value("block", _block);
     }
     resolve_type();
 }
@@ -43,6 +43,10 @@ typedef int UniformLocation;
 /// The texture index a uniform corresponds to.
 typedef size_t TextureIndex;
 
+///
+/// The index of a uniform block within a shader.
+typedef size_t UniformBlockIndex;
+
 ///
 /// A parameter of a shader.
 ///
@@ -103,6 +107,34 @@ public:
     /// \param value The new value.
     void set_value(const UniformValue& value);
 
+    ///
+    /// Returns the name of the uniform block the uniform is packed into.
+    ///
+    /// \note Uniforms in a block are not set individually; they are
+    /// submitted as part of a UniformBlock.
+    Name block() const;
+
+    ///
+    /// Sets the name of the uniform block the uniform is packed into.
+    ///
+    /// \param block The name of the block; Name::Unnamed if the uniform is
+    /// not in a block.
+    void set_block(Name block);
+
+    ///
+    /// Returns whether the uniform is packed into a uniform block.
+    bool is_in_block() const;
+
+    ///
+    /// Returns the index of the uniform block the uniform is packed into
+    /// within its shader.
+    UniformBlockIndex block_index() const;
+
+    ///
+    /// Returns the std140 byte offset of the uniform within its uniform
+    /// block.
+    size_t block_offset() const;
+
     ///
     /// Returns the index of the uniform within its shader.
     UniformIndex index() const;
@@ -144,8 +176,11 @@ private:
     UniformType _type { UniformType::Float };
     UniformBinding _binding { UniformBinding::None };
     UniformValue _value;
+    Name _block { Name::Unnamed };
 
     UniformIndex _index { UniformIndex(-1) };
+    UniformBlockIndex _block_index { UniformBlockIndex(-1) };
+    size_t _block_offset { 0 };
     TextureIndex _texture_index { TextureIndex(-1) };
     UniformLocation _location { -1 };
 };
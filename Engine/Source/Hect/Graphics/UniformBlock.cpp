@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "UniformBlock.h"
+
+#include <cstring>
+
+#include "Hect/Core/Exception.h"
+
+using namespace hect;
+
+UniformBlock::UniformBlock()
+{
+}
+
+UniformBlock::UniformBlock(const UniformBlockLayout& layout) :
+    _data(layout.size(), 0)
+{
+}
+
+size_t UniformBlock::size() const
+{
+    return _data.size();
+}
+
+const std::vector<uint8_t>& UniformBlock::data() const
+{
+    return _data;
+}
+
+void UniformBlock::set_value(const Uniform& uniform, int value)
+{
+    const int32_t values[1] = { value };
+    write(uniform, UniformType::Int, values, 1);
+}
+
+void UniformBlock::set_value(const Uniform& uniform, double value)
+{
+    const float values[1] = { static_cast<float>(value) };
+    write(uniform, UniformType::Float, values, 1);
+}
+
+void UniformBlock::set_value(const Uniform& uniform, Vector2 value)
+{
+    const float values[2] = { static_cast<float>(value.x), static_cast<float>(value.y) };
+    write(uniform, UniformType::Vector2, values, 2);
+}
+
+void UniformBlock::set_value(const Uniform& uniform, Vector3 value)
+{
+    const float values[3] = { static_cast<float>(value.x), static_cast<float>(value.y), static_cast<float>(value.z) };
+    write(uniform, UniformType::Vector3, values, 3);
+}
+
+void UniformBlock::set_value(const Uniform& uniform, Vector4 value)
+{
+    const float values[4] = { static_cast<float>(value.x), static_cast<float>(value.y), static_cast<float>(value.z), static_cast<float>(value.w) };
+    write(uniform, UniformType::Vector4, values, 4);
+}
+
+void UniformBlock::set_value(const Uniform& uniform, const Matrix4& value)
+{
+    float values[16];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        values[i] = static_cast<float>(value[i]);
+    }
+    write(uniform, UniformType::Matrix4, values, 16);
+}
+
+void UniformBlock::set_value(const Uniform& uniform, Color value)
+{
+    const float values[4] = { static_cast<float>(value.r), static_cast<float>(value.g), static_cast<float>(value.b), static_cast<float>(value.a) };
+    write(uniform, UniformType::Color, values, 4);
+}
+
+void UniformBlock::set_value(const Uniform& uniform, const UniformValue& value)
+{
+    switch (value.type())
+    {
+    case UniformType::Int:
+        set_value(uniform, value.as_int());
+        break;
+    case UniformType::Float:
+        set_value(uniform, value.as_double());
+        break;
+    case UniformType::Vector2:
+        set_value(uniform, value.as_vector2());
+        break;
+    case UniformType::Vector3:
+        set_value(uniform, value.as_vector3());
+        break;
+    case UniformType::Vector4:
+        set_value(uniform, value.as_vector4());
+        break;
+    case UniformType::Matrix4:
+        set_value(uniform, value.as_matrix4());
+        break;
+    case UniformType::Color:
+        set_value(uniform, value.as_color());
+        break;
+    case UniformType::Texture2:
+    case UniformType::Texture3:
+    case UniformType::TextureCube:
+        throw InvalidOperation("Textures cannot be in a uniform block");
+    }
+}
+
+bool UniformBlock::is_modified() const
+{
+    return _modified;
+}
+
+void UniformBlock::set_as_synchronized()
+{
+    _modified = false;
+}
+
+template <typename ValueType>
+void UniformBlock::write(const Uniform& uniform, UniformType type, const ValueType* values, size_t count)
+{
+    if (!uniform.is_in_block())
+    {
+        throw InvalidOperation("Uniform is not in a uniform block");
+    }
+    else if (uniform.type() != type)
+    {
+        throw InvalidOperation("Invalid value for uniform");
+    }
+
+    const size_t offset = uniform.block_offset();
+    const size_t size = count * sizeof(ValueType);
+    if (offset + size > _data.size())
+    {
+        throw InvalidOperation("Uniform does not fit in the uniform block");
+    }
+
+    // Only flag the block as modified if the packed value changes so that
+    // re-writing the same values does not cause a re-upload
+    uint8_t* destination = &_data[offset];
+    if (std::memcmp(destination, values, size) != 0)
+    {
+        std::memcpy(destination, values, size);
+        _modified = true;
+    }
+}
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Hect/Core/Export.h"
+#include "Hect/Graphics/Color.h"
+#include "Hect/Graphics/Renderer.h"
+#include "Hect/Graphics/UniformBlockLayout.h"
+#include "Hect/Math/Matrix4.h"
+#include "Hect/Math/Vector2.h"
+#include "Hect/Math/Vector3.h"
+#include "Hect/Math/Vector4.h"
+
+namespace hect
+{
+
+///
+/// The CPU-side values of a uniform block packed according to the std140
+/// layout of a UniformBlockLayout.
+///
+/// A uniform block is uploaded to the renderer as a single buffer and is
+/// only re-uploaded when one of its values changes.
+class HECT_EXPORT UniformBlock :
+    public Renderer::Object<UniformBlock>
+{
+public:
+
+    ///
+    /// Constructs an empty uniform block.
+    UniformBlock();
+
+    ///
+    /// Constructs a zeroed uniform block sized for a layout.
+    ///
+    /// \param layout The layout of the block.
+    UniformBlock(const UniformBlockLayout& layout);
+
+    ///
+    /// Returns the size of the block in bytes.
+    size_t size() const;
+
+    ///
+    /// Returns the packed data of the block.
+    const std::vector<uint8_t>& data() const;
+
+    ///
+    /// Sets the value of a uniform in the block.
+    ///
+    /// \param uniform The uniform.
+    /// \param value The new value.
+    ///
+    /// \throws InvalidOperation If the uniform is not in a block, the value
+    /// is of the wrong type, or the uniform does not fit in the block.
+    void set_value(const Uniform& uniform, int value);
+
+    ///
+    /// \copydoc hect::UniformBlock::set_value()
+    void set_value(const Uniform& uniform, double value);
+
+    ///
+    /// \copydoc hect::UniformBlock::set_value()
+    void set_value(const Uniform& uniform, Vector2 value);
+
+    ///
+    /// \copydoc hect::UniformBlock::set_value()
+    void set_value(const Uniform& uniform, Vector3 value);
+
+    ///
+    /// \copydoc hect::UniformBlock::set_value()
+    void set_value(const Uniform& uniform, Vector4 value);
+
+    ///
+    /// \copydoc hect::UniformBlock::set_value()
+    void set_value(const Uniform& uniform, const Matrix4& value);
+
+    ///
+    /// \copydoc hect::UniformBlock::set_value()
+    void set_value(const Uniform& uniform, Color value);
+
+    ///
+    /// \copydoc hect::UniformBlock::set_value()
+    void set_value(const Uniform& uniform, const UniformValue& value);
+
+    ///
+    /// Returns whether the values have changed since the block was last
+    /// uploaded.
+    bool is_modified() const;
+
+    ///
+    /// Marks the values as being uploaded.
+    void set_as_synchronized();
+
+private:
+    template <typename ValueType>
+    void write(const Uniform& uniform, UniformType type, const ValueType* values, size_t count);
+
+    std::vector<uint8_t> _data;
+    bool _modified { true };
+};
+
+}
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "UniformBlockLayout.h"
+
+#include "Hect/Core/Exception.h"
+
+using namespace hect;
+
+namespace
+{
+
+// Rounds an offset up to the next multiple of an alignment
+size_t align_offset(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+}
+
+UniformBlockLayout::UniformBlockLayout()
+{
+}
+
+UniformBlockLayout::UniformBlockLayout(Name name) :
+    _name(name)
+{
+}
+
+Name UniformBlockLayout::name() const
+{
+    return _name;
+}
+
+UniformBlockIndex UniformBlockLayout::index() const
+{
+    return _index;
+}
+
+size_t UniformBlockLayout::size() const
+{
+    // The size of a std140 block is padded to a multiple of a vec4
+    return align_offset(_size, 16);
+}
+
+bool UniformBlockLayout::is_bound() const
+{
+    return _bound;
+}
+
+const std::vector<UniformIndex>& UniformBlockLayout::uniform_indices() const
+{
+    return _uniform_indices;
+}
+
+size_t UniformBlockLayout::add_member(UniformType type)
+{
+    size_t size = 0;
+    size_t alignment = 0;
+
+    // The base alignment and size of each type under the std140 rules
+    switch (type)
+    {
+    case UniformType::Int:
+    case UniformType::Float:
+        size = 4;
+        alignment = 4;
+        break;
+    case UniformType::Vector2:
+        size = 8;
+        alignment = 8;
+        break;
+    case UniformType::Vector3:
+        size = 12;
+        alignment = 16;
+        break;
+    case UniformType::Vector4:
+    case UniformType::Color:
+        size = 16;
+        alignment = 16;
+        break;
+    case UniformType::Matrix4:
+        size = 64;
+        alignment = 16;
+        break;
+    case UniformType::Texture2:
+    case UniformType::Texture3:
+    case UniformType::TextureCube:
+        throw InvalidOperation("Textures cannot be in a uniform block");
+    }
+
+    const size_t offset = align_offset(_size, alignment);
+    _size = offset + size;
+    return offset;
+}
+
+bool UniformBlockLayout::operator==(const UniformBlockLayout& layout) const
+{
+    return _name == layout._name && size() == layout.size() && _bound == layout._bound && _uniform_indices == layout._uniform_indices;
+}
+
+bool UniformBlockLayout::operator!=(const UniformBlockLayout& layout) const
+{
+    return !(*this == layout);
+}
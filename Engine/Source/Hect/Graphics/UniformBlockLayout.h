@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+#include "Hect/Core/Export.h"
+#include "Hect/Core/Name.h"
+#include "Hect/Graphics/Uniform.h"
+
+namespace hect
+{
+
+///
+/// The std140 layout of a named block of Uniform%s within a Shader.
+///
+/// The layout of each block is resolved by its shader from the uniforms
+/// naming the block.  A block either consists entirely of uniforms bound to
+/// per-frame values provided by the renderer or entirely of unbound uniforms
+/// with values provided by a Material.
+class HECT_EXPORT UniformBlockLayout
+{
+    friend class Shader;
+public:
+
+    ///
+    /// Constructs an empty layout.
+    UniformBlockLayout();
+
+    ///
+    /// Constructs an empty layout.
+    ///
+    /// \param name The name of the block.
+    UniformBlockLayout(Name name);
+
+    ///
+    /// Returns the name of the block.
+    Name name() const;
+
+    ///
+    /// Returns the index of the block within its shader, which is also the
+    /// binding point the block is submitted to.
+    UniformBlockIndex index() const;
+
+    ///
+    /// Returns the size of the block in bytes.
+    size_t size() const;
+
+    ///
+    /// Returns whether the uniforms of the block are bound to values
+    /// provided by the renderer.
+    bool is_bound() const;
+
+    ///
+    /// Returns the indices of the uniforms in the block within the shader.
+    const std::vector<UniformIndex>& uniform_indices() const;
+
+    ///
+    /// Appends a member of the specified type to the layout.
+    ///
+    /// \param type The type of the member.
+    ///
+    /// \returns The std140 byte offset of the member.
+    ///
+    /// \throws InvalidOperation If the type cannot be in a uniform block.
+    size_t add_member(UniformType type);
+
+    ///
+    /// Returns whether the layout is equivalent to another.
+    ///
+    /// \param layout The other layout.
+    bool operator==(const UniformBlockLayout& layout) const;
+
+    ///
+    /// Returns whether the layout is different from another.
+    ///
+    /// \param layout The other layout.
+    bool operator!=(const UniformBlockLayout& layout) const;
+
+private:
+    Name _name;
+    UniformBlockIndex _index { 0 };
+    size_t _size { 0 };
+    bool _bound { false };
+    std::vector<UniformIndex> _uniform_indices;
+};
+
+}
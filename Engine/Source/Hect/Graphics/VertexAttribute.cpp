@@ -60,14 +60,17 @@ unsigned VertexAttribute::size() const
         return 1 * _cardinality;
     case VertexAttributeType::Int16:
     case VertexAttributeType::UInt16:
+    case VertexAttributeType::Float16:
+    case VertexAttributeType::NormalizedInt16:
+    case VertexAttributeType::NormalizedUInt16:
         return 2 * _cardinality;
     case VertexAttributeType::Int32:
     case VertexAttributeType::UInt32:
         return 4 * _cardinality;
     case VertexAttributeType::Float32:
         return 4 * _cardinality;
-    default:
-        break;
+    case VertexAttributeType::OctahedralInt16:
+        return 4;
     }
 
     return 0;
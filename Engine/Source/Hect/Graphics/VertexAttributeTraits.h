@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+
+#include "Hect/Graphics/VertexAttributeType.h"
+#include "Hect/Math/Vector2.h"
+#include "Hect/Math/Vector3.h"
+#include "Hect/Math/Vector4.h"
+
+namespace hect
+{
+
+///
+/// Describes how values of a type are stored as a vertex attribute.
+///
+/// \note Specialized for each type which a VertexAttribute can be viewed
+/// as.
+template <typename Type>
+struct VertexAttributeTraits;
+
+#define HECT_VERTEX_ATTRIBUTE_TRAITS(value_type, attribute_type, attribute_cardinality) \
+    template <> \
+    struct VertexAttributeTraits<value_type> \
+    { \
+        static constexpr VertexAttributeType type = VertexAttributeType::attribute_type; \
+        static constexpr unsigned cardinality = attribute_cardinality; \
+    };
+
+HECT_VERTEX_ATTRIBUTE_TRAITS(int8_t, Int8, 1)
+HECT_VERTEX_ATTRIBUTE_TRAITS(uint8_t, UInt8, 1)
+HECT_VERTEX_ATTRIBUTE_TRAITS(int16_t, Int16, 1)
+HECT_VERTEX_ATTRIBUTE_TRAITS(uint16_t, UInt16, 1)
+HECT_VERTEX_ATTRIBUTE_TRAITS(int32_t, Int32, 1)
+HECT_VERTEX_ATTRIBUTE_TRAITS(uint32_t, UInt32, 1)
+HECT_VERTEX_ATTRIBUTE_TRAITS(float, Float32, 1)
+HECT_VERTEX_ATTRIBUTE_TRAITS(FloatVector2, Float32, 2)
+HECT_VERTEX_ATTRIBUTE_TRAITS(FloatVector3, Float32, 3)
+HECT_VERTEX_ATTRIBUTE_TRAITS(FloatVector4, Float32, 4)
+
+#undef HECT_VERTEX_ATTRIBUTE_TRAITS
+
+}
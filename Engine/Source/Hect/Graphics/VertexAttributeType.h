@@ -54,12 +54,34 @@ enum class VertexAttributeType
     /// A 32-bit unsigned integer.
     UInt32,
 
-    // Reserved for Float16
-    Reserved,
+    ///
+    /// A 16-bit float.
+    Float16,
 
     ///
     /// A 32-bit float.
-    Float32
+    Float32,
+
+    ///
+    /// A 16-bit signed integer representing a value in the range [-1, 1].
+    ///
+    /// \note Positions of this type are transformed by the dequantization
+    /// transform of the mesh.
+    NormalizedInt16,
+
+    ///
+    /// A 16-bit unsigned integer representing a value in the range [0, 1].
+    ///
+    /// \note Positions of this type are transformed by the dequantization
+    /// transform of the mesh.
+    NormalizedUInt16,
+
+    ///
+    /// A unit-length 3-dimensional direction encoded in two 16-bit
+    /// normalized signed integers using an octahedral mapping.
+    ///
+    /// \note Attributes of this type must have a cardinality of 3.
+    OctahedralInt16
 };
 
 }
\ No newline at end of file
@@ -23,6 +23,9 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "AssetCache.h"
 
+#include "Hect/IO/AssetDecoder.h"
+#include "Hect/IO/AssetManifest.h"
+
 using namespace hect;
 
 AssetCache::AssetCache(FileSystem& file_system, bool concurrent) :
@@ -62,6 +65,7 @@ void AssetCache::clear()
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     _entries.clear();
+    _decoded_paths.clear();
 }
 
 TaskPool& AssetCache::task_pool()
@@ -94,6 +98,13 @@ Path AssetCache::resolve_path(const Path& path, bool prefer_yaml_file)
             resolved_path = resolve_path(path, false);
         }
 
+        // Use the cooked asset if the source file was cooked
+        auto it = _cooked_paths.find(resolved_path);
+        if (it != _cooked_paths.end())
+        {
+            resolved_path = it->second;
+        }
+
         return resolved_path;
     }
     else
@@ -117,6 +128,29 @@ Path AssetCache::resolve_path(const Path& path, bool prefer_yaml_file)
     }
 }
 
+void AssetCache::load_manifest(const Path& path)
+{
+    AssetManifest manifest;
+    {
+        AssetDecoder decoder(*this, path);
+        decoder >> decode_value(manifest);
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    const Path directory_path = path.parent_directory();
+    for (const AssetManifest::Entry& entry : manifest.entries())
+    {
+        _cooked_paths[entry.path] = directory_path + entry.cooked_path;
+    }
+}
+
+std::vector<Path> AssetCache::decoded_paths()
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    return std::vector<Path>(_decoded_paths.begin(), _decoded_paths.end());
+}
+
 void AssetCache::push_directory(const Path& directory_path)
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
@@ -132,3 +166,9 @@ void AssetCache::pop_directory()
     std::stack<Path>& path_stack = _directory_stack[std::this_thread::get_id()];
     path_stack.pop();
 }
+
+void AssetCache::add_decoded_path(const Path& path)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _decoded_paths.insert(path);
+}
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <stack>
 
 #include "Hect/Concurrency/TaskPool.h"
@@ -110,7 +111,7 @@ public:
     void remove(const Path& path);
 
     ///
-    /// Clears all cached assets.
+    /// Clears all cached assets and the paths they were decoded from.
     void clear();
 
     ///
@@ -126,6 +127,23 @@ public:
     /// exists.
     Path resolve_path(const Path& path, bool prefer_yaml_file = true);
 
+    ///
+    /// Loads a manifest of cooked assets to consult when resolving paths.
+    ///
+    /// \note Paths which resolve to the source file of an asset in the
+    /// manifest resolve to the cooked asset instead.
+    ///
+    /// \param path The path to the AssetManifest; the paths to the cooked
+    /// assets are relative to its directory.
+    ///
+    /// \throws DecodeError If the manifest failed to decode.
+    void load_manifest(const Path& path);
+
+    ///
+    /// Returns the paths to the files that assets have been decoded from
+    /// through the cache, including base assets.
+    std::vector<Path> decoded_paths();
+
     ///
     /// Push the given directory as the preferred directory for the current
     /// thread.
@@ -139,12 +157,18 @@ public:
     void pop_directory();
 
 private:
+    friend class AssetDecoder;
+
+    void add_decoded_path(const Path& path);
+
     FileSystem& _file_system;
     TaskPool _task_pool;
 
     std::recursive_mutex _mutex;
     std::map<std::thread::id, std::stack<Path>> _directory_stack;
     std::map<Path, std::shared_ptr<AssetEntryBase>> _entries;
+    std::map<Path, Path> _cooked_paths;
+    std::set<Path> _decoded_paths;
 };
 
 }
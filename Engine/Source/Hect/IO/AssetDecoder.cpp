@@ -51,6 +51,7 @@ AssetDecoder::AssetDecoder(AssetCache& asset_cache, const Path& path) :
         _implementation.reset(new BinaryDecoder(*_stream, asset_cache));
     }
 
+    asset_cache.add_decoded_path(resolved_path);
     asset_cache.push_directory(resolved_path.parent_directory());
 }
 
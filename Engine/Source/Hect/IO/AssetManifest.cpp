@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "AssetManifest.h"
+
+#include <algorithm>
+
+#include "Hect/Core/Exception.h"
+#include "Hect/Core/Format.h"
+
+using namespace hect;
+
+void AssetManifest::Entry::encode(Encoder& encoder) const
+{
+    encoder << encode_value("path", path)
+            << encode_value("cooked_path", cooked_path)
+            << encode_value("hash", hash)
+            << encode_vector("dependencies", dependencies);
+}
+
+void AssetManifest::Entry::decode(Decoder& decoder)
+{
+    decoder >> decode_value("path", path, true)
+            >> decode_value("cooked_path", cooked_path, true)
+            >> decode_value("hash", hash)
+            >> decode_vector("dependencies", dependencies);
+}
+
+AssetManifest::AssetManifest()
+{
+}
+
+void AssetManifest::add_entry(const Entry& entry)
+{
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), entry.path, [](const Entry& existing_entry, const Path& path)
+    {
+        return existing_entry.path < path;
+    });
+
+    if (it != _entries.end() && it->path == entry.path)
+    {
+        *it = entry;
+    }
+    else
+    {
+        _entries.insert(it, entry);
+    }
+}
+
+bool AssetManifest::has_entry(const Path& path) const
+{
+    return find_entry(path) != _entries.end();
+}
+
+const AssetManifest::Entry& AssetManifest::entry(const Path& path) const
+{
+    auto it = find_entry(path);
+    if (it == _entries.end())
+    {
+        throw InvalidOperation(format("Manifest has no entry for '%s'", path.as_string().data()));
+    }
+    return *it;
+}
+
+const std::vector<AssetManifest::Entry>& AssetManifest::entries() const
+{
+    return _entries;
+}
+
+void AssetManifest::encode(Encoder& encoder) const
+{
+    encoder << encode_vector("entries", _entries);
+}
+
+void AssetManifest::decode(Decoder& decoder)
+{
+    std::vector<Entry> entries;
+    decoder >> decode_vector("entries", entries);
+
+    _entries.clear();
+    for (const Entry& entry : entries)
+    {
+        add_entry(entry);
+    }
+}
+
+std::vector<AssetManifest::Entry>::const_iterator AssetManifest::find_entry(const Path& path) const
+{
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), path, [](const Entry& entry, const Path& entry_path)
+    {
+        return entry.path < entry_path;
+    });
+
+    if (it != _entries.end() && it->path == path)
+    {
+        return it;
+    }
+    return _entries.end();
+}
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Hect/Core/Export.h"
+#include "Hect/IO/Encodable.h"
+#include "Hect/IO/Path.h"
+
+namespace hect
+{
+
+///
+/// A table of cooked assets, which are assets converted ahead of time from
+/// their source files to their binary encoding.
+///
+/// \note An AssetCache consults the manifests it has loaded when resolving
+/// paths, so that cooked assets are loaded in place of their source files.
+class HECT_EXPORT AssetManifest :
+    public Encodable
+{
+public:
+
+    ///
+    /// A cooked asset.
+    class HECT_EXPORT Entry :
+        public Encodable
+    {
+    public:
+
+        ///
+        /// The path to the source file of the asset.
+        Path path;
+
+        ///
+        /// The path to the cooked asset, relative to the directory of the
+        /// manifest.
+        Path cooked_path;
+
+        ///
+        /// The hash of the contents of the source file and its dependencies
+        /// that the asset was cooked from.
+        uint64_t hash { 0 };
+
+        ///
+        /// The paths to the files other than the source file that the
+        /// asset was cooked from.
+        std::vector<Path> dependencies;
+
+        void encode(Encoder& encoder) const override;
+        void decode(Decoder& decoder) override;
+    };
+
+    ///
+    /// Constructs an empty manifest.
+    AssetManifest();
+
+    ///
+    /// Adds an entry to the manifest, replacing any entry for the same
+    /// source file.
+    ///
+    /// \param entry The entry to add.
+    void add_entry(const Entry& entry);
+
+    ///
+    /// Returns whether the manifest has an entry for a source file.
+    ///
+    /// \param path The path to the source file.
+    bool has_entry(const Path& path) const;
+
+    ///
+    /// Returns the entry for a source file.
+    ///
+    /// \param path The path to the source file.
+    ///
+    /// \throws InvalidOperation If the manifest has no entry for the source
+    /// file.
+    const Entry& entry(const Path& path) const;
+
+    ///
+    /// Returns the entries of the manifest ordered by the path to their
+    /// source files.
+    const std::vector<Entry>& entries() const;
+
+    void encode(Encoder& encoder) const override;
+    void decode(Decoder& decoder) override;
+
+private:
+    std::vector<Entry>::const_iterator find_entry(const Path& path) const;
+
+    std::vector<Entry> _entries;
+};
+
+}
@@ -23,6 +23,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "AxisAlignedBox.h"
 
+#include <cmath>
+
 using namespace hect;
 
 AxisAlignedBox::AxisAlignedBox() :
@@ -98,6 +100,32 @@ void AxisAlignedBox::rotate(Quaternion rotation)
     }
 }
 
+void AxisAlignedBox::transform(const Matrix4& matrix)
+{
+    if (!has_size())
+    {
+        return;
+    }
+
+    // Transform the center as a point and project the half-extent onto each
+    // axis using the absolute values of the rotation/scale part
+    Vector3 center = this->center();
+    Vector3 extent = size() * 0.5;
+    matrix.transform_points(&center, &center, 1);
+
+    Vector3 transformed_extent;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        transformed_extent[i] =
+            std::abs(matrix[i]) * extent.x +
+            std::abs(matrix[i + 4]) * extent.y +
+            std::abs(matrix[i + 8]) * extent.z;
+    }
+
+    _minimum = center - transformed_extent;
+    _maximum = center + transformed_extent;
+}
+
 Vector3 AxisAlignedBox::minimum() const
 {
     return _minimum;
@@ -25,6 +25,7 @@
 
 #include "Hect/Core/Export.h"
 #include "Hect/IO/Encodable.h"
+#include "Hect/Math/Matrix4.h"
 #include "Hect/Math/Quaternion.h"
 #include "Hect/Math/Vector3.h"
 
@@ -79,6 +80,15 @@ public:
     /// \param rotation The rotation to apply.
     void rotate(Quaternion rotation);
 
+    ///
+    /// Applies an affine transform to the box.
+    ///
+    /// \note The resulting box encloses the transformed box without
+    /// transforming each of its corners.
+    ///
+    /// \param matrix The transform to apply.
+    void transform(const Matrix4& matrix);
+
     ///
     /// Returns the minimum point.
     Vector3 minimum() const;
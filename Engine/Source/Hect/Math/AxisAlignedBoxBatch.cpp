@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "AxisAlignedBoxBatch.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace hect;
+
+void AxisAlignedBoxBatch::add(const AxisAlignedBox& box)
+{
+    if (!box.has_size())
+    {
+        const float infinite = std::numeric_limits<float>::max();
+        _center_x.push_back(0.0f);
+        _center_y.push_back(0.0f);
+        _center_z.push_back(0.0f);
+        _extent_x.push_back(infinite);
+        _extent_y.push_back(infinite);
+        _extent_z.push_back(infinite);
+        return;
+    }
+
+    const Vector3 center = box.center();
+    const Vector3 size = box.size();
+    _center_x.push_back(static_cast<float>(center.x));
+    _center_y.push_back(static_cast<float>(center.y));
+    _center_z.push_back(static_cast<float>(center.z));
+    _extent_x.push_back(static_cast<float>(std::abs(size.x) * 0.5));
+    _extent_y.push_back(static_cast<float>(std::abs(size.y) * 0.5));
+    _extent_z.push_back(static_cast<float>(std::abs(size.z) * 0.5));
+}
+
+void AxisAlignedBoxBatch::clear()
+{
+    _center_x.clear();
+    _center_y.clear();
+    _center_z.clear();
+    _extent_x.clear();
+    _extent_y.clear();
+    _extent_z.clear();
+}
+
+void AxisAlignedBoxBatch::reserve(size_t count)
+{
+    _center_x.reserve(count);
+    _center_y.reserve(count);
+    _center_z.reserve(count);
+    _extent_x.reserve(count);
+    _extent_y.reserve(count);
+    _extent_z.reserve(count);
+}
+
+size_t AxisAlignedBoxBatch::size() const
+{
+    return _center_x.size();
+}
+
+const float* AxisAlignedBoxBatch::center_x() const
+{
+    return _center_x.data();
+}
+
+const float* AxisAlignedBoxBatch::center_y() const
+{
+    return _center_y.data();
+}
+
+const float* AxisAlignedBoxBatch::center_z() const
+{
+    return _center_z.data();
+}
+
+const float* AxisAlignedBoxBatch::extent_x() const
+{
+    return _extent_x.data();
+}
+
+const float* AxisAlignedBoxBatch::extent_y() const
+{
+    return _extent_y.data();
+}
+
+const float* AxisAlignedBoxBatch::extent_z() const
+{
+    return _extent_z.data();
+}
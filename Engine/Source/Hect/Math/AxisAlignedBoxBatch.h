@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+#include "Hect/Core/Export.h"
+#include "Hect/Math/AxisAlignedBox.h"
+
+namespace hect
+{
+
+///
+/// An array of axis aligned boxes stored in center/extent form with each
+/// component in its own array.
+///
+/// \note Used to test many boxes at once against a Frustum.
+class HECT_EXPORT AxisAlignedBoxBatch
+{
+public:
+
+    ///
+    /// Adds a box to the end of the batch.
+    ///
+    /// \note A box without a size is stored as an infinitely large box so
+    /// it is never culled.
+    ///
+    /// \param box The box to add.
+    void add(const AxisAlignedBox& box);
+
+    ///
+    /// Removes all boxes from the batch.
+    void clear();
+
+    ///
+    /// Reserves space for a number of boxes.
+    ///
+    /// \param count The number of boxes.
+    void reserve(size_t count);
+
+    ///
+    /// Returns the number of boxes in the batch.
+    size_t size() const;
+
+    ///
+    /// Returns the x components of the centers of the boxes.
+    const float* center_x() const;
+
+    ///
+    /// Returns the y components of the centers of the boxes.
+    const float* center_y() const;
+
+    ///
+    /// Returns the z components of the centers of the boxes.
+    const float* center_z() const;
+
+    ///
+    /// Returns the x components of the half-sizes of the boxes.
+    const float* extent_x() const;
+
+    ///
+    /// Returns the y components of the half-sizes of the boxes.
+    const float* extent_y() const;
+
+    ///
+    /// Returns the z components of the half-sizes of the boxes.
+    const float* extent_z() const;
+
+private:
+    std::vector<float> _center_x;
+    std::vector<float> _center_y;
+    std::vector<float> _center_z;
+    std::vector<float> _extent_x;
+    std::vector<float> _extent_y;
+    std::vector<float> _extent_z;
+};
+
+}
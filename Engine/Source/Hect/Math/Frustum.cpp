@@ -23,9 +23,56 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Frustum.h"
 
+#include <cmath>
+
+#include "Hect/Core/Configuration.h"
+
+#ifdef HECT_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace hect
 {
 
+namespace
+{
+
+// The frustum planes in single precision with each component in its own
+// array
+struct FloatPlanes
+{
+    float normal_x[6];
+    float normal_y[6];
+    float normal_z[6];
+    float distance[6];
+};
+
+FloatPlanes to_float_planes(const Plane* planes)
+{
+    FloatPlanes result;
+    for (size_t i = 0; i < 6; ++i)
+    {
+        const Vector3 normal = planes[i].normal();
+        result.normal_x[i] = static_cast<float>(normal.x);
+        result.normal_y[i] = static_cast<float>(normal.y);
+        result.normal_z[i] = static_cast<float>(normal.z);
+        result.distance[i] = static_cast<float>(planes[i].distance());
+    }
+    return result;
+}
+
+void clear_bitmask(std::vector<uint64_t>& bitmask, size_t count)
+{
+    bitmask.assign((count + 63) / 64, 0);
+}
+
+void set_bits(std::vector<uint64_t>& bitmask, size_t index, uint64_t bits)
+{
+    bitmask[index / 64] |= bits << (index % 64);
+}
+
+}
+
 Frustum::Frustum()
 {
 }
@@ -151,4 +198,125 @@ bool Frustum::contains_sphere(Sphere sphere, Vector3 position) const
     return true;
 }
 
+void Frustum::test_axis_aligned_boxes(const AxisAlignedBoxBatch& boxes, std::vector<uint64_t>& visible) const
+{
+    const size_t count = boxes.size();
+    clear_bitmask(visible, count);
+
+    const FloatPlanes planes = to_float_planes(_planes);
+    const float* center_x = boxes.center_x();
+    const float* center_y = boxes.center_y();
+    const float* center_z = boxes.center_z();
+    const float* extent_x = boxes.extent_x();
+    const float* extent_y = boxes.extent_y();
+    const float* extent_z = boxes.extent_z();
+
+    // A box is outside of a plane if its center is further behind the plane
+    // than its extent projected onto the plane normal
+    size_t i = 0;
+
+#ifdef HECT_SIMD_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 cx = _mm_loadu_ps(center_x + i);
+        const __m128 cy = _mm_loadu_ps(center_y + i);
+        const __m128 cz = _mm_loadu_ps(center_z + i);
+        const __m128 ex = _mm_loadu_ps(extent_x + i);
+        const __m128 ey = _mm_loadu_ps(extent_y + i);
+        const __m128 ez = _mm_loadu_ps(extent_z + i);
+
+        __m128 outside = zero;
+        for (size_t j = 0; j < 6; ++j)
+        {
+            __m128 distance = _mm_mul_ps(_mm_set1_ps(planes.normal_x[j]), cx);
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.normal_y[j]), cy));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.normal_z[j]), cz));
+            distance = _mm_add_ps(distance, _mm_set1_ps(planes.distance[j]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(std::abs(planes.normal_x[j])), ex));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(std::abs(planes.normal_y[j])), ey));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(std::abs(planes.normal_z[j])), ez));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+        }
+
+        set_bits(visible, i, static_cast<uint64_t>(~_mm_movemask_ps(outside) & 0xf));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        bool outside = false;
+        for (size_t j = 0; j < 6; ++j)
+        {
+            float distance = planes.normal_x[j] * center_x[i];
+            distance += planes.normal_y[j] * center_y[i];
+            distance += planes.normal_z[j] * center_z[i];
+            distance += planes.distance[j];
+            distance += std::abs(planes.normal_x[j]) * extent_x[i];
+            distance += std::abs(planes.normal_y[j]) * extent_y[i];
+            distance += std::abs(planes.normal_z[j]) * extent_z[i];
+            outside |= distance < 0.0f;
+        }
+
+        if (!outside)
+        {
+            set_bits(visible, i, 1);
+        }
+    }
+}
+
+void Frustum::contains_spheres(const SphereBatch& spheres, std::vector<uint64_t>& visible) const
+{
+    const size_t count = spheres.size();
+    clear_bitmask(visible, count);
+
+    const FloatPlanes planes = to_float_planes(_planes);
+    const float* position_x = spheres.position_x();
+    const float* position_y = spheres.position_y();
+    const float* position_z = spheres.position_z();
+    const float* radius = spheres.radius();
+
+    size_t i = 0;
+
+#ifdef HECT_SIMD_SSE2
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 px = _mm_loadu_ps(position_x + i);
+        const __m128 py = _mm_loadu_ps(position_y + i);
+        const __m128 pz = _mm_loadu_ps(position_z + i);
+        const __m128 negative_radius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+
+        __m128 outside = _mm_setzero_ps();
+        for (size_t j = 0; j < 6; ++j)
+        {
+            __m128 distance = _mm_mul_ps(_mm_set1_ps(planes.normal_x[j]), px);
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.normal_y[j]), py));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.normal_z[j]), pz));
+            distance = _mm_add_ps(distance, _mm_set1_ps(planes.distance[j]));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negative_radius));
+        }
+
+        set_bits(visible, i, static_cast<uint64_t>(~_mm_movemask_ps(outside) & 0xf));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        bool outside = false;
+        for (size_t j = 0; j < 6; ++j)
+        {
+            float distance = planes.normal_x[j] * position_x[i];
+            distance += planes.normal_y[j] * position_y[i];
+            distance += planes.normal_z[j] * position_z[i];
+            distance += planes.distance[j];
+            outside |= distance < -radius[i];
+        }
+
+        if (!outside)
+        {
+            set_bits(visible, i, 1);
+        }
+    }
+}
+
 }
@@ -23,10 +23,15 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "Hect/Core/Export.h"
 #include "Hect/Math/AxisAlignedBox.h"
+#include "Hect/Math/AxisAlignedBoxBatch.h"
 #include "Hect/Math/Plane.h"
 #include "Hect/Math/Sphere.h"
+#include "Hect/Math/SphereBatch.h"
 #include "Hect/Math/Vector3.h"
 #include "Hect/Units/Angle.h"
 
@@ -97,6 +102,26 @@ public:
     /// \param position The position of the sphere.
     bool contains_sphere(Sphere sphere, Vector3 position) const;
 
+    ///
+    /// Tests a batch of axis aligned boxes against the frustum.
+    ///
+    /// \note The boxes are tested in single precision.
+    ///
+    /// \param boxes The boxes.
+    /// \param visible The bitmask to store the results in; bit i % 64 of
+    /// element i / 64 is set if box i is not outside of the frustum.
+    void test_axis_aligned_boxes(const AxisAlignedBoxBatch& boxes, std::vector<uint64_t>& visible) const;
+
+    ///
+    /// Tests whether each sphere in a batch is within the frustum.
+    ///
+    /// \note The spheres are tested in single precision.
+    ///
+    /// \param spheres The spheres.
+    /// \param visible The bitmask to store the results in; bit i % 64 of
+    /// element i / 64 is set if sphere i is within the frustum.
+    void contains_spheres(const SphereBatch& spheres, std::vector<uint64_t>& visible) const;
+
 private:
     Plane _planes[6];
     Vector3 _position;
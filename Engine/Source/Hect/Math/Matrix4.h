@@ -134,6 +134,18 @@ public:
     /// \param v The vector to transform.
     Vector4T<Type> operator*(Vector4T<Type> v) const;
 
+    ///
+    /// Transforms an array of points by the matrix.
+    ///
+    /// \note Each point is transformed as if it were multiplied by the
+    /// matrix as a 4-dimensional vector with a w component of one.
+    ///
+    /// \param points The points to transform.
+    /// \param results The array to store the transformed points in; may be
+    /// the same as the points.
+    /// \param count The number of points.
+    void transform_points(const Vector3T<Type>* points, Vector3T<Type>* results, size_t count) const;
+
     ///
     /// Returns the product of the matrix and another matrix.
     ///
@@ -182,6 +194,7 @@ private:
 };
 
 typedef Matrix4T<double> Matrix4;
+typedef Matrix4T<float> FloatMatrix4;
 
 template <typename Type>
 Encoder& operator<<(Encoder& encoder, const Matrix4T<Type>& m);
@@ -25,6 +25,7 @@
 #include <cstring>
 
 #include "Hect/Math/Quaternion.h"
+#include "Hect/Math/Simd.h"
 
 namespace hect
 {
@@ -172,34 +173,22 @@ Vector3T<Type> Matrix4T<Type>::operator*(Vector3T<Type> v) const
 template <typename Type>
 Vector4T<Type> Matrix4T<Type>::operator*(Vector4T<Type> v) const
 {
-    Type x = v.x * _c[0] + v.y * _c[4] + v.z * _c[8] + v.w * _c[12];
-    Type y = v.x * _c[1] + v.y * _c[5] + v.z * _c[9] + v.w * _c[13];
-    Type z = v.x * _c[2] + v.y * _c[6] + v.z * _c[10] + v.w * _c[14];
-    Type w = v.x * _c[3] + v.y * _c[7] + v.z * _c[11] + v.w * _c[15];
+    Type components[4] = { v.x, v.y, v.z, v.w };
+    simd::transform_vector4(_c, components, components);
+    return Vector4T<Type>(components[0], components[1], components[2], components[3]);
+}
 
-    return Vector4T<Type>(x, y, z, w);
+template <typename Type>
+void Matrix4T<Type>::transform_points(const Vector3T<Type>* points, Vector3T<Type>* results, size_t count) const
+{
+    simd::transform_points(_c, points, results, count);
 }
 
 template <typename Type>
 Matrix4T<Type> Matrix4T<Type>::operator*(const Matrix4T& m) const
 {
     Matrix4T result;
-    result[0]  = _c[0] * m[0]  + _c[4] * m[1] + _c[8]   * m[2]  + _c[12] * m[3];
-    result[1]  = _c[1] * m[0]  + _c[5] * m[1] + _c[9]   * m[2]  + _c[13] * m[3];
-    result[2]  = _c[2] * m[0]  + _c[6] * m[1] + _c[10]  * m[2]  + _c[14] * m[3];
-    result[3]  = _c[3] * m[0]  + _c[7] * m[1] + _c[11]  * m[2]  + _c[15] * m[3];
-    result[4]  = _c[0] * m[4]  + _c[4] * m[5] + _c[8]   * m[6]  + _c[12] * m[7];
-    result[5]  = _c[1] * m[4]  + _c[5] * m[5] + _c[9]   * m[6]  + _c[13] * m[7];
-    result[6]  = _c[2] * m[4]  + _c[6] * m[5] + _c[10]  * m[6]  + _c[14] * m[7];
-    result[7]  = _c[3] * m[4]  + _c[7] * m[5] + _c[11]  * m[6]  + _c[15] * m[7];
-    result[8]  = _c[0] * m[8]  + _c[4] * m[9] + _c[8]   * m[10] + _c[12] * m[11];
-    result[9]  = _c[1] * m[8]  + _c[5] * m[9] + _c[9]   * m[10] + _c[13] * m[11];
-    result[10] = _c[2] * m[8]  + _c[6] * m[9] + _c[10]  * m[10] + _c[14] * m[11];
-    result[11] = _c[3] * m[8]  + _c[7] * m[9] + _c[11]  * m[10] + _c[15] * m[11];
-    result[12] = _c[0] * m[12] + _c[4] * m[13] + _c[8]  * m[14] + _c[12] * m[15];
-    result[13] = _c[1] * m[12] + _c[5] * m[13] + _c[9]  * m[14] + _c[13] * m[15];
-    result[14] = _c[2] * m[12] + _c[6] * m[13] + _c[10] * m[14] + _c[14] * m[15];
-    result[15] = _c[3] * m[12] + _c[7] * m[13] + _c[11] * m[14] + _c[15] * m[15];
+    simd::multiply_matrix4(_c, m._c, result._c);
     return result;
 }
 
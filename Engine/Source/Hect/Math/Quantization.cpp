@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace hect;
+
+namespace
+{
+
+double sign_not_zero(double value)
+{
+    return value >= 0.0 ? 1.0 : -1.0;
+}
+
+}
+
+uint16_t hect::encode_float16(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(float));
+
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const int exponent = static_cast<int>((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    if (exponent >= 31)
+    {
+        // Infinity or NaN; keep a mantissa bit set for NaN
+        const bool is_nan = ((bits >> 23) & 0xff) == 0xff && mantissa != 0;
+        return sign | 0x7c00 | (is_nan ? 0x200 : 0);
+    }
+    else if (exponent <= 0)
+    {
+        if (exponent < -10)
+        {
+            // Too small for a subnormal
+            return sign;
+        }
+
+        // Subnormal with the implicit leading bit made explicit
+        mantissa |= 0x800000;
+        const unsigned shift = static_cast<unsigned>(14 - exponent);
+        uint32_t half_mantissa = mantissa >> shift;
+
+        // Round to nearest even
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half_mantissa & 1)))
+        {
+            ++half_mantissa;
+        }
+        return static_cast<uint16_t>(sign | half_mantissa);
+    }
+
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+
+    // Round to nearest even; a carry into the exponent rounds up correctly
+    const uint32_t remainder = mantissa & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    {
+        ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+float hect::decode_float16(uint16_t bits)
+{
+    const uint32_t sign = static_cast<uint32_t>(bits & 0x8000) << 16;
+    const uint32_t exponent = (bits >> 10) & 0x1f;
+    uint32_t mantissa = bits & 0x3ff;
+
+    uint32_t result;
+    if (exponent == 0x1f)
+    {
+        // Infinity or NaN
+        result = sign | 0x7f800000 | (mantissa << 13);
+    }
+    else if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            result = sign;
+        }
+        else
+        {
+            // Normalize the subnormal
+            int32_t float_exponent = 127 - 15 + 1;
+            while (!(mantissa & 0x400))
+            {
+                mantissa <<= 1;
+                --float_exponent;
+            }
+            mantissa &= 0x3ff;
+            result = sign | (static_cast<uint32_t>(float_exponent) << 23) | (mantissa << 13);
+        }
+    }
+    else
+    {
+        result = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &result, sizeof(float));
+    return value;
+}
+
+int16_t hect::encode_normalized_int16(double value)
+{
+    value = std::max(-1.0, std::min(1.0, value));
+    return static_cast<int16_t>(std::round(value * 32767.0));
+}
+
+double hect::decode_normalized_int16(int16_t value)
+{
+    return std::max(-1.0, value / 32767.0);
+}
+
+uint16_t hect::encode_normalized_uint16(double value)
+{
+    value = std::max(0.0, std::min(1.0, value));
+    return static_cast<uint16_t>(std::round(value * 65535.0));
+}
+
+double hect::decode_normalized_uint16(uint16_t value)
+{
+    return value / 65535.0;
+}
+
+void hect::encode_octahedral(Vector3 direction, int16_t* encoded)
+{
+    // Project onto the octahedron
+    const double length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+    if (length > 0.0)
+    {
+        direction /= length;
+    }
+
+    double u = direction.x;
+    double v = direction.y;
+
+    // Fold the lower hemisphere over the diagonals
+    if (direction.z < 0.0)
+    {
+        const double folded_u = (1.0 - std::abs(v)) * sign_not_zero(u);
+        const double folded_v = (1.0 - std::abs(u)) * sign_not_zero(v);
+        u = folded_u;
+        v = folded_v;
+    }
+
+    encoded[0] = encode_normalized_int16(u);
+    encoded[1] = encode_normalized_int16(v);
+}
+
+Vector3 hect::decode_octahedral(const int16_t* encoded)
+{
+    const double u = decode_normalized_int16(encoded[0]);
+    const double v = decode_normalized_int16(encoded[1]);
+
+    Vector3 direction(u, v, 1.0 - std::abs(u) - std::abs(v));
+
+    // Unfold the lower hemisphere
+    if (direction.z < 0.0)
+    {
+        direction.x = (1.0 - std::abs(v)) * sign_not_zero(u);
+        direction.y = (1.0 - std::abs(u)) * sign_not_zero(v);
+    }
+
+    return direction.normalized();
+}
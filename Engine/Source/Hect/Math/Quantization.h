@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+
+#include "Hect/Core/Export.h"
+#include "Hect/Math/Vector3.h"
+
+namespace hect
+{
+
+///
+/// Converts a value to a 16-bit float.
+///
+/// \note Values too large to represent become infinity and values too small
+/// to represent become zero.
+///
+/// \param value The value.
+///
+/// \returns The bits of the 16-bit float.
+HECT_EXPORT uint16_t encode_float16(float value);
+
+///
+/// Converts a 16-bit float to a value.
+///
+/// \param bits The bits of the 16-bit float.
+///
+/// \returns The value.
+HECT_EXPORT float decode_float16(uint16_t bits);
+
+///
+/// Converts a value in the range [-1, 1] to a normalized 16-bit signed
+/// integer.
+///
+/// \param value The value; clamped to the range.
+///
+/// \returns The normalized integer.
+HECT_EXPORT int16_t encode_normalized_int16(double value);
+
+///
+/// Converts a normalized 16-bit signed integer to a value in the range
+/// [-1, 1].
+///
+/// \param value The normalized integer.
+///
+/// \returns The value.
+HECT_EXPORT double decode_normalized_int16(int16_t value);
+
+///
+/// Converts a value in the range [0, 1] to a normalized 16-bit unsigned
+/// integer.
+///
+/// \param value The value; clamped to the range.
+///
+/// \returns The normalized integer.
+HECT_EXPORT uint16_t encode_normalized_uint16(double value);
+
+///
+/// Converts a normalized 16-bit unsigned integer to a value in the range
+/// [0, 1].
+///
+/// \param value The normalized integer.
+///
+/// \returns The value.
+HECT_EXPORT double decode_normalized_uint16(uint16_t value);
+
+///
+/// Encodes a direction as two normalized 16-bit signed integers by
+/// projecting it onto an octahedron and unfolding the octahedron onto a
+/// square.
+///
+/// \param direction The direction; does not need to be unit length.
+/// \param encoded The array of two integers to store the encoding in.
+HECT_EXPORT void encode_octahedral(Vector3 direction, int16_t* encoded);
+
+///
+/// Decodes a direction encoded with encode_octahedral().
+///
+/// \param encoded The array of two integers of the encoding.
+///
+/// \returns The unit-length direction.
+HECT_EXPORT Vector3 decode_octahedral(const int16_t* encoded);
+
+}
@@ -204,6 +204,7 @@ public:
 };
 
 typedef QuaternionT<double> Quaternion;
+typedef QuaternionT<float> FloatQuaternion;
 
 template <typename Type>
 Encoder& operator<<(Encoder& encoder, QuaternionT<Type> q);
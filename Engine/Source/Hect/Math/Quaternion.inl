@@ -23,6 +23,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include <cassert>
 
+#include "Hect/Math/Simd.h"
+
 namespace hect
 {
 
@@ -157,19 +159,19 @@ QuaternionT<Type> QuaternionT<Type>::operator*(Type value) const
 template <typename Type>
 Vector3T<Type> QuaternionT<Type>::operator*(Vector3T<Type> v) const
 {
-    return Matrix4T<Type>::from_rotation(*this) * v;
+    const Type components[4] = { x, y, z, w };
+    return simd::rotate_vector3(components, v);
 }
 
 template <typename Type>
 QuaternionT<Type> QuaternionT<Type>::operator*(const QuaternionT& q) const
 {
-    Vector3T<Type> av(x, y, z);
-    Vector3T<Type> bv(q.x, q.y, q.z);
-
-    Vector3T<Type> new_v = (bv * w) + (av * q.w) + av.cross(bv);
-    Type new_w = w * q.w - av.dot(bv);
+    const Type a[4] = { x, y, z, w };
+    const Type b[4] = { q.x, q.y, q.z, q.w };
 
-    return QuaternionT<Type>(new_v, new_w);
+    Type result[4];
+    simd::multiply_quaternion(a, b, result);
+    return QuaternionT<Type>(result[0], result[1], result[2], result[3]);
 }
 
 template <typename Type>
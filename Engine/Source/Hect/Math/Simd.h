@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+
+#include "Hect/Core/Configuration.h"
+#include "Hect/Math/Vector3.h"
+
+#ifdef HECT_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef HECT_SIMD_AVX
+#include <immintrin.h>
+#endif
+
+namespace hect
+{
+
+///
+/// Kernels for the math types operating on their raw components.
+///
+/// Each kernel is a template implemented with scalar arithmetic.  The matrix
+/// kernels are overloaded for float and double to use SSE or AVX when
+/// available; the overloads accumulate in the same order as the scalar
+/// kernels so they produce identical results, provided the compiler does not
+/// contract the scalar arithmetic into fused multiply-adds.  The scalar
+/// kernels can be called explicitly by passing the template argument (e.g.
+/// simd::multiply_matrix4<float>()).
+///
+/// Matrices are 16 components in column-major order, quaternions are 4
+/// components in x, y, z, w order, and vectors are 4 components.
+namespace simd
+{
+
+///
+/// Multiplies two 4x4 matrices.
+///
+/// \param a The left-hand matrix.
+/// \param b The right-hand matrix.
+/// \param result The matrix to store the product in; may be the same as
+/// the right-hand matrix but not the left-hand matrix.
+template <typename Type>
+void multiply_matrix4(const Type* a, const Type* b, Type* result);
+
+///
+/// Multiplies a 4x4 matrix and a 4-dimensional vector.
+///
+/// \param m The matrix.
+/// \param v The vector.
+/// \param result The vector to store the product in; may be the same as
+/// the vector.
+template <typename Type>
+void transform_vector4(const Type* m, const Type* v, Type* result);
+
+///
+/// Transforms an array of points by a 4x4 matrix.
+///
+/// \note The points are treated as having a w component of one and the
+/// resulting w component is discarded, so the matrix is expected to be an
+/// affine transform.
+///
+/// \param m The matrix.
+/// \param points The points to transform.
+/// \param results The array to store the transformed points in; may be the
+/// same as the points.
+/// \param count The number of points.
+template <typename Type>
+void transform_points(const Type* m, const Vector3T<Type>* points, Vector3T<Type>* results, size_t count);
+
+///
+/// Multiplies two quaternions.
+///
+/// \param a The left-hand quaternion.
+/// \param b The right-hand quaternion.
+/// \param result The quaternion to store the product in; may be the same
+/// as either quaternion.
+template <typename Type>
+void multiply_quaternion(const Type* a, const Type* b, Type* result);
+
+///
+/// Rotates a vector by a unit quaternion using the same convention as
+/// Matrix4T::from_rotation().
+///
+/// \param q The quaternion.
+/// \param v The vector.
+///
+/// \returns The rotated vector.
+template <typename Type>
+Vector3T<Type> rotate_vector3(const Type* q, Vector3T<Type> v);
+
+#ifdef HECT_SIMD_SSE2
+
+void multiply_matrix4(const float* a, const float* b, float* result);
+void multiply_matrix4(const double* a, const double* b, double* result);
+
+void transform_vector4(const float* m, const float* v, float* result);
+void transform_vector4(const double* m, const double* v, double* result);
+
+void transform_points(const float* m, const Vector3T<float>* points, Vector3T<float>* results, size_t count);
+
+#endif
+
+}
+
+}
+
+#include "Simd.inl"
@@ -0,0 +1,241 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+namespace hect
+{
+
+namespace simd
+{
+
+template <typename Type>
+void multiply_matrix4(const Type* a, const Type* b, Type* result)
+{
+    for (size_t j = 0; j < 16; j += 4)
+    {
+        const Type b0 = b[j];
+        const Type b1 = b[j + 1];
+        const Type b2 = b[j + 2];
+        const Type b3 = b[j + 3];
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            result[j + i] = a[i] * b0 + a[i + 4] * b1 + a[i + 8] * b2 + a[i + 12] * b3;
+        }
+    }
+}
+
+template <typename Type>
+void transform_vector4(const Type* m, const Type* v, Type* result)
+{
+    const Type x = v[0];
+    const Type y = v[1];
+    const Type z = v[2];
+    const Type w = v[3];
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        result[i] = m[i] * x + m[i + 4] * y + m[i + 8] * z + m[i + 12] * w;
+    }
+}
+
+template <typename Type>
+void transform_points(const Type* m, const Vector3T<Type>* points, Vector3T<Type>* results, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Vector3T<Type> p = points[i];
+        results[i].x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+        results[i].y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+        results[i].z = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14];
+    }
+}
+
+template <typename Type>
+void multiply_quaternion(const Type* a, const Type* b, Type* result)
+{
+    const Vector3T<Type> av(a[0], a[1], a[2]);
+    const Vector3T<Type> bv(b[0], b[1], b[2]);
+    const Type aw = a[3];
+    const Type bw = b[3];
+
+    const Vector3T<Type> v = (bv * aw) + (av * bw) + av.cross(bv);
+    result[0] = v.x;
+    result[1] = v.y;
+    result[2] = v.z;
+    result[3] = aw * bw - av.dot(bv);
+}
+
+template <typename Type>
+Vector3T<Type> rotate_vector3(const Type* q, Vector3T<Type> v)
+{
+    // Matrix4T::from_rotation() rotates by the conjugate of the quaternion
+    const Vector3T<Type> u(-q[0], -q[1], -q[2]);
+    const Vector3T<Type> t = u.cross(v) * Type(2);
+    return v + t * q[3] + u.cross(t);
+}
+
+#ifdef HECT_SIMD_SSE2
+
+inline void multiply_matrix4(const float* a, const float* b, float* result)
+{
+    const __m128 a0 = _mm_loadu_ps(a);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+
+    __m128 columns[4];
+    for (size_t j = 0; j < 4; ++j)
+    {
+        const float* column = b + j * 4;
+        __m128 r = _mm_mul_ps(a0, _mm_set1_ps(column[0]));
+        r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(column[1])));
+        r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(column[2])));
+        r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(column[3])));
+        columns[j] = r;
+    }
+
+    for (size_t j = 0; j < 4; ++j)
+    {
+        _mm_storeu_ps(result + j * 4, columns[j]);
+    }
+}
+
+inline void transform_vector4(const float* m, const float* v, float* result)
+{
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(v[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(v[3])));
+    _mm_storeu_ps(result, r);
+}
+
+inline void transform_points(const float* m, const Vector3T<float>* points, Vector3T<float>* results, size_t count)
+{
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+
+    float transformed[4];
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Vector3T<float> p = points[i];
+        __m128 r = _mm_mul_ps(c0, _mm_set1_ps(p.x));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(p.y)));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(p.z)));
+        r = _mm_add_ps(r, c3);
+        _mm_storeu_ps(transformed, r);
+        results[i] = Vector3T<float>(transformed[0], transformed[1], transformed[2]);
+    }
+}
+
+#ifdef HECT_SIMD_AVX
+
+inline void multiply_matrix4(const double* a, const double* b, double* result)
+{
+    const __m256d a0 = _mm256_loadu_pd(a);
+    const __m256d a1 = _mm256_loadu_pd(a + 4);
+    const __m256d a2 = _mm256_loadu_pd(a + 8);
+    const __m256d a3 = _mm256_loadu_pd(a + 12);
+
+    __m256d columns[4];
+    for (size_t j = 0; j < 4; ++j)
+    {
+        const double* column = b + j * 4;
+        __m256d r = _mm256_mul_pd(a0, _mm256_set1_pd(column[0]));
+        r = _mm256_add_pd(r, _mm256_mul_pd(a1, _mm256_set1_pd(column[1])));
+        r = _mm256_add_pd(r, _mm256_mul_pd(a2, _mm256_set1_pd(column[2])));
+        r = _mm256_add_pd(r, _mm256_mul_pd(a3, _mm256_set1_pd(column[3])));
+        columns[j] = r;
+    }
+
+    for (size_t j = 0; j < 4; ++j)
+    {
+        _mm256_storeu_pd(result + j * 4, columns[j]);
+    }
+}
+
+inline void transform_vector4(const double* m, const double* v, double* result)
+{
+    __m256d r = _mm256_mul_pd(_mm256_loadu_pd(m), _mm256_set1_pd(v[0]));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(m + 4), _mm256_set1_pd(v[1])));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(m + 8), _mm256_set1_pd(v[2])));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_loadu_pd(m + 12), _mm256_set1_pd(v[3])));
+    _mm256_storeu_pd(result, r);
+}
+
+#else
+
+inline void multiply_matrix4(const double* a, const double* b, double* result)
+{
+    // Each column is split into a low (x, y) and high (z, w) half
+    __m128d columns[8];
+    for (size_t j = 0; j < 4; ++j)
+    {
+        const double* column = b + j * 4;
+        for (size_t half = 0; half < 2; ++half)
+        {
+            const double* row = a + half * 2;
+            __m128d r = _mm_mul_pd(_mm_loadu_pd(row), _mm_set1_pd(column[0]));
+            r = _mm_add_pd(r, _mm_mul_pd(_mm_loadu_pd(row + 4), _mm_set1_pd(column[1])));
+            r = _mm_add_pd(r, _mm_mul_pd(_mm_loadu_pd(row + 8), _mm_set1_pd(column[2])));
+            r = _mm_add_pd(r, _mm_mul_pd(_mm_loadu_pd(row + 12), _mm_set1_pd(column[3])));
+            columns[j * 2 + half] = r;
+        }
+    }
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        _mm_storeu_pd(result + i * 2, columns[i]);
+    }
+}
+
+inline void transform_vector4(const double* m, const double* v, double* result)
+{
+    const __m128d x = _mm_set1_pd(v[0]);
+    const __m128d y = _mm_set1_pd(v[1]);
+    const __m128d z = _mm_set1_pd(v[2]);
+    const __m128d w = _mm_set1_pd(v[3]);
+
+    __m128d halves[2];
+    for (size_t half = 0; half < 2; ++half)
+    {
+        const double* row = m + half * 2;
+        __m128d r = _mm_mul_pd(_mm_loadu_pd(row), x);
+        r = _mm_add_pd(r, _mm_mul_pd(_mm_loadu_pd(row + 4), y));
+        r = _mm_add_pd(r, _mm_mul_pd(_mm_loadu_pd(row + 8), z));
+        r = _mm_add_pd(r, _mm_mul_pd(_mm_loadu_pd(row + 12), w));
+        halves[half] = r;
+    }
+
+    _mm_storeu_pd(result, halves[0]);
+    _mm_storeu_pd(result + 2, halves[1]);
+}
+
+#endif
+
+#endif
+
+}
+
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "SphereBatch.h"
+
+using namespace hect;
+
+void SphereBatch::add(Sphere sphere, Vector3 position)
+{
+    _position_x.push_back(static_cast<float>(position.x));
+    _position_y.push_back(static_cast<float>(position.y));
+    _position_z.push_back(static_cast<float>(position.z));
+    _radius.push_back(static_cast<float>(sphere.radius()));
+}
+
+void SphereBatch::clear()
+{
+    _position_x.clear();
+    _position_y.clear();
+    _position_z.clear();
+    _radius.clear();
+}
+
+void SphereBatch::reserve(size_t count)
+{
+    _position_x.reserve(count);
+    _position_y.reserve(count);
+    _position_z.reserve(count);
+    _radius.reserve(count);
+}
+
+size_t SphereBatch::size() const
+{
+    return _radius.size();
+}
+
+const float* SphereBatch::position_x() const
+{
+    return _position_x.data();
+}
+
+const float* SphereBatch::position_y() const
+{
+    return _position_y.data();
+}
+
+const float* SphereBatch::position_z() const
+{
+    return _position_z.data();
+}
+
+const float* SphereBatch::radius() const
+{
+    return _radius.data();
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+#include "Hect/Core/Export.h"
+#include "Hect/Math/Sphere.h"
+#include "Hect/Math/Vector3.h"
+
+namespace hect
+{
+
+///
+/// An array of positioned spheres with each component in its own array.
+///
+/// \note Used to test many spheres at once against a Frustum.
+class HECT_EXPORT SphereBatch
+{
+public:
+
+    ///
+    /// Adds a sphere to the end of the batch.
+    ///
+    /// \param sphere The sphere to add.
+    /// \param position The position of the sphere.
+    void add(Sphere sphere, Vector3 position);
+
+    ///
+    /// Removes all spheres from the batch.
+    void clear();
+
+    ///
+    /// Reserves space for a number of spheres.
+    ///
+    /// \param count The number of spheres.
+    void reserve(size_t count);
+
+    ///
+    /// Returns the number of spheres in the batch.
+    size_t size() const;
+
+    ///
+    /// Returns the x components of the positions of the spheres.
+    const float* position_x() const;
+
+    ///
+    /// Returns the y components of the positions of the spheres.
+    const float* position_y() const;
+
+    ///
+    /// Returns the z components of the positions of the spheres.
+    const float* position_z() const;
+
+    ///
+    /// Returns the radii of the spheres.
+    const float* radius() const;
+
+private:
+    std::vector<float> _position_x;
+    std::vector<float> _position_y;
+    std::vector<float> _position_z;
+    std::vector<float> _radius;
+};
+
+}
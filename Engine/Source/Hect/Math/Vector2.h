@@ -267,6 +267,10 @@ public:
 /// A 2-dimensional vector of doubles.
 typedef Vector2T<double> Vector2;
 
+///
+/// A 2-dimensional vector of floats.
+typedef Vector2T<float> FloatVector2;
+
 ///
 /// A 2-dimensional vector of integers.
 typedef Vector2T<int> IntVector2;
@@ -276,6 +276,10 @@ public:
 /// A 3-dimensional vector of doubles.
 typedef Vector3T<double> Vector3;
 
+///
+/// A 3-dimensional vector of floats.
+typedef Vector3T<float> FloatVector3;
+
 ///
 /// A 3-dimensional vector of integers.
 typedef Vector3T<int> IntVector3;
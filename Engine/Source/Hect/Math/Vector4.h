@@ -286,6 +286,10 @@ public:
 /// A 4-dimensional vector of doubles.
 typedef Vector4T<double> Vector4;
 
+///
+/// A 4-dimensional vector of floats.
+typedef Vector4T<float> FloatVector4;
+
 ///
 /// A 4-dimensional vector of integers.
 typedef Vector4T<int> IntVector4;
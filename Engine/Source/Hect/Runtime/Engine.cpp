@@ -127,6 +127,12 @@ Engine::Engine(int argc, char* const argv[], const Path& settings_files_path)
         }
     }
 
+    // Load the manifests of cooked assets specified in the settings
+    for (const DataValue& manifest : _settings["manifests"])
+    {
+        _asset_cache->load_manifest(manifest.as_string());
+    }
+
     const DataValue& video_mode_value = _settings["video_mode"];
     if (!video_mode_value.is_null())
     {
@@ -251,6 +257,11 @@ Window& Engine::main_window()
     return *_window;
 }
 
+bool Engine::has_renderer()
+{
+    return static_cast<bool>(_renderer);
+}
+
 Renderer& Engine::renderer()
 {
     assert(_renderer);
@@ -106,6 +106,13 @@ public:
     /// Returns the main window.
     Window& main_window();
 
+    ///
+    /// Returns whether the engine has a renderer.
+    ///
+    /// \note An engine without a video mode in its settings is headless and
+    /// has no main window or renderers.
+    bool has_renderer();
+
     ///
     /// Returns the renderer.
     Renderer& renderer();
@@ -23,6 +23,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <bitset>
+
 #include "Hect/Core/Export.h"
 #include "Hect/IO/Encodable.h"
 #include "Hect/Scene/ComponentHandle.h"
@@ -35,6 +37,15 @@ namespace hect
 /// A numeric identifier for a Component type.
 typedef uint32_t ComponentTypeId;
 
+///
+/// The maximum number of Component types that can be registered.
+const size_t MaxComponentTypeCount = 64;
+
+///
+/// A set of bits indicating which Component types an Entity has, indexed by
+/// ComponentTypeId.
+typedef std::bitset<MaxComponentTypeCount> ComponentSignature;
+
 ///
 /// Abstract base for Component.
 class HECT_EXPORT ComponentBase :
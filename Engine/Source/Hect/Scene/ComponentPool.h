@@ -49,6 +49,8 @@ public:
 
 protected:
     virtual void dispatch_event(ComponentEventType type, Entity& entity) = 0;
+    virtual void enqueue_event(ComponentEventType type, Entity& entity) = 0;
+    virtual void dispatch_queued_events() = 0;
 
     virtual void add_base(Entity& entity, const ComponentBase& component) = 0;
     virtual ComponentBase& get_base(Entity& entity) = 0;
@@ -134,6 +136,8 @@ public:
 
 private:
     void dispatch_event(ComponentEventType type, Entity& entity) override;
+    void enqueue_event(ComponentEventType type, Entity& entity) override;
+    void dispatch_queued_events() override;
 
     void add_base(Entity& entity, const ComponentBase& component) override;
     ComponentBase& get_base(Entity& entity) override;
@@ -168,6 +172,7 @@ private:
     bool expand_vector(std::vector<Type>& vector, size_t size, Type value = Type());
 
     Scene& _scene;
+    ComponentTypeId _type_id;
     IdPool<ComponentId> _id_pool;
 
     std::deque<ComponentType> _components;
@@ -26,7 +26,8 @@ namespace hect
 
 template <typename ComponentType>
 ComponentPool<ComponentType>::ComponentPool(Scene& scene) :
-    _scene(scene)
+    _scene(scene),
+    _type_id(ComponentRegistry::type_id_of<ComponentType>())
 {
 }
 
@@ -129,6 +130,25 @@ void ComponentPool<ComponentType>::dispatch_event(ComponentEventType type, Entit
     EventDispatcher<ComponentEvent<ComponentType>>::dispatch_event(event);
 }
 
+template <typename ComponentType>
+void ComponentPool<ComponentType>::enqueue_event(ComponentEventType type, Entity& entity)
+{
+    ComponentEvent<ComponentType> event;
+    event.type = type;
+    event.entity = entity.handle();
+
+    EventDispatcher<ComponentEvent<ComponentType>>::enqueue_event(event);
+}
+
+template <typename ComponentType>
+void ComponentPool<ComponentType>::dispatch_queued_events()
+{
+    if (EventDispatcher<ComponentEvent<ComponentType>>::has_queued_events())
+    {
+        EventDispatcher<ComponentEvent<ComponentType>>::dispatch_queued_events();
+    }
+}
+
 template <typename ComponentType>
 void ComponentPool<ComponentType>::add_base(Entity& entity, const ComponentBase& component)
 {
@@ -172,6 +192,9 @@ void ComponentPool<ComponentType>::remove(Entity& entity)
         // entity
         _component_to_entity[id] = EntityId(-1);
         _entity_to_component[entity_id] = ComponentId(-1);
+
+        // The entity no longer has a component of this type
+        entity._component_signature.reset(_type_id);
     }
     else
     {
@@ -197,10 +220,7 @@ void ComponentPool<ComponentType>::clone(const Entity& source, Entity& dest)
 template <typename ComponentType>
 bool ComponentPool<ComponentType>::has(const Entity& entity) const
 {
-    EntityId entity_id = entity.id();
-
-    ComponentId id;
-    return entity_id_to_component_id(entity_id, id);
+    return entity._component_signature.test(_type_id);
 }
 
 template <typename ComponentType>
@@ -234,6 +254,7 @@ ComponentType& ComponentPool<ComponentType>::add(Entity& entity, const Component
 
     // Remember which component this entity has
     _entity_to_component[entity_id] = id;
+    entity._component_signature.set(_type_id);
 
     // Expand the component-to-entity vector if needed
     expand_vector(_component_to_entity, id, EntityId(-1));
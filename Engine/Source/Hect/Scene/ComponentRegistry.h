@@ -110,6 +110,9 @@ public:
     /// Registers a Component type.
     ///
     /// \warning The type must be registered with Type.
+    ///
+    /// \throws InvalidOperation If the maximum number of component types
+    /// are already registered.
     template <typename ComponentType>
     static void register_type();
 
@@ -121,6 +124,15 @@ public:
     template <typename ComponentType>
     static ComponentTypeId type_id_of();
 
+    ///
+    /// Returns the ComponentSignature including each of the specified
+    /// Component types.
+    ///
+    /// \throws InvalidOperation If any of the specified types are not
+    /// registered component types.
+    template <typename... ComponentTypes>
+    static ComponentSignature signature_of();
+
 private:
     ComponentRegistry() = delete;
 
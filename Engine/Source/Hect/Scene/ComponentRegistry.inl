@@ -23,6 +23,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Hect/Reflection/Type.h"
 
+#include "Hect/Core/Exception.h"
 #include "Hect/Core/Format.h"
 #include "Hect/Core/Logging.h"
 
@@ -38,6 +39,11 @@ void ComponentRegistry::register_type()
     {
         Name type_name = Type::get<ComponentType>().name();
 
+        if (_component_constructors.size() >= MaxComponentTypeCount)
+        {
+            throw InvalidOperation(format("Cannot register component type '%s': maximum number of component types reached", type_name.data()));
+        }
+
         ComponentTypeId type_id = static_cast<ComponentTypeId>(_component_constructors.size());
 
         _component_constructors.push_back([]()
@@ -71,4 +77,13 @@ ComponentTypeId ComponentRegistry::type_id_of()
     return id;
 }
 
+template <typename... ComponentTypes>
+ComponentSignature ComponentRegistry::signature_of()
+{
+    ComponentSignature signature;
+    int _[] = { 0, (signature.set(type_id_of<ComponentTypes>()), 0)... };
+    (void)_;
+    return signature;
+}
+
 }
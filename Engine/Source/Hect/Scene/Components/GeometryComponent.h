@@ -23,6 +23,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <vector>
+
 #include "Hect/Core/Export.h"
 #include "Hect/Graphics/Material.h"
 #include "Hect/Graphics/Mesh.h"
@@ -40,6 +42,27 @@ class HECT_EXPORT GeometrySurface :
     public Encodable
 {
 public:
+
+    ///
+    /// The level of detail of the mesh which was last rendered by a camera.
+    class CameraLevelOfDetail
+    {
+    public:
+
+        ///
+        /// The entity of the camera; no longer valid once the entity is
+        /// destroyed, even if its id is re-used.
+        EntityHandle camera;
+
+        ///
+        /// The level of detail last rendered.
+        size_t level { 0 };
+
+        ///
+        /// The index of the frame the level was last rendered in.
+        uint64_t frame { 0 };
+    };
+
     GeometrySurface();
 
     ///
@@ -66,6 +89,17 @@ public:
     ///
     /// \property
     bool visible { true };
+
+    ///
+    /// The level of detail of the mesh which was last rendered by each
+    /// camera.
+    ///
+    /// \note The levels are kept between frames so that selecting a level
+    /// can resist switching back and forth near a threshold.  Each camera
+    /// keeps its own level so that cameras at different distances from the
+    /// surface do not disturb each other.  The level of a camera which has
+    /// been destroyed or has not rendered the surface recently is dropped.
+    std::vector<CameraLevelOfDetail> levels_of_detail;
 };
 
 ///
@@ -24,12 +24,23 @@
 #include "Entity.h"
 
 #include "Hect/IO/AssetCache.h"
-#include "Hect/IO/AssetDecoder.h"
 #include "Hect/Scene/EntityPool.h"
+#include "Hect/Scene/Prefab.h"
 #include "Hect/Scene/Scene.h"
 
 using namespace hect;
 
+bool Entity::has_components(const ComponentSignature& signature) const
+{
+    ensure_in_pool();
+    return (_component_signature & signature) == signature;
+}
+
+ComponentSignature Entity::component_signature() const
+{
+    return _component_signature;
+}
+
 Name Entity::name() const
 {
     return _name;
@@ -59,12 +70,7 @@ EntityHandle Entity::handle() const
         return EntityHandle();
     }
 
-    if (!_handle)
-    {
-        _handle = EntityHandle(*const_cast<Entity*>(reinterpret_cast<const Entity*>(this)));
-    }
-
-    return _handle;
+    return EntityHandle(*_pool, _id, _generation.load(std::memory_order_relaxed));
 }
 
 EntityIterator Entity::iterator()
@@ -250,7 +256,9 @@ Entity::Entity(const Entity& entity) :
     _parent_id(entity._parent_id),
     _child_ids(entity._child_ids),
     _name(entity._name),
-    _flags(entity._flags)
+    _flags(entity._flags),
+    _component_signature(entity._component_signature),
+    _generation(entity._generation.load())
 {
 }
 
@@ -260,7 +268,9 @@ Entity::Entity(Entity&& entity) :
     _parent_id(entity._parent_id),
     _child_ids(std::move(entity._child_ids)),
     _name(entity._name),
-    _flags(entity._flags)
+    _flags(entity._flags),
+    _component_signature(entity._component_signature),
+    _generation(entity._generation.load())
 {
 }
 
@@ -270,9 +280,10 @@ Entity& Entity::operator=(const Entity& entity)
     _id = entity._id;
     _parent_id = entity._parent_id;
     _child_ids = entity._child_ids;
-    _handle = entity._handle;
     _name = entity._name;
     _flags = entity._flags;
+    _component_signature = entity._component_signature;
+    _generation = entity._generation.load();
     return *this;
 }
 
@@ -282,9 +293,10 @@ Entity& Entity::operator=(Entity&& entity)
     _id = entity._id;
     _parent_id = entity._parent_id;
     _child_ids = std::move(entity._child_ids);
-    _handle = entity._handle;
     _name = entity._name;
     _flags = entity._flags;
+    _component_signature = entity._component_signature;
+    _generation = entity._generation.load();
     return *this;
 }
 
@@ -301,12 +313,10 @@ void Entity::exit_pool()
     _parent_id = EntityId(-1);
     _child_ids.clear();
     _flags = std::bitset<4>();
+    _component_signature.reset();
 
-    if (_handle)
-    {
-        _handle.invalidate();
-    }
-    _handle = EntityHandle();
+    // Invalidate all handles to the entity
+    _generation.fetch_add(1, std::memory_order_release);
 }
 
 bool Entity::in_pool() const
@@ -385,8 +395,9 @@ void Entity::decode(Decoder& decoder)
 
             try
             {
-                AssetDecoder base_decoder(decoder.asset_cache(), base_path);
-                base_decoder >> decode_value(*entity);
+                // The base entity is decoded once and cached as a prefab
+                const Prefab& base = decoder.asset_cache().get<Prefab>(base_path);
+                base.apply(*entity);
             }
             catch (const Exception& exception)
             {
@@ -23,6 +23,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <atomic>
 #include <bitset>
 #include <functional>
 
@@ -49,7 +50,9 @@ class HECT_EXPORT Entity :
     friend class Scene;
     friend class EntityChildren;
     friend class EntityChildIteratorBase;
+    friend class EntityHandle;
     friend class EntityPool;
+    template <typename ComponentType> friend class ComponentPool;
 public:
 
     ///
@@ -99,6 +102,23 @@ public:
     template <typename ComponentType>
     bool has_component() const;
 
+    ///
+    /// Returns whether the Entity has a Component of each of the specified
+    /// types.
+    template <typename... ComponentTypes>
+    bool has_components() const;
+
+    ///
+    /// Returns whether the Entity has a Component of each type included in a
+    /// signature.
+    ///
+    /// \param signature The signature of the component types.
+    bool has_components(const ComponentSignature& signature) const;
+
+    ///
+    /// Returns the signature of the Component types that the Entity has.
+    ComponentSignature component_signature() const;
+
     ///
     /// Returns a reference to the Component of a specific type for the Entity.
     ///
@@ -386,7 +406,8 @@ private:
     std::vector<EntityId> _child_ids;
     Name _name;
     std::bitset<4> _flags;
-    mutable EntityHandle _handle;
+    ComponentSignature _component_signature;
+    std::atomic<EntityGeneration> _generation { 0 };
 };
 
 }
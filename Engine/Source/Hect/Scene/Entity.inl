@@ -56,6 +56,12 @@ bool Entity::has_component() const
     return component_pool.has(*this);
 }
 
+template <typename... ComponentTypes>
+bool Entity::has_components() const
+{
+    return has_components(ComponentRegistry::signature_of<ComponentTypes...>());
+}
+
 template <typename ComponentType>
 ComponentType& Entity::component()
 {
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "EntityCommandBuffer.h"
+
+#include "Hect/Scene/Prefab.h"
+#include "Hect/Scene/Scene.h"
+
+using namespace hect;
+
+void EntityCommandBuffer::instantiate(const Prefab& prefab)
+{
+    Command command;
+    command.type = CommandType::InstantiatePrefab;
+    command.prefab = &prefab;
+    _commands.push_back(command);
+}
+
+void EntityCommandBuffer::destroy_entity(EntityHandle entity)
+{
+    Command command;
+    command.type = CommandType::DestroyEntity;
+    command.entity = entity;
+    _commands.push_back(command);
+}
+
+size_t EntityCommandBuffer::command_count() const
+{
+    return _commands.size();
+}
+
+EntityCommandBuffer::EntityCommandBuffer()
+{
+}
+
+void EntityCommandBuffer::add_component_base(EntityHandle entity, const std::shared_ptr<ComponentBase>& component)
+{
+    Command command;
+    command.type = CommandType::AddComponent;
+    command.entity = entity;
+    command.component_index = _components.size();
+    command.component_count = 1;
+    _commands.push_back(command);
+
+    _components.push_back(component);
+}
+
+void EntityCommandBuffer::remove_component_of_type_id(EntityHandle entity, ComponentTypeId type_id)
+{
+    Command command;
+    command.type = CommandType::RemoveComponent;
+    command.entity = entity;
+    command.component_type_id = type_id;
+    _commands.push_back(command);
+}
+
+void EntityCommandBuffer::play_back(Scene& scene)
+{
+    try
+    {
+        for (Command& command : _commands)
+        {
+            switch (command.type)
+            {
+            case CommandType::CreateEntity:
+            {
+                Entity& entity = scene.create_entity(command.name);
+                for (size_t i = 0; i < command.component_count; ++i)
+                {
+                    const ComponentBase& component = *_components[command.component_index + i];
+                    scene.add_entity_component_base(entity, component);
+                }
+                entity.activate();
+            }
+            break;
+            case CommandType::InstantiatePrefab:
+            {
+                Entity& entity = command.prefab->instantiate(scene);
+                entity.activate();
+            }
+            break;
+            case CommandType::DestroyEntity:
+                if (command.entity && !command.entity->is_pending_destruction())
+                {
+                    command.entity->destroy();
+                }
+                break;
+            case CommandType::AddComponent:
+                if (command.entity)
+                {
+                    const ComponentBase& component = *_components[command.component_index];
+                    scene.add_entity_component_base(*command.entity, component);
+                }
+                break;
+            case CommandType::RemoveComponent:
+                if (command.entity)
+                {
+                    scene.remove_entity_component_base(*command.entity, command.component_type_id);
+                }
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        // Never play back commands that already ran
+        clear();
+        throw;
+    }
+
+    clear();
+}
+
+void EntityCommandBuffer::clear()
+{
+    _commands.clear();
+    _components.clear();
+}
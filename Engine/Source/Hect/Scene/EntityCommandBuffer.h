@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Hect/Core/Export.h"
+#include "Hect/Core/Name.h"
+#include "Hect/Core/Uncopyable.h"
+#include "Hect/Scene/Component.h"
+#include "Hect/Scene/EntityHandle.h"
+
+namespace hect
+{
+
+class Prefab;
+class Scene;
+
+///
+/// A recording of structural changes to a Scene which are deferred until the
+/// next Scene::refresh().
+///
+/// Creating or destroying \link Entity Entities \endlink and adding or
+/// removing Component%s is not safe while systems are running in parallel.
+/// A command buffer allows a task running on a worker thread to record such
+/// changes without touching the scene.  The recorded commands of all command
+/// buffers are played back on the thread calling Scene::refresh() in the
+/// order that the command buffers were created, so the result does not depend
+/// on the scheduling of the worker threads.
+///
+/// \note A command buffer must only be recorded to from one thread at a
+/// time.
+class HECT_EXPORT EntityCommandBuffer :
+    public Uncopyable
+{
+    friend class Scene;
+public:
+
+    ///
+    /// Records the creation of a new activated Entity with the specified
+    /// Component%s.
+    ///
+    /// \param name The name of the entity.
+    /// \param components The components to add to the entity.
+    template <typename... ComponentTypes>
+    void create_entity(Name name, const ComponentTypes&... components);
+
+    ///
+    /// Records the instantiation of a Prefab as a new activated Entity.
+    ///
+    /// \warning The prefab must out-live the next Scene::refresh().
+    ///
+    /// \param prefab The prefab to instantiate.
+    void instantiate(const Prefab& prefab);
+
+    ///
+    /// Records the destruction of an Entity.
+    ///
+    /// \note Nothing happens on play back if the entity no longer exists or
+    /// is already pending destruction.
+    ///
+    /// \param entity The entity to destroy.
+    void destroy_entity(EntityHandle entity);
+
+    ///
+    /// Records the addition of a Component to an Entity.
+    ///
+    /// \note Nothing happens on play back if the entity no longer exists.
+    ///
+    /// \param entity The entity to add the component to.
+    /// \param component The component to add.
+    ///
+    /// \throws InvalidOperation On play back if the entity already has a
+    /// component of the type.
+    template <typename ComponentType>
+    void add_component(EntityHandle entity, const ComponentType& component);
+
+    ///
+    /// Records the removal of a Component of a specific type from an Entity.
+    ///
+    /// \note Nothing happens on play back if the entity no longer exists or
+    /// does not have a component of the type.
+    ///
+    /// \param entity The entity to remove the component from.
+    template <typename ComponentType>
+    void remove_component(EntityHandle entity);
+
+    ///
+    /// Returns the number of recorded commands.
+    size_t command_count() const;
+
+private:
+    EntityCommandBuffer();
+
+    enum class CommandType
+    {
+        CreateEntity,
+        InstantiatePrefab,
+        DestroyEntity,
+        AddComponent,
+        RemoveComponent
+    };
+
+    struct Command
+    {
+        CommandType type { CommandType::CreateEntity };
+        EntityHandle entity;
+        Name name { Name::Unnamed };
+        const Prefab* prefab { nullptr };
+        ComponentTypeId component_type_id { ComponentTypeId(-1) };
+        size_t component_index { 0 };
+        size_t component_count { 0 };
+    };
+
+    void add_component_base(EntityHandle entity, const std::shared_ptr<ComponentBase>& component);
+    void remove_component_of_type_id(EntityHandle entity, ComponentTypeId type_id);
+
+    void play_back(Scene& scene);
+    void clear();
+
+    std::vector<Command> _commands;
+    std::vector<std::shared_ptr<ComponentBase>> _components;
+};
+
+}
+
+#include "EntityCommandBuffer.inl"
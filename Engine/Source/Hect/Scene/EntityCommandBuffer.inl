@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Hect/Scene/ComponentRegistry.h"
+
+namespace hect
+{
+
+template <typename... ComponentTypes>
+void EntityCommandBuffer::create_entity(Name name, const ComponentTypes&... components)
+{
+    Command command;
+    command.type = CommandType::CreateEntity;
+    command.name = name;
+    command.component_index = _components.size();
+    command.component_count = sizeof...(ComponentTypes);
+
+    int _[] = { 0, (_components.push_back(std::make_shared<ComponentTypes>(components)), 0)... };
+    (void)_;
+
+    _commands.push_back(command);
+}
+
+template <typename ComponentType>
+void EntityCommandBuffer::add_component(EntityHandle entity, const ComponentType& component)
+{
+    add_component_base(entity, std::make_shared<ComponentType>(component));
+}
+
+template <typename ComponentType>
+void EntityCommandBuffer::remove_component(EntityHandle entity)
+{
+    remove_component_of_type_id(entity, ComponentRegistry::type_id_of<ComponentType>());
+}
+
+}
@@ -23,11 +23,15 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "EntityHandle.h"
 
+#include <type_traits>
+
 #include "Hect/Scene/EntityPool.h"
 #include "Hect/Scene/Scene.h"
 
 using namespace hect;
 
+static_assert(std::is_trivially_copyable<EntityHandle>::value, "Entity handles must be plain values");
+
 EntityHandle::EntityHandle()
 {
 }
@@ -39,64 +43,82 @@ EntityHandle::EntityHandle(Scene& scene, const Path& entity_path)
 
 Entity& EntityHandle::operator*()
 {
-    ensure_valid();
-    return *_entity;
+    return ensure_valid();
 }
 
 const Entity& EntityHandle::operator*() const
 {
-    ensure_valid();
-    return *_entity;
+    return ensure_valid();
 }
 
 Entity* EntityHandle::operator->()
 {
-    ensure_valid();
-    return _entity;
+    return &ensure_valid();
 }
 
 const Entity* EntityHandle::operator->() const
 {
-    ensure_valid();
-    return _entity;
+    return &ensure_valid();
 }
 
 bool EntityHandle::operator==(const EntityHandle& other) const
 {
-    return _entity == other._entity;
+    return _pool_key == other._pool_key && _key == other._key;
 }
 
 bool EntityHandle::operator!=(const EntityHandle& other) const
 {
-    return _entity != other._entity;
+    return !(*this == other);
 }
 
 EntityHandle::operator bool() const
 {
-    return is_valid();
+    return look_up_entity() != nullptr;
+}
+
+EntityId EntityHandle::id() const
+{
+    return static_cast<EntityId>(_key & 0xFFFFFFFF);
 }
 
-EntityHandle::EntityHandle(Entity& entity) :
-    _entity(&entity),
-    _valid(std::make_shared<std::atomic_bool>(true))
+EntityGeneration EntityHandle::generation() const
 {
+    return static_cast<EntityGeneration>(_key >> 32);
 }
 
-bool EntityHandle::is_valid() const
+EntityHandle::EntityHandle(EntityPool& pool, EntityId id, EntityGeneration generation) :
+    _pool_key(pool._registry_key),
+    _key(static_cast<uint64_t>(id) | (static_cast<uint64_t>(generation) << 32))
 {
-    return _entity && _valid && *_valid;
 }
 
-void EntityHandle::ensure_valid() const
+Entity* EntityHandle::look_up_entity() const
 {
-    if (!is_valid())
+    EntityPool* pool = EntityPool::registered_pool(_pool_key);
+    if (pool)
     {
-        throw InvalidOperation("Invalid entity handle");
+        const EntityId entity_id = id();
+        if (entity_id < pool->max_id())
+        {
+            // The entity is only the one the handle refers to if the slot
+            // has not been destroyed since the handle was created
+            Entity& entity = pool->look_up_entity(entity_id);
+            if (entity._generation.load(std::memory_order_acquire) == generation() && entity.in_pool())
+            {
+                return &entity;
+            }
+        }
     }
+
+    return nullptr;
 }
 
-void EntityHandle::invalidate()
+Entity& EntityHandle::ensure_valid() const
 {
-    ensure_valid();
-    _valid->store(false);
+    Entity* entity = look_up_entity();
+    if (!entity)
+    {
+        throw InvalidOperation("Invalid entity handle");
+    }
+    return *entity;
 }
@@ -23,20 +23,36 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
-#include <atomic>
-#include <memory>
+#include <cstdint>
 
 #include "Hect/Core/Export.h"
 #include "Hect/IO/Path.h"
+#include "Hect/Scene/EntityIterator.h"
 
 namespace hect
 {
 
 class Entity;
+class EntityPool;
 class Scene;
 
+///
+/// A number incremented each time an Entity slot in an EntityPool is
+/// destroyed, used to detect stale \link EntityHandle EntityHandles \endlink.
+typedef uint32_t EntityGeneration;
+
 ///
 /// A weak reference to an Entity.
+///
+/// A handle refers to an entity by its id and the generation of the entity's
+/// slot in the EntityPool.  The handle becomes invalid once the entity is
+/// destroyed, since destroying an entity advances the generation of its
+/// slot.  The pool is referred to by its slot in a fixed registry of pools
+/// and the generation of that slot, so a handle also becomes invalid once the
+/// Scene owning the entity is destroyed.  A handle is a plain value: copying
+/// or checking it never allocates or touches shared reference counts, so
+/// handles can be freely passed to and used from worker threads while the
+/// scene exists.
 class HECT_EXPORT EntityHandle
 {
     friend class Entity;
@@ -98,15 +114,26 @@ public:
     /// Returns whether the handle is valid.
     operator bool() const;
 
+    ///
+    /// Returns the id of the entity that the handle refers to.
+    EntityId id() const;
+
+    ///
+    /// Returns the generation of the entity that the handle refers to.
+    EntityGeneration generation() const;
+
 private:
-    EntityHandle(Entity& entity);
+    EntityHandle(EntityPool& pool, EntityId id, EntityGeneration generation);
+
+    Entity* look_up_entity() const;
+    Entity& ensure_valid() const;
 
-    bool is_valid() const;
-    void ensure_valid() const;
-    void invalidate();
+    // The slot of the pool in the low 32 bits and the generation of the slot
+    // in the high 32 bits
+    uint64_t _pool_key { uint64_t(-1) };
 
-    Entity* _entity { nullptr };
-    std::shared_ptr<std::atomic_bool> _valid;
+    // The entity id in the low 32 bits and the generation in the high 32 bits
+    uint64_t _key { uint64_t(-1) };
 };
 
 }
@@ -24,13 +24,69 @@
 #include "EntityPool.h"
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "Hect/Core/Exception.h"
 
 using namespace hect;
 
+namespace
+{
+
+// The most entity pools which can exist at once
+const size_t MaxEntityPools = 1024;
+
+// A slot in the registry of entity pools; the generation of a slot advances
+// each time its pool is destroyed so that handles to entities in the
+// destroyed pool never resolve to a later pool in the same slot
+class EntityPoolSlot
+{
+public:
+    std::atomic<EntityPool*> pool;
+    std::atomic<uint32_t> generation;
+};
+
+// Zero-initialized before any pool is constructed
+EntityPoolSlot entity_pool_slots[MaxEntityPools];
+
+// Guards registering and unregistering pools; looking up a pool does not lock
+std::mutex& entity_pool_slots_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+}
+
 EntityPool::EntityPool(Scene& scene) :
     _scene(scene)
 {
     allocate_chunk();
+
+    std::lock_guard<std::mutex> lock(entity_pool_slots_mutex());
+    for (size_t index = 0; index < MaxEntityPools; ++index)
+    {
+        EntityPoolSlot& slot = entity_pool_slots[index];
+        if (!slot.pool.load(std::memory_order_relaxed))
+        {
+            const uint32_t generation = slot.generation.load(std::memory_order_relaxed);
+            slot.pool.store(this, std::memory_order_release);
+            _registry_key = static_cast<uint64_t>(index) | (static_cast<uint64_t>(generation) << 32);
+            return;
+        }
+    }
+
+    throw InvalidOperation("Too many entity pools exist at once");
+}
+
+EntityPool::~EntityPool()
+{
+    // Invalidate all handles to entities in the pool
+    std::lock_guard<std::mutex> lock(entity_pool_slots_mutex());
+    EntityPoolSlot& slot = entity_pool_slots[_registry_key & 0xFFFFFFFF];
+    slot.generation.fetch_add(1, std::memory_order_release);
+    slot.pool.store(nullptr, std::memory_order_release);
 }
 
 EntityIterator EntityPool::begin()
@@ -183,3 +239,22 @@ void EntityPool::allocate_chunk()
     _entity_chunks.push_back(std::move(chunk));
 }
 
+EntityPool* EntityPool::registered_pool(uint64_t key)
+{
+    const size_t index = static_cast<size_t>(key & 0xFFFFFFFF);
+    if (index >= MaxEntityPools)
+    {
+        return nullptr;
+    }
+
+    // The pool is only the one the key refers to if the slot has not been
+    // released since the key was created
+    const EntityPoolSlot& slot = entity_pool_slots[index];
+    EntityPool* pool = slot.pool.load(std::memory_order_acquire);
+    if (pool && slot.generation.load(std::memory_order_acquire) == static_cast<uint32_t>(key >> 32))
+    {
+        return pool;
+    }
+
+    return nullptr;
+}
@@ -53,6 +53,7 @@ class HECT_EXPORT EntityPool :
     friend class EntityChildIteratorBase;
 public:
     EntityPool(Scene& scene);
+    ~EntityPool();
 
     ///
     /// Returns an iterator to the beginning of the pool.
@@ -129,6 +130,10 @@ private:
 
     void allocate_chunk();
 
+    // Returns the pool registered with the given key, or null if the pool
+    // was destroyed
+    static EntityPool* registered_pool(uint64_t key);
+
     Scene& _scene;
     IdPool<EntityId> _id_pool;
 
@@ -136,6 +141,10 @@ private:
     // constructors private
     std::vector<std::unique_ptr<Entity[]>> _entity_chunks;
     size_t _entity_chunk_size { 128 };
+
+    // The slot of the pool in the registry of pools and the generation of
+    // the slot, which is how an EntityHandle refers to the pool
+    uint64_t _registry_key { uint64_t(-1) };
 };
 
 }
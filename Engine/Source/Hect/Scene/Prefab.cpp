@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include "Prefab.h"
+
+#include <algorithm>
+
+#include "Hect/IO/AssetDecoder.h"
+#include "Hect/IO/EncodeError.h"
+#include "Hect/Reflection/Type.h"
+#include "Hect/Scene/Scene.h"
+
+using namespace hect;
+
+Prefab::Prefab()
+{
+}
+
+Prefab::Prefab(Name name) :
+    Asset(name)
+{
+}
+
+Entity& Prefab::instantiate(Scene& scene) const
+{
+    Entity& entity = scene.create_entity();
+    apply(entity);
+    return entity;
+}
+
+void Prefab::apply(Entity& entity) const
+{
+    if (!entity)
+    {
+        throw InvalidOperation("Invalid entity");
+    }
+
+    if (!_nodes.empty())
+    {
+        apply_node(0, entity);
+    }
+}
+
+size_t Prefab::entity_count() const
+{
+    return _nodes.size();
+}
+
+void Prefab::encode(Encoder& encoder) const
+{
+    if (_nodes.empty())
+    {
+        throw EncodeError("Cannot encode an empty prefab");
+    }
+
+    encode_node(0, encoder);
+}
+
+void Prefab::decode(Decoder& decoder)
+{
+    _nodes.clear();
+    _nodes.emplace_back();
+    decode_node(0, decoder);
+}
+
+void Prefab::apply_node(size_t node_index, Entity& entity) const
+{
+    const Node& node = _nodes[node_index];
+    if (node.name != Name::Unnamed)
+    {
+        entity.set_name(node.name);
+    }
+
+    // Copy the template components into the pools of the scene
+    Scene& scene = entity.scene();
+    for (const std::shared_ptr<ComponentBase>& component : node.components)
+    {
+        scene.add_entity_component_base(entity, *component);
+    }
+
+    // Entities are allocated in fixed chunks so the reference to the parent
+    // remains valid as children are created
+    for (size_t child_index : node.child_indices)
+    {
+        Entity& child = scene.create_entity();
+        apply_node(child_index, child);
+        entity.add_child(child);
+    }
+}
+
+void Prefab::encode_node(size_t node_index, Encoder& encoder) const
+{
+    const Node& node = _nodes[node_index];
+
+    const bool has_name = node.name != Name::Unnamed;
+    if (encoder.is_binary_stream())
+    {
+        encoder << encode_value(has_name);
+    }
+
+    if (has_name)
+    {
+        encoder << encode_value("name", node.name);
+    }
+
+    if (encoder.is_binary_stream())
+    {
+        WriteStream& stream = encoder.binary_stream();
+        stream << static_cast<uint8_t>(node.components.size());
+        for (const std::shared_ptr<ComponentBase>& component : node.components)
+        {
+            stream << component->type_id();
+            component->encode(encoder);
+        }
+    }
+    else
+    {
+        encoder << begin_array("components");
+        for (const std::shared_ptr<ComponentBase>& component : node.components)
+        {
+            encoder << begin_object();
+
+            Name type_name = Type::of(*component).name();
+            encoder << encode_value("component_type", type_name);
+            component->encode(encoder);
+
+            encoder << end_object();
+        }
+        encoder << end_array();
+    }
+
+    encoder << begin_array("children");
+    for (size_t child_index : node.child_indices)
+    {
+        encoder << begin_object();
+        encode_node(child_index, encoder);
+        encoder << end_object();
+    }
+    encoder << end_array();
+}
+
+void Prefab::decode_node(size_t node_index, Decoder& decoder)
+{
+    // Note that nodes are only referred to by index since decoding children
+    // may grow the node vector
+
+    if (!decoder.is_binary_stream())
+    {
+        if (decoder.select_member("base"))
+        {
+            Path base_path;
+            decoder >> decode_value(base_path);
+
+            try
+            {
+                AssetDecoder base_decoder(decoder.asset_cache(), base_path);
+                base_decoder >> begin_object();
+                decode_node(node_index, base_decoder);
+                base_decoder >> end_object();
+            }
+            catch (const Exception& exception)
+            {
+                throw DecodeError(format("Failed to load base entity '%s': %s", base_path.as_string().data(), exception.what()));
+            }
+        }
+    }
+
+    bool has_name = true;
+    if (decoder.is_binary_stream())
+    {
+        decoder >> decode_value(has_name);
+    }
+
+    if (has_name)
+    {
+        decoder >> decode_value("name", _nodes[node_index].name);
+    }
+
+    if (decoder.select_member("components"))
+    {
+        decode_components(node_index, decoder);
+    }
+
+    if (decoder.select_member("children"))
+    {
+        decoder >> begin_array();
+        while (decoder.has_more_elements())
+        {
+            const size_t child_index = _nodes.size();
+            _nodes.emplace_back();
+            _nodes[node_index].child_indices.push_back(child_index);
+
+            decoder >> begin_object();
+            decode_node(child_index, decoder);
+            decoder >> end_object();
+        }
+        decoder >> end_array();
+    }
+}
+
+void Prefab::decode_components(size_t node_index, Decoder& decoder)
+{
+    std::vector<std::shared_ptr<ComponentBase>>& components = _nodes[node_index].components;
+
+    if (decoder.is_binary_stream())
+    {
+        ReadStream& stream = decoder.binary_stream();
+        uint8_t component_count;
+        stream >> component_count;
+        for (uint8_t i = 0; i < component_count; ++i)
+        {
+            ComponentTypeId type_id;
+            stream >> type_id;
+            std::shared_ptr<ComponentBase> component = ComponentRegistry::create(type_id);
+            component->decode(decoder);
+            components.push_back(component);
+        }
+    }
+    else
+    {
+        decoder >> begin_array();
+        while (decoder.has_more_elements())
+        {
+            decoder >> begin_object();
+
+            std::string type_name;
+            decoder >> decode_value("component_type", type_name);
+
+            ComponentTypeId type_id = ComponentRegistry::type_id_of(type_name);
+
+            // If the node already has a component of this type (from a base)
+            auto it = std::find_if(components.begin(), components.end(), [type_id](const std::shared_ptr<ComponentBase>& component)
+            {
+                return component->type_id() == type_id;
+            });
+
+            if (it != components.end())
+            {
+                // Re-decode the existing component
+                (*it)->decode(decoder);
+            }
+            else
+            {
+                // Create and decode a new component of the type
+                std::shared_ptr<ComponentBase> component = ComponentRegistry::create(type_id);
+                component->decode(decoder);
+                components.push_back(component);
+            }
+
+            decoder >> end_object();
+        }
+        decoder >> end_array();
+    }
+}
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Hect/Core/Export.h"
+#include "Hect/IO/Asset.h"
+#include "Hect/Scene/Component.h"
+
+namespace hect
+{
+
+class Entity;
+class Scene;
+
+///
+/// A decoded Entity hierarchy which can be instantiated into a Scene any
+/// number of times.
+///
+/// A prefab decodes its entity asset once and keeps the resulting
+/// Component%s as templates.  Instantiating the prefab copies the template
+/// components directly into the component pools of the scene without
+/// re-decoding or re-opening any asset files.
+class HECT_EXPORT Prefab :
+    public Asset<Prefab>
+{
+public:
+
+    ///
+    /// Constructs an empty prefab.
+    Prefab();
+
+    ///
+    /// Constructs an empty prefab.
+    ///
+    /// \param name The name of the prefab.
+    Prefab(Name name);
+
+    ///
+    /// Creates a new Entity hierarchy in a Scene from the prefab.
+    ///
+    /// \note The entity will have no effect on the scene until it is
+    /// activated.
+    ///
+    /// \param scene The scene to create the entity in.
+    ///
+    /// \returns A reference to the new root entity.
+    Entity& instantiate(Scene& scene) const;
+
+    ///
+    /// Applies the name, Component%s, and children of the prefab to an
+    /// existing Entity.
+    ///
+    /// \param entity The entity to apply the prefab to.
+    ///
+    /// \throws InvalidOperation If the entity is invalid or already has a
+    /// component of a type included in the prefab.
+    void apply(Entity& entity) const;
+
+    ///
+    /// Returns the number of \link Entity Entities \endlink in the
+    /// hierarchy of the prefab.
+    size_t entity_count() const;
+
+    void encode(Encoder& encoder) const override;
+    void decode(Decoder& decoder) override;
+
+private:
+    struct Node
+    {
+        Name name { Name::Unnamed };
+        std::vector<std::shared_ptr<ComponentBase>> components;
+        std::vector<size_t> child_indices;
+    };
+
+    void apply_node(size_t node_index, Entity& entity) const;
+
+    void encode_node(size_t node_index, Encoder& encoder) const;
+    void decode_node(size_t node_index, Decoder& decoder);
+    void decode_components(size_t node_index, Decoder& decoder);
+
+    std::vector<Node> _nodes;
+};
+
+}
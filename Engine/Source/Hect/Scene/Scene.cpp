@@ -24,11 +24,44 @@
 #include "Scene.h"
 
 #include "Hect/IO/AssetDecoder.h"
+#include "Hect/Scene/Prefab.h"
 #include "Hect/Scene/SceneRegistry.h"
 #include "Hect/Runtime/Engine.h"
 
+#ifdef HECT_WINDOWS_BUILD
+#include <intrin.h>
+#endif
+
 using namespace hect;
 
+namespace
+{
+
+static_assert(MaxComponentTypeCount <= 64, "Component signatures must fit in 64 bits");
+
+// Invokes the action with the id of each component type included in the
+// signature (in ascending order)
+template <typename ActionType>
+void for_each_component_type(const ComponentSignature& signature, ActionType&& action)
+{
+    uint64_t bits = signature.to_ullong();
+    while (bits)
+    {
+#ifdef HECT_WINDOWS_BUILD
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+#else
+        const int index = __builtin_ctzll(bits);
+#endif
+        action(static_cast<ComponentTypeId>(index));
+
+        // Clear the lowest set bit
+        bits &= bits - 1;
+    }
+}
+
+}
+
 Scene::Scene(Engine& engine) :
     _engine(&engine),
     _entity_pool(*this)
@@ -68,6 +101,8 @@ void Scene::set_active(bool active)
 
 void Scene::refresh()
 {
+    play_back_command_buffers();
+
     // Create/activate/destroy all pending entities and dispatch related
     while (has_pending_entities())
     {
@@ -87,6 +122,16 @@ void Scene::initialize()
     _initialized = true;
 }
 
+EntityCommandBuffer& Scene::create_command_buffer()
+{
+    if (_command_buffer_count == _command_buffers.size())
+    {
+        _command_buffers.emplace_back(new EntityCommandBuffer());
+    }
+
+    return *_command_buffers[_command_buffer_count++];
+}
+
 Entity& Scene::create_entity(Name name)
 {
     Entity& entity = _entity_pool.create(name);
@@ -96,20 +141,10 @@ Entity& Scene::create_entity(Name name)
 
 Entity& Scene::load_entity(const Path& path)
 {
-    Timer timer;
-
-    Entity& entity = create_entity();
-
-    // Resolve the path to the entity
+    // Decode the entity once into a cached prefab and instantiate it
     AssetCache& asset_cache = _engine->asset_cache();
-    const Path resolved_path = asset_cache.resolve_path(path);
-
-    AssetDecoder decoder(_engine->asset_cache(), resolved_path);
-    decoder >> decode_value(entity);
-
-    HECT_INFO(format("Loaded entity '%s' in %ims", resolved_path.as_string().data(), Milliseconds(timer.elapsed()).value));
-
-    return entity;
+    const Prefab& prefab = asset_cache.get<Prefab>(path);
+    return prefab.instantiate(*this);
 }
 
 void Scene::destroy_all_entities()
@@ -340,7 +375,6 @@ void Scene::add_component_type(ComponentTypeId type_id)
     // Add the component pool
     auto component_pool = ComponentRegistry::create_pool(type_id, *this);
     _component_pools[type_id] = component_pool;
-    _component_type_ids.push_back(type_id);
 }
 
 ComponentPoolBase& Scene::component_pool_of_type_id(ComponentTypeId type_id)
@@ -364,11 +398,11 @@ Entity& Scene::clone_entity(const Entity& entity)
 {
     Entity& cloned_entity = create_entity(entity.name());
 
-    for (ComponentTypeId type_id : _component_type_ids)
+    for_each_component_type(entity._component_signature, [&](ComponentTypeId type_id)
     {
-        ComponentPoolBase& component_pool = component_pool_of_type_id(type_id);
+        ComponentPoolBase& component_pool = *_component_pools[type_id];
         component_pool.clone(entity, cloned_entity);
-    }
+    });
 
     // Recursively clone all children
     for (const Entity& child : entity.children())
@@ -405,14 +439,11 @@ void Scene::destroy_entity(Entity& entity)
     }
 
     // Remove all components
-    for (ComponentTypeId type_id : _component_type_ids)
+    for_each_component_type(entity._component_signature, [&](ComponentTypeId type_id)
     {
         ComponentPoolBase& component_pool = *_component_pools[type_id];
-        if (component_pool.has(entity))
-        {
-            component_pool.remove(entity);
-        }
-    }
+        component_pool.remove(entity);
+    });
 
     if (entity.is_activated())
     {
@@ -445,20 +476,18 @@ void Scene::activate_entity(Entity& entity)
     entity.set_flag(Entity::Flag::Activated, true);
     entity.set_flag(Entity::Flag::PendingActivation, false);
 
-    for (ComponentTypeId type_id : _component_type_ids)
+    // Enqueue the component add events and the entity activate event to be
+    // dispatched in batches once all pending entities are activated
+    for_each_component_type(entity._component_signature, [&](ComponentTypeId type_id)
     {
         ComponentPoolBase& component_pool = *_component_pools[type_id];
-        if (component_pool.has(entity))
-        {
-            component_pool.dispatch_event(ComponentEventType::Add, entity);
-        }
-    }
+        component_pool.enqueue_event(ComponentEventType::Add, entity);
+    });
 
-    // Dispatch the entity activate event
     EntityEvent event;
     event.type = EntityEventType::Activate;
     event.entity = entity.handle();
-    _entity_pool.dispatch_event(event);
+    _entity_pool.enqueue_event(event);
 }
 
 void Scene::pend_entity_destruction(Entity& entity)
@@ -504,6 +533,31 @@ bool Scene::has_pending_entities() const
     return !_entities_pending_creation.empty() || !_entities_pending_activation.empty() || !_entities_pending_destruction.empty();
 }
 
+void Scene::play_back_command_buffers()
+{
+    // Play back in creation order so the result is independent of which
+    // threads recorded the commands
+    try
+    {
+        for (size_t i = 0; i < _command_buffer_count; ++i)
+        {
+            _command_buffers[i]->play_back(*this);
+        }
+    }
+    catch (...)
+    {
+        // Discard the remaining command buffers so no command is played back
+        // on a later refresh
+        for (size_t i = 0; i < _command_buffer_count; ++i)
+        {
+            _command_buffers[i]->clear();
+        }
+        _command_buffer_count = 0;
+        throw;
+    }
+    _command_buffer_count = 0;
+}
+
 void Scene::dispatch_entity_creation_events()
 {
     // Dispatch the entity creation event for all entities pending creation
@@ -531,6 +585,21 @@ void Scene::activate_pending_entities()
         Entity& entity = _entity_pool.entity_with_id(entity_id);
         activate_entity(entity);
     }
+
+    // Dispatch the batched component add events followed by the batched
+    // entity activate events
+    for (auto& component_pool : _component_pools)
+    {
+        if (component_pool)
+        {
+            component_pool->dispatch_queued_events();
+        }
+    }
+
+    if (_entity_pool.has_queued_events())
+    {
+        _entity_pool.dispatch_queued_events();
+    }
 }
 
 void Scene::destroy_pending_entities()
@@ -555,9 +624,23 @@ void Scene::add_entity_component_base(Entity& entity, const ComponentBase& compo
 
     ComponentTypeId type_id = component.type_id();
     ComponentPoolBase& component_pool = component_pool_of_type_id(type_id);
+    if (component_pool.has(entity))
+    {
+        const Name type_name = ComponentRegistry::type_name_of(type_id);
+        throw InvalidOperation(format("Entity already has component of type '%s'", type_name.data()));
+    }
     component_pool.add_base(entity, component);
 }
 
+void Scene::remove_entity_component_base(Entity& entity, ComponentTypeId type_id)
+{
+    ComponentPoolBase& component_pool = component_pool_of_type_id(type_id);
+    if (component_pool.has(entity))
+    {
+        component_pool.remove(entity);
+    }
+}
+
 void Scene::encode_components(const Entity& entity, Encoder& encoder)
 {
     if (encoder.is_binary_stream())
@@ -568,18 +651,15 @@ void Scene::encode_components(const Entity& entity, Encoder& encoder)
         uint8_t component_count = 0;
         stream << component_count;
 
-        for (ComponentTypeId type_id : _component_type_ids)
+        for_each_component_type(entity._component_signature, [&](ComponentTypeId type_id)
         {
-            ComponentPoolBase& component_pool = *_component_pools[type_id];
-            if (component_pool.has(entity))
-            {
-                ++component_count;
+            ++component_count;
 
-                const ComponentBase& component = component_pool.get_base(entity);
-                stream << component.type_id();
-                component.encode(encoder);
-            }
-        }
+            const ComponentPoolBase& component_pool = *_component_pools[type_id];
+            const ComponentBase& component = component_pool.get_base(entity);
+            stream << component.type_id();
+            component.encode(encoder);
+        });
 
         size_t current_position = stream.position();
         stream.seek(component_count_position);
@@ -590,22 +670,19 @@ void Scene::encode_components(const Entity& entity, Encoder& encoder)
     {
         encoder << begin_array("components");
 
-        for (ComponentTypeId type_id : _component_type_ids)
+        for_each_component_type(entity._component_signature, [&](ComponentTypeId type_id)
         {
-            ComponentPoolBase& component_pool = *_component_pools[type_id];
-            if (component_pool.has(entity))
-            {
-                encoder << begin_object();
+            encoder << begin_object();
 
-                const ComponentBase& component = component_pool.get_base(entity);
-                Name type_name = Type::of(component).name();
+            const ComponentPoolBase& component_pool = *_component_pools[type_id];
+            const ComponentBase& component = component_pool.get_base(entity);
+            Name type_name = Type::of(component).name();
 
-                encoder << encode_value("component_type", type_name);
-                component.encode(encoder);
+            encoder << encode_value("component_type", type_name);
+            component.encode(encoder);
 
-                encoder << end_object();
-            }
-        }
+            encoder << end_object();
+        });
 
         encoder << end_array();
     }
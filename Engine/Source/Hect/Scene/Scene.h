@@ -26,6 +26,7 @@
 #include <array>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <typeindex>
 #include <typeinfo>
 
@@ -37,6 +38,7 @@
 #include "Hect/Scene/ComponentPool.h"
 #include "Hect/Scene/ComponentRegistry.h"
 #include "Hect/Scene/Entity.h"
+#include "Hect/Scene/EntityCommandBuffer.h"
 #include "Hect/Scene/EntityPool.h"
 #include "Hect/Scene/SystemBase.h"
 #include "Hect/Scene/SystemRegistry.h"
@@ -63,6 +65,8 @@ class HECT_EXPORT Scene :
     public EventListener<EntityEvent>
 {
     friend class Entity;
+    friend class EntityCommandBuffer;
+    friend class Prefab;
     template <typename ComponentType> friend class Component;
 public:
 
@@ -108,12 +112,25 @@ public:
     void set_active(bool active);
 
     ///
-    /// Dispatches pending entity events, activates entities pending
-    /// activation, and destroys entities pending destruction.
+    /// Plays back all command buffers, dispatches pending entity events,
+    /// activates entities pending activation, and destroys entities pending
+    /// destruction.
     ///
     /// \note This is always called at the beginning and end of Scene::tick().
     void refresh();
 
+    ///
+    /// Creates a command buffer for recording structural changes to the
+    /// scene from a worker thread.
+    ///
+    /// \note The command buffer is only valid until the next call to
+    /// Scene::refresh(), where the command buffers are played back in the
+    /// order they were created.  Command buffers must only be created from the
+    /// thread that refreshes the scene.
+    ///
+    /// \returns The command buffer.
+    EntityCommandBuffer& create_command_buffer();
+
     ///
     /// Returns whether the scene is initialized.
     bool is_initialized() const;
@@ -163,6 +180,9 @@ public:
     ///
     /// \note The entity will have no effect on the scene until it is activated.
     ///
+    /// \note The asset is decoded once into a Prefab cached by the AssetCache;
+    /// subsequent loads of the same asset instantiate the cached prefab.
+    ///
     /// \param path The path to the entity asset.
     ///
     /// \returns An iterator to the new entity.
@@ -223,11 +243,13 @@ private:
     // or destruction
     bool has_pending_entities() const;
 
+    void play_back_command_buffers();
     void dispatch_entity_creation_events();
     void activate_pending_entities();
     void destroy_pending_entities();
 
     void add_entity_component_base(Entity& entity, const ComponentBase& component);
+    void remove_entity_component_base(Entity& entity, ComponentTypeId type_id);
 
     void encode_components(const Entity& entity, Encoder& encoder);
     void decode_components(Entity& entity, Decoder& decoder);
@@ -246,9 +268,12 @@ private:
     std::deque<EntityId> _entities_pending_activation;
     std::deque<EntityId> _entities_pending_destruction;
 
-    std::vector<ComponentTypeId> _component_type_ids;
     std::vector<std::shared_ptr<ComponentPoolBase>> _component_pools;
 
+    // Command buffers are retained across refreshes to re-use their storage
+    std::vector<std::unique_ptr<EntityCommandBuffer>> _command_buffers;
+    size_t _command_buffer_count { 0 };
+
     std::vector<SystemBase*> _systems;
 };
 
@@ -36,7 +36,7 @@ using namespace hect;
 
 DefaultScene::DefaultScene(Engine& engine) :
     Scene(engine),
-    _interface_system(*this, engine.asset_cache(), engine.platform(), engine.renderer(), engine.vector_renderer()),
+    _interface_system(*this, engine.asset_cache(), engine.platform(), engine.has_renderer() ? &engine.renderer() : nullptr, engine.has_renderer() ? &engine.vector_renderer() : nullptr),
     _debug_system(*this, engine.asset_cache(), _interface_system),
     _input_system(*this, engine.platform(), engine.settings()),
     _camera_system(*this),
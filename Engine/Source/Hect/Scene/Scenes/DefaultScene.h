@@ -51,6 +51,9 @@ public:
     ///
     /// Constructs an empty default scene.
     ///
+    /// \note The scene of a headless engine can be decoded, encoded, and
+    /// ticked but not rendered.
+    ///
     /// \param engine The engine.
     DefaultScene(Engine& engine);
 
@@ -98,10 +98,12 @@ void BoundingBoxSystem::update_recursively(Entity& entity)
         {
             auto& transform = entity.component<TransformComponent>();
 
-            AxisAlignedBox& globalExtents = bounding_box.globalExtents;
-            globalExtents.scale(transform.global_scale);
-            globalExtents.rotate(transform.global_rotation);
-            globalExtents.translate(transform.global_position);
+            // Scale, rotate, then translate the extents in one transform
+            // rather than rotating each of their corners
+            Matrix4 matrix = Matrix4::from_translation(transform.global_position);
+            matrix *= Matrix4::from_rotation(transform.global_rotation);
+            matrix *= Matrix4::from_scale(transform.global_scale);
+            bounding_box.globalExtents.transform(matrix);
         }
     }
 
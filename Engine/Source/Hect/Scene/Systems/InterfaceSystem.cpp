@@ -27,7 +27,7 @@
 
 using namespace hect;
 
-InterfaceSystem::InterfaceSystem(Scene& scene, AssetCache& asset_cache, Platform& platform, Renderer& renderer, VectorRenderer& vector_renderer) :
+InterfaceSystem::InterfaceSystem(Scene& scene, AssetCache& asset_cache, Platform& platform, Renderer* renderer, VectorRenderer* vector_renderer) :
     System(scene),
     default_font(asset_cache, HECT_ASSET("Hect/Interface/Vera.font")),
     _platform(platform),
@@ -46,17 +46,27 @@ Interface::Handle InterfaceSystem::create_interface(RenderTarget& render_target)
 
 Vector2 InterfaceSystem::measure_text_dimensions(const std::string& text, const Font& font, double size) const
 {
-    return _vector_renderer.measure_text_dimensions(text, font, size);
+    if (!_vector_renderer)
+    {
+        throw InvalidOperation("Cannot measure text without a vector renderer");
+    }
+
+    return _vector_renderer->measure_text_dimensions(text, font, size);
 }
 
 void InterfaceSystem::render_all_interfaces()
 {
+    if (!_interfaces.empty() && (!_renderer || !_vector_renderer))
+    {
+        throw InvalidOperation("Cannot render interfaces without a renderer");
+    }
+
     for (const Interface::Handle& interface : _interfaces)
     {
         RenderTarget& interface_target = interface->render_target();
 
-        Renderer::Frame frame = _renderer.begin_frame(interface_target);
-        VectorRenderer::Frame vector_frame = _vector_renderer.begin_frame(interface_target);
+        Renderer::Frame frame = _renderer->begin_frame(interface_target);
+        VectorRenderer::Frame vector_frame = _vector_renderer->begin_frame(interface_target);
 
         Rectangle clipping(0.0, 0.0, interface_target.width(), interface_target.height());
         interface->render(vector_frame, clipping);
@@ -45,7 +45,17 @@ class HECT_EXPORT InterfaceSystem :
     public EventListener<MouseEvent>
 {
 public:
-    InterfaceSystem(Scene& scene, AssetCache& asset_cache, Platform& platform, Renderer& renderer, VectorRenderer& vector_renderer);
+
+    ///
+    /// Constructs an interface system.
+    ///
+    /// \param scene The scene.
+    /// \param asset_cache The asset cache to load fonts from.
+    /// \param platform The platform to receive mouse events from.
+    /// \param renderer The renderer, or null if the engine is headless.
+    /// \param vector_renderer The vector renderer, or null if the engine is
+    /// headless.
+    InterfaceSystem(Scene& scene, AssetCache& asset_cache, Platform& platform, Renderer* renderer, VectorRenderer* vector_renderer);
 
     ///
     /// Creates a new interface.
@@ -62,10 +72,15 @@ public:
     /// \param text The text to measure.
     /// \param font The font.
     /// \param size The font size.
+    ///
+    /// \throws InvalidOperation If the engine is headless.
     Vector2 measure_text_dimensions(const std::string& text, const Font& font, double size) const;
 
     ///
     /// Renders all interfaces to their render targets.
+    ///
+    /// \throws InvalidOperation If there are interfaces and the engine is
+    /// headless.
     void render_all_interfaces();
 
     ///
@@ -91,8 +106,8 @@ private:
     void receive_event(const MouseEvent& event) override;
 
     Platform& _platform;
-    Renderer& _renderer;
-    VectorRenderer& _vector_renderer;
+    Renderer* _renderer;
+    VectorRenderer* _vector_renderer;
 
     std::vector<Interface::Handle> _interfaces;
 };
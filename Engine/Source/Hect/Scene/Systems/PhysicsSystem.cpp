@@ -23,7 +23,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "PhysicsSystem.h"
 
-#include "Hect/Graphics/MeshReader.h"
+#include "Hect/Graphics/Mesh.h"
 #include "Hect/Runtime/Engine.h"
 #include "Hect/Scene/Components/RigidBodyComponent.h"
 #include "Hect/Scene/Components/TransformComponent.h"
@@ -65,20 +65,18 @@ btTransform convert_to_bullet(const TransformComponent& t)
 
 btTriangleMesh* convert_to_bullet(const Mesh& m)
 {
-    MeshReader mesh_reader(m);
+    std::vector<Vector3> positions;
+    m.copy_attribute_data(VertexAttributeSemantic::Position, positions);
 
     std::vector<btVector3> vertices;
-    while (mesh_reader.next_vertex())
+    vertices.reserve(positions.size());
+    for (Vector3 position : positions)
     {
-        Vector3 position = mesh_reader.read_attribute_vector3(VertexAttributeSemantic::Position);
         vertices.push_back(convert_to_bullet(position));
     }
 
-    std::vector<size_t> indices;
-    while (mesh_reader.next_index())
-    {
-        indices.push_back(mesh_reader.read_index_uint32());
-    }
+    std::vector<uint32_t> indices;
+    m.copy_index_data(indices);
 
     btTriangleMesh* mesh = new btTriangleMesh();
     for (size_t i = 0; i < indices.size() - 2; i += 3)
@@ -40,8 +40,12 @@ set(SOURCE_HECT_CORE
     "Source/Hect/Core/Name.h"
     "Source/Hect/Core/Optional.h"
     "Source/Hect/Core/Optional.inl"
+    "Source/Hect/Core/RadixSort.h"
+    "Source/Hect/Core/RadixSort.inl"
     "Source/Hect/Core/Sequence.h"
     "Source/Hect/Core/Sequence.inl"
+    "Source/Hect/Core/StridedView.h"
+    "Source/Hect/Core/StridedView.inl"
     "Source/Hect/Core/Uncopyable.cpp"
     "Source/Hect/Core/Uncopyable.h"
     )
@@ -70,21 +74,35 @@ set(SOURCE_HECT_GRAPHICS
     "Source/Hect/Graphics/GeometryBuffer.h"
     "Source/Hect/Graphics/Image.cpp"
     "Source/Hect/Graphics/Image.h"
+    "Source/Hect/Graphics/ImageCompressor.cpp"
+    "Source/Hect/Graphics/ImageCompressor.h"
     "Source/Hect/Graphics/IndexType.h"
+    "Source/Hect/Graphics/LightProbeConvolver.cpp"
+    "Source/Hect/Graphics/LightProbeConvolver.h"
     "Source/Hect/Graphics/Material.cpp"
     "Source/Hect/Graphics/Material.h"
     "Source/Hect/Graphics/Mesh.cpp"
     "Source/Hect/Graphics/Mesh.h"
+    "Source/Hect/Graphics/Mesh.inl"
+    "Source/Hect/Graphics/MeshOptimizer.cpp"
+    "Source/Hect/Graphics/MeshOptimizer.h"
     "Source/Hect/Graphics/MeshReader.cpp"
     "Source/Hect/Graphics/MeshReader.h"
     "Source/Hect/Graphics/MeshWriter.cpp"
     "Source/Hect/Graphics/MeshWriter.h"
+    "Source/Hect/Graphics/MipmapFilter.h"
+    "Source/Hect/Graphics/MipmapGenerator.cpp"
+    "Source/Hect/Graphics/MipmapGenerator.h"
     "Source/Hect/Graphics/PhysicallyBasedSceneRenderer.cpp"
     "Source/Hect/Graphics/PhysicallyBasedSceneRenderer.h"
+    "Source/Hect/Graphics/PixelConversion.cpp"
+    "Source/Hect/Graphics/PixelConversion.h"
     "Source/Hect/Graphics/PixelFormat.cpp"
     "Source/Hect/Graphics/PixelFormat.h"
     "Source/Hect/Graphics/PixelType.h"
     "Source/Hect/Graphics/PrimitiveType.h"
+    "Source/Hect/Graphics/RenderCommandBuffer.cpp"
+    "Source/Hect/Graphics/RenderCommandBuffer.h"
     "Source/Hect/Graphics/Renderer.cpp"
     "Source/Hect/Graphics/Renderer.h"
     "Source/Hect/Graphics/Renderer.inl"
@@ -96,6 +114,8 @@ set(SOURCE_HECT_GRAPHICS
     "Source/Hect/Graphics/ShaderModule.cpp"
     "Source/Hect/Graphics/ShaderModule.h"
     "Source/Hect/Graphics/ShaderModuleType.h"
+    "Source/Hect/Graphics/SphericalHarmonics.cpp"
+    "Source/Hect/Graphics/SphericalHarmonics.h"
     "Source/Hect/Graphics/Texture2.cpp"
     "Source/Hect/Graphics/Texture2.h"
     "Source/Hect/Graphics/Texture3.cpp"
@@ -106,6 +126,10 @@ set(SOURCE_HECT_GRAPHICS
     "Source/Hect/Graphics/Uniform.cpp"
     "Source/Hect/Graphics/Uniform.h"
     "Source/Hect/Graphics/UniformBinding.h"
+    "Source/Hect/Graphics/UniformBlock.cpp"
+    "Source/Hect/Graphics/UniformBlock.h"
+    "Source/Hect/Graphics/UniformBlockLayout.cpp"
+    "Source/Hect/Graphics/UniformBlockLayout.h"
     "Source/Hect/Graphics/UniformType.h"
     "Source/Hect/Graphics/UniformValue.cpp"
     "Source/Hect/Graphics/UniformValue.h"
@@ -114,6 +138,7 @@ set(SOURCE_HECT_GRAPHICS
     "Source/Hect/Graphics/VertexAttribute.cpp"
     "Source/Hect/Graphics/VertexAttribute.h"
     "Source/Hect/Graphics/VertexAttributeSemantic.h"
+    "Source/Hect/Graphics/VertexAttributeTraits.h"
     "Source/Hect/Graphics/VertexAttributeType.h"
     "Source/Hect/Graphics/VertexLayout.cpp"
     "Source/Hect/Graphics/VertexLayout.h"
@@ -206,6 +231,8 @@ set(SOURCE_HECT_IO
     "Source/Hect/IO/AssetEntry.inl"
     "Source/Hect/IO/AssetHandle.h"
     "Source/Hect/IO/AssetHandle.inl"
+    "Source/Hect/IO/AssetManifest.cpp"
+    "Source/Hect/IO/AssetManifest.h"
     "Source/Hect/IO/BinaryDecoder.cpp"
     "Source/Hect/IO/BinaryDecoder.h"
     "Source/Hect/IO/BinaryEncoder.cpp"
@@ -254,6 +281,8 @@ source_group("Source\\Hect\\IO" FILES ${SOURCE_HECT_IO})
 set(SOURCE_HECT_MATH
     "Source/Hect/Math/AxisAlignedBox.cpp"
     "Source/Hect/Math/AxisAlignedBox.h"
+    "Source/Hect/Math/AxisAlignedBoxBatch.cpp"
+    "Source/Hect/Math/AxisAlignedBoxBatch.h"
     "Source/Hect/Math/Box.cpp"
     "Source/Hect/Math/Box.h"
     "Source/Hect/Math/Constants.h"
@@ -265,12 +294,18 @@ set(SOURCE_HECT_MATH
     "Source/Hect/Math/Matrix4.inl"
     "Source/Hect/Math/Plane.cpp"
     "Source/Hect/Math/Plane.h"
+    "Source/Hect/Math/Quantization.cpp"
+    "Source/Hect/Math/Quantization.h"
     "Source/Hect/Math/Quaternion.h"
     "Source/Hect/Math/Quaternion.inl"
     "Source/Hect/Math/Rectangle.cpp"
     "Source/Hect/Math/Rectangle.h"
+    "Source/Hect/Math/Simd.h"
+    "Source/Hect/Math/Simd.inl"
     "Source/Hect/Math/Sphere.cpp"
     "Source/Hect/Math/Sphere.h"
+    "Source/Hect/Math/SphereBatch.cpp"
+    "Source/Hect/Math/SphereBatch.h"
     "Source/Hect/Math/Vector2.h"
     "Source/Hect/Math/Vector2.inl"
     "Source/Hect/Math/Vector3.h"
@@ -359,6 +394,9 @@ set(SOURCE_HECT_SCENE
     "Source/Hect/Scene/EntityChildIterator.h"
     "Source/Hect/Scene/EntityChildren.cpp"
     "Source/Hect/Scene/EntityChildren.h"
+    "Source/Hect/Scene/EntityCommandBuffer.cpp"
+    "Source/Hect/Scene/EntityCommandBuffer.h"
+    "Source/Hect/Scene/EntityCommandBuffer.inl"
     "Source/Hect/Scene/EntityEvent.h"
     "Source/Hect/Scene/EntityEventType.h"
     "Source/Hect/Scene/EntityHandle.cpp"
@@ -370,6 +408,8 @@ set(SOURCE_HECT_SCENE
     "Source/Hect/Scene/EntityPool.inl"
     "Source/Hect/Scene/IdPool.h"
     "Source/Hect/Scene/IdPool.inl"
+    "Source/Hect/Scene/Prefab.cpp"
+    "Source/Hect/Scene/Prefab.h"
     "Source/Hect/Scene/Scene.cpp"
     "Source/Hect/Scene/Scene.h"
     "Source/Hect/Scene/Scene.inl"
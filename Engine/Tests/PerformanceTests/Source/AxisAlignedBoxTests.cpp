@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect.h>
+using namespace hect;
+
+#include <celero/Celero.h>
+
+namespace
+{
+
+const AxisAlignedBox box(Vector3(-1.0, -2.0, -3.0), Vector3(4.0, 5.0, 6.0));
+const Quaternion rotation = Quaternion::from_axis_angle(Vector3(1.0, 1.0, 0.0).normalized(), Degrees(35));
+const Matrix4 transform = Matrix4::from_rotation(rotation);
+
+}
+
+BASELINE(AxisAlignedBoxTransform, Corners, 10, 100000)
+{
+    AxisAlignedBox result = box;
+    result.rotate(rotation);
+    celero::DoNotOptimizeAway(result.minimum().x);
+}
+
+BENCHMARK(AxisAlignedBoxTransform, Extents, 10, 100000)
+{
+    AxisAlignedBox result = box;
+    result.transform(transform);
+    celero::DoNotOptimizeAway(result.minimum().x);
+}
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect.h>
+using namespace hect;
+
+#include <celero/Celero.h>
+
+namespace
+{
+
+const size_t box_count = 100000;
+
+const Frustum frustum(Vector3::Zero, -Vector3::UnitZ, Vector3::UnitY, Degrees(90), 1.0, 0.1, 100.0);
+
+std::vector<AxisAlignedBox> create_boxes()
+{
+    std::vector<AxisAlignedBox> boxes;
+    for (size_t i = 0; i < box_count; ++i)
+    {
+        const Vector3 center((i % 97) * 3.0 - 150.0, (i % 13) * 2.0 - 13.0, -double(i % 211));
+        boxes.push_back(AxisAlignedBox(center - Vector3(0.5), center + Vector3(0.5)));
+    }
+    return boxes;
+}
+
+const std::vector<AxisAlignedBox> boxes = create_boxes();
+
+AxisAlignedBoxBatch create_batch()
+{
+    AxisAlignedBoxBatch batch;
+    batch.reserve(boxes.size());
+    for (const AxisAlignedBox& box : boxes)
+    {
+        batch.add(box);
+    }
+    return batch;
+}
+
+const AxisAlignedBoxBatch batch = create_batch();
+std::vector<uint64_t> visible;
+
+}
+
+BASELINE(FrustumCullBoxes, Individual, 5, 10)
+{
+    size_t visible_count = 0;
+    for (const AxisAlignedBox& box : boxes)
+    {
+        if (frustum.test_axis_aligned_box(box) != FrustumTestResult::Outside)
+        {
+            ++visible_count;
+        }
+    }
+    celero::DoNotOptimizeAway(visible_count);
+}
+
+BENCHMARK(FrustumCullBoxes, Batch, 5, 10)
+{
+    frustum.test_axis_aligned_boxes(batch, visible);
+    celero::DoNotOptimizeAway(visible[0]);
+}
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <cmath>
+
+#include <Hect.h>
+using namespace hect;
+
+#include <celero/Celero.h>
+
+namespace
+{
+
+const unsigned image_size = 512;
+
+Image create_image()
+{
+    Image image(image_size, image_size, PixelFormat::Rgba8);
+    image.set_color_space(ColorSpace::NonLinear);
+
+    ByteVector pixel_data(image_size * image_size * 4);
+    for (size_t i = 0; i < pixel_data.size(); ++i)
+    {
+        pixel_data[i] = static_cast<uint8_t>(i * 31 + i / 4);
+    }
+    image.set_pixel_data(std::move(pixel_data));
+    return image;
+}
+
+const Image image = create_image();
+std::vector<float> components(image_size * image_size * 4);
+
+}
+
+BASELINE(ImageReadPixels, ReadPixel, 5, 10)
+{
+    size_t i = 0;
+    for (unsigned y = 0; y < image_size; ++y)
+    {
+        for (unsigned x = 0; x < image_size; ++x)
+        {
+            const Color color = image.read_pixel(x, y);
+            for (unsigned c = 0; c < 4; ++c)
+            {
+                components[i++] = static_cast<float>(color[c]);
+            }
+        }
+    }
+    celero::DoNotOptimizeAway(components[0]);
+}
+
+BENCHMARK(ImageReadPixels, ReadRegion, 5, 10)
+{
+    image.read_region(0, 0, image_size, image_size, components.data());
+    celero::DoNotOptimizeAway(components[0]);
+}
+
+BASELINE(ImageConvertToLinearFloats, WritePixel, 5, 10)
+{
+    Image converted_image(image_size, image_size, PixelFormat::Rgba32);
+    for (unsigned y = 0; y < image_size; ++y)
+    {
+        for (unsigned x = 0; x < image_size; ++x)
+        {
+            Color color = image.read_pixel(x, y);
+            for (unsigned c = 0; c < 3; ++c)
+            {
+                color[c] = color[c] <= 0.04045 ? color[c] / 12.92 : std::pow((color[c] + 0.055) / 1.055, 2.4);
+            }
+            converted_image.write_pixel(x, y, color);
+        }
+    }
+    celero::DoNotOptimizeAway(converted_image.pixel_data()[0]);
+}
+
+BENCHMARK(ImageConvertToLinearFloats, Convert, 5, 10)
+{
+    Image converted_image = image;
+    converted_image.convert(PixelFormat::Rgba32, ColorSpace::Linear);
+    celero::DoNotOptimizeAway(converted_image.pixel_data()[0]);
+}
+
+BASELINE(ImageConvertRgbaToRgb, WritePixel, 5, 10)
+{
+    Image converted_image(image_size, image_size, PixelFormat::Rgb8);
+    for (unsigned y = 0; y < image_size; ++y)
+    {
+        for (unsigned x = 0; x < image_size; ++x)
+        {
+            converted_image.write_pixel(x, y, image.read_pixel(x, y));
+        }
+    }
+    celero::DoNotOptimizeAway(converted_image.pixel_data()[0]);
+}
+
+BENCHMARK(ImageConvertRgbaToRgb, Convert, 5, 10)
+{
+    Image converted_image = image;
+    converted_image.convert(PixelFormat::Rgb8, ColorSpace::NonLinear);
+    celero::DoNotOptimizeAway(converted_image.pixel_data()[0]);
+}
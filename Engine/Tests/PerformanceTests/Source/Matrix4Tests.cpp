@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect.h>
+using namespace hect;
+
+#include <celero/Celero.h>
+
+namespace
+{
+
+const FloatMatrix4 float_a = FloatMatrix4::from_rotation(FloatQuaternion::from_axis_angle(FloatVector3::UnitY, Degrees(30)));
+const FloatMatrix4 float_b = FloatMatrix4::from_translation(FloatVector3(1.0f, 2.0f, 3.0f));
+const Matrix4 double_a = Matrix4::from_rotation(Quaternion::from_axis_angle(Vector3::UnitY, Degrees(30)));
+const Matrix4 double_b = Matrix4::from_translation(Vector3(1.0, 2.0, 3.0));
+
+const size_t point_count = 1024;
+std::vector<FloatVector3> float_points(point_count, FloatVector3(1.0f, 2.0f, 3.0f));
+
+}
+
+BASELINE(FloatMatrix4Multiply, Scalar, 10, 100000)
+{
+    FloatMatrix4 result;
+    simd::multiply_matrix4<float>(&float_a[0], &float_b[0], &result[0]);
+    celero::DoNotOptimizeAway(result[0]);
+}
+
+BENCHMARK(FloatMatrix4Multiply, Simd, 10, 100000)
+{
+    FloatMatrix4 result = float_a * float_b;
+    celero::DoNotOptimizeAway(result[0]);
+}
+
+BASELINE(Matrix4Multiply, Scalar, 10, 100000)
+{
+    Matrix4 result;
+    simd::multiply_matrix4<double>(&double_a[0], &double_b[0], &result[0]);
+    celero::DoNotOptimizeAway(result[0]);
+}
+
+BENCHMARK(Matrix4Multiply, Simd, 10, 100000)
+{
+    Matrix4 result = double_a * double_b;
+    celero::DoNotOptimizeAway(result[0]);
+}
+
+BASELINE(FloatMatrix4TransformPoints, Scalar, 10, 1000)
+{
+    simd::transform_points<float>(&float_a[0], float_points.data(), float_points.data(), point_count);
+    celero::DoNotOptimizeAway(float_points[0].x);
+}
+
+BENCHMARK(FloatMatrix4TransformPoints, Simd, 10, 1000)
+{
+    float_a.transform_points(float_points.data(), float_points.data(), point_count);
+    celero::DoNotOptimizeAway(float_points[0].x);
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect.h>
+using namespace hect;
+
+#include <celero/Celero.h>
+
+namespace
+{
+
+Mesh create_mesh()
+{
+    Mesh mesh("Benchmark");
+    mesh.set_index_type(IndexType::UInt32);
+
+    MeshWriter mesh_writer(mesh);
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        mesh_writer.add_vertex();
+        mesh_writer.write_attribute_data(VertexAttributeSemantic::Position, Vector3(i, i + 1.0, i + 2.0));
+        mesh_writer.write_attribute_data(VertexAttributeSemantic::Normal, Vector3::UnitY);
+        mesh_writer.add_index(i);
+    }
+
+    return mesh;
+}
+
+const Mesh mesh = create_mesh();
+std::vector<Vector3> positions;
+std::vector<uint32_t> indices;
+
+}
+
+BASELINE(MeshReadPositions, MeshReader, 5, 20)
+{
+    positions.clear();
+    MeshReader mesh_reader(mesh);
+    while (mesh_reader.next_vertex())
+    {
+        positions.push_back(mesh_reader.read_attribute_vector3(VertexAttributeSemantic::Position));
+    }
+    celero::DoNotOptimizeAway(positions[0].x);
+}
+
+BENCHMARK(MeshReadPositions, AttributeView, 5, 20)
+{
+    mesh.copy_attribute_data(VertexAttributeSemantic::Position, positions);
+    celero::DoNotOptimizeAway(positions[0].x);
+}
+
+BASELINE(MeshReadIndices, MeshReader, 5, 20)
+{
+    indices.clear();
+    MeshReader mesh_reader(mesh);
+    while (mesh_reader.next_index())
+    {
+        indices.push_back(mesh_reader.read_index_uint32());
+    }
+    celero::DoNotOptimizeAway(indices[0]);
+}
+
+BENCHMARK(MeshReadIndices, IndexView, 5, 20)
+{
+    mesh.copy_index_data(indices);
+    celero::DoNotOptimizeAway(indices[0]);
+}
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect.h>
+using namespace hect;
+
+#include <celero/Celero.h>
+
+namespace
+{
+
+const size_t matrix_count = 1024;
+
+std::vector<Matrix4> create_double_matrices()
+{
+    std::vector<Matrix4> matrices;
+    for (size_t i = 0; i < matrix_count; ++i)
+    {
+        Matrix4 matrix = Matrix4::from_translation(Vector3(static_cast<double>(i), 2.0, 3.0));
+        matrix *= Matrix4::from_rotation(Quaternion::from_axis_angle(Vector3::UnitY, Degrees(static_cast<double>(i))));
+        matrices.push_back(matrix);
+    }
+    return matrices;
+}
+
+std::vector<FloatMatrix4> create_float_matrices(const std::vector<Matrix4>& double_matrices)
+{
+    std::vector<FloatMatrix4> matrices;
+    for (const Matrix4& matrix : double_matrices)
+    {
+        matrices.push_back(static_cast<FloatMatrix4>(matrix));
+    }
+    return matrices;
+}
+
+Shader create_shader()
+{
+    Shader shader("Benchmark");
+    shader.add_uniform(Uniform("model", UniformType::Matrix4));
+    return shader;
+}
+
+const std::vector<Matrix4> double_matrices = create_double_matrices();
+const std::vector<FloatMatrix4> float_matrices = create_float_matrices(double_matrices);
+std::vector<FloatMatrix4> converted_matrices(matrix_count);
+
+Shader shader = create_shader();
+const Uniform& model = shader.uniform(Name("model"));
+Mesh mesh("Benchmark");
+
+RenderCommandBuffer commands;
+
+}
+
+BASELINE(RecordModelMatrices, DoublePrecision, 5, 100)
+{
+    commands.clear();
+    for (const Matrix4& matrix : double_matrices)
+    {
+        commands.set_uniform(model, matrix);
+        commands.render_mesh(mesh);
+    }
+    celero::DoNotOptimizeAway(commands.command_count());
+}
+
+BENCHMARK(RecordModelMatrices, SinglePrecision, 5, 100)
+{
+    commands.clear();
+    for (const FloatMatrix4& matrix : float_matrices)
+    {
+        commands.set_uniform(model, matrix);
+        commands.render_mesh(mesh);
+    }
+    celero::DoNotOptimizeAway(commands.command_count());
+}
+
+BASELINE(RecordInstanceMatrices, DoublePrecision, 5, 100)
+{
+    commands.clear();
+    for (size_t i = 0; i < matrix_count; ++i)
+    {
+        converted_matrices[i] = static_cast<FloatMatrix4>(double_matrices[i]);
+    }
+    commands.render_mesh_instanced(mesh, converted_matrices.data(), matrix_count);
+    celero::DoNotOptimizeAway(commands.command_count());
+}
+
+BENCHMARK(RecordInstanceMatrices, SinglePrecision, 5, 100)
+{
+    commands.clear();
+    commands.render_mesh_instanced(mesh, float_matrices.data(), matrix_count);
+    celero::DoNotOptimizeAway(commands.command_count());
+}
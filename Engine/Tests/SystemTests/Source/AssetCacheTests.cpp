@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+
+#include <Hect.h>
+using namespace hect;
+
+#include <catch.hpp>
+
+namespace
+{
+
+void write_file(FileSystem& file_system, const Path& path, const ByteVector& data)
+{
+    auto stream = file_system.open_file_for_write(path);
+    stream->write(data.data(), data.size());
+}
+
+}
+
+TEST_CASE("Load a cooked asset through a manifest", "[AssetCache]")
+{
+    Engine& engine = Engine::instance();
+    FileSystem& file_system = engine.file_system();
+
+    Path base_directory = file_system.base_directory();
+    file_system.mount_archive(base_directory);
+    file_system.set_write_directory(base_directory);
+
+    // Cook a built-in mesh
+    const Path source_path("Hect/Rendering/SkyBox.mesh.yaml");
+    Mesh& source_mesh = engine.asset_cache().get<Mesh>(source_path);
+
+    file_system.create_directory("Cooked");
+    {
+        ByteVector data;
+        {
+            BinaryEncoder encoder(data);
+            encoder << encode_value(source_mesh);
+        }
+        write_file(file_system, "Cooked/SkyBox.mesh", data);
+    }
+
+    AssetManifest manifest;
+    {
+        AssetManifest::Entry entry;
+        entry.path = source_path;
+        entry.cooked_path = "SkyBox.mesh";
+        manifest.add_entry(entry);
+
+        ByteVector data;
+        {
+            BinaryEncoder encoder(data);
+            encoder << encode_value(manifest);
+        }
+        write_file(file_system, "Cooked/Assets.manifest", data);
+    }
+
+    {
+        AssetCache asset_cache(file_system, false);
+        REQUIRE(asset_cache.resolve_path("Hect/Rendering/SkyBox.mesh") == source_path);
+
+        asset_cache.load_manifest("Cooked/Assets.manifest");
+        REQUIRE(asset_cache.resolve_path("Hect/Rendering/SkyBox.mesh") == Path("Cooked/SkyBox.mesh"));
+        REQUIRE(asset_cache.resolve_path(source_path) == Path("Cooked/SkyBox.mesh"));
+
+        Mesh& mesh = asset_cache.get<Mesh>("Hect/Rendering/SkyBox.mesh");
+        REQUIRE(mesh == source_mesh);
+
+        std::vector<Path> decoded_paths = asset_cache.decoded_paths();
+        REQUIRE(std::find(decoded_paths.begin(), decoded_paths.end(), Path("Cooked/SkyBox.mesh")) != decoded_paths.end());
+    }
+
+    file_system.remove("Cooked/Assets.manifest");
+    file_system.remove("Cooked/SkyBox.mesh");
+    file_system.remove("Cooked");
+}
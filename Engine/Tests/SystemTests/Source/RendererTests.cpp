@@ -226,3 +226,627 @@ TEST_CASE("Attach a 3-dimensional texture to a frame buffer", "[Renderer]")
 
     Renderer::Frame frame = renderer.begin_frame(frame_buffer);
 }
+
+TEST_CASE("Redundant state changes within a frame are dropped", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    Shader shader("Test");
+    const UniformIndex color_index = shader.add_uniform(Uniform("color", UniformValue(Color(1.0, 0.0, 0.0))));
+    const Uniform& color = shader.uniform(color_index);
+
+    Mesh mesh = create_test_mesh();
+    FrameBuffer frame_buffer(32, 32);
+
+    Renderer::Statistics& statistics = renderer.statistics();
+    statistics.reset_counters();
+
+    {
+        Renderer::Frame frame = renderer.begin_frame(frame_buffer);
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            frame.set_shader(shader);
+            frame.set_uniform(color, Color(0.0, 1.0, 0.0));
+            frame.set_cull_mode(CullMode::CounterClockwise);
+            frame.render_mesh(mesh);
+        }
+    }
+
+    REQUIRE(statistics.render_calls == 4);
+    REQUIRE(statistics.shader_changes == 1);
+    REQUIRE(statistics.redundant_shader_changes == 3);
+    REQUIRE(statistics.mesh_binds == 1);
+    REQUIRE(statistics.redundant_mesh_binds == 3);
+
+    // The default value is re-applied by each shader change and then
+    // overridden, so every value after the first two differs from the last
+    REQUIRE(statistics.uniform_changes == 8);
+
+    // Blend mode, depth testing, cull mode, and point sprites
+    REQUIRE(statistics.state_changes == 4);
+    REQUIRE(statistics.redundant_state_changes == 12);
+
+    // A new frame starts with unknown state
+    statistics.reset_counters();
+    {
+        Renderer::Frame frame = renderer.begin_frame(frame_buffer);
+        frame.set_shader(shader);
+        frame.set_shader(shader);
+        frame.render_mesh(mesh);
+    }
+
+    REQUIRE(statistics.shader_changes == 1);
+    REQUIRE(statistics.redundant_shader_changes == 1);
+    REQUIRE(statistics.uniform_changes == 1);
+    REQUIRE(statistics.redundant_uniform_changes == 1);
+    REQUIRE(statistics.mesh_binds == 1);
+}
+
+TEST_CASE("Record command buffers in parallel and submit them in order", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+    TaskPool& task_pool = engine.task_pool();
+
+    Shader shader("Test");
+    const UniformIndex scale_index = shader.add_uniform(Uniform("scale", UniformValue(-1.0)));
+    const Uniform& scale = shader.uniform(scale_index);
+
+    Mesh mesh = create_test_mesh();
+    FrameBuffer frame_buffer(32, 32);
+
+    const size_t buffer_count = 4;
+    const size_t calls_per_buffer = 16;
+
+    std::vector<RenderCommandBuffer> command_buffers(buffer_count);
+    std::vector<Task::Handle> tasks;
+    for (size_t i = 0; i < buffer_count; ++i)
+    {
+        RenderCommandBuffer& command_buffer = command_buffers[i];
+        tasks.push_back(task_pool.enqueue([&, i]
+        {
+            command_buffer.set_shader(shader);
+            for (size_t j = 0; j < calls_per_buffer; ++j)
+            {
+                command_buffer.set_uniform(scale, static_cast<double>(i * calls_per_buffer + j));
+                command_buffer.render_mesh(mesh);
+            }
+        }));
+    }
+
+    for (Task::Handle& task : tasks)
+    {
+        task->wait();
+    }
+
+    Renderer::Statistics& statistics = renderer.statistics();
+    statistics.reset_counters();
+
+    {
+        Renderer::Frame frame = renderer.begin_frame(frame_buffer);
+        for (RenderCommandBuffer& command_buffer : command_buffers)
+        {
+            REQUIRE(command_buffer.command_count() == 1 + calls_per_buffer * 2);
+            frame.submit(command_buffer);
+        }
+    }
+
+    REQUIRE(statistics.submitted_commands == buffer_count * (1 + calls_per_buffer * 2));
+    REQUIRE(statistics.render_calls == buffer_count * calls_per_buffer);
+    REQUIRE(statistics.shader_changes == 1);
+    REQUIRE(statistics.redundant_shader_changes == buffer_count - 1);
+
+    // The default value is re-applied at the start of each buffer
+    REQUIRE(statistics.uniform_changes == buffer_count * (calls_per_buffer + 1));
+    REQUIRE(statistics.mesh_binds == 1);
+}
+
+TEST_CASE("Record a uniform value of the wrong type into a command buffer", "[Renderer]")
+{
+    Shader shader("Test");
+    const UniformIndex scale_index = shader.add_uniform(Uniform("scale", UniformType::Float));
+
+    RenderCommandBuffer command_buffer;
+    REQUIRE_THROWS_AS(command_buffer.set_uniform(shader.uniform(scale_index), Vector3::UnitX), InvalidOperation);
+    REQUIRE(command_buffer.command_count() == 0);
+}
+
+TEST_CASE("Render calls sharing a mesh and an instanced material are batched", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    DefaultScene scene(engine);
+
+    Shader shader("Test");
+    shader.set_render_stage(RenderStage::PhysicalGeometry);
+    shader.set_instanced(true);
+
+    Material material("Test");
+    material.set_shader(shader.create_handle());
+
+    Mesh mesh = create_test_mesh();
+
+    Entity& camera = scene.create_entity();
+    camera.add_component<TransformComponent>();
+    camera.add_component<CameraComponent>();
+    camera.activate();
+
+    const size_t instance_count = 16;
+    for (size_t i = 0; i < instance_count; ++i)
+    {
+        Entity& entity = scene.create_entity();
+
+        auto& transform = entity.add_component<TransformComponent>();
+        transform.local_position = Vector3(static_cast<double>(i), 0.0, 0.0);
+
+        auto& geometry = entity.add_component<GeometryComponent>();
+        geometry.add_surface(mesh.create_handle(), material.create_handle());
+
+        entity.activate();
+    }
+
+    scene.tick(Seconds(0.0));
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Statistics& statistics = renderer.statistics();
+
+    statistics.reset_counters();
+    scene.render(frame_buffer);
+
+    const size_t instanced_render_calls = statistics.render_calls;
+    REQUIRE(statistics.rendered_instances == instance_count);
+
+    // Without instancing each call is rendered individually
+    shader.set_instanced(false);
+
+    statistics.reset_counters();
+    scene.render(frame_buffer);
+
+    REQUIRE(statistics.rendered_instances == 0);
+    REQUIRE(statistics.render_calls == instanced_render_calls + instance_count - 1);
+}
+
+TEST_CASE("A lone render call with an instanced material is rendered instanced", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    DefaultScene scene(engine);
+
+    Shader shader("Test");
+    shader.set_render_stage(RenderStage::PhysicalGeometry);
+    shader.set_instanced(true);
+
+    Material material("Test");
+    material.set_shader(shader.create_handle());
+
+    Mesh mesh = create_test_mesh();
+
+    Entity& camera = scene.create_entity();
+    camera.add_component<TransformComponent>();
+    camera.add_component<CameraComponent>();
+    camera.activate();
+
+    Entity& entity = scene.create_entity();
+    entity.add_component<TransformComponent>();
+    auto& geometry = entity.add_component<GeometryComponent>();
+    geometry.add_surface(mesh.create_handle(), material.create_handle());
+    entity.activate();
+
+    scene.tick(Seconds(0.0));
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Statistics& statistics = renderer.statistics();
+
+    statistics.reset_counters();
+    scene.render(frame_buffer);
+
+    REQUIRE(statistics.rendered_instances == 1);
+}
+
+TEST_CASE("Render calls with the default material are batched", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    DefaultScene scene(engine);
+
+    AssetHandle<Material> material = engine.asset_cache().get_handle<Material>("Hect/Materials/Default.material");
+    REQUIRE(material->shader()->is_instanced());
+
+    // The camera matrices are read from the per-frame block
+    const std::vector<UniformBlockLayout>& layouts = material->shader()->uniform_blocks();
+    REQUIRE(layouts.size() == 1);
+    REQUIRE(layouts[0].name() == "Camera");
+    REQUIRE(layouts[0].is_bound());
+
+    Mesh mesh = create_test_mesh();
+
+    Entity& camera = scene.create_entity();
+    camera.add_component<TransformComponent>();
+    camera.add_component<CameraComponent>();
+    camera.activate();
+
+    const size_t instance_count = 4;
+    for (size_t i = 0; i < instance_count; ++i)
+    {
+        Entity& entity = scene.create_entity();
+
+        auto& transform = entity.add_component<TransformComponent>();
+        transform.local_position = Vector3(static_cast<double>(i), 0.0, 0.0);
+
+        auto& geometry = entity.add_component<GeometryComponent>();
+        geometry.add_surface(mesh.create_handle(), material);
+
+        entity.activate();
+    }
+
+    scene.tick(Seconds(0.0));
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Statistics& statistics = renderer.statistics();
+
+    statistics.reset_counters();
+    scene.render(frame_buffer);
+
+    REQUIRE(statistics.rendered_instances == instance_count);
+}
+
+TEST_CASE("Render calls are built for all visible geometry across tasks", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    DefaultScene scene(engine);
+
+    Shader shader("Test");
+    shader.set_render_stage(RenderStage::PhysicalGeometry);
+
+    Material material("Test");
+    material.set_shader(shader.create_handle());
+
+    Mesh mesh = create_test_mesh();
+
+    Entity& camera = scene.create_entity();
+    camera.add_component<TransformComponent>();
+    camera.add_component<CameraComponent>();
+    camera.activate();
+
+    scene.tick(Seconds(0.0));
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Statistics& statistics = renderer.statistics();
+
+    // The render calls of the lighting, composite, and expose passes
+    statistics.reset_counters();
+    scene.render(frame_buffer);
+    const size_t base_render_calls = statistics.render_calls;
+
+    // Enough geometry to be split between multiple tasks, with every
+    // other entity hidden
+    const size_t entity_count = 500;
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        Entity& entity = scene.create_entity();
+        entity.add_component<TransformComponent>();
+
+        auto& geometry = entity.add_component<GeometryComponent>();
+        geometry.add_surface(mesh.create_handle(), material.create_handle());
+        geometry.visible = i % 2 == 0;
+
+        entity.activate();
+    }
+
+    scene.tick(Seconds(0.0));
+
+    // Each frame builds the same render calls
+    for (unsigned frame = 0; frame < 2; ++frame)
+    {
+        statistics.reset_counters();
+        scene.render(frame_buffer);
+        REQUIRE(statistics.render_calls == base_render_calls + entity_count / 2);
+    }
+}
+
+TEST_CASE("Children of an entity outside of the frustum are culled without being tested", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    DefaultScene scene(engine);
+
+    Shader shader("Test");
+    shader.set_render_stage(RenderStage::PhysicalGeometry);
+
+    Material material("Test");
+    material.set_shader(shader.create_handle());
+
+    Mesh mesh = create_test_mesh();
+
+    Entity& camera = scene.create_entity();
+    camera.add_component<TransformComponent>();
+    camera.add_component<CameraComponent>();
+    camera.activate();
+
+    scene.tick(Seconds(0.0));
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Statistics& statistics = renderer.statistics();
+
+    statistics.reset_counters();
+    scene.render(frame_buffer);
+    const size_t base_render_calls = statistics.render_calls;
+
+    // A parent far past the far clip plane whose children have no bounding
+    // boxes of their own
+    Entity& parent = scene.create_entity();
+    auto& parent_transform = parent.add_component<TransformComponent>();
+    parent_transform.local_position = Vector3(0.0, 0.0, 1.0e9);
+    auto& bounding_box = parent.add_component<BoundingBoxComponent>();
+    bounding_box.adaptive = false;
+    bounding_box.local_extents = AxisAlignedBox(-Vector3::One, Vector3::One);
+
+    const size_t child_count = 4;
+    for (size_t i = 0; i < child_count; ++i)
+    {
+        Entity& child = scene.create_entity();
+        child.add_component<TransformComponent>();
+
+        auto& geometry = child.add_component<GeometryComponent>();
+        geometry.add_surface(mesh.create_handle(), material.create_handle());
+
+        parent.add_child(child);
+    }
+
+    parent.activate();
+    scene.tick(Seconds(0.0));
+
+    for (unsigned frame = 0; frame < 2; ++frame)
+    {
+        statistics.reset_counters();
+        scene.render(frame_buffer);
+        REQUIRE(statistics.render_calls == base_render_calls);
+    }
+}
+
+TEST_CASE("The level of detail of a destroyed camera is not inherited by a new camera", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+
+    DefaultScene scene(engine);
+
+    Shader shader("Test");
+    shader.set_render_stage(RenderStage::PhysicalGeometry);
+
+    Material material("Test");
+    material.set_shader(shader.create_handle());
+
+    Mesh mesh = create_test_mesh();
+
+    Entity& entity = scene.create_entity();
+    entity.add_component<TransformComponent>();
+    auto& geometry = entity.add_component<GeometryComponent>();
+    geometry.add_surface(mesh.create_handle(), material.create_handle());
+    entity.activate();
+
+    Entity& first_camera = scene.create_entity();
+    first_camera.add_component<TransformComponent>();
+    first_camera.add_component<CameraComponent>();
+    first_camera.activate();
+    const EntityHandle first_camera_handle = first_camera.handle();
+
+    scene.tick(Seconds(0.0));
+
+    FrameBuffer frame_buffer(32, 32);
+    scene.render(frame_buffer);
+
+    GeometrySurface& surface = geometry.surfaces[0];
+    REQUIRE(surface.levels_of_detail.size() == 1);
+    REQUIRE(surface.levels_of_detail[0].camera == first_camera_handle);
+
+    first_camera.destroy();
+    scene.tick(Seconds(0.0));
+
+    // The new camera may re-use the id of the destroyed camera
+    Entity& second_camera = scene.create_entity();
+    second_camera.add_component<TransformComponent>();
+    auto& camera = second_camera.add_component<CameraComponent>();
+    second_camera.activate();
+    scene.camera_system().set_active_camera(camera);
+
+    scene.tick(Seconds(0.0));
+    scene.render(frame_buffer);
+
+    REQUIRE(surface.levels_of_detail.size() == 1);
+    REQUIRE(surface.levels_of_detail[0].camera == second_camera.handle());
+    REQUIRE(surface.levels_of_detail[0].camera != first_camera_handle);
+}
+
+TEST_CASE("Uniform blocks are only uploaded and bound when changed", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    Shader shader("Test");
+    Uniform color("color", UniformType::Color);
+    color.set_block("Material");
+    shader.add_uniform(color);
+
+    const UniformBlockLayout& layout = shader.uniform_blocks()[0];
+    UniformBlock block(layout);
+    block.set_value(shader.uniform("color"), Color(1.0, 0.0, 0.0));
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Statistics& statistics = renderer.statistics();
+
+    statistics.reset_counters();
+    {
+        Renderer::Frame frame = renderer.begin_frame(frame_buffer);
+        frame.set_uniform_block(layout, block);
+        frame.set_uniform_block(layout, block);
+    }
+
+    REQUIRE(statistics.uniform_block_uploads == 1);
+    REQUIRE(statistics.uniform_block_binds == 1);
+    REQUIRE(statistics.redundant_uniform_block_binds == 1);
+
+    // Writing the same value does not modify the block
+    block.set_value(shader.uniform("color"), Color(1.0, 0.0, 0.0));
+    REQUIRE(!block.is_modified());
+
+    block.set_value(shader.uniform("color"), Color(0.0, 1.0, 0.0));
+    REQUIRE(block.is_modified());
+
+    statistics.reset_counters();
+    {
+        Renderer::Frame frame = renderer.begin_frame(frame_buffer);
+        frame.set_uniform_block(layout, block);
+    }
+
+    REQUIRE(statistics.uniform_block_uploads == 1);
+    REQUIRE(statistics.uniform_block_binds == 1);
+    REQUIRE(!block.is_modified());
+}
+
+TEST_CASE("Bind a uniform block which does not match its layout", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    Shader shader("Test");
+    Uniform color("color", UniformType::Color);
+    color.set_block("Material");
+    shader.add_uniform(color);
+
+    UniformBlock block;
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Frame frame = renderer.begin_frame(frame_buffer);
+    REQUIRE_THROWS_AS(frame.set_uniform_block(shader.uniform_blocks()[0], block), InvalidOperation);
+}
+
+TEST_CASE("Uniform blocks of a material and of the frame are uploaded once per change", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    DefaultScene scene(engine);
+
+    Shader shader("Test");
+    shader.set_render_stage(RenderStage::PhysicalGeometry);
+
+    Uniform view_projection("view_projection", UniformBinding::ViewProjectionMatrix);
+    view_projection.set_block("Frame");
+    shader.add_uniform(view_projection);
+
+    Uniform color("color", UniformValue(Color(1.0, 1.0, 1.0)));
+    color.set_block("Material");
+    shader.add_uniform(color);
+
+    Material material("Test");
+    material.set_shader(shader.create_handle());
+    material.set_uniform_value("color", Color(1.0, 0.0, 0.0));
+
+    Mesh mesh = create_test_mesh();
+
+    Entity& camera = scene.create_entity();
+    camera.add_component<TransformComponent>();
+    camera.add_component<CameraComponent>();
+    camera.activate();
+
+    const size_t entity_count = 8;
+    for (size_t i = 0; i < entity_count; ++i)
+    {
+        Entity& entity = scene.create_entity();
+        entity.add_component<TransformComponent>();
+
+        auto& geometry = entity.add_component<GeometryComponent>();
+        geometry.add_surface(mesh.create_handle(), material.create_handle());
+
+        entity.activate();
+    }
+
+    scene.tick(Seconds(0.0));
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Statistics& statistics = renderer.statistics();
+
+    // Both blocks are uploaded on the first frame and bound once each
+    statistics.reset_counters();
+    scene.render(frame_buffer);
+    REQUIRE(statistics.uniform_block_uploads == 2);
+    REQUIRE(statistics.uniform_block_binds == 2);
+    REQUIRE(statistics.redundant_uniform_block_binds == 2 * (entity_count - 1));
+
+    // Nothing changed so nothing is uploaded
+    statistics.reset_counters();
+    scene.render(frame_buffer);
+    REQUIRE(statistics.uniform_block_uploads == 0);
+
+    // Only the material block changed
+    material.set_uniform_value("color", Color(0.0, 1.0, 0.0));
+    statistics.reset_counters();
+    scene.render(frame_buffer);
+    REQUIRE(statistics.uniform_block_uploads == 1);
+}
+
+TEST_CASE("Uniform values are compared in the precision they are submitted in", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    Shader shader("Test");
+    const UniformIndex model_index = shader.add_uniform(Uniform("model", UniformBinding::ModelMatrix));
+    const Uniform& model = shader.uniform(model_index);
+
+    const Matrix4 matrix = Matrix4::from_translation(Vector3(1.0, 2.0, 3.0));
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Statistics& statistics = renderer.statistics();
+
+    statistics.reset_counters();
+    {
+        RenderCommandBuffer commands;
+        commands.set_shader(shader);
+        commands.set_uniform(model, matrix);
+
+        Renderer::Frame frame = renderer.begin_frame(frame_buffer);
+        frame.submit(commands);
+
+        // The same matrix in single precision is redundant
+        frame.set_uniform(model, static_cast<FloatMatrix4>(matrix));
+
+        // A difference lost in the conversion to single precision is
+        // redundant as well
+        frame.set_uniform(model, Matrix4::from_translation(Vector3(1.0 + 1e-12, 2.0, 3.0)));
+    }
+
+    REQUIRE(statistics.uniform_changes == 1);
+    REQUIRE(statistics.redundant_uniform_changes == 2);
+}
+
+TEST_CASE("The first value of a uniform in a frame is submitted even if it is zero", "[Renderer]")
+{
+    Engine& engine = Engine::instance();
+    Renderer& renderer = engine.renderer();
+
+    Shader shader("Test");
+    const UniformIndex exposure_index = shader.add_uniform(Uniform("exposure", UniformValue(0.0)));
+    const Uniform& exposure = shader.uniform(exposure_index);
+
+    FrameBuffer frame_buffer(32, 32);
+    Renderer::Statistics& statistics = renderer.statistics();
+
+    statistics.reset_counters();
+    {
+        // Setting the shader submits the default value of the uniform
+        Renderer::Frame frame = renderer.begin_frame(frame_buffer);
+        frame.set_shader(shader);
+        frame.set_uniform(exposure, 0.0f);
+    }
+
+    REQUIRE(statistics.uniform_changes == 1);
+    REQUIRE(statistics.redundant_uniform_changes == 1);
+}
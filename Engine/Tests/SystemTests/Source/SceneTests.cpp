@@ -880,6 +880,41 @@ TEST_CASE("Check that an entity has a component of a specific type", "[Scene]")
     REQUIRE(a->has_component<TestComponentA>() == true);
 }
 
+TEST_CASE("Check that an entity has components of multiple specific types", "[Scene]")
+{
+    TestScene scene(Engine::instance());
+
+    EntityIterator a = scene.create_entity().iterator();
+    a->add_component<TestComponentA>("TestA");
+
+    REQUIRE(a->has_components<TestComponentA>() == true);
+    REQUIRE((a->has_components<TestComponentA, TestComponentB>()) == false);
+
+    a->add_component<TestComponentB>("TestB");
+
+    REQUIRE((a->has_components<TestComponentA, TestComponentB>()) == true);
+    REQUIRE(a->has_components(ComponentRegistry::signature_of<TestComponentB>()) == true);
+}
+
+TEST_CASE("Component signature of an entity reflects added and removed components", "[Scene]")
+{
+    TestScene scene(Engine::instance());
+
+    EntityIterator a = scene.create_entity().iterator();
+    REQUIRE(a->component_signature().none());
+
+    a->add_component<TestComponentA>("TestA");
+    a->add_component<TestComponentB>("TestB");
+    REQUIRE(a->component_signature() == (ComponentRegistry::signature_of<TestComponentA, TestComponentB>()));
+
+    a->remove_component<TestComponentA>();
+    REQUIRE(a->component_signature() == ComponentRegistry::signature_of<TestComponentB>());
+
+    Entity& b = a->clone();
+    REQUIRE(b.component_signature() == ComponentRegistry::signature_of<TestComponentB>());
+    REQUIRE(b.component<TestComponentB>().value == "TestB");
+}
+
 TEST_CASE("Iterate over the components in a scene without any components", "[Scene]")
 {
     TestScene scene(Engine::instance());
@@ -1785,6 +1820,28 @@ TEST_CASE("Copy an entity handle", "[Scene]")
     REQUIRE_THROWS_AS(*handle_copy, InvalidOperation);
 }
 
+TEST_CASE("Entity handle to a destroyed entity is invalid after its id is reused", "[Scene]")
+{
+    TestScene scene(Engine::instance());
+
+    EntityHandle a = scene.create_entity("A").handle();
+    const EntityId id = a.id();
+
+    a->destroy();
+    scene.refresh();
+    REQUIRE(!a);
+
+    Entity& b = scene.create_entity("B");
+    REQUIRE(b.id() == id);
+
+    EntityHandle b_handle = b.handle();
+    REQUIRE(b_handle);
+    REQUIRE(!a);
+    REQUIRE(a != b_handle);
+    REQUIRE(a.generation() != b_handle.generation());
+    REQUIRE_THROWS_AS(*a, InvalidOperation);
+}
+
 TEST_CASE("Encode and decode a simple scene", "[Scene]")
 {
     test_encode_decode([](TestScene& scene)
@@ -1879,6 +1936,41 @@ TEST_CASE("Entity handle is invalidated when entity is destroyed", "[Scene]")
     REQUIRE(!entity);
 }
 
+TEST_CASE("Entity handle is invalidated when its scene is destroyed", "[Scene]")
+{
+    EntityHandle entity;
+
+    {
+        TestScene scene(Engine::instance());
+
+        entity = scene.create_entity().handle();
+        entity->activate();
+        scene.refresh();
+        REQUIRE(entity);
+    }
+
+    REQUIRE(!entity);
+    REQUIRE_THROWS_AS(*entity, InvalidOperation);
+}
+
+TEST_CASE("Entity handle to a destroyed scene does not refer to an entity in a later scene", "[Scene]")
+{
+    EntityHandle entity;
+
+    {
+        TestScene scene(Engine::instance());
+        entity = scene.create_entity().handle();
+    }
+
+    // The later scene may re-use the registry slot of the destroyed scene
+    TestScene scene(Engine::instance());
+    EntityHandle other_entity = scene.create_entity().handle();
+    REQUIRE(other_entity.id() == entity.id());
+    REQUIRE(other_entity.generation() == entity.generation());
+    REQUIRE(other_entity != entity);
+    REQUIRE(!entity);
+}
+
 TEST_CASE("Component handle is invalidated when entity is destroyed", "[Scene]")
 {
     TestScene scene(Engine::instance());
@@ -1900,3 +1992,193 @@ TEST_CASE("Component handle is invalidated when entity is destroyed", "[Scene]")
     scene.refresh();
     REQUIRE(!component);
 }
+
+void test_prefab_instantiation(std::function<void(Entity& entity, Prefab& prefab)> encode_decode)
+{
+    TestScene scene(Engine::instance());
+
+    Entity& source = scene.create_entity("Source");
+    source.add_component<TestComponentA>("A");
+    Entity& source_child = scene.create_entity("Child");
+    source_child.add_component<TestComponentB>("B");
+    source.add_child(source_child);
+
+    Prefab prefab;
+    encode_decode(source, prefab);
+    REQUIRE(prefab.entity_count() == 2);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        Entity& entity = prefab.instantiate(scene);
+        REQUIRE(entity.name() == "Source");
+        REQUIRE(entity.component<TestComponentA>().value == "A");
+        REQUIRE(!entity.has_component<TestComponentB>());
+
+        EntityHandle child = entity.find_first_child([](const Entity&) { return true; });
+        REQUIRE(child);
+        REQUIRE(child->name() == "Child");
+        REQUIRE(child->component<TestComponentB>().value == "B");
+
+        entity.activate();
+    }
+
+    scene.refresh();
+    REQUIRE(scene.entity_count() == 6);
+}
+
+TEST_CASE("Instantiate a prefab decoded from a data value", "[Scene]")
+{
+    test_prefab_instantiation([](Entity& entity, Prefab& prefab)
+    {
+        DataValueEncoder encoder;
+        encoder << encode_value(entity);
+
+        DataValueDecoder decoder(encoder.data_values()[0]);
+        decoder >> decode_value(prefab);
+    });
+}
+
+TEST_CASE("Instantiate a prefab decoded from a binary stream", "[Scene]")
+{
+    test_prefab_instantiation([](Entity& entity, Prefab& prefab)
+    {
+        std::vector<uint8_t> data;
+
+        {
+            MemoryWriteStream write_stream(data);
+            BinaryEncoder encoder(write_stream);
+            encoder << encode_value(entity);
+        }
+
+        MemoryReadStream read_stream(data);
+        BinaryDecoder decoder(read_stream);
+        decoder >> decode_value(prefab);
+    });
+}
+
+TEST_CASE("Encode a prefab and instantiate the decoded copy", "[Scene]")
+{
+    test_prefab_instantiation([](Entity& entity, Prefab& prefab)
+    {
+        Prefab intermediate;
+
+        {
+            DataValueEncoder encoder;
+            encoder << encode_value(entity);
+
+            DataValueDecoder decoder(encoder.data_values()[0]);
+            decoder >> decode_value(intermediate);
+        }
+
+        DataValueEncoder encoder;
+        encoder << encode_value(intermediate);
+
+        DataValueDecoder decoder(encoder.data_values()[0]);
+        decoder >> decode_value(prefab);
+    });
+}
+
+TEST_CASE("Play back command buffers recorded from worker tasks in creation order", "[Scene]")
+{
+    TestScene scene(Engine::instance());
+
+    const size_t buffer_count = 4;
+    const size_t entities_per_buffer = 32;
+
+    std::vector<Task::Handle> tasks;
+    for (size_t i = 0; i < buffer_count; ++i)
+    {
+        EntityCommandBuffer& command_buffer = scene.create_command_buffer();
+        tasks.push_back(Engine::instance().task_pool().enqueue([&command_buffer, i, entities_per_buffer]
+        {
+            for (size_t j = 0; j < entities_per_buffer; ++j)
+            {
+                std::string value = std::to_string(i * entities_per_buffer + j);
+                command_buffer.create_entity(Name(value), TestComponentA(value));
+            }
+        }));
+    }
+
+    for (Task::Handle& task : tasks)
+    {
+        task->wait();
+    }
+
+    REQUIRE(scene.entity_count() == 0);
+
+    scene.refresh();
+    REQUIRE(scene.entity_count() == buffer_count * entities_per_buffer);
+
+    size_t index = 0;
+    for (TestComponentA& a : scene.components<TestComponentA>())
+    {
+        REQUIRE(a.value == std::to_string(index));
+        REQUIRE(a.entity().name() == Name(a.value));
+        REQUIRE(a.entity().is_activated());
+        ++index;
+    }
+    REQUIRE(index == buffer_count * entities_per_buffer);
+}
+
+TEST_CASE("Play back component and destroy commands from a command buffer", "[Scene]")
+{
+    TestScene scene(Engine::instance());
+
+    EntityHandle a = scene.create_entity().handle();
+    a->add_component<TestComponentA>("A");
+    a->activate();
+
+    EntityHandle b = scene.create_entity().handle();
+    b->activate();
+    scene.refresh();
+
+    EntityCommandBuffer& command_buffer = scene.create_command_buffer();
+    command_buffer.remove_component<TestComponentA>(a);
+    command_buffer.add_component(a, TestComponentB("B"));
+    command_buffer.destroy_entity(b);
+    command_buffer.destroy_entity(b);
+    REQUIRE(command_buffer.command_count() == 4);
+
+    REQUIRE(a->has_component<TestComponentA>());
+    REQUIRE(b);
+
+    scene.refresh();
+    REQUIRE(!a->has_component<TestComponentA>());
+    REQUIRE(a->component<TestComponentB>().value == "B");
+    REQUIRE(!b);
+    REQUIRE(scene.entity_count() == 1);
+}
+
+TEST_CASE("Commands that already ran are not played back again after a command throws", "[Scene]")
+{
+    TestScene scene(Engine::instance());
+
+    EntityHandle a = scene.create_entity().handle();
+    a->add_component<TestComponentA>("A");
+    a->activate();
+    scene.refresh();
+
+    EntityCommandBuffer& first_command_buffer = scene.create_command_buffer();
+    first_command_buffer.create_entity(Name("B"), TestComponentB("B"));
+
+    EntityCommandBuffer& second_command_buffer = scene.create_command_buffer();
+    second_command_buffer.create_entity(Name("C"), TestComponentB("C"));
+    second_command_buffer.add_component(a, TestComponentA("Duplicate"));
+    second_command_buffer.create_entity(Name("D"), TestComponentB("D"));
+
+    EntityCommandBuffer& third_command_buffer = scene.create_command_buffer();
+    third_command_buffer.create_entity(Name("E"), TestComponentB("E"));
+
+    REQUIRE_THROWS_AS(scene.refresh(), InvalidOperation);
+    REQUIRE(first_command_buffer.command_count() == 0);
+    REQUIRE(second_command_buffer.command_count() == 0);
+    REQUIRE(third_command_buffer.command_count() == 0);
+    REQUIRE(a->component<TestComponentA>().value == "A");
+
+    scene.refresh();
+    REQUIRE(scene.entity_count() == 3);
+    REQUIRE(scene.entities().find_first_by_name("B"));
+    REQUIRE(scene.entities().find_first_by_name("C"));
+    REQUIRE(!scene.entities().find_first_by_name("D"));
+    REQUIRE(!scene.entities().find_first_by_name("E"));
+}
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect/IO/AssetManifest.h>
+#include <Hect/IO/BinaryDecoder.h>
+#include <Hect/IO/BinaryEncoder.h>
+using namespace hect;
+
+#include <catch.hpp>
+
+namespace
+{
+
+AssetManifest::Entry create_entry(const Path& path, uint64_t hash)
+{
+    AssetManifest::Entry entry;
+    entry.path = path;
+    entry.cooked_path = path.as_string() + ".cooked";
+    entry.hash = hash;
+    return entry;
+}
+
+}
+
+TEST_CASE("Add entries to an asset manifest", "[AssetManifest]")
+{
+    AssetManifest manifest;
+    manifest.add_entry(create_entry("Shaders/Opaque.shader.yaml", 1));
+    manifest.add_entry(create_entry("Materials/Opaque.material.yaml", 2));
+    manifest.add_entry(create_entry("Shaders/Opaque.shader.yaml", 3));
+
+    REQUIRE(manifest.entries().size() == 2);
+    REQUIRE(manifest.entries()[0].path == Path("Materials/Opaque.material.yaml"));
+    REQUIRE(manifest.has_entry("Shaders/Opaque.shader.yaml"));
+    REQUIRE(manifest.entry("Shaders/Opaque.shader.yaml").hash == 3);
+    REQUIRE(!manifest.has_entry("Shaders/Opaque.shader"));
+    REQUIRE_THROWS_AS(manifest.entry("Shaders/Opaque.shader"), InvalidOperation);
+}
+
+TEST_CASE("Encode and decode an asset manifest", "[AssetManifest]")
+{
+    AssetManifest manifest;
+    AssetManifest::Entry entry = create_entry("Materials/Opaque.material.yaml", 0xFEDCBA9876543210ull);
+    entry.dependencies.push_back("Shaders/Opaque.shader.yaml");
+    manifest.add_entry(entry);
+    manifest.add_entry(create_entry("Rendering/SkyBox.mesh.yaml", 7));
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(manifest);
+    }
+
+    AssetManifest decoded_manifest;
+    {
+        BinaryDecoder decoder(data);
+        decoder >> decode_value(decoded_manifest);
+    }
+
+    REQUIRE(decoded_manifest.entries().size() == 2);
+    const AssetManifest::Entry& decoded_entry = decoded_manifest.entry("Materials/Opaque.material.yaml");
+    REQUIRE(decoded_entry.cooked_path == entry.cooked_path);
+    REQUIRE(decoded_entry.hash == entry.hash);
+    REQUIRE(decoded_entry.dependencies.size() == 1);
+    REQUIRE(decoded_entry.dependencies[0] == Path("Shaders/Opaque.shader.yaml"));
+}
@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect/Math/AxisAlignedBox.h>
+#include <Hect/Math/Matrix4.h>
+#include <Hect/Units/Angle.h>
+using namespace hect;
+
+#include <catch.hpp>
+
+// Transforms each of the corners of a box and returns the box enclosing them
+AxisAlignedBox transform_corners(const AxisAlignedBox& box, const Matrix4& matrix)
+{
+    const Vector3 minimum = box.minimum();
+    const Vector3 maximum = box.maximum();
+
+    AxisAlignedBox result;
+    for (unsigned corner = 0; corner < 8; ++corner)
+    {
+        Vector4 point;
+        point.x = corner & 1 ? maximum.x : minimum.x;
+        point.y = corner & 2 ? maximum.y : minimum.y;
+        point.z = corner & 4 ? maximum.z : minimum.z;
+        point.w = 1.0;
+
+        const Vector4 transformed_point = matrix * point;
+        result.expand_to_include(Vector3(transformed_point.x, transformed_point.y, transformed_point.z));
+    }
+
+    return result;
+}
+
+void test_transform(const AxisAlignedBox& box, const Matrix4& matrix)
+{
+    AxisAlignedBox transformed_box = box;
+    transformed_box.transform(matrix);
+
+    const AxisAlignedBox expected_box = transform_corners(box, matrix);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        REQUIRE(transformed_box.minimum()[i] == Approx(expected_box.minimum()[i]));
+        REQUIRE(transformed_box.maximum()[i] == Approx(expected_box.maximum()[i]));
+    }
+}
+
+TEST_CASE("Construct a default axis aligned box", "[AxisAlignedBox]")
+{
+    AxisAlignedBox box;
+    REQUIRE(!box.has_size());
+}
+
+TEST_CASE("Transform an axis aligned box by a translation", "[AxisAlignedBox]")
+{
+    AxisAlignedBox box(Vector3(-1.0, -2.0, -3.0), Vector3(1.0, 2.0, 3.0));
+    test_transform(box, Matrix4::from_translation(Vector3(4.0, -5.0, 6.0)));
+}
+
+TEST_CASE("Transform an axis aligned box by a rotation", "[AxisAlignedBox]")
+{
+    AxisAlignedBox box(Vector3(0.5, -2.0, 1.0), Vector3(3.0, 2.0, 1.5));
+    test_transform(box, Matrix4::from_rotation(Quaternion::from_axis_angle(Vector3::UnitZ, Degrees(30))));
+    test_transform(box, Matrix4::from_rotation(Quaternion::from_axis_angle(Vector3(1.0, 1.0, 0.0).normalized(), Degrees(135))));
+}
+
+TEST_CASE("Transform an axis aligned box by a scale, rotation, and translation", "[AxisAlignedBox]")
+{
+    AxisAlignedBox box(Vector3(-1.0, 0.0, 2.0), Vector3(2.0, 0.5, 4.0));
+
+    Matrix4 matrix = Matrix4::from_translation(Vector3(-3.0, 1.0, 7.0));
+    matrix *= Matrix4::from_rotation(Quaternion::from_axis_angle(Vector3(0.2, 1.0, -0.5).normalized(), Degrees(70)));
+    matrix *= Matrix4::from_scale(Vector3(2.0, -0.5, 3.0));
+    test_transform(box, matrix);
+}
+
+TEST_CASE("Transform an axis aligned box without size", "[AxisAlignedBox]")
+{
+    AxisAlignedBox box;
+    box.transform(Matrix4::from_translation(Vector3(1.0, 2.0, 3.0)));
+    REQUIRE(!box.has_size());
+}
@@ -21,6 +21,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 ///////////////////////////////////////////////////////////////////////////////
+#include <Hect/Concurrency/TaskPool.h>
 #include <Hect/Core/EventDispatcher.h>
 #include <Hect/Core/EventListener.h>
 using namespace hect;
@@ -59,6 +60,26 @@ public:
     TestEventB last_test_event_b;
 };
 
+class TestBatchListener :
+    public EventListener<TestEventA>
+{
+public:
+
+    void receive_event(const TestEventA& event) override
+    {
+        received_events.push_back(event);
+    }
+
+    void receive_events(const std::vector<TestEventA>& events) override
+    {
+        ++batch_count;
+        EventListener<TestEventA>::receive_events(events);
+    }
+
+    size_t batch_count { 0 };
+    std::vector<TestEventA> received_events;
+};
+
 TEST_CASE("Register a listener, dispatch event, and unregister listener", "[Event]")
 {
     EventDispatcher<TestEventA> dispatcher;
@@ -117,3 +138,124 @@ TEST_CASE("Unregister a listener that is not registered", "[Event]")
     TestListener listener;
     REQUIRE_THROWS_AS(dispatcher.unregister_listener(listener), InvalidOperation);
 }
+
+class ThrowingBatchListener :
+    public EventListener<TestEventA>
+{
+public:
+
+    void receive_event(const TestEventA& event) override
+    {
+        (void)event;
+        throw InvalidOperation("Test");
+    }
+};
+
+TEST_CASE("Enqueue events and dispatch them as a batch", "[Event]")
+{
+    EventDispatcher<TestEventA> dispatcher;
+
+    TestBatchListener listener;
+    dispatcher.register_listener(listener);
+
+    dispatcher.enqueue_event(TestEventA::A);
+    dispatcher.enqueue_event(TestEventA::B);
+    dispatcher.enqueue_event(TestEventA::A);
+    REQUIRE(dispatcher.has_queued_events());
+    REQUIRE(listener.received_events.empty());
+
+    dispatcher.dispatch_queued_events();
+    REQUIRE(!dispatcher.has_queued_events());
+    REQUIRE(listener.batch_count == 1);
+    REQUIRE(listener.received_events.size() == 3);
+    REQUIRE(TestEventA::A == listener.received_events[0]);
+    REQUIRE(TestEventA::B == listener.received_events[1]);
+    REQUIRE(TestEventA::A == listener.received_events[2]);
+
+    dispatcher.dispatch_queued_events();
+    REQUIRE(listener.received_events.size() == 3);
+}
+
+TEST_CASE("Dispatch a batch of events to each listener in a separate task", "[Event]")
+{
+    TaskPool task_pool(size_t(4));
+    EventDispatcher<TestEventA> dispatcher;
+
+    TestBatchListener listeners[8];
+    for (TestBatchListener& listener : listeners)
+    {
+        dispatcher.register_listener(listener);
+    }
+
+    for (size_t i = 0; i < 64; ++i)
+    {
+        dispatcher.enqueue_event(i % 2 ? TestEventA::B : TestEventA::A);
+    }
+
+    dispatcher.dispatch_queued_events(task_pool);
+    REQUIRE(!dispatcher.has_queued_events());
+
+    for (TestBatchListener& listener : listeners)
+    {
+        REQUIRE(listener.batch_count == 1);
+        REQUIRE(listener.received_events.size() == 64);
+        REQUIRE(TestEventA::B == listener.received_events[63]);
+    }
+}
+
+TEST_CASE("Events are not delivered again after a listener throws", "[Event]")
+{
+    EventDispatcher<TestEventA> dispatcher;
+
+    ThrowingBatchListener throwing_listener;
+    dispatcher.register_listener(throwing_listener);
+
+    dispatcher.enqueue_event(TestEventA::A);
+    REQUIRE_THROWS_AS(dispatcher.dispatch_queued_events(), InvalidOperation);
+    REQUIRE(!dispatcher.has_queued_events());
+
+    dispatcher.unregister_listener(throwing_listener);
+
+    TestBatchListener listener;
+    dispatcher.register_listener(listener);
+
+    dispatcher.enqueue_event(TestEventA::B);
+    dispatcher.dispatch_queued_events();
+    REQUIRE(listener.received_events.size() == 1);
+    REQUIRE(TestEventA::B == listener.received_events[0]);
+}
+
+TEST_CASE("Every listener task finishes before an error from another is re-thrown", "[Event]")
+{
+    TaskPool task_pool(size_t(4));
+    EventDispatcher<TestEventA> dispatcher;
+
+    ThrowingBatchListener throwing_listener;
+    dispatcher.register_listener(throwing_listener);
+
+    TestBatchListener listeners[8];
+    for (TestBatchListener& listener : listeners)
+    {
+        dispatcher.register_listener(listener);
+    }
+
+    dispatcher.enqueue_event(TestEventA::A);
+    REQUIRE_THROWS_AS(dispatcher.dispatch_queued_events(task_pool), TaskError);
+
+    for (TestBatchListener& listener : listeners)
+    {
+        REQUIRE(listener.batch_count == 1);
+        REQUIRE(listener.received_events.size() == 1);
+    }
+
+    dispatcher.unregister_listener(throwing_listener);
+
+    dispatcher.enqueue_event(TestEventA::B);
+    dispatcher.dispatch_queued_events(task_pool);
+    for (TestBatchListener& listener : listeners)
+    {
+        REQUIRE(listener.batch_count == 2);
+        REQUIRE(listener.received_events.size() == 2);
+        REQUIRE(TestEventA::B == listener.received_events[1]);
+    }
+}
@@ -90,3 +90,77 @@ TEST_CASE("Test an axis-aligned box intersecting a frustum", "[Frustum]")
 
     REQUIRE(FrustumTestResult::Intersect == frustum.test_axis_aligned_box(box));
 }
+
+TEST_CASE("Test a batch of axis-aligned boxes against a frustum", "[Frustum]")
+{
+    Frustum frustum(
+        Vector3(0, 0, 0),
+        Vector3(0, 0, -1),
+        Vector3(0, 1, 0),
+        Degrees(90),
+        1,
+        0.1,
+        100);
+
+    std::vector<AxisAlignedBox> boxes;
+    for (int i = 0; i < 70; ++i)
+    {
+        const double offset = (i % 7 - 3) * 20.0;
+        const double depth = -(i % 5) * 30.0 + 5.0;
+        boxes.push_back(AxisAlignedBox(Vector3(offset - 1, -1, depth - 2), Vector3(offset + 1, 1, depth)));
+    }
+    boxes.push_back(AxisAlignedBox());
+
+    AxisAlignedBoxBatch batch;
+    for (const AxisAlignedBox& box : boxes)
+    {
+        batch.add(box);
+    }
+
+    std::vector<uint64_t> visible;
+    frustum.test_axis_aligned_boxes(batch, visible);
+    REQUIRE(visible.size() == 2);
+
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        const bool expected = frustum.test_axis_aligned_box(boxes[i]) != FrustumTestResult::Outside;
+        REQUIRE(((visible[i / 64] >> (i % 64)) & 1) == (expected ? 1u : 0u));
+    }
+
+    // Bits past the end of the batch are clear
+    REQUIRE((visible[1] >> (boxes.size() - 64)) == 0);
+}
+
+TEST_CASE("Test a batch of spheres against a frustum", "[Frustum]")
+{
+    Frustum frustum(
+        Vector3(0, 0, 0),
+        Vector3(0, 0, -1),
+        Vector3(0, 1, 0),
+        Degrees(90),
+        1,
+        0.1,
+        100);
+
+    std::vector<Vector3> positions;
+    for (int i = 0; i < 11; ++i)
+    {
+        positions.push_back(Vector3((i - 5) * 15.0, 0, -10.0 - i * 9.0));
+    }
+
+    SphereBatch batch;
+    for (Vector3 position : positions)
+    {
+        batch.add(Sphere(2.0), position);
+    }
+
+    std::vector<uint64_t> visible;
+    frustum.contains_spheres(batch, visible);
+    REQUIRE(visible.size() == 1);
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        const bool expected = frustum.contains_sphere(Sphere(2.0), positions[i]);
+        REQUIRE(((visible[0] >> i) & 1) == (expected ? 1u : 0u));
+    }
+}
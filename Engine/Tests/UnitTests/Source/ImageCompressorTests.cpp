@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <cmath>
+
+#include <Hect/Graphics/ImageCompressor.h>
+#include <Hect/Noise/Random.h>
+using namespace hect;
+
+#include <catch.hpp>
+
+namespace
+{
+
+// Creates an image of smooth gradients with some noise
+Image create_test_image(unsigned width, unsigned height, bool opaque = false)
+{
+    Random random(0);
+
+    Image image(width, height, PixelFormat::Rgba8);
+    for (unsigned x = 0; x < width; ++x)
+    {
+        for (unsigned y = 0; y < height; ++y)
+        {
+            Color color;
+            color.r = 0.5 + 0.5 * std::sin(x * 0.1);
+            color.g = 0.5 + 0.5 * std::cos(y * 0.1);
+            color.b = random.next(0.45, 0.55);
+            color.a = opaque ? 1.0 : static_cast<double>(x + y) / (width + height);
+            image.write_pixel(x, y, color);
+        }
+    }
+    return image;
+}
+
+// Returns the root-mean-square error of the first components of two images
+// in 8-bit units
+double root_mean_square_error(const Image& a, const Image& b, unsigned component_count)
+{
+    double sum = 0.0;
+    for (unsigned x = 0; x < a.width(); ++x)
+    {
+        for (unsigned y = 0; y < a.height(); ++y)
+        {
+            Color color_a = a.read_pixel(x, y);
+            Color color_b = b.read_pixel(x, y);
+            for (unsigned i = 0; i < component_count; ++i)
+            {
+                double error = (color_a[i] - color_b[i]) * 255.0;
+                sum += error * error;
+            }
+        }
+    }
+    return std::sqrt(sum / (a.width() * a.height() * component_count));
+}
+
+void test_round_trip(const PixelFormat& pixel_format, const PixelFormat& decompressed_pixel_format, unsigned component_count, double max_error)
+{
+    // BC1 stores pixels with less than half alpha as transparent black
+    Image image = create_test_image(64, 32, pixel_format == PixelFormat::Bc1);
+
+    ImageCompressor compressor;
+    Image compressed_image = compressor.compress(image, pixel_format);
+
+    REQUIRE(compressed_image.width() == image.width());
+    REQUIRE(compressed_image.height() == image.height());
+    REQUIRE(compressed_image.pixel_format() == pixel_format);
+    REQUIRE(compressed_image.pixel_data().size() == pixel_format.image_size(64, 32));
+
+    Image decompressed_image = compressor.decompress(compressed_image);
+    REQUIRE(decompressed_image.pixel_format() == decompressed_pixel_format);
+    REQUIRE(root_mean_square_error(image, decompressed_image, component_count) < max_error);
+}
+
+}
+
+TEST_CASE("Compute the size of block-compressed images", "[ImageCompressor]")
+{
+    REQUIRE(PixelFormat::Bc1.is_compressed());
+    REQUIRE(!PixelFormat::Rgba8.is_compressed());
+
+    REQUIRE(PixelFormat::Bc1.image_size(4, 4) == 8);
+    REQUIRE(PixelFormat::Bc7.image_size(4, 4) == 16);
+    REQUIRE(PixelFormat::Bc4.image_size(5, 1) == 16);
+    REQUIRE(PixelFormat::Bc5.image_size(1, 1) == 16);
+    REQUIRE(PixelFormat::Rgba8.image_size(5, 3) == 60);
+}
+
+TEST_CASE("Compress and decompress a BC1 image", "[ImageCompressor]")
+{
+    test_round_trip(PixelFormat::Bc1, PixelFormat::Rgba8, 3, 8.0);
+}
+
+TEST_CASE("Compress and decompress a BC3 image", "[ImageCompressor]")
+{
+    test_round_trip(PixelFormat::Bc3, PixelFormat::Rgba8, 4, 7.0);
+}
+
+TEST_CASE("Compress and decompress a BC4 image", "[ImageCompressor]")
+{
+    test_round_trip(PixelFormat::Bc4, PixelFormat::R8, 1, 2.0);
+}
+
+TEST_CASE("Compress and decompress a BC5 image", "[ImageCompressor]")
+{
+    test_round_trip(PixelFormat::Bc5, PixelFormat::Rg8, 2, 2.0);
+}
+
+TEST_CASE("Compress and decompress a BC7 image", "[ImageCompressor]")
+{
+    test_round_trip(PixelFormat::Bc7, PixelFormat::Rgba8, 4, 7.0);
+}
+
+TEST_CASE("Compress transparent pixels of a BC1 image", "[ImageCompressor]")
+{
+    Image image(8, 8, PixelFormat::Rgba8);
+    for (unsigned x = 0; x < image.width(); ++x)
+    {
+        for (unsigned y = 0; y < image.height(); ++y)
+        {
+            image.write_pixel(x, y, Color(1.0, 0.5, 0.25, (x + y) % 2 ? 1.0 : 0.0));
+        }
+    }
+
+    ImageCompressor compressor;
+    Image decompressed_image = compressor.decompress(compressor.compress(image, PixelFormat::Bc1));
+
+    for (unsigned x = 0; x < image.width(); ++x)
+    {
+        for (unsigned y = 0; y < image.height(); ++y)
+        {
+            REQUIRE(decompressed_image.read_pixel(x, y).a == ((x + y) % 2 ? 1.0 : 0.0));
+        }
+    }
+}
+
+TEST_CASE("Compress the mipmaps of an image", "[ImageCompressor]")
+{
+    Image image = create_test_image(16, 8);
+    image.generate_mipmaps();
+
+    ImageCompressor compressor;
+    Image compressed_image = compressor.compress(image, PixelFormat::Bc7);
+
+    REQUIRE(compressed_image.mipmap_count() == 5);
+    REQUIRE(compressed_image.mipmap(4).width() == 1);
+    REQUIRE(compressed_image.mipmap(4).height() == 1);
+    REQUIRE(compressed_image.mipmap(4).pixel_data().size() == 16);
+}
+
+TEST_CASE("Compress an image with an uncompressed pixel format", "[ImageCompressor]")
+{
+    ImageCompressor compressor;
+    REQUIRE_THROWS_AS(compressor.compress(create_test_image(4, 4), PixelFormat::Rgb8), InvalidOperation);
+}
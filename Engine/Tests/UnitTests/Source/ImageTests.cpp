@@ -21,12 +21,28 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 ///////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
 #include <Hect/Graphics/Image.h>
+#include <Hect/IO/BinaryDecoder.h>
+#include <Hect/IO/BinaryEncoder.h>
 #include <Hect/Noise/Random.h>
 using namespace hect;
 
 #include <catch.hpp>
 
+// Returns the offset of the header of the cooked image in encoded image data
+size_t find_cooked_image_header(const ByteVector& data)
+{
+    const uint8_t signature[] = { 'H', 'E', 'C', 'T', 'I', 'M', 'G' };
+    auto it = std::search(data.begin(), data.end(), std::begin(signature), std::end(signature));
+    REQUIRE(it != data.end());
+    return static_cast<size_t>(it - data.begin());
+}
+
 TEST_CASE("Construct a default image", "[Image]")
 {
     Image image;
@@ -146,4 +162,427 @@ TEST_CASE("Write and read pixels", "[Image]")
             }
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Flip an image vertically", "[Image]")
+{
+    Image image(3, 5, PixelFormat::Rgba8);
+    for (unsigned y = 0; y < image.height(); ++y)
+    {
+        image.write_pixel(0, y, Color(y / 255.0, 0, 0, 1));
+    }
+
+    image.flip_vertical();
+
+    for (unsigned y = 0; y < image.height(); ++y)
+    {
+        REQUIRE(image.read_pixel(0, y).r * 255 == Approx(image.height() - y - 1));
+    }
+}
+
+TEST_CASE("Encode and decode an image", "[Image]")
+{
+    Random random(0);
+
+    Image image(33, 17, PixelFormat::Rgba8);
+    for (unsigned x = 0; x < image.width(); ++x)
+    {
+        for (unsigned y = 0; y < image.height(); ++y)
+        {
+            // Use gradients with noise so that the encoder chooses various
+            // scanline filters
+            Color color;
+            color.r = x / 255.0;
+            color.g = y / 255.0;
+            color.b = random.next(0.0, 1.0);
+            color.a = (x + y) % 2 ? 1.0 : 0.5;
+            image.write_pixel(x, y, color);
+        }
+    }
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        image.encode(encoder);
+    }
+
+    Image decoded_image;
+    {
+        BinaryDecoder decoder(data);
+        decoded_image.decode(decoder);
+    }
+
+    REQUIRE(decoded_image.width() == image.width());
+    REQUIRE(decoded_image.height() == image.height());
+    REQUIRE(decoded_image.pixel_format() == PixelFormat::Rgba8);
+    REQUIRE(decoded_image.pixel_data() == image.pixel_data());
+}
+
+uint32_t compute_png_crc(const ByteVector& data, size_t begin, size_t end)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = begin; i < end; ++i)
+    {
+        crc ^= data[i];
+        for (unsigned bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+void write_png_uint32(ByteVector& data, size_t offset, uint32_t value)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        data[offset + i] = static_cast<uint8_t>(value >> (24 - i * 8));
+    }
+}
+
+size_t png_chunk_length(const ByteVector& data, size_t chunk)
+{
+    return (size_t(data[chunk]) << 24) | (size_t(data[chunk + 1]) << 16) | (size_t(data[chunk + 2]) << 8) | size_t(data[chunk + 3]);
+}
+
+// Recomputes the CRC of the chunk at an offset after its data is modified
+void update_png_chunk_crc(ByteVector& data, size_t chunk)
+{
+    const size_t length = png_chunk_length(data, chunk);
+    write_png_uint32(data, chunk + 8 + length, compute_png_crc(data, chunk + 4, chunk + 8 + length));
+}
+
+// Returns the offset of the first chunk of a type
+size_t find_png_chunk(const ByteVector& data, const char* type)
+{
+    size_t chunk = 8;
+    while (chunk + 12 <= data.size())
+    {
+        if (std::memcmp(&data[chunk + 4], type, 4) == 0)
+        {
+            return chunk;
+        }
+        chunk += png_chunk_length(data, chunk) + 12;
+    }
+
+    FAIL("PNG data does not have the chunk");
+    return 0;
+}
+
+void append_png_chunk(ByteVector& data, const char* type, const ByteVector& chunk_data)
+{
+    const size_t chunk = data.size();
+    data.resize(chunk + chunk_data.size() + 12);
+    write_png_uint32(data, chunk, static_cast<uint32_t>(chunk_data.size()));
+    std::memcpy(&data[chunk + 4], type, 4);
+    if (!chunk_data.empty())
+    {
+        std::memcpy(&data[chunk + 8], chunk_data.data(), chunk_data.size());
+    }
+    update_png_chunk_crc(data, chunk);
+}
+
+// Builds a 1x1 palette PNG whose only pixel has a palette index and whose
+// palette has a single red entry
+ByteVector create_palette_png(uint8_t index)
+{
+    ByteVector data = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    append_png_chunk(data, "IHDR", { 0, 0, 0, 1, 0, 0, 0, 1, 8, 3, 0, 0, 0 });
+    append_png_chunk(data, "PLTE", { 255, 0, 0 });
+
+    // A zlib stream with a single stored block holding the filter type and
+    // the index followed by the Adler-32 checksum of the two bytes
+    const uint32_t adler_a = 1 + index;
+    const uint32_t adler_b = 1 + adler_a;
+    ByteVector image_data = { 0x78, 0x01, 0x01, 0x02, 0x00, 0xFD, 0xFF, 0, index, 0, 0, 0, 0 };
+    write_png_uint32(image_data, 9, (adler_b << 16) | adler_a);
+    append_png_chunk(data, "IDAT", image_data);
+
+    append_png_chunk(data, "IEND", ByteVector());
+    return data;
+}
+
+ByteVector encode_test_png()
+{
+    Image image(4, 4, PixelFormat::Rgba8);
+    for (unsigned x = 0; x < image.width(); ++x)
+    {
+        for (unsigned y = 0; y < image.height(); ++y)
+        {
+            image.write_pixel(x, y, Color(x / 4.0, y / 4.0, 0.5, 1.0));
+        }
+    }
+
+    ByteVector data;
+    BinaryEncoder encoder(data);
+    image.encode(encoder);
+    return data;
+}
+
+TEST_CASE("Decode PNG data with dimensions too large to allocate", "[Image]")
+{
+    Image image(1, 1, PixelFormat::Rgba8);
+    image.write_pixel(0, 0, Color::White);
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        image.encode(encoder);
+    }
+
+    // Overwrite the width and height in the IHDR chunk with 65536x65536 and
+    // update the CRC of the chunk so the header itself is valid
+    const size_t ihdr_offset = 8;
+    write_png_uint32(data, ihdr_offset + 8, 65536);
+    write_png_uint32(data, ihdr_offset + 12, 65536);
+    update_png_chunk_crc(data, ihdr_offset);
+
+    Image decoded_image;
+    BinaryDecoder decoder(data);
+    REQUIRE_THROWS_AS(decoded_image.decode(decoder), DecodeError);
+}
+
+TEST_CASE("Decode PNG data with a corrupted image data chunk", "[Image]")
+{
+    ByteVector data = encode_test_png();
+
+    const size_t idat_offset = find_png_chunk(data, "IDAT");
+    data[idat_offset + 8 + png_chunk_length(data, idat_offset) / 2] ^= 0xFF;
+
+    Image decoded_image;
+    BinaryDecoder decoder(data);
+    REQUIRE_THROWS_AS(decoded_image.decode(decoder), DecodeError);
+}
+
+TEST_CASE("Decode PNG data with an incorrect image data checksum", "[Image]")
+{
+    const ByteVector encoded_data = encode_test_png();
+    const size_t idat_offset = find_png_chunk(encoded_data, "IDAT");
+    const size_t idat_length = png_chunk_length(encoded_data, idat_offset);
+    const uint8_t* idat_data = &encoded_data[idat_offset + 8];
+
+    // Move the Adler-32 checksum ending the zlib stream into a chunk of its
+    // own so that it is only read after all of the pixels are decoded, and
+    // corrupt it while keeping the CRC of the chunk valid
+    ByteVector data(encoded_data.begin(), encoded_data.begin() + idat_offset);
+    append_png_chunk(data, "IDAT", ByteVector(idat_data, idat_data + idat_length - 4));
+
+    ByteVector checksum(idat_data + idat_length - 4, idat_data + idat_length);
+    checksum[3] ^= 0xFF;
+    append_png_chunk(data, "IDAT", checksum);
+    data.insert(data.end(), encoded_data.begin() + idat_offset + idat_length + 12, encoded_data.end());
+
+    Image decoded_image;
+    BinaryDecoder decoder(data);
+    REQUIRE_THROWS_AS(decoded_image.decode(decoder), DecodeError);
+}
+
+TEST_CASE("Decode palette PNG data", "[Image]")
+{
+    ByteVector data = create_palette_png(0);
+
+    Image decoded_image;
+    BinaryDecoder decoder(data);
+    decoded_image.decode(decoder);
+
+    REQUIRE(decoded_image.width() == 1);
+    REQUIRE(decoded_image.height() == 1);
+    REQUIRE(decoded_image.read_pixel(0, 0) == Color(1.0, 0.0, 0.0, 1.0));
+}
+
+TEST_CASE("Decode palette PNG data with an index outside of the palette", "[Image]")
+{
+    ByteVector data = create_palette_png(5);
+
+    Image decoded_image;
+    BinaryDecoder decoder(data);
+    REQUIRE_THROWS_AS(decoded_image.decode(decoder), DecodeError);
+}
+
+TEST_CASE("Decode palette PNG data with a corrupted palette", "[Image]")
+{
+    ByteVector data = create_palette_png(0);
+
+    const size_t plte_offset = find_png_chunk(data, "PLTE");
+    data[plte_offset + 9] ^= 0xFF;
+
+    Image decoded_image;
+    BinaryDecoder decoder(data);
+    REQUIRE_THROWS_AS(decoded_image.decode(decoder), DecodeError);
+}
+
+TEST_CASE("Generate the mipmaps of an image", "[Image]")
+{
+    Image image(8, 2, PixelFormat::Rgba8);
+    for (unsigned x = 0; x < image.width(); ++x)
+    {
+        for (unsigned y = 0; y < image.height(); ++y)
+        {
+            image.write_pixel(x, y, x % 2 ? Color(1.0, 1.0, 1.0, 1.0) : Color(0.0, 0.0, 0.0, 1.0));
+        }
+    }
+
+    image.generate_mipmaps();
+
+    REQUIRE(image.mipmap_count() == 4);
+    REQUIRE(image.mipmap(1).width() == 4);
+    REQUIRE(image.mipmap(1).height() == 1);
+    REQUIRE(image.mipmap(3).width() == 1);
+    REQUIRE(image.mipmap(3).height() == 1);
+
+    Color color = image.mipmap(1).read_pixel(0, 0);
+    REQUIRE(std::abs(color.r - 0.5) < 0.01);
+    REQUIRE(color.a == 1.0);
+
+    REQUIRE_THROWS_AS(image.mipmap(4), InvalidOperation);
+}
+
+TEST_CASE("Encode and decode a cooked image", "[Image]")
+{
+    Image image(5, 3, PixelFormat::Rgb8);
+    for (unsigned x = 0; x < image.width(); ++x)
+    {
+        for (unsigned y = 0; y < image.height(); ++y)
+        {
+            image.write_pixel(x, y, Color(x / 4.0, y / 2.0, 0.0));
+        }
+    }
+    image.generate_mipmaps();
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        image.encode(encoder);
+    }
+
+    Image decoded_image;
+    {
+        BinaryDecoder decoder(data);
+        decoded_image.decode(decoder);
+    }
+
+    REQUIRE(decoded_image.pixel_format() == PixelFormat::Rgb8);
+    REQUIRE(decoded_image.color_space() == image.color_space());
+    REQUIRE(decoded_image.mipmap_count() == image.mipmap_count());
+    for (size_t level = 0; level < image.mipmap_count(); ++level)
+    {
+        REQUIRE(decoded_image.mipmap(level).width() == image.mipmap(level).width());
+        REQUIRE(decoded_image.mipmap(level).height() == image.mipmap(level).height());
+        REQUIRE(decoded_image.mipmap(level).pixel_data() == image.mipmap(level).pixel_data());
+    }
+}
+
+TEST_CASE("Decode a cooked image with a level offset which wraps around", "[Image]")
+{
+    Image image(5, 3, PixelFormat::Rgb8);
+    image.write_pixel(0, 0, Color::White);
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        image.encode(encoder);
+    }
+
+    // Overwrite the offset of the first level so that adding it to the
+    // position of the image wraps around
+    const size_t offset_position = find_cooked_image_header(data) + 16 + 8;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        data[offset_position + i] = 0xFF;
+    }
+
+    Image decoded_image;
+    BinaryDecoder decoder(data);
+    REQUIRE_THROWS_AS(decoded_image.decode(decoder), DecodeError);
+}
+
+TEST_CASE("Decode a cooked image with a color space incompatible with its pixel format", "[Image]")
+{
+    Image image(4, 4, PixelFormat::Bc4);
+    image.set_pixel_data(ByteVector(PixelFormat::Bc4.image_size(4, 4), 0));
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        image.encode(encoder);
+    }
+
+    // Overwrite the color space in the header
+    data[find_cooked_image_header(data) + 10] = static_cast<uint8_t>(ColorSpace::NonLinear);
+
+    Image decoded_image;
+    BinaryDecoder decoder(data);
+    REQUIRE_THROWS_AS(decoded_image.decode(decoder), DecodeError);
+}
+
+TEST_CASE("Write and read regions of pixels", "[Image]")
+{
+    Image image(6, 5, PixelFormat::Rgb32);
+
+    std::vector<float> components(3 * 2 * 4);
+    for (size_t i = 0; i < components.size(); ++i)
+    {
+        components[i] = static_cast<float>(i);
+    }
+    image.write_region(2, 1, 3, 2, components.data());
+
+    // Pixels are written as they are, and alpha reads as one
+    Color color = image.read_pixel(3, 2);
+    REQUIRE(color.r == 16.0);
+    REQUIRE(color.g == 17.0);
+    REQUIRE(color.b == 18.0);
+
+    std::vector<float> read_components(components.size());
+    image.read_region(2, 1, 3, 2, read_components.data());
+    for (size_t i = 0; i < components.size(); ++i)
+    {
+        REQUIRE(read_components[i] == (i % 4 == 3 ? 1.0f : components[i]));
+    }
+
+    std::vector<float> row(image.width() * 4);
+    image.read_row(0, row.data());
+    REQUIRE(row[0] == 0.0f);
+
+    REQUIRE_THROWS_AS(image.read_region(4, 0, 3, 1, row.data()), InvalidOperation);
+    REQUIRE_THROWS_AS(image.write_row(5, row.data()), InvalidOperation);
+}
+
+TEST_CASE("Write and read 16-bit float pixels", "[Image]")
+{
+    Image image(2, 2, PixelFormat::Rgba16);
+    image.write_pixel(1, 1, Color(0.5, -2.0, 1024.0, 0.25));
+
+    Color color = image.read_pixel(1, 1);
+    REQUIRE(color.r == 0.5);
+    REQUIRE(color.g == -2.0);
+    REQUIRE(color.b == 1024.0);
+    REQUIRE(color.a == 0.25);
+}
+
+TEST_CASE("Convert an image to another pixel format", "[Image]")
+{
+    Image image(4, 4, PixelFormat::Rgba8);
+    image.set_color_space(ColorSpace::NonLinear);
+
+    std::vector<float> components;
+    for (unsigned i = 0; i < image.width() * image.height(); ++i)
+    {
+        components.insert(components.end(), { 188.0f / 255.0f, 0.0f, 1.0f, 0.5f });
+    }
+    image.write_region(0, 0, image.width(), image.height(), components.data());
+    image.generate_mipmaps();
+
+    image.convert(PixelFormat::Rgb32, ColorSpace::Linear);
+
+    REQUIRE(image.pixel_format() == PixelFormat::Rgb32);
+    REQUIRE(image.color_space() == ColorSpace::Linear);
+    REQUIRE(image.pixel_data().size() == 4 * 4 * 12);
+    REQUIRE(image.mipmap(2).pixel_format() == PixelFormat::Rgb32);
+
+    Color color = image.read_pixel(0, 0);
+    REQUIRE(std::abs(color.r - 0.5) < 0.005);
+    REQUIRE(color.g == 0.0);
+    REQUIRE(color.b == 1.0);
+
+    REQUIRE_THROWS_AS(image.convert(PixelFormat::Rgb32, ColorSpace::NonLinear), InvalidOperation);
+    REQUIRE_THROWS_AS(image.convert(PixelFormat::Bc1, ColorSpace::Linear), InvalidOperation);
+}
@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <cmath>
+#include <vector>
+
+#include <Hect/Concurrency/TaskPool.h>
+#include <Hect/Graphics/LightProbeConvolver.h>
+using namespace hect;
+
+#include <catch.hpp>
+
+namespace
+{
+
+const double Pi = 3.14159265358979323846;
+
+// Creates a cube map whose sides are filled with a constant color, except
+// for the positive Y side which is filled with another
+TextureCube create_test_texture_cube(unsigned size, const Color& color, const Color& top_color, const PixelFormat& pixel_format = PixelFormat::Rgba32)
+{
+    TextureCube texture("Test", size, size);
+    texture.set_pixel_format(pixel_format);
+    for (unsigned side = 0; side < 6; ++side)
+    {
+        const Color& side_color = static_cast<CubeSide>(side) == CubeSide::PositiveY ? top_color : color;
+
+        std::vector<float> components;
+        for (unsigned i = 0; i < size * size; ++i)
+        {
+            components.insert(components.end(), { static_cast<float>(side_color.r), static_cast<float>(side_color.g), static_cast<float>(side_color.b), 1.0f });
+        }
+
+        Image& image = texture.image(static_cast<CubeSide>(side));
+        image.write_region(0, 0, size, size, components.data());
+    }
+    return texture;
+}
+
+}
+
+TEST_CASE("Compute the directions through the sides of a cube map", "[LightProbeConvolver]")
+{
+    REQUIRE(LightProbeConvolver::direction(CubeSide::PositiveX, Vector2(0.5, 0.5)).x == Approx(1.0));
+    REQUIRE(LightProbeConvolver::direction(CubeSide::NegativeY, Vector2(0.5, 0.5)).y == Approx(-1.0));
+    REQUIRE(LightProbeConvolver::direction(CubeSide::NegativeZ, Vector2(0.5, 0.5)).z == Approx(-1.0));
+
+    // The first pixel of the positive X side is towards positive Y and Z
+    Vector3 direction = LightProbeConvolver::direction(CubeSide::PositiveX, Vector2(0.0, 0.0));
+    REQUIRE(direction.x == Approx(1.0 / std::sqrt(3.0)));
+    REQUIRE(direction.y == Approx(1.0 / std::sqrt(3.0)));
+    REQUIRE(direction.z == Approx(1.0 / std::sqrt(3.0)));
+}
+
+TEST_CASE("Project the irradiance of a constant environment", "[LightProbeConvolver]")
+{
+    TextureCube texture = create_test_texture_cube(8, Color(0.5, 1.0, 2.0), Color(0.5, 1.0, 2.0));
+
+    LightProbeConvolver convolver;
+    SphericalHarmonics irradiance = convolver.project_irradiance(texture);
+
+    const Vector3 directions[] = { Vector3::UnitX, -Vector3::UnitY, Vector3(1.0, 1.0, -1.0).normalized() };
+    for (const Vector3& direction : directions)
+    {
+        Vector3 value = irradiance.evaluate(direction);
+        REQUIRE(value.x == Approx(0.5 * Pi));
+        REQUIRE(value.y == Approx(1.0 * Pi));
+        REQUIRE(value.z == Approx(2.0 * Pi));
+    }
+}
+
+TEST_CASE("Project the irradiance of an environment lit from above", "[LightProbeConvolver]")
+{
+    TextureCube texture = create_test_texture_cube(8, Color(0.0, 0.0, 0.0), Color(1.0, 1.0, 1.0), PixelFormat::Rgba8);
+
+    LightProbeConvolver convolver;
+    SphericalHarmonics irradiance = convolver.project_irradiance(texture);
+
+    const double up = irradiance.evaluate(Vector3::UnitY).x;
+    const double side = irradiance.evaluate(Vector3::UnitX).x;
+    const double down = irradiance.evaluate(-Vector3::UnitY).x;
+    REQUIRE(up > side);
+    REQUIRE(side > down);
+    REQUIRE(std::abs(down) < 0.1);
+    REQUIRE(irradiance.evaluate(-Vector3::UnitZ).x == Approx(side));
+}
+
+TEST_CASE("Prefilter a constant environment", "[LightProbeConvolver]")
+{
+    TextureCube texture = create_test_texture_cube(8, Color(0.25, 0.5, 1.0), Color(0.25, 0.5, 1.0));
+
+    LightProbeConvolver convolver;
+    convolver.set_sample_count(32);
+    convolver.prefilter_specular(texture);
+
+    REQUIRE(texture.is_mipmapped());
+    for (unsigned side = 0; side < 6; ++side)
+    {
+        const Image& image = texture.image(static_cast<CubeSide>(side));
+        REQUIRE(image.mipmap_count() == 4);
+        REQUIRE(image.mipmap(3).width() == 1);
+
+        for (size_t level = 1; level < image.mipmap_count(); ++level)
+        {
+            Color color = image.mipmap(level).read_pixel(0, 0);
+            REQUIRE(color.r == Approx(0.25).epsilon(0.001));
+            REQUIRE(color.g == Approx(0.5).epsilon(0.001));
+            REQUIRE(color.b == Approx(1.0).epsilon(0.001));
+        }
+    }
+}
+
+TEST_CASE("Prefilter an environment lit from above", "[LightProbeConvolver]")
+{
+    TextureCube texture = create_test_texture_cube(16, Color(0.0, 0.0, 0.0), Color(1.0, 1.0, 1.0));
+
+    LightProbeConvolver convolver;
+    convolver.set_sample_count(64);
+    convolver.prefilter_specular(texture);
+
+    // Rougher levels blur the edge of the lit side further
+    const Image& top = texture.image(CubeSide::PositiveY);
+    const Image& bottom = texture.image(CubeSide::NegativeY);
+    const Image& side = texture.image(CubeSide::PositiveX);
+    REQUIRE(top.mipmap(1).read_pixel(4, 4).r > 0.9);
+    REQUIRE(bottom.mipmap(1).read_pixel(4, 4).r < 0.01);
+    REQUIRE(side.mipmap(3).read_pixel(0, 1).r > side.mipmap(1).read_pixel(0, 7).r);
+
+    REQUIRE(LightProbeConvolver::level_roughness(0, 5) == 0.0);
+    REQUIRE(LightProbeConvolver::level_roughness(2, 5) == 0.5);
+    REQUIRE(LightProbeConvolver::level_roughness(4, 5) == 1.0);
+}
+
+TEST_CASE("Convolve a cube map on worker threads", "[LightProbeConvolver]")
+{
+    TextureCube texture = create_test_texture_cube(32, Color(0.2, 0.4, 0.6), Color(4.0, 3.0, 2.0));
+    TextureCube threaded_texture = create_test_texture_cube(32, Color(0.2, 0.4, 0.6), Color(4.0, 3.0, 2.0));
+
+    LightProbeConvolver convolver;
+    convolver.set_sample_count(16);
+    SphericalHarmonics irradiance = convolver.project_irradiance(texture);
+    convolver.prefilter_specular(texture);
+
+    TaskPool task_pool(size_t(4));
+    LightProbeConvolver threaded_convolver(task_pool);
+    threaded_convolver.set_sample_count(16);
+    SphericalHarmonics threaded_irradiance = threaded_convolver.project_irradiance(threaded_texture);
+    threaded_convolver.prefilter_specular(threaded_texture);
+
+    for (size_t i = 0; i < SphericalHarmonics::CoefficientCount; ++i)
+    {
+        REQUIRE(threaded_irradiance[i] == irradiance[i]);
+    }
+
+    for (unsigned side = 0; side < 6; ++side)
+    {
+        const Image& image = texture.image(static_cast<CubeSide>(side));
+        const Image& threaded_image = threaded_texture.image(static_cast<CubeSide>(side));
+        REQUIRE(threaded_image.mipmap_count() == image.mipmap_count());
+        for (size_t level = 0; level < image.mipmap_count(); ++level)
+        {
+            REQUIRE(threaded_image.mipmap(level).pixel_data() == image.mipmap(level).pixel_data());
+        }
+    }
+}
+
+TEST_CASE("Convolve an unsupported cube map", "[LightProbeConvolver]")
+{
+    LightProbeConvolver convolver;
+
+    TextureCube empty_texture("Test", 4, 4);
+    REQUIRE_THROWS_AS(convolver.project_irradiance(empty_texture), InvalidOperation);
+
+    TextureCube partial_texture = create_test_texture_cube(4, Color(), Color());
+    partial_texture.set_image(CubeSide::NegativeZ, AssetHandle<Image>(new Image(4, 4, PixelFormat::Rgba32)));
+    REQUIRE_THROWS_AS(convolver.prefilter_specular(partial_texture), InvalidOperation);
+
+    REQUIRE_THROWS_AS(convolver.set_sample_count(0), InvalidOperation);
+}
@@ -126,3 +126,33 @@ TEST_CASE("Set the shader of a material with uniform values", "[Material]")
 
     REQUIRE(material.uniform_values().empty());
 }
+
+TEST_CASE("Uniform blocks of a material are only rebuilt when updated", "[Material]")
+{
+    Shader shader;
+    Uniform scale("scale", UniformType::Float);
+    scale.set_block("Material");
+    shader.add_uniform(scale);
+
+    Material material;
+    material.set_shader(shader.create_handle());
+    material.set_uniform_value("scale", 2.0);
+
+    // The blocks are out of date until they are updated
+    REQUIRE_THROWS_AS(material.uniform_block(0), InvalidOperation);
+
+    material.update_uniform_blocks();
+    UniformBlock& block = material.uniform_block(0);
+    REQUIRE(block.is_modified());
+    block.set_as_synchronized();
+
+    // Accessing the values does not invalidate the blocks
+    REQUIRE(!material.uniform_values().empty());
+    REQUIRE(!material.uniform_block(0).is_modified());
+
+    material.set_uniform_value("scale", 3.0);
+    REQUIRE_THROWS_AS(material.uniform_block(0), InvalidOperation);
+
+    material.update_uniform_blocks();
+    REQUIRE(material.uniform_block(0).is_modified());
+}
@@ -73,3 +73,73 @@ TEST_CASE("Cast a 4x4 matrix from double to float", "[Matrix]")
         REQUIRE(std::abs(a[i] - b[i]) < 0.01);
     }
 }
+
+TEST_CASE("Transform a 4-dimensional vector by a single-precision 4x4 matrix", "[Matrix]")
+{
+    FloatMatrix4 m = FloatMatrix4::from_translation(FloatVector3(1.0f, 2.0f, 3.0f));
+    m *= FloatMatrix4::from_scale(FloatVector3(2.0f, 2.0f, 2.0f));
+
+    FloatVector4 v = m * FloatVector4(1.0f, 0.0f, 0.0f, 1.0f);
+    REQUIRE(v.x == 3.0f);
+    REQUIRE(v.y == 2.0f);
+    REQUIRE(v.z == 3.0f);
+    REQUIRE(v.w == 1.0f);
+}
+
+TEST_CASE("Multiply two 4x4 matrices matches the scalar kernel", "[Matrix]")
+{
+    FloatMatrix4 a = FloatMatrix4::from_rotation(FloatQuaternion::from_axis_angle(FloatVector3::UnitY, Degrees(30)));
+    a *= FloatMatrix4::from_translation(FloatVector3(1.5f, -2.25f, 3.125f));
+    FloatMatrix4 b = FloatMatrix4::from_scale(FloatVector3(0.3f, 1.7f, 2.9f));
+    b *= FloatMatrix4::from_rotation(FloatQuaternion::from_axis_angle(FloatVector3::UnitX, Degrees(45)));
+
+    FloatMatrix4 c = a * b;
+
+    FloatMatrix4 expected;
+    simd::multiply_matrix4<float>(&a[0], &b[0], &expected[0]);
+    for (size_t i = 0; i < 16; ++i)
+    {
+        REQUIRE(c[i] == expected[i]);
+    }
+}
+
+TEST_CASE("Multiply two double-precision 4x4 matrices matches the scalar kernel", "[Matrix]")
+{
+    Matrix4 a = Matrix4::from_rotation(Quaternion::from_axis_angle(Vector3::UnitY, Degrees(30)));
+    a *= Matrix4::from_translation(Vector3(1.5, -2.25, 3.125));
+    Matrix4 b = Matrix4::from_scale(Vector3(0.3, 1.7, 2.9));
+    b *= Matrix4::from_rotation(Quaternion::from_axis_angle(Vector3::UnitX, Degrees(45)));
+
+    Matrix4 c = a * b;
+
+    Matrix4 expected;
+    simd::multiply_matrix4<double>(&a[0], &b[0], &expected[0]);
+    for (size_t i = 0; i < 16; ++i)
+    {
+        REQUIRE(c[i] == expected[i]);
+    }
+}
+
+TEST_CASE("Transform points by a 4x4 matrix", "[Matrix]")
+{
+    Matrix4 m = Matrix4::from_rotation(Quaternion::from_axis_angle(Vector3::UnitZ, Degrees(60)));
+    m *= Matrix4::from_translation(Vector3(4.0, 5.0, 6.0));
+
+    Vector3 points[] = { Vector3(1.0, 2.0, 3.0), Vector3(-1.0, 0.5, 0.25), Vector3::Zero };
+    Vector3 results[3];
+    m.transform_points(points, results, 3);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        Vector4 expected = m * Vector4(points[i].x, points[i].y, points[i].z, 1.0);
+        REQUIRE(results[i].x == expected.x);
+        REQUIRE(results[i].y == expected.y);
+        REQUIRE(results[i].z == expected.z);
+    }
+
+    m.transform_points(points, points, 3);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        REQUIRE(points[i] == results[i]);
+    }
+}
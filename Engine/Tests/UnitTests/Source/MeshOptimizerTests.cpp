@@ -0,0 +1,500 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect/Graphics/Mesh.h>
+#include <Hect/Graphics/MeshOptimizer.h>
+#include <Hect/Graphics/MeshReader.h>
+#include <Hect/Graphics/MeshWriter.h>
+#include <Hect/IO/BinaryDecoder.h>
+#include <Hect/IO/BinaryEncoder.h>
+using namespace hect;
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <tuple>
+
+namespace
+{
+
+// Creates an unindexed triangle list of a grid of quads with each vertex
+// repeated for every triangle it belongs to
+Mesh create_grid_soup(unsigned size)
+{
+    VertexLayout vertex_layout;
+    vertex_layout.add_attribute(VertexAttribute(VertexAttributeSemantic::Position, VertexAttributeType::Float32, 3));
+
+    Mesh::Descriptor descriptor;
+    descriptor.vertex_layout = vertex_layout;
+    descriptor.index_type = IndexType::UInt32;
+
+    Mesh mesh(descriptor);
+    MeshWriter mesh_writer(mesh);
+
+    auto add_vertex = [&](unsigned x, unsigned y)
+    {
+        mesh_writer.add_vertex();
+        mesh_writer.write_attribute_data(VertexAttributeSemantic::Position, Vector3(x, y, 0));
+    };
+
+    for (unsigned y = 0; y < size; ++y)
+    {
+        for (unsigned x = 0; x < size; ++x)
+        {
+            add_vertex(x, y);
+            add_vertex(x + 1, y);
+            add_vertex(x + 1, y + 1);
+
+            add_vertex(x, y);
+            add_vertex(x + 1, y + 1);
+            add_vertex(x, y + 1);
+        }
+    }
+
+    return mesh;
+}
+
+// Creates a mesh with the default vertex layout spanning (-1, -2, -4) to
+// (1, 2, 4)
+Mesh create_default_mesh()
+{
+    Mesh mesh;
+    MeshWriter mesh_writer(mesh);
+
+    for (unsigned i = 0; i < 64; ++i)
+    {
+        const double angle = i * 0.1;
+        Vector3 position(std::cos(angle), 2 * std::sin(angle * 3), 4 * std::cos(angle * 5));
+        Vector3 normal = Vector3(std::sin(angle), std::cos(angle * 2), -std::sin(angle * 7)).normalized();
+
+        mesh_writer.add_vertex();
+        mesh_writer.write_attribute_data(VertexAttributeSemantic::Position, position);
+        mesh_writer.write_attribute_data(VertexAttributeSemantic::Normal, normal);
+        mesh_writer.write_attribute_data(VertexAttributeSemantic::Tangent, normal.cross(Vector3::UnitY).normalized());
+        mesh_writer.write_attribute_data(VertexAttributeSemantic::TextureCoords0, Vector2(i / 64.0, 1.0 - i / 64.0));
+        mesh_writer.add_index(i);
+    }
+
+    // Ensure the bounds are exact
+    mesh_writer.add_vertex();
+    mesh_writer.write_attribute_data(VertexAttributeSemantic::Position, Vector3(-1, -2, -4));
+    mesh_writer.write_attribute_data(VertexAttributeSemantic::Normal, Vector3::UnitX);
+    mesh_writer.add_vertex();
+    mesh_writer.write_attribute_data(VertexAttributeSemantic::Position, Vector3(1, 2, 4));
+    mesh_writer.write_attribute_data(VertexAttributeSemantic::Normal, Vector3::UnitZ);
+
+    return mesh;
+}
+
+// Creates a closed, indexed sphere of unit radius
+Mesh create_sphere(unsigned rings, unsigned segments)
+{
+    VertexLayout vertex_layout;
+    vertex_layout.add_attribute(VertexAttribute(VertexAttributeSemantic::Position, VertexAttributeType::Float32, 3));
+
+    Mesh::Descriptor descriptor;
+    descriptor.vertex_layout = vertex_layout;
+    descriptor.index_type = IndexType::UInt32;
+
+    Mesh mesh(descriptor);
+    MeshWriter mesh_writer(mesh);
+
+    const double pi = std::acos(-1.0);
+    mesh_writer.add_vertex();
+    mesh_writer.write_attribute_data(VertexAttributeSemantic::Position, Vector3::UnitZ);
+    for (unsigned ring = 1; ring < rings; ++ring)
+    {
+        const double polar = pi * ring / rings;
+        for (unsigned segment = 0; segment < segments; ++segment)
+        {
+            const double azimuth = 2.0 * pi * segment / segments;
+            mesh_writer.add_vertex();
+            mesh_writer.write_attribute_data(VertexAttributeSemantic::Position, Vector3(std::sin(polar) * std::cos(azimuth), std::sin(polar) * std::sin(azimuth), std::cos(polar)));
+        }
+    }
+    mesh_writer.add_vertex();
+    mesh_writer.write_attribute_data(VertexAttributeSemantic::Position, -Vector3::UnitZ);
+
+    auto ring_vertex = [&](unsigned ring, unsigned segment)
+    {
+        return 1 + (ring - 1) * segments + segment % segments;
+    };
+
+    const unsigned bottom = 1 + (rings - 1) * segments;
+    for (unsigned segment = 0; segment < segments; ++segment)
+    {
+        mesh_writer.add_index(0);
+        mesh_writer.add_index(ring_vertex(1, segment));
+        mesh_writer.add_index(ring_vertex(1, segment + 1));
+
+        for (unsigned ring = 1; ring < rings - 1; ++ring)
+        {
+            mesh_writer.add_index(ring_vertex(ring, segment));
+            mesh_writer.add_index(ring_vertex(ring + 1, segment));
+            mesh_writer.add_index(ring_vertex(ring + 1, segment + 1));
+
+            mesh_writer.add_index(ring_vertex(ring, segment));
+            mesh_writer.add_index(ring_vertex(ring + 1, segment + 1));
+            mesh_writer.add_index(ring_vertex(ring, segment + 1));
+        }
+
+        mesh_writer.add_index(ring_vertex(rings - 1, segment));
+        mesh_writer.add_index(bottom);
+        mesh_writer.add_index(ring_vertex(rings - 1, segment + 1));
+    }
+
+    return mesh;
+}
+
+// Returns the triangles of a mesh as sorted position triples
+std::vector<std::vector<double>> sorted_triangles(const Mesh& mesh)
+{
+    std::vector<Vector3> positions;
+    mesh.copy_attribute_data(VertexAttributeSemantic::Position, positions);
+
+    std::vector<uint32_t> indices;
+    if (mesh.index_count() > 0)
+    {
+        mesh.copy_index_data(indices);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < mesh.vertex_count(); ++i)
+        {
+            indices.push_back(i);
+        }
+    }
+
+    std::vector<std::vector<double>> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        // Rotate the triangle to begin with its smallest vertex to keep the
+        // winding order significant
+        std::vector<Vector3> vertices { positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]] };
+        auto less = [](Vector3 a, Vector3 b)
+        {
+            return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+        };
+        std::rotate(vertices.begin(), std::min_element(vertices.begin(), vertices.end(), less), vertices.end());
+
+        std::vector<double> triangle;
+        for (Vector3 vertex : vertices)
+        {
+            triangle.insert(triangle.end(), { vertex.x, vertex.y, vertex.z });
+        }
+        triangles.push_back(triangle);
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}
+
+TEST_CASE("Compute the average cache miss ratio of a triangle soup", "[MeshOptimizer]")
+{
+    Mesh mesh = create_grid_soup(4);
+
+    REQUIRE(MeshOptimizer::compute_acmr(mesh) == 3.0);
+}
+
+TEST_CASE("Weld the duplicate vertices of a triangle soup", "[MeshOptimizer]")
+{
+    Mesh mesh = create_grid_soup(4);
+    auto triangles = sorted_triangles(mesh);
+
+    MeshOptimizer optimizer;
+    optimizer.weld_vertices(mesh);
+
+    REQUIRE(mesh.vertex_count() == 25u);
+    REQUIRE(mesh.index_count() == 96u);
+    REQUIRE(mesh.index_type() == IndexType::UInt16);
+    REQUIRE(sorted_triangles(mesh) == triangles);
+}
+
+TEST_CASE("Optimize the vertex cache order of a mesh", "[MeshOptimizer]")
+{
+    Mesh mesh = create_grid_soup(16);
+    auto triangles = sorted_triangles(mesh);
+
+    MeshOptimizer optimizer;
+    optimizer.weld_vertices(mesh);
+    double acmr_before = MeshOptimizer::compute_acmr(mesh);
+
+    optimizer.optimize_vertex_cache(mesh);
+
+    REQUIRE(MeshOptimizer::compute_acmr(mesh) < acmr_before);
+    REQUIRE(sorted_triangles(mesh) == triangles);
+}
+
+TEST_CASE("Optimize the vertex fetch order of a mesh", "[MeshOptimizer]")
+{
+    Mesh mesh = create_grid_soup(2);
+    MeshOptimizer optimizer;
+    optimizer.weld_vertices(mesh);
+
+    // Drop the first quad so its corner vertex is no longer referenced
+    std::vector<uint32_t> indices;
+    mesh.copy_index_data(indices);
+    indices.erase(indices.begin(), indices.begin() + 6);
+
+    Mesh::IndexData index_data(indices.size() * sizeof(uint16_t));
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        uint16_t index = static_cast<uint16_t>(indices[i]);
+        std::memcpy(&index_data[i * sizeof(uint16_t)], &index, sizeof(uint16_t));
+    }
+    mesh.set_index_data(index_data);
+    auto triangles = sorted_triangles(mesh);
+
+    optimizer.optimize_vertex_fetch(mesh);
+
+    REQUIRE(mesh.vertex_count() == 8u);
+    REQUIRE(sorted_triangles(mesh) == triangles);
+
+    mesh.copy_index_data(indices);
+    uint32_t next_index = 0;
+    for (uint32_t index : indices)
+    {
+        REQUIRE(index <= next_index);
+        next_index = std::max(next_index, index + 1);
+    }
+}
+
+TEST_CASE("Optimize a mesh and report its metrics", "[MeshOptimizer]")
+{
+    Mesh mesh = create_grid_soup(16);
+    auto triangles = sorted_triangles(mesh);
+
+    MeshOptimizer::Metrics metrics = mesh.optimize();
+
+    REQUIRE(metrics.vertex_count_before == 1536u);
+    REQUIRE(metrics.vertex_count_after == 289u);
+    REQUIRE(metrics.acmr_before == 3.0);
+    REQUIRE(metrics.acmr_after < 1.0);
+    REQUIRE(metrics.acmr_after == MeshOptimizer::compute_acmr(mesh));
+    REQUIRE(sorted_triangles(mesh) == triangles);
+}
+
+TEST_CASE("Quantize the vertices of a mesh", "[MeshOptimizer]")
+{
+    Mesh mesh = create_default_mesh();
+    Mesh quantized_mesh = mesh;
+
+    MeshOptimizer optimizer;
+    optimizer.quantize_vertices(quantized_mesh);
+
+    REQUIRE(mesh.vertex_layout().vertex_size() == 44u);
+    REQUIRE(quantized_mesh.vertex_layout().vertex_size() == 20u);
+    REQUIRE(quantized_mesh.has_quantized_positions());
+    REQUIRE(quantized_mesh.dequantization_scale() == 4.0);
+    REQUIRE(quantized_mesh.vertex_count() == mesh.vertex_count());
+    REQUIRE(quantized_mesh.index_data() == mesh.index_data());
+
+    MeshReader reader(mesh);
+    MeshReader quantized_reader(quantized_mesh);
+    while (reader.next_vertex() && quantized_reader.next_vertex())
+    {
+        Vector3 position = reader.read_attribute_vector3(VertexAttributeSemantic::Position);
+        Vector3 quantized_position = quantized_reader.read_attribute_vector3(VertexAttributeSemantic::Position);
+        REQUIRE((position - quantized_position).length() < 1.0e-3);
+
+        Vector3 normal = reader.read_attribute_vector3(VertexAttributeSemantic::Normal);
+        Vector3 quantized_normal = quantized_reader.read_attribute_vector3(VertexAttributeSemantic::Normal);
+        REQUIRE(normal.dot(quantized_normal) > 0.9999);
+
+        Vector2 texture_coords = reader.read_attribute_vector2(VertexAttributeSemantic::TextureCoords0);
+        Vector2 quantized_texture_coords = quantized_reader.read_attribute_vector2(VertexAttributeSemantic::TextureCoords0);
+        REQUIRE((texture_coords - quantized_texture_coords).length() < 1.0e-3);
+    }
+}
+
+TEST_CASE("Encode and decode a quantized mesh", "[MeshOptimizer]")
+{
+    Mesh mesh = create_default_mesh();
+    MeshOptimizer optimizer;
+    optimizer.quantize_vertices(mesh);
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(mesh);
+    }
+
+    Mesh decoded_mesh;
+    {
+        BinaryDecoder decoder(data);
+        decoder >> decode_value(decoded_mesh);
+    }
+
+    REQUIRE(decoded_mesh == mesh);
+    REQUIRE(decoded_mesh.dequantization_offset() == mesh.dequantization_offset());
+    REQUIRE(decoded_mesh.dequantization_scale() == mesh.dequantization_scale());
+    REQUIRE((decoded_mesh.axis_aligned_box().maximum() - Vector3(1, 2, 4)).length() < 1.0e-3);
+}
+
+TEST_CASE("Simplify a flat grid without error", "[MeshOptimizer]")
+{
+    Mesh mesh = create_grid_soup(16);
+    MeshOptimizer optimizer;
+    optimizer.weld_vertices(mesh);
+
+    Mesh simplified_mesh = optimizer.simplify(mesh, mesh.index_count() / 4);
+
+    REQUIRE(simplified_mesh.index_count() < mesh.index_count() / 2);
+    REQUIRE(simplified_mesh.simplification_error() < 1.0e-6);
+
+    // The borders are kept in place
+    REQUIRE(simplified_mesh.axis_aligned_box().minimum() == mesh.axis_aligned_box().minimum());
+    REQUIRE(simplified_mesh.axis_aligned_box().maximum() == mesh.axis_aligned_box().maximum());
+}
+
+TEST_CASE("Simplify a sphere", "[MeshOptimizer]")
+{
+    Mesh mesh = create_sphere(32, 64);
+    MeshOptimizer optimizer;
+
+    Mesh simplified_mesh = optimizer.simplify(mesh, mesh.index_count() / 4);
+
+    REQUIRE(simplified_mesh.index_count() <= mesh.index_count() / 4);
+    REQUIRE(simplified_mesh.simplification_error() > 0.0);
+    REQUIRE(simplified_mesh.simplification_error() < 0.1);
+    REQUIRE(simplified_mesh.level_of_detail_count() == 1);
+
+    // The simplified surface stays near the sphere
+    std::vector<Vector3> positions;
+    simplified_mesh.copy_attribute_data(VertexAttributeSemantic::Position, positions);
+    for (Vector3 position : positions)
+    {
+        REQUIRE(std::abs(position.length() - 1.0) < 1.0e-3);
+    }
+}
+
+TEST_CASE("Generate the levels of detail of a mesh", "[MeshOptimizer]")
+{
+    Mesh mesh = create_sphere(32, 64);
+    MeshOptimizer optimizer;
+    optimizer.generate_levels_of_detail(mesh, 4);
+
+    REQUIRE(mesh.level_of_detail_count() == 4);
+    REQUIRE(&mesh.level_of_detail(0) == &mesh);
+    REQUIRE(mesh.simplification_error() == 0.0);
+    for (size_t level = 1; level < mesh.level_of_detail_count(); ++level)
+    {
+        const Mesh& previous_level = mesh.level_of_detail(level - 1);
+        const Mesh& level_of_detail = mesh.level_of_detail(level);
+        REQUIRE(level_of_detail.index_count() < previous_level.index_count());
+        REQUIRE(level_of_detail.simplification_error() > previous_level.simplification_error());
+        REQUIRE(level_of_detail.level_of_detail_count() == 1);
+    }
+
+    REQUIRE_THROWS_AS(mesh.level_of_detail(4), InvalidOperation);
+}
+
+TEST_CASE("Encode and decode a mesh with levels of detail", "[MeshOptimizer]")
+{
+    Mesh mesh = create_sphere(16, 32);
+    MeshOptimizer optimizer;
+    optimizer.generate_levels_of_detail(mesh, 3);
+    REQUIRE(mesh.level_of_detail_count() == 3);
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(mesh);
+    }
+
+    Mesh decoded_mesh;
+    {
+        BinaryDecoder decoder(data);
+        decoder >> decode_value(decoded_mesh);
+    }
+
+    REQUIRE(decoded_mesh == mesh);
+    REQUIRE(decoded_mesh.level_of_detail_count() == 3);
+    REQUIRE(decoded_mesh.level_of_detail(2).simplification_error() == mesh.level_of_detail(2).simplification_error());
+}
+
+TEST_CASE("Decode a mesh followed by other data in a stream", "[MeshOptimizer]")
+{
+    Mesh mesh = create_default_mesh();
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(mesh)
+                << encode_value(std::string("Next"));
+    }
+
+    Mesh decoded_mesh;
+    std::string next;
+    {
+        BinaryDecoder decoder(data);
+        decoder >> decode_value(decoded_mesh)
+                >> decode_value(next);
+    }
+
+    REQUIRE(decoded_mesh == mesh);
+    REQUIRE(decoded_mesh.level_of_detail_count() == 1);
+    REQUIRE(next == "Next");
+}
+
+TEST_CASE("Decode a mesh encoded before the binary format was versioned", "[MeshOptimizer]")
+{
+    Mesh mesh = create_default_mesh();
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(mesh);
+    }
+
+    // Strip the signature and version from the beginning and the
+    // simplification error and level of detail count from the end
+    ByteVector unversioned_data(data.begin() + 8, data.end() - 12);
+
+    Mesh decoded_mesh;
+    {
+        BinaryDecoder decoder(unversioned_data);
+        decoder >> decode_value(decoded_mesh);
+    }
+
+    REQUIRE(decoded_mesh == mesh);
+    REQUIRE(decoded_mesh.level_of_detail_count() == 1);
+}
+
+TEST_CASE("Quantize a mesh with levels of detail", "[MeshOptimizer]")
+{
+    Mesh mesh = create_sphere(16, 32);
+    MeshOptimizer optimizer;
+    optimizer.generate_levels_of_detail(mesh, 3);
+    optimizer.quantize_vertices(mesh);
+
+    REQUIRE(mesh.level_of_detail_count() == 3);
+    for (size_t level = 0; level < mesh.level_of_detail_count(); ++level)
+    {
+        REQUIRE(mesh.level_of_detail(level).has_quantized_positions());
+    }
+}
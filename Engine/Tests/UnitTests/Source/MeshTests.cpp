@@ -22,6 +22,7 @@
 // IN THE SOFTWARE.
 ///////////////////////////////////////////////////////////////////////////////
 #include <Hect/Graphics/Mesh.h>
+#include <Hect/Graphics/MeshWriter.h>
 using namespace hect;
 
 #include <catch.hpp>
@@ -189,3 +190,87 @@ TEST_CASE("Get the index data of a mesh", "[Mesh]")
     REQUIRE(index_data[4] == 3);
     REQUIRE(index_data[5] == 0);
 }
+
+TEST_CASE("View the values of a vertex attribute of a mesh", "[Mesh]")
+{
+    VertexLayout vertex_layout;
+    vertex_layout.add_attribute(VertexAttribute(VertexAttributeSemantic::Position, VertexAttributeType::Float32, 3));
+    vertex_layout.add_attribute(VertexAttribute(VertexAttributeSemantic::Normal, VertexAttributeType::Int16, 3));
+    vertex_layout.add_attribute(VertexAttribute(VertexAttributeSemantic::TextureCoords0, VertexAttributeType::Float32, 2));
+
+    Mesh mesh("Test");
+    mesh.set_vertex_layout(vertex_layout);
+
+    {
+        MeshWriter mesh_writer(mesh);
+        for (int i = 0; i < 5; ++i)
+        {
+            mesh_writer.add_vertex();
+            mesh_writer.write_attribute_data(VertexAttributeSemantic::Position, Vector3(i, i * 2.0, i * 3.0));
+            mesh_writer.write_attribute_data(VertexAttributeSemantic::Normal, Vector3(-i, 0, i));
+            mesh_writer.write_attribute_data(VertexAttributeSemantic::TextureCoords0, Vector2(i * 0.5, 1.0));
+        }
+    }
+
+    StridedView<FloatVector3> positions = mesh.attribute_view<FloatVector3>(VertexAttributeSemantic::Position);
+    REQUIRE(positions.size() == 5u);
+    REQUIRE(positions.stride() == vertex_layout.vertex_size());
+    REQUIRE(!positions.is_contiguous());
+
+    size_t index = 0;
+    for (FloatVector3 position : positions)
+    {
+        REQUIRE(position == FloatVector3(index, index * 2.0f, index * 3.0f));
+        REQUIRE(positions[index] == position);
+        ++index;
+    }
+    REQUIRE(index == 5u);
+
+    StridedView<FloatVector2> texture_coords = mesh.attribute_view<FloatVector2>(VertexAttributeSemantic::TextureCoords0);
+    std::vector<Vector2> converted(texture_coords.size());
+    texture_coords.convert_to(converted.data());
+    REQUIRE(converted[3] == Vector2(1.5, 1.0));
+
+    REQUIRE(mesh.has_attribute_view<FloatVector3>(VertexAttributeSemantic::Position));
+    REQUIRE(!mesh.has_attribute_view<FloatVector3>(VertexAttributeSemantic::Normal));
+    REQUIRE(!mesh.has_attribute_view<FloatVector3>(VertexAttributeSemantic::Tangent));
+    REQUIRE_THROWS_AS(mesh.attribute_view<FloatVector4>(VertexAttributeSemantic::Position), InvalidOperation);
+    REQUIRE_THROWS_AS(mesh.attribute_view<FloatVector3>(VertexAttributeSemantic::Tangent), InvalidOperation);
+
+    // Attributes not stored as single-precision vectors are converted
+    // component by component
+    std::vector<Vector3> normals;
+    mesh.copy_attribute_data(VertexAttributeSemantic::Normal, normals);
+    REQUIRE(normals.size() == 5u);
+    REQUIRE(normals[4] == Vector3(-4, 0, 4));
+
+    std::vector<Vector3> copied_positions;
+    mesh.copy_attribute_data(VertexAttributeSemantic::Position, copied_positions);
+    REQUIRE(copied_positions.size() == 5u);
+    REQUIRE(copied_positions[2] == Vector3(2, 4, 6));
+}
+
+TEST_CASE("View the indices of a mesh", "[Mesh]")
+{
+    Mesh mesh("Test");
+    mesh.set_index_type(IndexType::UInt16);
+
+    {
+        MeshWriter mesh_writer(mesh);
+        mesh_writer.add_index(0);
+        mesh_writer.add_index(300);
+        mesh_writer.add_index(65535);
+    }
+
+    StridedView<uint16_t> indices = mesh.index_view<uint16_t>();
+    REQUIRE(indices.size() == 3u);
+    REQUIRE(indices.is_contiguous());
+    REQUIRE(indices[1] == 300);
+    REQUIRE(indices[2] == 65535);
+
+    REQUIRE_THROWS_AS(mesh.index_view<uint32_t>(), InvalidOperation);
+
+    std::vector<uint32_t> widened;
+    mesh.copy_index_data(widened);
+    REQUIRE(widened == std::vector<uint32_t>({ 0, 300, 65535 }));
+}
@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <cmath>
+
+#include <Hect/Concurrency/TaskPool.h>
+#include <Hect/Graphics/MipmapGenerator.h>
+#include <Hect/Noise/Random.h>
+using namespace hect;
+
+#include <catch.hpp>
+
+namespace
+{
+
+Image create_noise_image(unsigned width, unsigned height, ColorSpace color_space)
+{
+    Random random(0);
+
+    Image image(width, height, PixelFormat::Rgba8);
+    image.set_color_space(color_space);
+    for (unsigned x = 0; x < width; ++x)
+    {
+        for (unsigned y = 0; y < height; ++y)
+        {
+            image.write_pixel(x, y, Color(random.next(0.0, 1.0), random.next(0.0, 1.0), random.next(0.0, 1.0), random.next(0.0, 1.0)));
+        }
+    }
+    return image;
+}
+
+}
+
+TEST_CASE("Generate mipmaps of a non-linear image", "[MipmapGenerator]")
+{
+    Image image(2, 2, PixelFormat::Rgba8);
+    image.set_color_space(ColorSpace::NonLinear);
+    image.write_pixel(0, 0, Color(0.0, 0.0, 0.0, 1.0));
+    image.write_pixel(1, 0, Color(1.0, 1.0, 1.0, 1.0));
+    image.write_pixel(0, 1, Color(0.0, 0.0, 0.0, 0.0));
+    image.write_pixel(1, 1, Color(1.0, 1.0, 1.0, 0.0));
+
+    MipmapGenerator generator;
+    generator.generate(image);
+
+    // Half of the light of white is 188 in sRGB, while alpha is averaged as
+    // is
+    REQUIRE(image.mipmap_count() == 2);
+    REQUIRE(image.mipmap(1).color_space() == ColorSpace::NonLinear);
+    REQUIRE(image.mipmap(1).pixel_data()[0] == 188);
+    REQUIRE(image.mipmap(1).pixel_data()[3] == 128);
+}
+
+TEST_CASE("Generate mipmaps of a normal map", "[MipmapGenerator]")
+{
+    Image image(2, 1, PixelFormat::Rgb8);
+    image.write_pixel(0, 0, Color(1.0, 0.5, 0.5));
+    image.write_pixel(1, 0, Color(0.5, 1.0, 0.5));
+
+    MipmapGenerator generator;
+    generator.set_normal_map(true);
+    generator.generate(image);
+
+    // The average of +X and +Y rescaled to unit length
+    Color color = image.mipmap(1).read_pixel(0, 0);
+    REQUIRE(std::abs(color.r * 2.0 - 1.0 - 0.7071) < 0.01);
+    REQUIRE(std::abs(color.g * 2.0 - 1.0 - 0.7071) < 0.01);
+    REQUIRE(std::abs(color.b * 2.0 - 1.0) < 0.01);
+
+    image.set_color_space(ColorSpace::NonLinear);
+    REQUIRE_THROWS_AS(generator.generate(image), InvalidOperation);
+}
+
+TEST_CASE("Generate mipmaps with a Kaiser filter", "[MipmapGenerator]")
+{
+    Image image(13, 6, PixelFormat::Rgb32);
+    for (unsigned x = 0; x < image.width(); ++x)
+    {
+        for (unsigned y = 0; y < image.height(); ++y)
+        {
+            image.write_pixel(x, y, Color(0.25, 0.5, 0.75));
+        }
+    }
+
+    MipmapGenerator generator;
+    generator.set_filter(MipmapFilter::Kaiser);
+    generator.generate(image);
+
+    // A constant image stays constant at every level
+    REQUIRE(image.mipmap_count() == 4);
+    for (size_t level = 1; level < image.mipmap_count(); ++level)
+    {
+        const Image& mipmap = image.mipmap(level);
+        for (unsigned x = 0; x < mipmap.width(); ++x)
+        {
+            for (unsigned y = 0; y < mipmap.height(); ++y)
+            {
+                Color color = mipmap.read_pixel(x, y);
+                REQUIRE(std::abs(color.r - 0.25) < 1e-5);
+                REQUIRE(std::abs(color.g - 0.5) < 1e-5);
+                REQUIRE(std::abs(color.b - 0.75) < 1e-5);
+            }
+        }
+    }
+}
+
+TEST_CASE("Generate mipmaps on a task pool", "[MipmapGenerator]")
+{
+    Image image = create_noise_image(256, 128, ColorSpace::NonLinear);
+    Image threaded_image = image;
+
+    MipmapGenerator generator;
+    generator.set_filter(MipmapFilter::Kaiser);
+    generator.generate(image);
+
+    TaskPool task_pool(size_t(4));
+    MipmapGenerator threaded_generator(task_pool);
+    threaded_generator.set_filter(MipmapFilter::Kaiser);
+    threaded_generator.generate(threaded_image);
+
+    REQUIRE(threaded_image.mipmap_count() == image.mipmap_count());
+    for (size_t level = 0; level < image.mipmap_count(); ++level)
+    {
+        REQUIRE(threaded_image.mipmap(level).pixel_data() == image.mipmap(level).pixel_data());
+    }
+}
+
+TEST_CASE("Resample an image", "[MipmapGenerator]")
+{
+    Image image = create_noise_image(16, 16, ColorSpace::Linear);
+
+    MipmapGenerator generator;
+    Image resampled_image = generator.resample(image, 5, 24);
+
+    REQUIRE(resampled_image.width() == 5);
+    REQUIRE(resampled_image.height() == 24);
+    REQUIRE(resampled_image.pixel_format() == PixelFormat::Rgba8);
+    REQUIRE(resampled_image.mipmap_count() == 1);
+
+    REQUIRE_THROWS_AS(generator.resample(image, 0, 4), InvalidOperation);
+    REQUIRE_THROWS_AS(generator.resample(Image(4, 4, PixelFormat::Rgba8), 2, 2), InvalidOperation);
+}
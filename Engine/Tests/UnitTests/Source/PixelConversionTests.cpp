@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <Hect/Graphics/PixelConversion.h>
+#include <Hect/IO/ByteVector.h>
+using namespace hect;
+
+#include <catch.hpp>
+
+namespace
+{
+
+ByteVector create_bytes(size_t count)
+{
+    ByteVector bytes(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        bytes[i] = static_cast<uint8_t>(i * 31 + i / 7);
+    }
+    return bytes;
+}
+
+}
+
+TEST_CASE("Decode pixels in bulk and one at a time", "[PixelConversion]")
+{
+    const size_t pixel_count = 37;
+    const ByteVector pixels = create_bytes(pixel_count * 4);
+
+    std::vector<float> bulk_components(pixel_count * 4);
+    decode_pixels(pixels.data(), PixelFormat::Rgba8, ColorSpace::Linear, bulk_components.data(), pixel_count);
+
+    for (size_t i = 0; i < pixel_count; ++i)
+    {
+        float components[4];
+        decode_pixels(&pixels[i * 4], PixelFormat::Rgba8, ColorSpace::Linear, components, 1);
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            REQUIRE(bulk_components[i * 4 + c] == components[c]);
+            REQUIRE(std::abs(components[c] - pixels[i * 4 + c] / 255.0f) < 1e-6f);
+        }
+    }
+}
+
+TEST_CASE("Encode pixels in bulk and one at a time", "[PixelConversion]")
+{
+    const size_t pixel_count = 37;
+    std::vector<float> components(pixel_count * 4);
+    for (size_t i = 0; i < components.size(); ++i)
+    {
+        components[i] = static_cast<float>(i % 29) / 20.0f - 0.2f;
+    }
+    components[1] = std::numeric_limits<float>::quiet_NaN();
+
+    ByteVector bulk_pixels(pixel_count * 4);
+    encode_pixels(components.data(), PixelFormat::Rgba8, ColorSpace::Linear, bulk_pixels.data(), pixel_count);
+
+    for (size_t i = 0; i < pixel_count; ++i)
+    {
+        uint8_t pixel[4];
+        encode_pixels(&components[i * 4], PixelFormat::Rgba8, ColorSpace::Linear, pixel, 1);
+        for (unsigned c = 0; c < 4; ++c)
+        {
+            REQUIRE(bulk_pixels[i * 4 + c] == pixel[c]);
+        }
+    }
+
+    REQUIRE(bulk_pixels[0] == 0);
+    REQUIRE(bulk_pixels[1] == 0);
+    REQUIRE(bulk_pixels[28] == 255);
+}
+
+TEST_CASE("Decode and encode non-linear pixels", "[PixelConversion]")
+{
+    const uint8_t pixel[4] = { 0, 188, 255, 188 };
+
+    float components[4];
+    decode_pixels(pixel, PixelFormat::Rgba8, ColorSpace::NonLinear, components, 1);
+
+    // Alpha is not in sRGB
+    REQUIRE(components[0] == 0.0f);
+    REQUIRE(std::abs(components[1] - 0.5f) < 0.005f);
+    REQUIRE(components[2] == 1.0f);
+    REQUIRE(std::abs(components[3] - 188.0f / 255.0f) < 1e-6f);
+
+    uint8_t encoded_pixel[4];
+    encode_pixels(components, PixelFormat::Rgba8, ColorSpace::NonLinear, encoded_pixel, 1);
+    REQUIRE(std::equal(pixel, pixel + 4, encoded_pixel));
+}
+
+TEST_CASE("Convert pixels between pixel formats", "[PixelConversion]")
+{
+    const size_t pixel_count = 300;
+    const ByteVector pixels = create_bytes(pixel_count * 4);
+
+    SECTION("Rgba8 to Rgb8 and back")
+    {
+        ByteVector rgb_pixels(pixel_count * 3);
+        convert_pixels(pixels.data(), PixelFormat::Rgba8, ColorSpace::NonLinear, rgb_pixels.data(), PixelFormat::Rgb8, ColorSpace::NonLinear, pixel_count);
+
+        ByteVector rgba_pixels(pixel_count * 4);
+        convert_pixels(rgb_pixels.data(), PixelFormat::Rgb8, ColorSpace::NonLinear, rgba_pixels.data(), PixelFormat::Rgba8, ColorSpace::NonLinear, pixel_count);
+
+        for (size_t i = 0; i < pixel_count; ++i)
+        {
+            REQUIRE(rgba_pixels[i * 4] == pixels[i * 4]);
+            REQUIRE(rgba_pixels[i * 4 + 1] == pixels[i * 4 + 1]);
+            REQUIRE(rgba_pixels[i * 4 + 2] == pixels[i * 4 + 2]);
+            REQUIRE(rgba_pixels[i * 4 + 3] == 255);
+        }
+    }
+
+    SECTION("Non-linear Rgba8 to linear 16-bit and 32-bit floats and back")
+    {
+        const PixelFormat float_pixel_formats[] = { PixelFormat::Rgba16, PixelFormat::Rgba32 };
+        for (const PixelFormat& pixel_format : float_pixel_formats)
+        {
+            ByteVector float_pixels(pixel_count * pixel_format.size());
+            convert_pixels(pixels.data(), PixelFormat::Rgba8, ColorSpace::NonLinear, float_pixels.data(), pixel_format, ColorSpace::Linear, pixel_count);
+
+            ByteVector byte_pixels(pixel_count * 4);
+            convert_pixels(float_pixels.data(), pixel_format, ColorSpace::Linear, byte_pixels.data(), PixelFormat::Rgba8, ColorSpace::NonLinear, pixel_count);
+
+            REQUIRE(byte_pixels == pixels);
+        }
+    }
+
+    SECTION("Block-compressed pixels")
+    {
+        ByteVector dest(pixel_count * 4);
+        REQUIRE_THROWS_AS(convert_pixels(pixels.data(), PixelFormat::Bc7, ColorSpace::Linear, dest.data(), PixelFormat::Rgba8, ColorSpace::Linear, 16), InvalidOperation);
+    }
+}
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect/Math/Quantization.h>
+using namespace hect;
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <limits>
+
+TEST_CASE("Encode and decode 16-bit floats", "[Quantization]")
+{
+    REQUIRE(encode_float16(0.0f) == 0x0000);
+    REQUIRE(encode_float16(-0.0f) == 0x8000);
+    REQUIRE(encode_float16(1.0f) == 0x3c00);
+    REQUIRE(encode_float16(-2.0f) == 0xc000);
+    REQUIRE(encode_float16(65504.0f) == 0x7bff);
+    REQUIRE(encode_float16(1.0e6f) == 0x7c00);
+    REQUIRE(encode_float16(std::numeric_limits<float>::infinity()) == 0x7c00);
+
+    REQUIRE(decode_float16(0x3c00) == 1.0f);
+    REQUIRE(decode_float16(0x3555) == Approx(0.333251953125f));
+    REQUIRE(decode_float16(0x0001) == Approx(5.9604645e-8f));
+    REQUIRE(std::isnan(decode_float16(encode_float16(std::numeric_limits<float>::quiet_NaN()))));
+
+    // Every finite 16-bit float survives a round trip
+    for (uint32_t bits = 0; bits < 0x10000; ++bits)
+    {
+        if ((bits & 0x7c00) != 0x7c00)
+        {
+            REQUIRE(encode_float16(decode_float16(static_cast<uint16_t>(bits))) == bits);
+        }
+    }
+}
+
+TEST_CASE("Encode and decode normalized 16-bit integers", "[Quantization]")
+{
+    REQUIRE(encode_normalized_int16(1.0) == 32767);
+    REQUIRE(encode_normalized_int16(-1.0) == -32767);
+    REQUIRE(encode_normalized_int16(2.0) == 32767);
+    REQUIRE(decode_normalized_int16(-32768) == -1.0);
+    REQUIRE(decode_normalized_int16(encode_normalized_int16(0.25)) == Approx(0.25).epsilon(1.0e-4));
+
+    REQUIRE(encode_normalized_uint16(1.0) == 65535);
+    REQUIRE(encode_normalized_uint16(-1.0) == 0);
+    REQUIRE(decode_normalized_uint16(encode_normalized_uint16(0.75)) == Approx(0.75).epsilon(1.0e-4));
+}
+
+TEST_CASE("Encode and decode octahedral directions", "[Quantization]")
+{
+    const Vector3 directions[] =
+    {
+        Vector3::UnitX,
+        -Vector3::UnitY,
+        Vector3::UnitZ,
+        -Vector3::UnitZ,
+        Vector3(1, 2, 3).normalized(),
+        Vector3(-3, 1, -2).normalized(),
+        Vector3(0.5, -0.5, -0.1).normalized()
+    };
+
+    for (Vector3 direction : directions)
+    {
+        int16_t encoded[2];
+        encode_octahedral(direction, encoded);
+        Vector3 decoded = decode_octahedral(encoded);
+
+        REQUIRE(decoded.length() == Approx(1.0));
+        REQUIRE(decoded.dot(direction) > 0.99999);
+    }
+}
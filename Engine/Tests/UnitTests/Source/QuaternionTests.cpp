@@ -169,3 +169,34 @@ TEST_CASE("Index a quaternion", "[Quaternion]")
     REQUIRE(a[2] == 3.0);
     REQUIRE(a[3] == 4.0);
 }
+
+TEST_CASE("Multiply a quaternion and a vector matches the rotation matrix", "[Quaternion]")
+{
+    Quaternion r = Quaternion::from_axis_angle(Vector3(1.0, 2.0, -3.0).normalized(), Degrees(75));
+    Vector3 v(0.5, -4.0, 2.0);
+
+    Vector3 a = r * v;
+    Vector3 b = Matrix4::from_rotation(r) * v;
+    REQUIRE(std::abs(a.x - b.x) < 0.0001);
+    REQUIRE(std::abs(a.y - b.y) < 0.0001);
+    REQUIRE(std::abs(a.z - b.z) < 0.0001);
+
+    FloatQuaternion rf = r;
+    FloatVector3 af = rf * FloatVector3(v);
+    REQUIRE(std::abs(af.x - a.x) < 0.001);
+    REQUIRE(std::abs(af.y - a.y) < 0.001);
+    REQUIRE(std::abs(af.z - a.z) < 0.001);
+}
+
+TEST_CASE("Multiply two single-precision quaternions", "[Quaternion]")
+{
+    Quaternion a = Quaternion::from_axis_angle(Vector3::UnitX, Degrees(40));
+    Quaternion b = Quaternion::from_axis_angle(Vector3(0.0, 1.0, 1.0).normalized(), Degrees(110));
+    Quaternion c = a * b;
+
+    FloatQuaternion cf = FloatQuaternion(a) * FloatQuaternion(b);
+    REQUIRE(std::abs(cf.x - c.x) < 0.0001);
+    REQUIRE(std::abs(cf.y - c.y) < 0.0001);
+    REQUIRE(std::abs(cf.z - c.z) < 0.0001);
+    REQUIRE(std::abs(cf.w - c.w) < 0.0001);
+}
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect/Core/RadixSort.h>
+using namespace hect;
+
+#include <algorithm>
+#include <random>
+
+#include <catch.hpp>
+
+namespace
+{
+
+struct TestValue
+{
+    uint64_t key;
+    size_t index;
+};
+
+uint64_t key_of(const TestValue& value)
+{
+    return value.key;
+}
+
+}
+
+TEST_CASE("Radix sort an empty vector", "[RadixSort]")
+{
+    std::vector<TestValue> values;
+    std::vector<TestValue> scratch;
+    radix_sort(values, scratch, key_of);
+    REQUIRE(values.empty());
+}
+
+TEST_CASE("Radix sort random keys spanning all bytes", "[RadixSort]")
+{
+    std::mt19937_64 random(42);
+
+    std::vector<TestValue> values;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        values.push_back(TestValue { random(), i });
+    }
+
+    std::vector<uint64_t> expected_keys;
+    for (const TestValue& value : values)
+    {
+        expected_keys.push_back(value.key);
+    }
+    std::sort(expected_keys.begin(), expected_keys.end());
+
+    std::vector<TestValue> scratch;
+    radix_sort(values, scratch, key_of);
+
+    REQUIRE(values.size() == expected_keys.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        REQUIRE(values[i].key == expected_keys[i]);
+    }
+}
+
+TEST_CASE("Radix sort is stable for equal keys", "[RadixSort]")
+{
+    std::vector<TestValue> values;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        values.push_back(TestValue { (i % 3) << 40, i });
+    }
+
+    std::vector<TestValue> scratch;
+    radix_sort(values, scratch, key_of);
+
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+        REQUIRE(values[i - 1].key <= values[i].key);
+        if (values[i - 1].key == values[i].key)
+        {
+            REQUIRE(values[i - 1].index < values[i].index);
+        }
+    }
+}
@@ -113,4 +113,79 @@ TEST_CASE("Get and set the priority of a shader", "[Shader]")
     REQUIRE(shader.priority() == 0);
     shader.set_priority(1);
     REQUIRE(shader.priority() == 1);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Get the indices of the bound uniforms of a shader", "[Shader]")
+{
+    Shader shader;
+    shader.add_uniform(Uniform("A", UniformType::Float));
+    shader.add_uniform(Uniform("B", UniformBinding::ModelMatrix));
+    shader.add_uniform(Uniform("C", UniformType::Vector3));
+    shader.add_uniform(Uniform("D", UniformBinding::CameraPosition));
+
+    const std::vector<UniformIndex>& indices = shader.bound_uniform_indices();
+    REQUIRE(indices.size() == 2);
+    REQUIRE(indices[0] == 1);
+    REQUIRE(indices[1] == 3);
+}
+
+TEST_CASE("Resolve the std140 layout of a uniform block of a shader", "[Shader]")
+{
+    Shader shader;
+
+    const Name block_name("Material");
+    const UniformType types[] = { UniformType::Float, UniformType::Vector3, UniformType::Vector2, UniformType::Matrix4, UniformType::Float };
+    for (size_t i = 0; i < 5; ++i)
+    {
+        Uniform uniform(format("uniform%d", static_cast<int>(i)), types[i]);
+        uniform.set_block(block_name);
+        shader.add_uniform(uniform);
+    }
+    shader.add_uniform(Uniform("unpacked", UniformType::Float));
+
+    REQUIRE(shader.uniform_blocks().size() == 1);
+
+    const UniformBlockLayout& layout = shader.uniform_blocks()[0];
+    REQUIRE(layout.name() == block_name);
+    REQUIRE(layout.index() == 0);
+    REQUIRE(!layout.is_bound());
+    REQUIRE(layout.uniform_indices().size() == 5);
+    REQUIRE(layout.size() == 128);
+
+    const size_t offsets[] = { 0, 16, 32, 48, 112 };
+    for (size_t i = 0; i < 5; ++i)
+    {
+        const Uniform& uniform = shader.uniform(i);
+        REQUIRE(uniform.is_in_block());
+        REQUIRE(uniform.block_index() == 0);
+        REQUIRE(uniform.block_offset() == offsets[i]);
+    }
+
+    REQUIRE(!shader.uniform("unpacked").is_in_block());
+}
+
+TEST_CASE("Add a uniform which cannot be in a uniform block to a shader", "[Shader]")
+{
+    Shader shader;
+
+    Uniform camera_position("camera_position", UniformBinding::CameraPosition);
+    camera_position.set_block("Frame");
+    shader.add_uniform(camera_position);
+
+    Uniform texture("texture", UniformType::Texture2);
+    texture.set_block("Material");
+    REQUIRE_THROWS_AS(shader.add_uniform(texture), InvalidOperation);
+
+    Uniform model_matrix("model_matrix", UniformBinding::ModelMatrix);
+    model_matrix.set_block("Frame");
+    REQUIRE_THROWS_AS(shader.add_uniform(model_matrix), InvalidOperation);
+
+    Uniform unbound("unbound", UniformType::Float);
+    unbound.set_block("Frame");
+    REQUIRE_THROWS_AS(shader.add_uniform(unbound), InvalidOperation);
+
+    REQUIRE(shader.uniforms().size() == 1);
+    REQUIRE(shader.uniform_blocks().size() == 1);
+    REQUIRE(shader.uniform_blocks()[0].is_bound());
+    REQUIRE(shader.uniform_blocks()[0].size() == 16);
+}
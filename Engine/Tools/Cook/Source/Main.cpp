@@ -0,0 +1,710 @@
+///////////////////////////////////////////////////////////////////////////////
+// This source file is part of Hect.
+//
+// Copyright (c) 2016 Colin Hill
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+///////////////////////////////////////////////////////////////////////////////
+#include <Hect.h>
+using namespace hect;
+
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+
+#include <tclap/CmdLine.h>
+
+namespace
+{
+
+ByteVector read_file(const std::string& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+    {
+        throw IOError(format("Failed to open '%s' for reading", path.data()));
+    }
+
+    return ByteVector(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string& path, const ByteVector& data)
+{
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream)
+    {
+        throw IOError(format("Failed to open '%s' for writing", path.data()));
+    }
+
+    stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+// Optimizes a binary mesh for rendering
+void cook_mesh(const std::string& input_path, const std::string& output_path, bool quantize, unsigned level_of_detail_count)
+{
+    Mesh mesh;
+    {
+        ByteVector data = read_file(input_path);
+        BinaryDecoder decoder(data);
+        decoder >> decode_value(mesh);
+    }
+
+    MeshOptimizer::Metrics metrics = mesh.optimize();
+    std::cout << format("Cooked mesh '%s'", input_path.data()) << std::endl;
+    std::cout << format("    Vertices: %u -> %u", static_cast<unsigned>(metrics.vertex_count_before), static_cast<unsigned>(metrics.vertex_count_after)) << std::endl;
+    std::cout << format("    ACMR: %.3f -> %.3f", metrics.acmr_before, metrics.acmr_after) << std::endl;
+
+    if (level_of_detail_count > 1)
+    {
+        MeshOptimizer optimizer;
+        optimizer.generate_levels_of_detail(mesh, level_of_detail_count);
+        for (size_t level = 0; level < mesh.level_of_detail_count(); ++level)
+        {
+            const Mesh& level_of_detail = mesh.level_of_detail(level);
+            const unsigned index_count = static_cast<unsigned>(level_of_detail.index_count());
+            std::cout << format("    Level of detail %u: %u triangles, error %.5f", static_cast<unsigned>(level), index_count / 3, level_of_detail.simplification_error()) << std::endl;
+        }
+    }
+
+    if (quantize)
+    {
+        const unsigned vertex_size = mesh.vertex_layout().vertex_size();
+
+        MeshOptimizer optimizer;
+        optimizer.quantize_vertices(mesh);
+        std::cout << format("    Vertex size: %u -> %u bytes", vertex_size, mesh.vertex_layout().vertex_size()) << std::endl;
+    }
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(mesh);
+    }
+    write_file(output_path, data);
+}
+
+// Returns the total size of the pixel data of an image and its mipmaps
+size_t image_data_size(const Image& image)
+{
+    size_t size = 0;
+    for (size_t level = 0; level < image.mipmap_count(); ++level)
+    {
+        size += image.mipmap(level).pixel_data().size();
+    }
+    return size;
+}
+
+// Converts a 32-bit RGBA image to a cooked texture image, optionally with a
+// mipmap chain and block compression
+void cook_texture(const std::string& input_path, const std::string& output_path, const std::string& format_name, bool mipmaps, bool srgb, bool normal_map)
+{
+    static const std::map<std::string, PixelFormat> pixel_formats =
+    {
+        { "rgba8", PixelFormat::Rgba8 },
+        { "bc1", PixelFormat::Bc1 },
+        { "bc3", PixelFormat::Bc3 },
+        { "bc4", PixelFormat::Bc4 },
+        { "bc5", PixelFormat::Bc5 },
+        { "bc7", PixelFormat::Bc7 }
+    };
+
+    auto it = pixel_formats.find(format_name);
+    if (it == pixel_formats.end())
+    {
+        throw InvalidOperation(format("Unknown texture format '%s'", format_name.data()));
+    }
+
+    Image image;
+    {
+        ByteVector data = read_file(input_path);
+        BinaryDecoder decoder(data);
+        decoder >> decode_value(image);
+    }
+
+    const size_t size_before = image_data_size(image);
+
+    if (srgb)
+    {
+        image.set_color_space(ColorSpace::NonLinear);
+    }
+
+    if (mipmaps)
+    {
+        TaskPool task_pool;
+        MipmapGenerator generator(task_pool);
+        generator.set_filter(MipmapFilter::Kaiser);
+        generator.set_normal_map(normal_map);
+        generator.generate(image);
+    }
+
+    if (it->second.is_compressed())
+    {
+        ImageCompressor compressor;
+        image = compressor.compress(image, it->second);
+    }
+
+    std::cout << format("Cooked texture '%s'", input_path.data()) << std::endl;
+    std::cout << format("    Format: %s", format_name.data()) << std::endl;
+    std::cout << format("    Mipmaps: %u", static_cast<unsigned>(image.mipmap_count())) << std::endl;
+    std::cout << format("    Size: %u -> %u bytes", static_cast<unsigned>(size_before), static_cast<unsigned>(image_data_size(image))) << std::endl;
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(image);
+    }
+    write_file(output_path, data);
+}
+
+// Replaces the wildcard in a path with the name of a side of a cube map
+std::string side_path(const std::string& path, CubeSide side)
+{
+    static const char* side_names[] =
+    {
+        "positive_x",
+        "negative_x",
+        "positive_y",
+        "negative_y",
+        "positive_z",
+        "negative_z"
+    };
+
+    const size_t wildcard = path.find('*');
+    if (wildcard == std::string::npos)
+    {
+        throw InvalidOperation(format("Path '%s' has no wildcard for the sides of the cube map", path.data()));
+    }
+
+    std::string result = path;
+    result.replace(wildcard, 1, side_names[static_cast<int>(side)]);
+    return result;
+}
+
+// Convolves the six sides of an environment into a light probe: each side
+// is written with its prefiltered specular mipmap chain, and the spherical
+// harmonics of the irradiance are printed
+void cook_probe(const std::string& input_path, const std::string& output_path, bool srgb)
+{
+    TextureCube texture;
+    for (int side = 0; side < 6; ++side)
+    {
+        AssetHandle<Image> image(new Image());
+        {
+            ByteVector data = read_file(side_path(input_path, static_cast<CubeSide>(side)));
+            BinaryDecoder decoder(data);
+            decoder >> decode_value(*image);
+        }
+
+        if (srgb)
+        {
+            image->set_color_space(ColorSpace::NonLinear);
+        }
+        texture.set_image(static_cast<CubeSide>(side), image);
+    }
+
+    TaskPool task_pool;
+    LightProbeConvolver convolver(task_pool);
+    const SphericalHarmonics irradiance = convolver.project_irradiance(texture);
+    convolver.prefilter_specular(texture);
+
+    std::cout << format("Cooked probe '%s'", input_path.data()) << std::endl;
+    std::cout << format("    Mipmaps: %u", static_cast<unsigned>(texture.image(CubeSide::PositiveX).mipmap_count())) << std::endl;
+    for (size_t i = 0; i < SphericalHarmonics::CoefficientCount; ++i)
+    {
+        const Vector3& coefficient = irradiance[i];
+        std::cout << format("    Irradiance %u: %.6f %.6f %.6f", static_cast<unsigned>(i), coefficient.x, coefficient.y, coefficient.z) << std::endl;
+    }
+
+    for (int side = 0; side < 6; ++side)
+    {
+        ByteVector data;
+        {
+            BinaryEncoder encoder(data);
+            encoder << encode_value(texture.image(static_cast<CubeSide>(side)));
+        }
+        write_file(side_path(output_path, static_cast<CubeSide>(side)), data);
+    }
+}
+
+// The name of the manifest written to the directory of cooked assets
+const char* const ManifestFileName = "Assets.manifest";
+
+// Changing the version re-cooks every asset, since it is hashed into the key
+// of each cooked asset
+const uint64_t CookVersion = 2;
+
+// The result of cooking an asset
+struct CookResult
+{
+    AssetManifest::Entry entry;
+    bool cooked { false };
+    std::string error;
+};
+
+bool file_exists(const std::string& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    return static_cast<bool>(stream);
+}
+
+// FNV-1a
+uint64_t hash_bytes(const void* data, size_t size, uint64_t hash)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t hash_file(FileSystem& file_system, const Path& path, uint64_t hash)
+{
+    const std::string& path_string = path.as_string();
+    hash = hash_bytes(path_string.data(), path_string.size() + 1, hash);
+
+    // A missing file hashes differently than any contents
+    if (!file_system.exists(path))
+    {
+        return hash_bytes("\xff", 1, hash);
+    }
+
+    auto stream = file_system.open_file_for_read(path);
+    ByteVector data(stream->length());
+    if (!data.empty())
+    {
+        stream->read(data.data(), data.size());
+    }
+    return hash_bytes(data.data(), data.size(), hash);
+}
+
+// Hashes the contents of the source file of an asset and its dependencies
+uint64_t hash_asset(FileSystem& file_system, const Path& path, const std::vector<Path>& dependencies)
+{
+    uint64_t hash = hash_bytes(&CookVersion, sizeof(CookVersion), 14695981039346656037ull);
+    hash = hash_file(file_system, path, hash);
+    for (const Path& dependency : dependencies)
+    {
+        hash = hash_file(file_system, dependency, hash);
+    }
+    return hash;
+}
+
+// Decodes an asset from its source file and encodes it in binary
+template <typename AssetType>
+ByteVector encode_asset(AssetCache& asset_cache, const Path& path)
+{
+    AssetType asset;
+    {
+        AssetDecoder decoder(asset_cache, path);
+        decoder >> decode_value(asset);
+    }
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(asset);
+    }
+    return data;
+}
+
+// Decodes a scene of the type named in its source file and encodes it in
+// binary; the scene is constructed against the engine, so the asset cache
+// must be the asset cache of the engine
+ByteVector encode_scene(AssetCache& asset_cache, const Path& path)
+{
+    assert(&asset_cache == &Engine::instance().asset_cache());
+
+    Name type_name;
+    {
+        AssetDecoder decoder(asset_cache, path);
+        decoder >> decode_value("scene_type", type_name);
+    }
+
+    std::shared_ptr<Scene> scene = SceneRegistry::create(SceneRegistry::type_id_of(type_name));
+    {
+        AssetDecoder decoder(asset_cache, path);
+        decoder >> decode_value(*scene);
+    }
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(*scene);
+    }
+    return data;
+}
+
+typedef ByteVector (*AssetEncoder)(AssetCache&, const Path&);
+
+// Returns the asset type of a YAML source file (e.g. "mesh" for
+// "Cube.mesh.yaml")
+std::string asset_type(const Path& path)
+{
+    if (path.extension() != "yaml")
+    {
+        return std::string();
+    }
+
+    const std::string& path_string = path.as_string();
+    return Path(path_string.substr(0, path_string.size() - 5)).extension();
+}
+
+// Returns the function which encodes the asset of a YAML source file, or
+// null if the asset has no binary encoding to cook to
+AssetEncoder asset_encoder(const Path& path)
+{
+    static const std::map<std::string, AssetEncoder> asset_encoders =
+    {
+        { "material", encode_asset<Material> },
+        { "mesh", encode_asset<Mesh> },
+        { "scene", encode_scene },
+        { "shader", encode_asset<Shader> },
+        { "texture2", encode_asset<Texture2> },
+        { "texture3", encode_asset<Texture3> },
+        { "texture_cube", encode_asset<TextureCube> }
+    };
+
+    auto it = asset_encoders.find(asset_type(path));
+    return it != asset_encoders.end() ? it->second : nullptr;
+}
+
+// Finds the source files of the assets to cook in a directory and its
+// sub-directories, as paths relative to the directory
+void find_source_files(FileSystem& file_system, const Path& mount_point, const Path& directory_path, const std::string& input_path, std::vector<Path>& source_paths)
+{
+    for (const Path& path : file_system.files_in_directory(mount_point + directory_path))
+    {
+        const Path relative_path = path.as_string().substr(mount_point.as_string().size() + (mount_point.empty() ? 0 : 1));
+        if (asset_encoder(relative_path))
+        {
+            // Skip files of other archives mounted to the same point
+            if (file_exists(input_path + "/" + relative_path.as_string()))
+            {
+                source_paths.push_back(relative_path);
+            }
+        }
+        else
+        {
+            find_source_files(file_system, mount_point, relative_path, input_path, source_paths);
+        }
+    }
+}
+
+// Cooks an asset unless the cooked asset of the previous cook is up to date;
+// the asset is decoded through an asset cache which is cleared first, so the
+// files it reads are the dependencies of the asset
+CookResult cook_asset(FileSystem& file_system, AssetCache& asset_cache, const Path& source_path, const Path& cooked_path, const std::string& output_path, const AssetManifest& previous_manifest)
+{
+    CookResult result;
+    AssetManifest::Entry& entry = result.entry;
+    entry.path = source_path;
+    entry.cooked_path = cooked_path;
+
+    try
+    {
+        // Skip the asset if neither the source file nor its dependencies
+        // changed
+        const std::string cooked_file_path = output_path + "/" + cooked_path.as_string();
+        if (previous_manifest.has_entry(source_path) && file_exists(cooked_file_path))
+        {
+            const AssetManifest::Entry& previous_entry = previous_manifest.entry(source_path);
+            if (previous_entry.cooked_path == cooked_path && hash_asset(file_system, source_path, previous_entry.dependencies) == previous_entry.hash)
+            {
+                entry = previous_entry;
+                return result;
+            }
+        }
+
+        asset_cache.clear();
+        const ByteVector data = asset_encoder(source_path)(asset_cache, source_path);
+        for (const Path& path : asset_cache.decoded_paths())
+        {
+            if (path != source_path)
+            {
+                entry.dependencies.push_back(path);
+            }
+        }
+        entry.hash = hash_asset(file_system, source_path, entry.dependencies);
+
+        write_file(cooked_file_path, data);
+        result.cooked = true;
+    }
+    catch (const std::exception& exception)
+    {
+        result.error = exception.what();
+    }
+
+    return result;
+}
+
+// Cooks the assets with binary encodings in a directory and writes a
+// manifest of the cooked assets for the AssetCache to consult; assets whose
+// source files and dependencies are unchanged since the last cook are not
+// cooked again
+void cook_assets(const std::string& input_path, const std::string& output_path, const std::string& mount_point, char* const argv[])
+{
+    Engine engine(1, argv);
+    FileSystem& file_system = engine.file_system();
+    file_system.mount_archive(input_path, mount_point);
+
+    // Create the output directory within its parent directory
+    const Path output_directory(output_path);
+    const Path parent_directory = output_directory.parent_directory();
+    file_system.set_write_directory(parent_directory.empty() ? file_system.working_directory() : parent_directory);
+    file_system.create_directory(output_path.substr(parent_directory.empty() ? 0 : parent_directory.as_string().size() + 1));
+    file_system.set_write_directory(output_directory);
+
+    // Load the manifest of the previous cook
+    AssetManifest previous_manifest;
+    const std::string manifest_path = output_path + "/" + ManifestFileName;
+    if (file_exists(manifest_path))
+    {
+        ByteVector data = read_file(manifest_path);
+        BinaryDecoder decoder(data);
+        decoder >> decode_value(previous_manifest);
+    }
+
+    std::vector<Path> relative_paths;
+    find_source_files(file_system, mount_point, Path(), input_path, relative_paths);
+
+    std::vector<Path> source_paths;
+    std::vector<Path> cooked_paths;
+    for (const Path& relative_path : relative_paths)
+    {
+        const std::string& relative_path_string = relative_path.as_string();
+        const Path cooked_path = relative_path_string.substr(0, relative_path_string.size() - 5);
+        if (!cooked_path.parent_directory().empty())
+        {
+            file_system.create_directory(cooked_path.parent_directory());
+        }
+
+        source_paths.push_back(Path(mount_point) + relative_path);
+        cooked_paths.push_back(cooked_path);
+    }
+
+    // Cook each asset in a task of its own with an asset cache of its own,
+    // except for scenes: the systems of a scene load assets through the
+    // asset cache of the engine, which is not safe to use concurrently, so
+    // scenes are cooked afterwards one at a time on this thread
+    std::vector<CookResult> results(relative_paths.size());
+    {
+        TaskPool task_pool;
+        std::vector<Task::Handle> tasks;
+        for (size_t i = 0; i < relative_paths.size(); ++i)
+        {
+            if (asset_type(relative_paths[i]) != "scene")
+            {
+                tasks.push_back(task_pool.enqueue([&, i]
+                {
+                    AssetCache asset_cache(file_system, false);
+                    results[i] = cook_asset(file_system, asset_cache, source_paths[i], cooked_paths[i], output_path, previous_manifest);
+                }));
+            }
+        }
+
+        for (Task::Handle& task : tasks)
+        {
+            task->wait();
+        }
+    }
+
+    for (size_t i = 0; i < relative_paths.size(); ++i)
+    {
+        if (asset_type(relative_paths[i]) == "scene")
+        {
+            results[i] = cook_asset(file_system, engine.asset_cache(), source_paths[i], cooked_paths[i], output_path, previous_manifest);
+        }
+    }
+
+    AssetManifest manifest;
+    unsigned cooked_count = 0;
+    unsigned failed_count = 0;
+    for (const CookResult& result : results)
+    {
+        if (!result.error.empty())
+        {
+            std::cerr << format("Failed to cook '%s': %s", result.entry.path.as_string().data(), result.error.data()) << std::endl;
+            ++failed_count;
+        }
+        else
+        {
+            if (result.cooked)
+            {
+                std::cout << format("Cooked asset '%s'", result.entry.path.as_string().data()) << std::endl;
+                ++cooked_count;
+            }
+            manifest.add_entry(result.entry);
+        }
+    }
+
+    ByteVector data;
+    {
+        BinaryEncoder encoder(data);
+        encoder << encode_value(manifest);
+    }
+    write_file(manifest_path, data);
+
+    std::cout << format("Cooked %u assets, %u up to date", cooked_count, static_cast<unsigned>(manifest.entries().size()) - cooked_count) << std::endl;
+    if (failed_count > 0)
+    {
+        throw InvalidOperation(format("Failed to cook %u assets", failed_count));
+    }
+}
+
+}
+
+int main(int argc, char* const argv[])
+{
+    int code = 0;
+    try
+    {
+        Engine::pre_initialize();
+
+        TCLAP::CmdLine cmd("Hect Cook");
+        TCLAP::UnlabeledValueArg<std::string> step_arg
+        {
+            "step",
+            "The cook step to perform (mesh, texture, probe or assets)",
+            true,
+            "",
+            "string"
+        };
+        TCLAP::UnlabeledValueArg<std::string> input_arg
+        {
+            "input",
+            "The path of the asset to cook, with a '*' for the side names of probes, or the directory of assets",
+            true,
+            "",
+            "string"
+        };
+        TCLAP::UnlabeledValueArg<std::string> output_arg
+        {
+            "output",
+            "The path to write the cooked asset to, with a '*' for the side names of probes, or the directory of cooked assets",
+            true,
+            "",
+            "string"
+        };
+
+        TCLAP::SwitchArg quantize_arg
+        {
+            "q", "quantize",
+            "Convert the vertex attributes of meshes to compact types",
+            false
+        };
+
+        TCLAP::ValueArg<unsigned> lods_arg
+        {
+            "l", "lods",
+            "The largest number of levels of detail to generate for meshes, including the mesh itself",
+            false,
+            1,
+            "unsigned"
+        };
+
+        TCLAP::ValueArg<std::string> format_arg
+        {
+            "f", "format",
+            "The pixel format of cooked textures (rgba8, bc1, bc3, bc4, bc5 or bc7)",
+            false,
+            "rgba8",
+            "string"
+        };
+
+        TCLAP::SwitchArg mipmaps_arg
+        {
+            "m", "mipmaps",
+            "Generate the mipmap chain of textures",
+            false
+        };
+
+        TCLAP::SwitchArg srgb_arg
+        {
+            "s", "srgb",
+            "Treat the color components of textures and probes as sRGB",
+            false
+        };
+
+        TCLAP::SwitchArg normal_map_arg
+        {
+            "n", "normal-map",
+            "Renormalize the normals of texture mipmaps",
+            false
+        };
+
+        TCLAP::ValueArg<std::string> mount_point_arg
+        {
+            "p", "mount-point",
+            "The path that the directory of assets is mounted to at runtime",
+            false,
+            "",
+            "string"
+        };
+
+        cmd.add(step_arg);
+        cmd.add(input_arg);
+        cmd.add(output_arg);
+        cmd.add(quantize_arg);
+        cmd.add(lods_arg);
+        cmd.add(format_arg);
+        cmd.add(mipmaps_arg);
+        cmd.add(srgb_arg);
+        cmd.add(normal_map_arg);
+        cmd.add(mount_point_arg);
+        cmd.parse(argc, argv);
+
+        const std::string& step = step_arg.getValue();
+        if (step == "mesh")
+        {
+            cook_mesh(input_arg.getValue(), output_arg.getValue(), quantize_arg.getValue(), lods_arg.getValue());
+        }
+        else if (step == "texture")
+        {
+            cook_texture(input_arg.getValue(), output_arg.getValue(), format_arg.getValue(), mipmaps_arg.getValue(), srgb_arg.getValue(), normal_map_arg.getValue());
+        }
+        else if (step == "probe")
+        {
+            cook_probe(input_arg.getValue(), output_arg.getValue(), srgb_arg.getValue());
+        }
+        else if (step == "assets")
+        {
+            cook_assets(input_arg.getValue(), output_arg.getValue(), mount_point_arg.getValue(), argv);
+        }
+        else
+        {
+            throw InvalidOperation(format("Unknown cook step '%s'", step.data()));
+        }
+    }
+    catch (hect::Exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        code = 1;
+    }
+    catch (TCLAP::ArgException& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        code = 1;
+    }
+
+    Engine::post_uninitialize();
+    return code;
+}